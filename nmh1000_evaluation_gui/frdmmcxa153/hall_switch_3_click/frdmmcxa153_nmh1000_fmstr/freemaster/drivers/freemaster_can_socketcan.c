@@ -0,0 +1,255 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * License: NXP LA_OPT_NXP_Software_License
+ *
+ * NXP Confidential. This software is owned or controlled by NXP and may
+ * only be used strictly in accordance with the applicable license terms.
+ * By expressly accepting such terms or by downloading, installing,
+ * activating and/or otherwise using the software, you are agreeing that
+ * you have read, and that you agree to comply with and are bound by,
+ * such license terms.  If you do not agree to be bound by the applicable
+ * license terms, then you may not retain, install, activate or otherwise
+ * use the software.  This code may only be used in a microprocessor,
+ * microcontroller, sensor or digital signal processor ("NXP Product")
+ * supplied directly or indirectly from NXP.  See the full NXP Software
+ * License Agreement in license/LA_OPT_NXP_Software_License.pdf
+ *
+ * FreeMASTER Communication Driver - CAN driver for Linux SocketCAN
+ */
+
+#include "freemaster.h"
+#include "freemaster_private.h"
+
+/* Numeric identifier to help pre-processor to identify whether our driver is used or not. */
+#define FMSTR_CAN_SOCKETCAN_ID 1
+
+#if (FMSTR_MK_IDSTR(FMSTR_CAN_DRV) == FMSTR_CAN_SOCKETCAN_ID)
+
+#include "freemaster_can_socketcan.h"
+
+#if FMSTR_DISABLE == 0
+
+#include "freemaster_can.h"
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <net/if.h>
+#include <sys/socket.h>
+#include <linux/can.h>
+#include <linux/can/raw.h>
+
+/******************************************************************************
+ * Configuration
+ ******************************************************************************/
+#if (defined(FMSTR_SHORT_INTR) && FMSTR_SHORT_INTR) || (defined(FMSTR_LONG_INTR) && FMSTR_LONG_INTR)
+#error The FreeMASTER SocketCAN driver does not support interrupt mode.
+#endif
+
+/******************************************************************************
+ * Local macros
+ ******************************************************************************/
+
+/* SocketCAN: id to can_id translation */
+#define FMSTR_SOCKETCAN_ID2IDR(id) \
+    (((id)&FMSTR_CAN_EXTID) != 0UL ? (((id)&CAN_EFF_MASK) | CAN_EFF_FLAG) : ((id)&CAN_SFF_MASK))
+
+/******************************************************************************
+ * Local functions
+ ******************************************************************************/
+
+static FMSTR_BOOL _FMSTR_SocketCan_Init(FMSTR_U32 idRx, FMSTR_U32 idTx); /* Open and bind the CAN socket. */
+static void _FMSTR_SocketCan_EnableRx(void);                             /* Enable/re-initialize Receiver buffer. */
+static FMSTR_SIZE8 _FMSTR_SocketCan_GetRxFrameLen(void);                 /* Return size of received CAN frame. */
+static FMSTR_BCHR _FMSTR_SocketCan_GetRxFrameByte(FMSTR_SIZE8 index);    /* Get data byte at index. */
+static void _FMSTR_SocketCan_AckRxFrame(void);           /* Discard received frame and enable receiving a next one. */
+static FMSTR_BOOL _FMSTR_SocketCan_PrepareTxFrame(void); /* Initialize transmit buffer. */
+static void _FMSTR_SocketCan_PutTxFrameByte(FMSTR_SIZE8 index, FMSTR_BCHR data); /* Fill one byte of transmit data. */
+static void _FMSTR_SocketCan_SendTxFrame(FMSTR_SIZE8 len);                       /* Send the Tx buffer. */
+
+/******************************************************************************
+ * Local variables
+ ******************************************************************************/
+
+static const char *fmstr_canIfName = FMSTR_CAN_SOCKETCAN_IF;
+static int fmstr_canSock           = -1;
+
+static struct canfd_frame fmstr_rxmsg; /* Received frame buffer */
+static FMSTR_SIZE8 fmstr_rxLen;        /* Received frame length, valid when >0 */
+static struct canfd_frame fmstr_txmsg; /* Buffer to prepare transmission */
+static FMSTR_BOOL fmstr_txPending;     /* Frame not yet accepted by the socket (queue full) */
+
+/******************************************************************************
+ * Driver interface
+ ******************************************************************************/
+
+const FMSTR_CAN_DRV_INTF FMSTR_CAN_SOCKETCAN = {
+    FMSTR_C99_INIT(Init) _FMSTR_SocketCan_Init,
+    FMSTR_C99_INIT(EnableTxInterrupt) NULL,
+    FMSTR_C99_INIT(EnableRxInterrupt) NULL,
+    FMSTR_C99_INIT(EnableRx) _FMSTR_SocketCan_EnableRx,
+    FMSTR_C99_INIT(GetRxFrameLen) _FMSTR_SocketCan_GetRxFrameLen,
+    FMSTR_C99_INIT(GetRxFrameByte) _FMSTR_SocketCan_GetRxFrameByte,
+    FMSTR_C99_INIT(AckRxFrame) _FMSTR_SocketCan_AckRxFrame,
+    FMSTR_C99_INIT(PrepareTxFrame) _FMSTR_SocketCan_PrepareTxFrame,
+    FMSTR_C99_INIT(PutTxFrameByte) _FMSTR_SocketCan_PutTxFrameByte,
+    FMSTR_C99_INIT(SendTxFrame) _FMSTR_SocketCan_SendTxFrame,
+};
+
+/******************************************************************************
+ * Implementation
+ ******************************************************************************/
+
+static FMSTR_BOOL _FMSTR_SocketCan_Init(FMSTR_U32 idRx, FMSTR_U32 idTx)
+{
+    struct sockaddr_can addr;
+    struct can_filter filter;
+    int on = 1;
+
+    if (fmstr_canSock >= 0)
+    {
+        (void)close(fmstr_canSock);
+    }
+
+    fmstr_canSock = socket(PF_CAN, SOCK_RAW | SOCK_NONBLOCK, CAN_RAW);
+    if (fmstr_canSock < 0)
+    {
+        return FMSTR_FALSE;
+    }
+
+    /* receive the command identifier only, data frames of the selected format */
+    filter.can_id   = FMSTR_SOCKETCAN_ID2IDR(idRx);
+    filter.can_mask = ((idRx & FMSTR_CAN_EXTID) != 0UL ? CAN_EFF_MASK : CAN_SFF_MASK) | CAN_EFF_FLAG | CAN_RTR_FLAG;
+    (void)setsockopt(fmstr_canSock, SOL_CAN_RAW, CAN_RAW_FILTER, &filter, sizeof(filter));
+
+#if FMSTR_CAN_FD > 0
+    if (setsockopt(fmstr_canSock, SOL_CAN_RAW, CAN_RAW_FD_FRAMES, &on, sizeof(on)) != 0)
+    {
+        goto init_failed;
+    }
+#else
+    FMSTR_UNUSED(on);
+#endif
+
+    FMSTR_MemSet(&addr, 0, sizeof(addr));
+    addr.can_family  = AF_CAN;
+    addr.can_ifindex = (int)if_nametoindex(fmstr_canIfName);
+    if (addr.can_ifindex == 0 || bind(fmstr_canSock, (struct sockaddr *)&addr, sizeof(addr)) != 0)
+    {
+        goto init_failed;
+    }
+
+    FMSTR_MemSet(&fmstr_rxmsg, 0, sizeof(fmstr_rxmsg));
+    fmstr_rxLen = 0U;
+
+    FMSTR_MemSet(&fmstr_txmsg, 0, sizeof(fmstr_txmsg));
+    fmstr_txmsg.can_id = FMSTR_SOCKETCAN_ID2IDR(idTx);
+#if FMSTR_CAN_FD > 0 && FMSTR_CAN_FD_BRS > 0
+    fmstr_txmsg.flags = CANFD_BRS;
+#endif
+    fmstr_txPending = FMSTR_FALSE;
+
+    return FMSTR_TRUE;
+
+init_failed:
+    (void)close(fmstr_canSock);
+    fmstr_canSock = -1;
+    return FMSTR_FALSE;
+}
+
+static void _FMSTR_SocketCan_EnableRx(void)
+{
+    /* the socket receives all the time */
+}
+
+static FMSTR_SIZE8 _FMSTR_SocketCan_GetRxFrameLen(void)
+{
+    ssize_t res;
+
+    /* A refused last frame of a response gets no PrepareTxFrame call, retry it on each poll */
+    if (fmstr_txPending != FMSTR_FALSE)
+    {
+        _FMSTR_SocketCan_SendTxFrame(fmstr_txmsg.len);
+    }
+
+    /* Current cache still valid? */
+    if (fmstr_rxLen == 0U && fmstr_canSock >= 0)
+    {
+        /* A classic frame arrives as CAN_MTU bytes, an FD frame (FD sockets only) as CANFD_MTU */
+        res = read(fmstr_canSock, &fmstr_rxmsg, sizeof(fmstr_rxmsg));
+        if ((res == (ssize_t)CAN_MTU || res == (ssize_t)CANFD_MTU) && fmstr_rxmsg.len <= FMSTR_CAN_FRAME_SIZE)
+        {
+            fmstr_rxLen = (FMSTR_SIZE8)fmstr_rxmsg.len;
+        }
+    }
+
+    return fmstr_rxLen;
+}
+
+static FMSTR_BCHR _FMSTR_SocketCan_GetRxFrameByte(FMSTR_SIZE8 index)
+{
+    return (FMSTR_BCHR)fmstr_rxmsg.data[index];
+}
+
+static void _FMSTR_SocketCan_AckRxFrame(void)
+{
+    fmstr_rxLen = 0U;
+}
+
+static FMSTR_BOOL _FMSTR_SocketCan_PrepareTxFrame(void)
+{
+    /* Retry the frame the socket refused last time, hold the next one until it is out */
+    if (fmstr_txPending != FMSTR_FALSE)
+    {
+        _FMSTR_SocketCan_SendTxFrame(fmstr_txmsg.len);
+        if (fmstr_txPending != FMSTR_FALSE)
+        {
+            return FMSTR_FALSE;
+        }
+    }
+
+    return FMSTR_TRUE;
+}
+
+static void _FMSTR_SocketCan_PutTxFrameByte(FMSTR_SIZE8 index, FMSTR_BCHR data)
+{
+    fmstr_txmsg.data[index] = (__u8)data;
+}
+
+static void _FMSTR_SocketCan_SendTxFrame(FMSTR_SIZE8 len)
+{
+    ssize_t res;
+
+    fmstr_txmsg.len = (__u8)len;
+
+#if FMSTR_CAN_FD > 0
+    res = write(fmstr_canSock, &fmstr_txmsg, CANFD_MTU);
+#else
+    res = write(fmstr_canSock, &fmstr_txmsg, CAN_MTU);
+#endif
+
+    /* A full queue keeps the frame for PrepareTxFrame, any other error drops it like a lost bus frame */
+    fmstr_txPending = (res < 0 && (errno == EAGAIN || errno == ENOBUFS)) ? FMSTR_TRUE : FMSTR_FALSE;
+}
+
+/******************************************************************************
+ *
+ * @brief    Selecting the SocketCAN interface, call before FMSTR_Init()
+ *
+ ******************************************************************************/
+
+void FMSTR_CanSetInterface(const char *ifName)
+{
+    fmstr_canIfName = ifName;
+}
+
+#else /* (!(FMSTR_DISABLE)) */
+
+void FMSTR_CanSetInterface(const char *ifName)
+{
+    FMSTR_UNUSED(ifName);
+}
+
+#endif /* (!(FMSTR_DISABLE)) */
+#endif /* (FMSTR_MK_IDSTR(FMSTR_CAN_DRV) == FMSTR_CAN_SOCKETCAN_ID) */
@@ -34,6 +34,11 @@
 #include "freemaster_can.h"
 #include "fsl_mcan.h"
 
+/* only classic CAN frames are implemented by this driver */
+#if FMSTR_CAN_FD > 0
+#error "The MCAN driver does not support FMSTR_CAN_FD framing"
+#endif
+
 /******************************************************************************
  * Configuration
  ******************************************************************************/
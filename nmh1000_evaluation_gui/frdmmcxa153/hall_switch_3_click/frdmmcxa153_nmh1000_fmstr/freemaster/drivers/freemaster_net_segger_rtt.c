@@ -54,6 +54,20 @@
 #define FMSTR_NET_SEGGER_RTT_BUFFER_INDEX 0
 #endif
 
+/* Own buffers (index > 0): the up buffer takes a whole response, the ring keeps one byte free and
+   responses are written in one piece so that a missing probe drops them instead of stalling */
+#ifndef FMSTR_NET_SEGGER_RTT_UP_SIZE
+#define FMSTR_NET_SEGGER_RTT_UP_SIZE (FMSTR_COMM_BUFFER_SIZE + 8)
+#endif
+
+#ifndef FMSTR_NET_SEGGER_RTT_DOWN_SIZE
+#define FMSTR_NET_SEGGER_RTT_DOWN_SIZE (FMSTR_COMM_BUFFER_SIZE + 8)
+#endif
+
+#if FMSTR_NET_SEGGER_RTT_BUFFER_INDEX > 0 && FMSTR_NET_SEGGER_RTT_UP_SIZE < (FMSTR_COMM_BUFFER_SIZE + 8)
+#error FMSTR_NET_SEGGER_RTT_UP_SIZE must hold one response frame (FMSTR_COMM_BUFFER_SIZE + 8).
+#endif
+
 /******************************************************************************
  * Local types
  ******************************************************************************/
@@ -93,8 +107,8 @@ const FMSTR_NET_DRV_INTF FMSTR_NET_SEGGER_RTT = {
 };
 
 #if FMSTR_NET_SEGGER_RTT_BUFFER_INDEX > 0
-#define FMSTR_RTT_BUFF_SIZE (FMSTR_COMM_BUFFER_SIZE + 7)
-static FMSTR_U8 fmstr_rttBuffer[FMSTR_RTT_BUFF_SIZE];
+static FMSTR_U8 fmstr_rttUpBuffer[FMSTR_NET_SEGGER_RTT_UP_SIZE];
+static FMSTR_U8 fmstr_rttDownBuffer[FMSTR_NET_SEGGER_RTT_DOWN_SIZE];
 #endif
 /******************************************************************************
  * Implementation
@@ -102,13 +116,14 @@ static FMSTR_U8 fmstr_rttBuffer[FMSTR_RTT_BUFF_SIZE];
 
 static FMSTR_BOOL _FMSTR_RttInit(void)
 {
+    /* No SEGGER_RTT_SetTerminal(), its escape sequence would be written into up buffer 0 */
     SEGGER_RTT_Init();
-    SEGGER_RTT_SetTerminal(FMSTR_NET_SEGGER_RTT_BUFFER_INDEX);
 
 #if FMSTR_NET_SEGGER_RTT_BUFFER_INDEX > 0
-    SEGGER_RTT_ConfigUpBuffer(FMSTR_NET_SEGGER_RTT_BUFFER_INDEX, NULL, fmstr_rttBuffer, FMSTR_RTT_BUFF_SIZE,
-                              SEGGER_RTT_MODE_NO_BLOCK_SKIP);
-    SEGGER_RTT_ConfigDownBuffer(FMSTR_NET_SEGGER_RTT_BUFFER_INDEX, NULL, fmstr_rttBuffer, FMSTR_RTT_BUFF_SIZE, 0);
+    SEGGER_RTT_ConfigUpBuffer(FMSTR_NET_SEGGER_RTT_BUFFER_INDEX, "FreeMASTER", fmstr_rttUpBuffer,
+                              FMSTR_NET_SEGGER_RTT_UP_SIZE, SEGGER_RTT_MODE_NO_BLOCK_SKIP);
+    SEGGER_RTT_ConfigDownBuffer(FMSTR_NET_SEGGER_RTT_BUFFER_INDEX, "FreeMASTER", fmstr_rttDownBuffer,
+                                FMSTR_NET_SEGGER_RTT_DOWN_SIZE, SEGGER_RTT_MODE_NO_BLOCK_SKIP);
 #else
     SEGGER_RTT_ConfigUpBuffer(FMSTR_NET_SEGGER_RTT_BUFFER_INDEX, NULL, NULL, 0, SEGGER_RTT_MODE_NO_BLOCK_SKIP);
     SEGGER_RTT_ConfigDownBuffer(FMSTR_NET_SEGGER_RTT_BUFFER_INDEX, NULL, NULL, 0, 0);
@@ -138,6 +153,7 @@ static FMSTR_S32 _FMSTR_RttSend(FMSTR_NET_ADDR *sendAddr, FMSTR_BPTR msgBuff, FM
     FMSTR_ASSERT(msgBuff != NULL);
     FMSTR_ASSERT(sendAddr != NULL);
 
+    /* 0 when no probe drains the buffer: the response is dropped and the host repeats the command */
     return SEGGER_RTT_Write(FMSTR_NET_SEGGER_RTT_BUFFER_INDEX, msgBuff, msgSize);
 }
 
@@ -0,0 +1,531 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * License: NXP LA_OPT_NXP_Software_License
+ *
+ * NXP Confidential. This software is owned or controlled by NXP and may
+ * only be used strictly in accordance with the applicable license terms.
+ * By expressly accepting such terms or by downloading, installing,
+ * activating and/or otherwise using the software, you are agreeing that
+ * you have read, and that you agree to comply with and are bound by,
+ * such license terms.  If you do not agree to be bound by the applicable
+ * license terms, then you may not retain, install, activate or otherwise
+ * use the software.  This code may only be used in a microprocessor,
+ * microcontroller, sensor or digital signal processor ("NXP Product")
+ * supplied directly or indirectly from NXP.  See the full NXP Software
+ * License Agreement in license/LA_OPT_NXP_Software_License.pdf
+ *
+ * FreeMASTER Communication Driver - Network TCP driver for host BSD sockets
+ */
+
+#include "freemaster.h"
+#include "freemaster_private.h"
+
+/* Numeric identifier to help pre-processor to identify whether our driver is used or not. */
+#define FMSTR_NET_SOCKET_TCP_ID 1
+
+#if (FMSTR_MK_IDSTR(FMSTR_NET_DRV) == FMSTR_NET_SOCKET_TCP_ID)
+
+#include "freemaster_net_socket_tcp.h"
+
+#if FMSTR_DISABLE == 0
+
+#include "freemaster_protocol.h"
+#include "freemaster_net.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+
+/******************************************************************************
+ * Adapter configuration
+ ******************************************************************************/
+#if (defined(FMSTR_SHORT_INTR) && FMSTR_SHORT_INTR) || (defined(FMSTR_LONG_INTR) && FMSTR_LONG_INTR)
+#error The FreeMASTER network TCP socket driver does not support interrupt mode.
+#endif
+
+/* Listen on loopback only unless told otherwise, the host port is meant for local testing */
+#ifndef FMSTR_NET_SOCKET_BIND_ADDR
+#define FMSTR_NET_SOCKET_BIND_ADDR INADDR_LOOPBACK
+#endif
+
+/* How long a response may wait for room in the socket buffer, in milliseconds */
+#ifndef FMSTR_NET_SOCKET_SEND_TIMEOUT
+#define FMSTR_NET_SOCKET_SEND_TIMEOUT 1000
+#endif
+
+#if FMSTR_NET_AUTODISCOVERY != 0
+#define FMSTR_TCP_SESSION_COUNT FMSTR_SESSION_COUNT + 1
+#else
+#define FMSTR_TCP_SESSION_COUNT FMSTR_SESSION_COUNT
+#endif
+
+/******************************************************************************
+ * Local types
+ ******************************************************************************/
+
+typedef struct FMSTR_TCP_SESSION_S
+{
+    int sock;
+    FMSTR_BOOL receivePending;
+    FMSTR_NET_ADDR address;
+} FMSTR_TCP_SESSION;
+
+/******************************************************************************
+ * Local functions
+ ******************************************************************************/
+
+static FMSTR_BOOL _FMSTR_NetSocketTcpInit(void);
+static void _FMSTR_NetSocketTcpPoll(void);
+static FMSTR_S32 _FMSTR_NetSocketTcpRecv(FMSTR_BPTR msgBuff,
+                                         FMSTR_SIZE msgMaxSize,
+                                         FMSTR_NET_ADDR *recvAddr,
+                                         FMSTR_BOOL *isBroadcast);
+static FMSTR_S32 _FMSTR_NetSocketTcpSend(FMSTR_NET_ADDR *sendAddr, FMSTR_BPTR msgBuff, FMSTR_SIZE msgSize);
+static void _FMSTR_NetSocketTcpClose(FMSTR_NET_ADDR *addr);
+static void _FMSTR_NetSocketTcpGetCaps(FMSTR_NET_IF_CAPS *caps);
+static void _FMSTR_NetAddrToFmstr(struct sockaddr_in *remoteAddr, FMSTR_NET_ADDR *fmstrAddr);
+
+/******************************************************************************
+ * Local variables
+ ******************************************************************************/
+
+/* TCP sessions */
+static FMSTR_TCP_SESSION fmstrTcpSessions[FMSTR_TCP_SESSION_COUNT];
+/* Session the last data came from, it is read first so a frame split over segments stays together */
+static FMSTR_TCP_SESSION *fmstrTcpLastSession = NULL;
+/* TCP listen socket */
+static int fmstrTcpListenSock = -1;
+
+#if FMSTR_NET_AUTODISCOVERY != 0
+/* UDP Broadcast socket */
+static int fmstrUdpBroadcastSock = -1;
+#endif /* FMSTR_NET_AUTODISCOVERY */
+
+/******************************************************************************
+ * Driver interface
+ ******************************************************************************/
+/* Interface of this network TCP driver */
+const FMSTR_NET_DRV_INTF FMSTR_NET_SOCKET_TCP = {
+    .Init    = _FMSTR_NetSocketTcpInit,
+    .Poll    = _FMSTR_NetSocketTcpPoll,
+    .Recv    = _FMSTR_NetSocketTcpRecv,
+    .Send    = _FMSTR_NetSocketTcpSend,
+    .Close   = _FMSTR_NetSocketTcpClose,
+    .GetCaps = _FMSTR_NetSocketTcpGetCaps,
+};
+
+/******************************************************************************
+ * Implementation
+ ******************************************************************************/
+
+static FMSTR_BOOL _FMSTR_NetSocketSetNonBlocking(int sock)
+{
+    int flags = fcntl(sock, F_GETFL, 0);
+
+    return (flags >= 0 && fcntl(sock, F_SETFL, flags | O_NONBLOCK) >= 0) ? FMSTR_TRUE : FMSTR_FALSE;
+}
+
+static FMSTR_BOOL _FMSTR_NetSocketTcpInit(void)
+{
+    struct sockaddr_in bindAddr;
+    FMSTR_INDEX i;
+    int one = 1;
+
+    FMSTR_MemSet(&fmstrTcpSessions, 0, sizeof(fmstrTcpSessions));
+    fmstrTcpLastSession = NULL;
+
+    /* Prepare sockets */
+    for (i = 0; i < FMSTR_TCP_SESSION_COUNT; i++)
+    {
+        fmstrTcpSessions[i].sock = -1;
+    }
+
+    FMSTR_MemSet(&bindAddr, 0, sizeof(bindAddr));
+    bindAddr.sin_family      = AF_INET;
+    bindAddr.sin_addr.s_addr = htonl(FMSTR_NET_SOCKET_BIND_ADDR);
+    bindAddr.sin_port        = htons(FMSTR_NET_PORT);
+
+    /* Create new listen socket, a restarted process may reuse the port right away */
+    fmstrTcpListenSock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (fmstrTcpListenSock < 0)
+    {
+        return FMSTR_FALSE;
+    }
+    (void)setsockopt(fmstrTcpListenSock, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    /* Accept is polled, it must never block */
+    if (_FMSTR_NetSocketSetNonBlocking(fmstrTcpListenSock) == FMSTR_FALSE)
+    {
+        return FMSTR_FALSE;
+    }
+
+    if (bind(fmstrTcpListenSock, (struct sockaddr *)&bindAddr, sizeof(bindAddr)) < 0)
+    {
+        return FMSTR_FALSE;
+    }
+
+    if (listen(fmstrTcpListenSock, FMSTR_SESSION_COUNT) < 0)
+    {
+        return FMSTR_FALSE;
+    }
+
+#if FMSTR_NET_AUTODISCOVERY != 0
+    bindAddr.sin_addr.s_addr = htonl(INADDR_ANY);
+
+    /* Create new UDP listen socket */
+    fmstrUdpBroadcastSock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (fmstrUdpBroadcastSock < 0)
+    {
+        return FMSTR_FALSE;
+    }
+    (void)setsockopt(fmstrUdpBroadcastSock, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    (void)setsockopt(fmstrUdpBroadcastSock, SOL_SOCKET, SO_BROADCAST, &one, sizeof(one));
+
+    if (bind(fmstrUdpBroadcastSock, (struct sockaddr *)&bindAddr, sizeof(bindAddr)) < 0)
+    {
+        return FMSTR_FALSE;
+    }
+
+    if (_FMSTR_NetSocketSetNonBlocking(fmstrUdpBroadcastSock) == FMSTR_FALSE)
+    {
+        return FMSTR_FALSE;
+    }
+
+    fmstrTcpSessions[0].sock = fmstrUdpBroadcastSock;
+#endif /* FMSTR_NET_AUTODISCOVERY */
+
+    return FMSTR_TRUE;
+}
+
+static FMSTR_TCP_SESSION *_FMSTR_NetSocketTcpSessionPending(void)
+{
+    FMSTR_INDEX i;
+
+    /* Finish the session the last data came from before serving others */
+    if (fmstrTcpLastSession != NULL && fmstrTcpLastSession->sock >= 0 &&
+        fmstrTcpLastSession->receivePending != FMSTR_FALSE)
+    {
+        return fmstrTcpLastSession;
+    }
+
+    for (i = 0; i < FMSTR_TCP_SESSION_COUNT; i++)
+    {
+        /* Find pending session */
+        if (fmstrTcpSessions[i].sock >= 0 && fmstrTcpSessions[i].receivePending != FMSTR_FALSE)
+        {
+            return &fmstrTcpSessions[i];
+        }
+    }
+
+    return NULL;
+}
+
+static FMSTR_TCP_SESSION *_FMSTR_NetSocketTcpSessionFind(FMSTR_NET_ADDR *sendAddr)
+{
+    FMSTR_INDEX i;
+
+    for (i = 0; i < FMSTR_TCP_SESSION_COUNT; i++)
+    {
+        /* Find free session */
+        if (sendAddr == NULL)
+        {
+            if (fmstrTcpSessions[i].sock < 0)
+            {
+                return &fmstrTcpSessions[i];
+            }
+        }
+        /* Find session by address */
+        else
+        {
+            if (fmstrTcpSessions[i].sock >= 0 &&
+                FMSTR_MemCmp(&fmstrTcpSessions[i].address, sendAddr, sizeof(FMSTR_NET_ADDR)) == 0)
+            {
+                return &fmstrTcpSessions[i];
+            }
+        }
+    }
+
+    return NULL;
+}
+
+static void _FMSTR_NetSocketTcpAccept(void)
+{
+    struct sockaddr_in remoteAddr;
+    socklen_t length = sizeof(remoteAddr);
+    FMSTR_TCP_SESSION *newSes;
+    int newSock;
+    int one = 1;
+
+    FMSTR_MemSet(&remoteAddr, 0, sizeof(remoteAddr));
+
+    /* Accept socket */
+    newSock = accept(fmstrTcpListenSock, (struct sockaddr *)&remoteAddr, &length);
+    if (newSock < 0)
+    {
+        return;
+    }
+
+    newSes = _FMSTR_NetSocketTcpSessionFind(NULL);
+    if (newSes == NULL || _FMSTR_NetSocketSetNonBlocking(newSock) == FMSTR_FALSE)
+    {
+        (void)close(newSock);
+        return;
+    }
+
+    /* Responses are single small writes, do not hold them back */
+    (void)setsockopt(newSock, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+    FMSTR_MemSet(newSes, 0, sizeof(FMSTR_TCP_SESSION));
+    newSes->sock = newSock;
+    _FMSTR_NetAddrToFmstr(&remoteAddr, &newSes->address);
+}
+
+static void _FMSTR_NetSocketTcpPoll(void)
+{
+    struct pollfd fds[FMSTR_TCP_SESSION_COUNT + 1];
+    FMSTR_TCP_SESSION *sessions[FMSTR_TCP_SESSION_COUNT];
+    nfds_t count = 0;
+    FMSTR_INDEX i;
+
+    /* Any session is still pending to read */
+    if (_FMSTR_NetSocketTcpSessionPending() != NULL)
+    {
+        return;
+    }
+
+    /* Prepare active sockets for read */
+    for (i = 0; i < FMSTR_TCP_SESSION_COUNT; i++)
+    {
+        if (fmstrTcpSessions[i].sock >= 0)
+        {
+            fds[count].fd      = fmstrTcpSessions[i].sock;
+            fds[count].events  = POLLIN;
+            fds[count].revents = 0;
+            sessions[count]    = &fmstrTcpSessions[i];
+            count++;
+        }
+    }
+
+    /* Listen socket, only while a session is free */
+    if (_FMSTR_NetSocketTcpSessionFind(NULL) != NULL)
+    {
+        fds[count].fd      = fmstrTcpListenSock;
+        fds[count].events  = POLLIN;
+        fds[count].revents = 0;
+        count++;
+    }
+
+    if (count == 0U || poll(fds, count, FMSTR_NET_BLOCKING_TIMEOUT) <= 0)
+    {
+        return;
+    }
+
+    /* Pending receive, a hang-up is reported by the receive call */
+    for (i = 0; i < (FMSTR_INDEX)count; i++)
+    {
+        if (fds[i].fd != fmstrTcpListenSock && (fds[i].revents & (POLLIN | POLLHUP | POLLERR)) != 0)
+        {
+            sessions[i]->receivePending = FMSTR_TRUE;
+        }
+    }
+
+    /* Pending accept */
+    if (fds[count - 1U].fd == fmstrTcpListenSock && (fds[count - 1U].revents & POLLIN) != 0)
+    {
+        _FMSTR_NetSocketTcpAccept();
+    }
+}
+
+static FMSTR_S32 _FMSTR_NetSocketTcpRecv(FMSTR_BPTR msgBuff,
+                                         FMSTR_SIZE msgMaxSize,
+                                         FMSTR_NET_ADDR *recvAddr,
+                                         FMSTR_BOOL *isBroadcast)
+{
+    FMSTR_TCP_SESSION *ses = NULL;
+    ssize_t res            = 0;
+
+    FMSTR_ASSERT(msgBuff != NULL);
+    FMSTR_ASSERT(recvAddr != NULL);
+    FMSTR_ASSERT(isBroadcast != NULL);
+
+    *isBroadcast = FMSTR_FALSE;
+
+    if (fmstrTcpListenSock < 0)
+    {
+        return 0;
+    }
+
+    /* Any receive pending? */
+    ses = _FMSTR_NetSocketTcpSessionPending();
+    if (ses == NULL)
+    {
+        return 0;
+    }
+
+#if FMSTR_NET_AUTODISCOVERY != 0
+    /* Receive UDP broadcast */
+    if (ses->sock == fmstrUdpBroadcastSock)
+    {
+        struct sockaddr_in remoteAddr;
+        socklen_t length = sizeof(remoteAddr);
+
+        *isBroadcast = FMSTR_TRUE;
+
+        FMSTR_MemSet(&remoteAddr, 0, sizeof(remoteAddr));
+        res = recvfrom(ses->sock, msgBuff, msgMaxSize, 0, (struct sockaddr *)&remoteAddr, &length);
+        if (res > 0)
+        {
+            _FMSTR_NetAddrToFmstr(&remoteAddr, &ses->address);
+        }
+    }
+    else
+#endif /* FMSTR_NET_AUTODISCOVERY */
+    {
+        res = recv(ses->sock, msgBuff, msgMaxSize, 0);
+        if (res == 0)
+        {
+            /* Orderly shutdown by the peer, let the network layer close the session */
+            res = -1;
+            errno = ECONNRESET;
+        }
+    }
+
+    /* Copy address */
+    FMSTR_MemCpy(recvAddr, &ses->address, sizeof(FMSTR_NET_ADDR));
+
+    if (res < 0 && (errno == EWOULDBLOCK || errno == EAGAIN || errno == EINTR))
+    {
+        /* Nothing more to read now */
+        res = 0;
+    }
+    if (res <= 0)
+    {
+        ses->receivePending = FMSTR_FALSE;
+    }
+    else
+    {
+        fmstrTcpLastSession = ses;
+    }
+
+    return (FMSTR_S32)res;
+}
+
+static FMSTR_S32 _FMSTR_NetSocketTcpSend(FMSTR_NET_ADDR *sendAddr, FMSTR_BPTR msgBuff, FMSTR_SIZE msgSize)
+{
+    FMSTR_TCP_SESSION *ses = NULL;
+    ssize_t res            = 0;
+
+    FMSTR_ASSERT(msgBuff != NULL);
+    FMSTR_ASSERT(sendAddr != NULL);
+
+    /* Find session by address */
+    ses = _FMSTR_NetSocketTcpSessionFind(sendAddr);
+    if (ses == NULL)
+    {
+        /* Same as socket error */
+        return -1;
+    }
+
+    /* The request is answered, its session does not have to be read first any more */
+    if (fmstrTcpLastSession == ses)
+    {
+        fmstrTcpLastSession = NULL;
+    }
+
+#if FMSTR_NET_AUTODISCOVERY != 0
+    /* Send UDP broadcast response */
+    if (ses->sock == fmstrUdpBroadcastSock)
+    {
+        struct sockaddr_in destAddr4;
+
+        FMSTR_MemSet(&destAddr4, 0, sizeof(destAddr4));
+        destAddr4.sin_family = AF_INET;
+        destAddr4.sin_port   = htons(sendAddr->port);
+        FMSTR_MemCpy(&destAddr4.sin_addr.s_addr, sendAddr->addr.v4, 4);
+
+        /* Send data */
+        res = sendto(ses->sock, msgBuff, msgSize, 0, (struct sockaddr *)&destAddr4, sizeof(destAddr4));
+    }
+    else
+#endif
+    {
+        struct pollfd pfd = {ses->sock, POLLOUT, 0};
+
+        /* Send data, wait while the socket buffer is full as the network layer expects progress */
+        for (;;)
+        {
+            res = send(ses->sock, msgBuff, msgSize, MSG_NOSIGNAL);
+            if (res >= 0 || (errno != EWOULDBLOCK && errno != EAGAIN && errno != EINTR))
+            {
+                break;
+            }
+            if (poll(&pfd, 1, FMSTR_NET_SOCKET_SEND_TIMEOUT) <= 0)
+            {
+                /* Peer does not take data, same as socket error */
+                res = -1;
+                break;
+            }
+        }
+    }
+
+    return (FMSTR_S32)res;
+}
+
+static void _FMSTR_NetSocketTcpClose(FMSTR_NET_ADDR *addr)
+{
+    FMSTR_TCP_SESSION *ses = NULL;
+
+    /* Find session by address */
+    ses = _FMSTR_NetSocketTcpSessionFind(addr);
+    if (ses == NULL)
+    {
+        /* Session not found */
+        return;
+    }
+
+#if FMSTR_NET_AUTODISCOVERY != 0
+    if (ses->sock == fmstrUdpBroadcastSock)
+    {
+        /* Broadcast session cannot be closed */
+        return;
+    }
+#endif
+
+    /* Close socket */
+    (void)close(ses->sock);
+
+    if (fmstrTcpLastSession == ses)
+    {
+        fmstrTcpLastSession = NULL;
+    }
+
+    FMSTR_MemSet(ses, 0, sizeof(FMSTR_TCP_SESSION));
+    ses->sock = -1;
+}
+
+static void _FMSTR_NetSocketTcpGetCaps(FMSTR_NET_IF_CAPS *caps)
+{
+    FMSTR_ASSERT(caps != NULL);
+
+    caps->flags |= FMSTR_NET_IF_CAPS_FLAG_TCP;
+}
+
+static void _FMSTR_NetAddrToFmstr(struct sockaddr_in *remoteAddr, FMSTR_NET_ADDR *fmstrAddr)
+{
+    FMSTR_ASSERT(remoteAddr != NULL);
+    FMSTR_ASSERT(fmstrAddr != NULL);
+
+    /* Whole structure is compared by the network layer, clear the unused address bytes */
+    FMSTR_MemSet(fmstrAddr, 0, sizeof(FMSTR_NET_ADDR));
+    fmstrAddr->type = FMSTR_NET_ADDR_TYPE_V4;
+    FMSTR_MemCpy(fmstrAddr->addr.v4, &remoteAddr->sin_addr.s_addr, sizeof(fmstrAddr->addr.v4));
+    fmstrAddr->port = ntohs(remoteAddr->sin_port);
+}
+
+#endif /* (!(FMSTR_DISABLE)) */
+#endif /* (FMSTR_MK_IDSTR(FMSTR_NET_DRV) == FMSTR_NET_SOCKET_TCP_ID) */
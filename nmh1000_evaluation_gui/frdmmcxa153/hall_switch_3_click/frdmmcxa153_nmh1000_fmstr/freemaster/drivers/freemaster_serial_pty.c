@@ -0,0 +1,246 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * License: NXP LA_OPT_NXP_Software_License
+ *
+ * NXP Confidential. This software is owned or controlled by NXP and may
+ * only be used strictly in accordance with the applicable license terms.
+ * By expressly accepting such terms or by downloading, installing,
+ * activating and/or otherwise using the software, you are agreeing that
+ * you have read, and that you agree to comply with and are bound by,
+ * such license terms.  If you do not agree to be bound by the applicable
+ * license terms, then you may not retain, install, activate or otherwise
+ * use the software.  This code may only be used in a microprocessor,
+ * microcontroller, sensor or digital signal processor ("NXP Product")
+ * supplied directly or indirectly from NXP.  See the full NXP Software
+ * License Agreement in license/LA_OPT_NXP_Software_License.pdf
+ *
+ * FreeMASTER Communication Driver - serial driver for a Linux pseudo terminal
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE /* posix_openpt() and cfmakeraw() */
+#endif
+
+#include "freemaster.h"
+#include "freemaster_private.h"
+
+/* Numeric identifier to help pre-processor to identify whether our driver is used or not. */
+#define FMSTR_SERIAL_PTY_ID 1
+
+#if (FMSTR_MK_IDSTR(FMSTR_SERIAL_DRV) == FMSTR_SERIAL_PTY_ID)
+
+#include "freemaster_serial_pty.h"
+
+#if FMSTR_DISABLE == 0
+
+#include "freemaster_serial.h"
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <unistd.h>
+
+/******************************************************************************
+ * Configuration
+ ******************************************************************************/
+#if (defined(FMSTR_SHORT_INTR) && FMSTR_SHORT_INTR) || (defined(FMSTR_LONG_INTR) && FMSTR_LONG_INTR)
+#error The FreeMASTER PTY driver does not support interrupt mode.
+#endif
+
+/* Bytes moved per read or write of the terminal */
+#ifndef FMSTR_SERIAL_PTY_BUFFER_SIZE
+#define FMSTR_SERIAL_PTY_BUFFER_SIZE 256
+#endif
+
+/******************************************************************************
+ * Local functions
+ ******************************************************************************/
+
+static FMSTR_BOOL _FMSTR_SerialPtyInit(void);
+static void _FMSTR_SerialPtyEnableTransmit(FMSTR_BOOL enable);
+static void _FMSTR_SerialPtyEnableReceive(FMSTR_BOOL enable);
+static FMSTR_BOOL _FMSTR_SerialPtyIsTransmitRegEmpty(void);
+static FMSTR_BOOL _FMSTR_SerialPtyIsReceiveRegFull(void);
+static FMSTR_BOOL _FMSTR_SerialPtyIsTransmitterActive(void);
+static void _FMSTR_SerialPtyPutChar(FMSTR_BCHR ch);
+static FMSTR_BCHR _FMSTR_SerialPtyGetChar(void);
+static void _FMSTR_SerialPtyFlush(void);
+
+/******************************************************************************
+ * Local variables
+ ******************************************************************************/
+
+static int fmstr_ptyMaster = -1;
+static int fmstr_ptySlave  = -1; /* kept open, the master reads EIO while no slave is open */
+static const char *fmstr_ptyName;
+
+static FMSTR_U8 fmstr_ptyRx[FMSTR_SERIAL_PTY_BUFFER_SIZE];
+static FMSTR_SIZE fmstr_ptyRxHead; /* next byte handed to GetChar */
+static FMSTR_SIZE fmstr_ptyRxTail; /* end of the bytes read */
+static FMSTR_U8 fmstr_ptyTx[FMSTR_SERIAL_PTY_BUFFER_SIZE];
+static FMSTR_SIZE fmstr_ptyTxHead; /* next byte written to the terminal */
+static FMSTR_SIZE fmstr_ptyTxTail; /* end of the bytes put */
+
+/******************************************************************************
+ * Driver interface
+ ******************************************************************************/
+
+const FMSTR_SERIAL_DRV_INTF FMSTR_SERIAL_PTY = {
+    FMSTR_C99_INIT(Init) _FMSTR_SerialPtyInit,
+    FMSTR_C99_INIT(EnableTransmit) _FMSTR_SerialPtyEnableTransmit,
+    FMSTR_C99_INIT(EnableReceive) _FMSTR_SerialPtyEnableReceive,
+    FMSTR_C99_INIT(EnableTransmitInterrupt) NULL,
+    FMSTR_C99_INIT(EnableTransmitCompleteInterrupt) NULL,
+    FMSTR_C99_INIT(EnableReceiveInterrupt) NULL,
+    FMSTR_C99_INIT(IsTransmitRegEmpty) _FMSTR_SerialPtyIsTransmitRegEmpty,
+    FMSTR_C99_INIT(IsReceiveRegFull) _FMSTR_SerialPtyIsReceiveRegFull,
+    FMSTR_C99_INIT(IsTransmitterActive) _FMSTR_SerialPtyIsTransmitterActive,
+    FMSTR_C99_INIT(PutChar) _FMSTR_SerialPtyPutChar,
+    FMSTR_C99_INIT(GetChar) _FMSTR_SerialPtyGetChar,
+    FMSTR_C99_INIT(Flush) _FMSTR_SerialPtyFlush,
+    FMSTR_C99_INIT(Poll) NULL,
+};
+
+/******************************************************************************
+ * Implementation
+ ******************************************************************************/
+
+static FMSTR_BOOL _FMSTR_SerialPtyInit(void)
+{
+    struct termios tio;
+    const char *name;
+
+    if (fmstr_ptyMaster >= 0)
+    {
+        return FMSTR_TRUE;
+    }
+
+    fmstr_ptyMaster = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if ((fmstr_ptyMaster < 0) || (grantpt(fmstr_ptyMaster) != 0) || (unlockpt(fmstr_ptyMaster) != 0) ||
+        ((name = ptsname(fmstr_ptyMaster)) == NULL))
+    {
+        goto init_failed;
+    }
+
+    /* Raw line discipline, no echo of the requests before the host tool configures the port */
+    fmstr_ptySlave = open(name, O_RDWR | O_NOCTTY);
+    if ((fmstr_ptySlave < 0) || (tcgetattr(fmstr_ptySlave, &tio) != 0))
+    {
+        goto init_failed;
+    }
+    cfmakeraw(&tio);
+    (void)tcsetattr(fmstr_ptySlave, TCSANOW, &tio);
+
+    fmstr_ptyName   = name;
+    fmstr_ptyRxHead = fmstr_ptyRxTail = 0U;
+    fmstr_ptyTxHead = fmstr_ptyTxTail = 0U;
+    return FMSTR_TRUE;
+
+init_failed:
+    if (fmstr_ptyMaster >= 0)
+    {
+        (void)close(fmstr_ptyMaster);
+        fmstr_ptyMaster = -1;
+    }
+    if (fmstr_ptySlave >= 0)
+    {
+        (void)close(fmstr_ptySlave);
+        fmstr_ptySlave = -1;
+    }
+    return FMSTR_FALSE;
+}
+
+static void _FMSTR_SerialPtyEnableTransmit(FMSTR_BOOL enable)
+{
+    /* the terminal is full duplex */
+    FMSTR_UNUSED(enable);
+}
+
+static void _FMSTR_SerialPtyEnableReceive(FMSTR_BOOL enable)
+{
+    FMSTR_UNUSED(enable);
+}
+
+/* Write what the terminal takes without blocking, the rest stays for the next call */
+static void _FMSTR_SerialPtyWrite(void)
+{
+    ssize_t res;
+
+    if (fmstr_ptyTxHead < fmstr_ptyTxTail)
+    {
+        res = write(fmstr_ptyMaster, &fmstr_ptyTx[fmstr_ptyTxHead], fmstr_ptyTxTail - fmstr_ptyTxHead);
+        if (res > 0)
+        {
+            fmstr_ptyTxHead += (FMSTR_SIZE)res;
+        }
+    }
+    if (fmstr_ptyTxHead == fmstr_ptyTxTail)
+    {
+        fmstr_ptyTxHead = fmstr_ptyTxTail = 0U;
+    }
+}
+
+static FMSTR_BOOL _FMSTR_SerialPtyIsTransmitRegEmpty(void)
+{
+    if (fmstr_ptyTxTail >= sizeof(fmstr_ptyTx))
+    {
+        _FMSTR_SerialPtyWrite();
+    }
+    return (fmstr_ptyTxTail < sizeof(fmstr_ptyTx)) ? FMSTR_TRUE : FMSTR_FALSE;
+}
+
+static FMSTR_BOOL _FMSTR_SerialPtyIsReceiveRegFull(void)
+{
+    ssize_t res;
+
+    if (fmstr_ptyRxHead == fmstr_ptyRxTail)
+    {
+        res             = read(fmstr_ptyMaster, fmstr_ptyRx, sizeof(fmstr_ptyRx));
+        fmstr_ptyRxHead = 0U;
+        fmstr_ptyRxTail = (res > 0) ? (FMSTR_SIZE)res : 0U;
+    }
+    return (fmstr_ptyRxHead < fmstr_ptyRxTail) ? FMSTR_TRUE : FMSTR_FALSE;
+}
+
+static FMSTR_BOOL _FMSTR_SerialPtyIsTransmitterActive(void)
+{
+    _FMSTR_SerialPtyWrite();
+    return (fmstr_ptyTxTail != 0U) ? FMSTR_TRUE : FMSTR_FALSE;
+}
+
+static void _FMSTR_SerialPtyPutChar(FMSTR_BCHR ch)
+{
+    fmstr_ptyTx[fmstr_ptyTxTail++] = (FMSTR_U8)ch;
+}
+
+static FMSTR_BCHR _FMSTR_SerialPtyGetChar(void)
+{
+    return (FMSTR_BCHR)fmstr_ptyRx[fmstr_ptyRxHead++];
+}
+
+static void _FMSTR_SerialPtyFlush(void)
+{
+    _FMSTR_SerialPtyWrite();
+}
+
+/******************************************************************************
+ *
+ * @brief    Slave device path of the pseudo terminal, valid after FMSTR_Init()
+ *
+ ******************************************************************************/
+
+const char *FMSTR_SerialPtyGetName(void)
+{
+    return fmstr_ptyName;
+}
+
+#else /* (!(FMSTR_DISABLE)) */
+
+const char *FMSTR_SerialPtyGetName(void)
+{
+    return NULL;
+}
+
+#endif /* (!(FMSTR_DISABLE)) */
+#endif /* (FMSTR_MK_IDSTR(FMSTR_SERIAL_DRV) == FMSTR_SERIAL_PTY_ID) */
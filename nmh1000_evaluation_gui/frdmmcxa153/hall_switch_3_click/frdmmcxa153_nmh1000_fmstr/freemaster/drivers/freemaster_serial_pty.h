@@ -0,0 +1,58 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * License: NXP LA_OPT_NXP_Software_License
+ *
+ * NXP Confidential. This software is owned or controlled by NXP and may
+ * only be used strictly in accordance with the applicable license terms.
+ * By expressly accepting such terms or by downloading, installing,
+ * activating and/or otherwise using the software, you are agreeing that
+ * you have read, and that you agree to comply with and are bound by,
+ * such license terms.  If you do not agree to be bound by the applicable
+ * license terms, then you may not retain, install, activate or otherwise
+ * use the software.  This code may only be used in a microprocessor,
+ * microcontroller, sensor or digital signal processor ("NXP Product")
+ * supplied directly or indirectly from NXP.  See the full NXP Software
+ * License Agreement in license/LA_OPT_NXP_Software_License.pdf
+ *
+ * FreeMASTER Communication Driver - serial driver for a Linux pseudo terminal
+ *
+ * Host counterpart of freemaster_serial_lpuart.c. The serial transport runs in
+ * a Linux process on the master side of a pseudo terminal, host tools open the
+ * slave side like the board's virtual COM port.
+ */
+
+#ifndef __FREEMASTER_SERIAL_PTY_H
+#define __FREEMASTER_SERIAL_PTY_H
+
+/******************************************************************************
+ * Required header files include check
+ ******************************************************************************/
+#ifndef __FREEMASTER_H
+#error Please include the freemaster.h master header file before the freemaster_serial_pty.h
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************
+ * Types definition
+ ******************************************************************************/
+
+/******************************************************************************
+ * inline functions
+ ******************************************************************************/
+
+/******************************************************************************
+ * Global API functions
+ ******************************************************************************/
+
+/* Slave device path of the pseudo terminal opened by FMSTR_Init(), NULL before */
+const char *FMSTR_SerialPtyGetName(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __FREEMASTER_SERIAL_PTY_H */
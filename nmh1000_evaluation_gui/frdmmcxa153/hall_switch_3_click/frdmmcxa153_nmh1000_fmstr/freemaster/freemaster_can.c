@@ -36,6 +36,16 @@
 #include "freemaster_can.h"
 #include "freemaster_utils.h"
 
+/* Control byte (and the length byte of CAN FD framing) preceding the data of each CAN frame */
+#if FMSTR_CAN_FD > 0
+#define FMSTR_CAN_HDR_SIZE 2U
+#else
+#define FMSTR_CAN_HDR_SIZE 1U
+#endif
+
+/* FreeMASTER message bytes carried by one CAN frame */
+#define FMSTR_CAN_DATA_MAX (FMSTR_CAN_FRAME_SIZE - FMSTR_CAN_HDR_SIZE)
+
 /******************************************************************************
  * Local function declarations
  ******************************************************************************/
@@ -45,6 +55,9 @@ static void _FMSTR_RxDone(void);
 static void _FMSTR_SendError(FMSTR_BCHR nErrCode);
 static FMSTR_BOOL _FMSTR_TxCan(void);
 static FMSTR_BOOL _FMSTR_RxCan(FMSTR_SIZE8 rxLen);
+#if FMSTR_CAN_FD > 0
+static FMSTR_SIZE8 _FMSTR_CanFdLength(FMSTR_SIZE8 len);
+#endif
 
 /******************************************************************************
  * Local variables
@@ -338,16 +351,20 @@ static FMSTR_BOOL _FMSTR_TxCan(void)
         return FMSTR_FALSE;
     }
 
-    if (len > 7U)
+    if (len > FMSTR_CAN_DATA_MAX)
     {
-        len = 7U;
+        len = FMSTR_CAN_DATA_MAX;
     }
 
     /* first byte is control */
     if (fmstr_wFlags.flg.bTxFirst != 0U)
     {
         /* the first frame and the length*/
-        fmstr_uTxCtlByte          = (FMSTR_U8)(FMSTR_CANCTL_FST | len);
+#if FMSTR_CAN_FD > 0
+        fmstr_uTxCtlByte = (FMSTR_U8)FMSTR_CANCTL_FST;
+#else
+        fmstr_uTxCtlByte = (FMSTR_U8)(FMSTR_CANCTL_FST | len);
+#endif
         fmstr_uTxFrmCtr           = 0U;
         fmstr_wFlags.flg.bTxFirst = 0U;
     }
@@ -356,7 +373,9 @@ static FMSTR_BOOL _FMSTR_TxCan(void)
         /* the next frame */
         fmstr_uTxCtlByte &= (FMSTR_U8) ~(FMSTR_CANCTL_FST | FMSTR_CANCTL_LEN_MASK);
         fmstr_uTxCtlByte ^= FMSTR_CANCTL_TGL;
+#if FMSTR_CAN_FD == 0
         fmstr_uTxCtlByte |= (FMSTR_U8)len;
+#endif
         fmstr_uTxFrmCtr++;
     }
 
@@ -369,16 +388,29 @@ static FMSTR_BOOL _FMSTR_TxCan(void)
 
     /* put control byte */
     FMSTR_CAN_DRV.PutTxFrameByte(0, fmstr_uTxCtlByte);
+#if FMSTR_CAN_FD > 0
+    /* the length does not fit the control byte */
+    FMSTR_CAN_DRV.PutTxFrameByte(1, (FMSTR_BCHR)len);
+#endif
 
     /* put data part */
-    for (i = 1; i <= len; i++)
+    for (i = 0; i < len; i++)
     {
         fmstr_pTxBuff = FMSTR_ValueFromBuffer8(&ch, fmstr_pTxBuff);
-        FMSTR_CAN_DRV.PutTxFrameByte(i, ch);
+        FMSTR_CAN_DRV.PutTxFrameByte((FMSTR_SIZE8)(FMSTR_CAN_HDR_SIZE + i), ch);
     }
+    len += FMSTR_CAN_HDR_SIZE;
+
+#if FMSTR_CAN_FD > 0
+    /* pad up to the nearest valid CAN FD data length */
+    for (i = _FMSTR_CanFdLength(len); len < i; len++)
+    {
+        FMSTR_CAN_DRV.PutTxFrameByte(len, FMSTR_CAN_FD_PADDING);
+    }
+#endif
 
     /* submit frame for transmission */
-    FMSTR_CAN_DRV.SendTxFrame(len + 1U);
+    FMSTR_CAN_DRV.SendTxFrame(len);
 
     /* if the full frame is safe in tx buffer(s), release the received command */
     if (fmstr_nTxTodo == 0U)
@@ -472,10 +504,14 @@ static FMSTR_BOOL _FMSTR_RxCan(FMSTR_SIZE8 rxLen)
     }
 
     /* frame is valid, get the data */
+#if FMSTR_CAN_FD > 0
+    len = (rxLen > 1U) ? (FMSTR_SIZE8)FMSTR_CAN_DRV.GetRxFrameByte(1) : 0xFFU;
+#else
     len = (FMSTR_SIZE8)(ctl & FMSTR_CANCTL_LEN_MASK);
+#endif
 
     /* sanity check of the real received frame length */
-    if (len >= rxLen)
+    if (len > FMSTR_CAN_DATA_MAX || (len + FMSTR_CAN_HDR_SIZE) > rxLen)
     {
         /* invalid frame length, re-start receiving */
         fmstr_nRxErr = FMSTR_STC_CANMSGERR;
@@ -497,7 +533,7 @@ static FMSTR_BOOL _FMSTR_RxCan(FMSTR_SIZE8 rxLen)
     fmstr_nRxCtr += len;
     for (i = 1; i <= len; i++)
     {
-        ch = FMSTR_CAN_DRV.GetRxFrameByte(i);
+        ch = FMSTR_CAN_DRV.GetRxFrameByte((FMSTR_SIZE8)(FMSTR_CAN_HDR_SIZE - 1U + i));
 
         fmstr_pRxBuff = FMSTR_ValueToBuffer8(fmstr_pRxBuff, ch);
 
@@ -531,6 +567,31 @@ frame_contd:
     return FMSTR_TRUE;
 }
 
+#if FMSTR_CAN_FD > 0
+/* Smallest CAN FD data length (0..8, 12, 16, 20, 24, 32, 48, 64) holding len bytes */
+
+static FMSTR_SIZE8 _FMSTR_CanFdLength(FMSTR_SIZE8 len)
+{
+    if (len <= 8U)
+    {
+        return len;
+    }
+    if (len <= 24U)
+    {
+        return (FMSTR_SIZE8)((len + 3U) & ~3U);
+    }
+    if (len <= 32U)
+    {
+        return 32U;
+    }
+    if (len <= 48U)
+    {
+        return 48U;
+    }
+    return 64U;
+}
+#endif
+
 /* Handle received FreeMASTER frame */
 
 static void _FMSTR_RxDone(void)
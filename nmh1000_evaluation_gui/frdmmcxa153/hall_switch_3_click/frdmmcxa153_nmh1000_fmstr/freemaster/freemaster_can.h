@@ -81,6 +81,30 @@
 #define FMSTR_CAN_RESPID 0x7AAU
 #endif
 
+/* CAN FD framing (disabled by default). Every frame carries the control byte,
+   a length byte and up to 62 data bytes, the LEN bits of the control byte are
+   zero. The frame is padded to the next valid CAN FD data length. */
+#ifndef FMSTR_CAN_FD
+#define FMSTR_CAN_FD 0
+#endif
+
+/* bit rate switch in the data phase of CAN FD frames, applied by the driver */
+#ifndef FMSTR_CAN_FD_BRS
+#define FMSTR_CAN_FD_BRS 1
+#endif
+
+/* value of the bytes padding a CAN FD frame */
+#ifndef FMSTR_CAN_FD_PADDING
+#define FMSTR_CAN_FD_PADDING 0xCCU
+#endif
+
+/* largest CAN frame handled by the transport and the driver */
+#if FMSTR_CAN_FD > 0
+#define FMSTR_CAN_FRAME_SIZE 64U
+#else
+#define FMSTR_CAN_FRAME_SIZE 8U
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -99,13 +123,13 @@ typedef struct FMSTR_CAN_DRV_INTF_S
     /* receiver */
     void (*EnableRx)(void);             /* Enable/re-initialize Receiver buffer. */
     FMSTR_SIZE8 (*GetRxFrameLen)(void); /* Return size of received CAN frame, or 0 if no Rx frame is available. */
-    FMSTR_BCHR (*GetRxFrameByte)(FMSTR_SIZE8 index); /* Get data byte at index (0..8). */
+    FMSTR_BCHR (*GetRxFrameByte)(FMSTR_SIZE8 index); /* Get data byte at index (0..FMSTR_CAN_FRAME_SIZE-1). */
     void (*AckRxFrame)(void);                        /* Discard received frame and enable receiving a next one. */
 
     /* transmitter */
     FMSTR_BOOL (*PrepareTxFrame)(void); /* Initialize transmit buffer; return false when Tx buffer is not available. */
     void (*PutTxFrameByte)(FMSTR_SIZE8 index, FMSTR_BCHR data); /* Fill one byte of transmit data. */
-    void (*SendTxFrame)(FMSTR_SIZE8 len);                       /* Send the Tx buffer. */
+    void (*SendTxFrame)(FMSTR_SIZE8 len); /* Send the Tx buffer, len is a valid CAN (FD) data length. */
 
 } FMSTR_CAN_DRV_INTF;
 
@@ -71,6 +71,15 @@ typedef struct
 } FMSTR_FEATURE_LOCK;
 #endif
 
+#if FMSTR_USE_READ_CACHE > 0
+typedef struct
+{
+    FMSTR_ADDR addr;   /* Address read by the host */
+    FMSTR_SIZE size;   /* Number of bytes read */
+    FMSTR_SIZE offset; /* Position of the copy in fmstr_readCacheData */
+} FMSTR_READ_CACHE_ENTRY;
+#endif
+
 /******************************************************************************
  * Local Functions
  ******************************************************************************/
@@ -102,6 +111,17 @@ static FMSTR_SESSION fmstr_sessions[FMSTR_SESSION_COUNT];
 static FMSTR_FEATURE_LOCK fmstr_features[FMSTR_FEATURE_LOCK_COUNT];
 #endif
 
+#if FMSTR_USE_READ_CACHE > 0
+/* Memory read by any session since the last FMSTR_ReadCacheInvalidate() */
+static FMSTR_READ_CACHE_ENTRY fmstr_readCache[FMSTR_READ_CACHE_ENTRIES];
+static FMSTR_U8 fmstr_readCacheData[FMSTR_READ_CACHE_SIZE];
+static FMSTR_U8 fmstr_readCacheCount;
+static FMSTR_SIZE fmstr_readCacheUsed;
+/* Incremented by FMSTR_ReadCacheInvalidate(), the entries are valid while it equals fmstr_readCacheEpochSeen */
+static volatile FMSTR_U16 fmstr_readCacheEpoch;
+static FMSTR_U16 fmstr_readCacheEpochSeen;
+#endif
+
 #if FMSTR_CFG_F1_RESTRICTED_ACCESS != 0
 /* To save stack usage, we have the following SHA context variables static, although
  * they could be local in Auth2 function. */
@@ -483,7 +503,7 @@ FMSTR_BOOL FMSTR_SendTestFrame(FMSTR_BPTR msgBuffIO, FMSTR_SESSION *session)
 FMSTR_BPTR _FMSTR_GetBoardConfig(FMSTR_BPTR msgBuffIO, FMSTR_U8 *retStatus)
 {
     static const FMSTR_CHAR *const fmstr_cfgParamNames[] = {
-        "MTU", "VS", "NM", "DS", "BD", "F1", "BA", "RC", "SC", "PV", "PC",
+        "MTU", "VS", "NM", "DS", "BD", "F1", "BA", "RC", "SC", "PV", "PC", "LM",
     };
 
     FMSTR_BPTR response = msgBuffIO;
@@ -524,7 +544,12 @@ FMSTR_BPTR _FMSTR_GetBoardConfig(FMSTR_BPTR msgBuffIO, FMSTR_U8 *retStatus)
     switch (ix)
     {
         case 1: /* MTU */
+#if FMSTR_SERIAL_LARGE_MSG > 0 && FMSTR_COMM_BUFFER_SIZE > 254
+            /* what standard serial frames carry, the rest needs large-message frames (LM) */
+            response = FMSTR_SizeToBuffer(response, 254U);
+#else
             response = FMSTR_SizeToBuffer(response, FMSTR_COMM_BUFFER_SIZE);
+#endif
             break;
         case 2: /* VS */
             response = FMSTR_StringCopyToBuffer(response, FMSTR_VERSION_STR);
@@ -558,6 +583,11 @@ FMSTR_BPTR _FMSTR_GetBoardConfig(FMSTR_BPTR msgBuffIO, FMSTR_U8 *retStatus)
         case 11: /* PC */
             response = FMSTR_ValueToBuffer8(response, FMSTR_USE_PIPES);
             break;
+#if FMSTR_SERIAL_LARGE_MSG > 0
+        case 12: /* LM */
+            response = FMSTR_SizeToBuffer(response, FMSTR_COMM_BUFFER_SIZE);
+            break;
+#endif
         default:
             respCode = FMSTR_STC_EACCESS;
             break;
@@ -765,6 +795,16 @@ FMSTR_BPTR _FMSTR_ReadMem(FMSTR_SESSION *session, FMSTR_BPTR msgBuffIO, FMSTR_U8
     /* Get the Size from incomming buffer */
     msgBuffIO = FMSTR_SizeFromBuffer(&size, msgBuffIO);
 
+#if FMSTR_USE_READ_CACHE > 0
+    /* Another session read the same memory since the last publication, it passed the checks below */
+    msgBuffIO = FMSTR_ReadCacheGet(response, addr, size);
+    if (msgBuffIO != NULL)
+    {
+        *retStatus = FMSTR_STS_OK;
+        return msgBuffIO;
+    }
+#endif
+
 #if FMSTR_USE_TSA && FMSTR_USE_TSA_SAFETY
     if (FMSTR_CheckTsaSpace(addr, size, FMSTR_FALSE) == FMSTR_FALSE)
     {
@@ -782,7 +822,11 @@ FMSTR_BPTR _FMSTR_ReadMem(FMSTR_SESSION *session, FMSTR_BPTR msgBuffIO, FMSTR_U8
 
     /* success  */
     *retStatus = FMSTR_STS_OK;
+#if FMSTR_USE_READ_CACHE > 0
+    return FMSTR_ReadCacheFill(response, addr, size);
+#else
     return FMSTR_CopyToBuffer(response, addr, size);
+#endif
 }
 
 /******************************************************************************
@@ -822,6 +866,16 @@ FMSTR_BPTR _FMSTR_ReadMemBaseAddress(FMSTR_SESSION *session, FMSTR_BPTR msgBuffI
 
     addr = (FMSTR_ADDR)(FMSTR_PLATFORM_BASE_ADDRESS + index);
 
+#if FMSTR_USE_READ_CACHE > 0
+    /* Another session read the same memory since the last publication, it passed the checks below */
+    msgBuffIO = FMSTR_ReadCacheGet(response, addr, size);
+    if (msgBuffIO != NULL)
+    {
+        *retStatus = FMSTR_STS_OK;
+        return msgBuffIO;
+    }
+#endif
+
 #if FMSTR_USE_TSA && FMSTR_USE_TSA_SAFETY
     if (FMSTR_CheckTsaSpace(addr, size, FMSTR_FALSE) == FMSTR_FALSE)
     {
@@ -839,7 +893,11 @@ FMSTR_BPTR _FMSTR_ReadMemBaseAddress(FMSTR_SESSION *session, FMSTR_BPTR msgBuffI
 
     /* success  */
     *retStatus = FMSTR_STS_OK;
+#if FMSTR_USE_READ_CACHE > 0
+    return FMSTR_ReadCacheFill(response, addr, size);
+#else
     return FMSTR_CopyToBuffer(response, addr, size);
+#endif
 }
 #endif /* FMSTR_PLATFORM_BASE_ADDRESS */
 
@@ -901,6 +959,11 @@ FMSTR_BPTR _FMSTR_WriteMem(FMSTR_SESSION *session, FMSTR_BPTR msgBuffIO, FMSTR_U
 
     respCode = FMSTR_STS_OK;
 
+#if FMSTR_USE_READ_CACHE > 0
+    /* Reads following the write must see the new value */
+    FMSTR_ReadCacheInvalidate();
+#endif
+
 #if FMSTR_USE_TSA && FMSTR_USE_TSA_SAFETY
 FMSTR_WriteMem_exit:
 #endif
@@ -910,6 +973,113 @@ FMSTR_WriteMem_exit:
     return response;
 }
 
+#if FMSTR_USE_READ_CACHE > 0
+/******************************************************************************
+ *
+ * @brief    API: Invalidate the memory read cache
+ *
+ * Call after new values are published, typically once per sample period.
+ * Only a counter is incremented here, the entries are dropped by the next
+ * read, so the function may be called from any context.
+ *
+ ******************************************************************************/
+
+void FMSTR_ReadCacheInvalidate(void)
+{
+    fmstr_readCacheEpoch++;
+}
+
+/******************************************************************************
+ *
+ * @brief    Drop the cache entries when new values were published
+ *
+ ******************************************************************************/
+
+static void _FMSTR_ReadCacheSync(void)
+{
+    FMSTR_U16 epoch = fmstr_readCacheEpoch;
+
+    if (epoch != fmstr_readCacheEpochSeen)
+    {
+        fmstr_readCacheEpochSeen = epoch;
+        fmstr_readCacheCount     = 0U;
+        fmstr_readCacheUsed      = 0U;
+    }
+}
+
+/******************************************************************************
+ *
+ * @brief    Copy memory to the response from the read cache
+ *
+ * @param    destBuff - response buffer
+ * @param    srcAddr - memory address requested
+ * @param    size - number of bytes requested
+ *
+ * @return   End of the copied data, NULL when the memory is not cached
+ *
+ ******************************************************************************/
+
+FMSTR_BPTR FMSTR_ReadCacheGet(FMSTR_BPTR destBuff, FMSTR_ADDR srcAddr, FMSTR_SIZE size)
+{
+    FMSTR_U8 i;
+
+    _FMSTR_ReadCacheSync();
+
+    for (i = 0U; i < fmstr_readCacheCount; i++)
+    {
+        if ((fmstr_readCache[i].addr == srcAddr) && (fmstr_readCache[i].size == size))
+        {
+            return FMSTR_CopyToBuffer(destBuff, (FMSTR_ADDR)&fmstr_readCacheData[fmstr_readCache[i].offset], size);
+        }
+    }
+
+    return NULL;
+}
+
+/******************************************************************************
+ *
+ * @brief    Copy memory to the response and keep the copy in the read cache
+ *
+ * @param    destBuff - response buffer
+ * @param    srcAddr - memory address, already checked by the caller
+ * @param    size - number of bytes
+ *
+ * @return   End of the copied data
+ *
+ * The copy is not kept when the cache is full or when new values were
+ * published while it was taken.
+ *
+ ******************************************************************************/
+
+FMSTR_BPTR FMSTR_ReadCacheFill(FMSTR_BPTR destBuff, FMSTR_ADDR srcAddr, FMSTR_SIZE size)
+{
+    FMSTR_BPTR response;
+    FMSTR_READ_CACHE_ENTRY *entry;
+
+    _FMSTR_ReadCacheSync();
+
+    response = FMSTR_CopyToBuffer(destBuff, srcAddr, size);
+
+    if ((fmstr_readCacheEpoch == fmstr_readCacheEpochSeen) &&
+        (fmstr_readCacheCount < (FMSTR_U8)FMSTR_READ_CACHE_ENTRIES) &&
+        (size <= ((FMSTR_SIZE)FMSTR_READ_CACHE_SIZE - fmstr_readCacheUsed)))
+    {
+        entry         = &fmstr_readCache[fmstr_readCacheCount];
+        entry->addr   = srcAddr;
+        entry->size   = size;
+        entry->offset = fmstr_readCacheUsed;
+
+        /*lint -e{534} ignoring function return value */
+        (void)FMSTR_CopyFromBuffer((FMSTR_ADDR)&fmstr_readCacheData[fmstr_readCacheUsed], destBuff, size);
+
+        fmstr_readCacheUsed += size;
+        fmstr_readCacheCount++;
+    }
+
+    return response;
+}
+#endif /* FMSTR_USE_READ_CACHE > 0 */
+
 #if FMSTR_SESSION_COUNT > 1
 /******************************************************************************
  *
@@ -256,6 +256,9 @@ FMSTR_BPTR FMSTR_ReadScope(FMSTR_SESSION *session, FMSTR_BPTR msgBuffIO, FMSTR_U
     FMSTR_U8 scopeIndex;
     FMSTR_SCOPE *scope;
     FMSTR_BPTR msgBuffIOStart = msgBuffIO;
+#if FMSTR_USE_READ_CACHE > 0
+    FMSTR_BPTR msgBuffIOEnd;
+#endif
 
     /* Get recerder index */
     (void)FMSTR_ValueFromBuffer8(&scopeIndex, msgBuffIO);
@@ -297,8 +300,14 @@ FMSTR_BPTR FMSTR_ReadScope(FMSTR_SESSION *session, FMSTR_BPTR msgBuffIO, FMSTR_U
         }
         maxOutSize -= scope->varSize[i];
 
-        /* Copy variable */
+        /* Copy variable, sessions sampling it within one publication get the same value */
+#if FMSTR_USE_READ_CACHE > 0
+        msgBuffIOEnd = FMSTR_ReadCacheGet(msgBuffIO, scope->varAddr[i], scope->varSize[i]);
+        msgBuffIO    = (msgBuffIOEnd != NULL) ? msgBuffIOEnd :
+                                                FMSTR_ReadCacheFill(msgBuffIO, scope->varAddr[i], scope->varSize[i]);
+#else
         msgBuffIO = FMSTR_CopyToBuffer(msgBuffIO, scope->varAddr[i], scope->varSize[i]);
+#endif
     }
 
     *retStatus = FMSTR_STS_OK;
@@ -200,7 +200,7 @@ FMSTR_INLINE void _FMSTR_CopyMaskedDstAligned_U16(FMSTR_LP_U16 dest, FMSTR_LP_U8
 #endif
 
 /* Test if FMSTR_ADDR address is mis-aligned for given number of bits */
-#define TEST_MISALIGNED(addr, bits) ((((FMSTR_U32)(addr)) & ((1U << (bits)) - 1U)) != 0U)
+#define TEST_MISALIGNED(addr, bits) ((((FMSTR_SIZE32)(addr)) & ((1U << (bits)) - 1U)) != 0U)
 
 /* in this helper call, we are already sure that the destination pointer is 64-bit aligned */
 static void _FMSTR_MemCpyDstAligned(FMSTR_ADDR dest, FMSTR_ADDR src, FMSTR_SIZE size)
@@ -758,7 +758,7 @@ FMSTR_BPTR FMSTR_ValueToBuffer16BE(FMSTR_BPTR dest, FMSTR_U16 num)
 
 FMSTR_WEAK FMSTR_SIZE FMSTR_GetAlignmentCorrection(FMSTR_ADDR addr, FMSTR_SIZE size)
 {
-    FMSTR_U32 addrn   = (FMSTR_U32)addr;
+    FMSTR_U32 addrn   = (FMSTR_U32)(FMSTR_SIZE32)addr;
     FMSTR_U32 aligned = addrn;
 
     FMSTR_ASSERT(size == 0U || size == 1U || size == 2U || size == 4U || size == 8U);
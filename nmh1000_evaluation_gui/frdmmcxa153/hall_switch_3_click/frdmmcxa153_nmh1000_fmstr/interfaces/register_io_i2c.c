@@ -34,15 +34,45 @@ I2C_Type *const i2cBases[] = I2C_BASE_PTRS;
 #endif
 volatile bool b_I2C_CompletionFlag[I2C_COUNT] = {false};
 volatile uint32_t g_I2C_ErrorEvent[I2C_COUNT] = {ARM_I2C_EVENT_TRANSFER_DONE};
+volatile registerI2cStats_t g_I2C_Stats[I2C_COUNT];
 
 /*******************************************************************************
  * Code
  ******************************************************************************/
 
+/* Account a transfer completion event in the instance statistics. */
+static inline void I2C_UpdateStats(uint32_t instance, uint32_t event)
+{
+    volatile registerI2cStats_t *pStats = &g_I2C_Stats[instance];
+
+    pStats->transfers++;
+    if (event & ARM_I2C_EVENT_TRANSFER_INCOMPLETE)
+    {
+        pStats->incomplete++;
+    }
+    if (event & ARM_I2C_EVENT_ADDRESS_NACK)
+    {
+        pStats->addressNack++;
+    }
+    if (event & ARM_I2C_EVENT_ARBITRATION_LOST)
+    {
+        pStats->arbitrationLost++;
+    }
+    if (event & ARM_I2C_EVENT_BUS_ERROR)
+    {
+        pStats->busError++;
+    }
+    if (event & ARM_I2C_EVENT_BUS_CLEAR)
+    {
+        pStats->busClear++;
+    }
+}
+
 #if defined(I2C0)
 /* The I2C0 Signal Event Handler function. */
 void I2C0_SignalEvent_t(uint32_t event)
 {
+    I2C_UpdateStats(0, event);
     if (event != ARM_I2C_EVENT_TRANSFER_DONE)
     {
         g_I2C_ErrorEvent[0] = event;
@@ -55,6 +85,7 @@ void I2C0_SignalEvent_t(uint32_t event)
 /* The I2C1 Signal Event Handler function. */
 void I2C1_SignalEvent_t(uint32_t event)
 {
+    I2C_UpdateStats(1, event);
     if (event != ARM_I2C_EVENT_TRANSFER_DONE)
     {
         g_I2C_ErrorEvent[1] = event;
@@ -67,6 +98,7 @@ void I2C1_SignalEvent_t(uint32_t event)
 /* The I2C2 Signal Event Handler function. */
 void I2C2_SignalEvent_t(uint32_t event)
 {
+    I2C_UpdateStats(2, event);
     if (event != ARM_I2C_EVENT_TRANSFER_DONE)
     {
         g_I2C_ErrorEvent[2] = event;
@@ -79,6 +111,7 @@ void I2C2_SignalEvent_t(uint32_t event)
 /* The I2C3 Signal Event Handler function. */
 void I2C3_SignalEvent_t(uint32_t event)
 {
+    I2C_UpdateStats(3, event);
     if (event != ARM_I2C_EVENT_TRANSFER_DONE)
     {
         g_I2C_ErrorEvent[3] = event;
@@ -91,6 +124,7 @@ void I2C3_SignalEvent_t(uint32_t event)
 /* The I2C4 Signal Event Handler function. */
 void I2C4_SignalEvent_t(uint32_t event)
 {
+    I2C_UpdateStats(4, event);
     if (event != ARM_I2C_EVENT_TRANSFER_DONE)
     {
         g_I2C_ErrorEvent[4] = event;
@@ -103,6 +137,7 @@ void I2C4_SignalEvent_t(uint32_t event)
 /* The I2C5 Signal Event Handler function. */
 void I2C5_SignalEvent_t(uint32_t event)
 {
+    I2C_UpdateStats(5, event);
     if (event != ARM_I2C_EVENT_TRANSFER_DONE)
     {
         g_I2C_ErrorEvent[5] = event;
@@ -115,6 +150,7 @@ void I2C5_SignalEvent_t(uint32_t event)
 /* The I2C6 Signal Event Handler function. */
 void I2C6_SignalEvent_t(uint32_t event)
 {
+    I2C_UpdateStats(6, event);
     if (event != ARM_I2C_EVENT_TRANSFER_DONE)
     {
         g_I2C_ErrorEvent[6] = event;
@@ -127,6 +163,7 @@ void I2C6_SignalEvent_t(uint32_t event)
 /* The I2C7 Signal Event Handler function. */
 void I2C7_SignalEvent_t(uint32_t event)
 {
+    I2C_UpdateStats(7, event);
     if (event != ARM_I2C_EVENT_TRANSFER_DONE)
     {
         g_I2C_ErrorEvent[7] = event;
@@ -140,6 +177,7 @@ void I2C7_SignalEvent_t(uint32_t event)
 /* The I2C11 Signal Event Handler function. */
 void I2C11_SignalEvent_t(uint32_t event)
 {
+    I2C_UpdateStats(11, event);
     if (event != ARM_I2C_EVENT_TRANSFER_DONE)
     {
         g_I2C_ErrorEvent[11] = event;
@@ -149,6 +187,45 @@ void I2C11_SignalEvent_t(uint32_t event)
 #endif
 #endif
 
+/* Wait for the transfer started on the instance, abort it when it does not complete in time. */
+static int32_t I2C_WaitCompletion(ARM_DRIVER_I2C *pCommDrv, registerDeviceInfo_t *devInfo)
+{
+    uint32_t instance = devInfo->deviceInstance;
+    uint32_t start = (devInfo->tickFunction != NULL) ? devInfo->tickFunction() : 0U;
+    uint32_t waitedUs = 0;
+
+    while (!b_I2C_CompletionFlag[instance])
+    {
+        /* Elapsed time when the caller has a time base, the idle function may run whole tasks in one pass */
+        if ((devInfo->tickFunction != NULL) ? ((devInfo->tickFunction() - start) >= devInfo->timeoutTicks)
+                                            : (waitedUs >= REGISTER_I2C_TIMEOUT_US))
+        {
+            /* A held bus or a lost interrupt, leave recovery to the caller */
+            pCommDrv->Control(ARM_I2C_ABORT_TRANSFER, 0);
+            g_I2C_Stats[instance].timeouts++;
+            return ARM_DRIVER_ERROR_TIMEOUT;
+        }
+
+        if (devInfo->idleFunction)
+        {
+            devInfo->idleFunction(devInfo->functionParam);
+        }
+        SDK_DelayAtLeastUs(REGISTER_I2C_POLL_US, SystemCoreClock);
+        waitedUs += REGISTER_I2C_POLL_US;
+    }
+
+    if (g_I2C_ErrorEvent[instance] == ARM_I2C_EVENT_TRANSFER_INCOMPLETE)
+    {
+        pCommDrv->Control(ARM_I2C_ABORT_TRANSFER, 0);
+    }
+    if (g_I2C_ErrorEvent[instance] != ARM_I2C_EVENT_TRANSFER_DONE)
+    {
+        return ARM_DRIVER_ERROR;
+    }
+
+    return ARM_DRIVER_OK;
+}
+
 /*! The interface function to block write sensor registers. */
 int32_t Register_I2C_BlockWrite(ARM_DRIVER_I2C *pCommDrv,
                                 registerDeviceInfo_t *devInfo,
@@ -169,25 +246,7 @@ int32_t Register_I2C_BlockWrite(ARM_DRIVER_I2C *pCommDrv,
     if (ARM_DRIVER_OK == status)
     {
         /* Wait for completion */
-        while (!b_I2C_CompletionFlag[devInfo->deviceInstance])
-        {
-            if (devInfo->idleFunction)
-            {
-                devInfo->idleFunction(devInfo->functionParam);
-            }
-            else
-            {
-                __NOP();
-            }
-        }
-        if (g_I2C_ErrorEvent[devInfo->deviceInstance] == ARM_I2C_EVENT_TRANSFER_INCOMPLETE)
-        {
-            pCommDrv->Control(ARM_I2C_ABORT_TRANSFER, 0);
-        }
-        if (g_I2C_ErrorEvent[devInfo->deviceInstance] != ARM_I2C_EVENT_TRANSFER_DONE)
-        {
-            status = ARM_DRIVER_ERROR;
-        }
+        status = I2C_WaitCompletion(pCommDrv, devInfo);
     }
 
     return status;
@@ -214,25 +273,11 @@ int32_t Register_I2C_Write(ARM_DRIVER_I2C *pCommDrv,
         status = pCommDrv->MasterTransmit(slaveAddress, &config[0], 1, true);
         if (ARM_DRIVER_OK == status)
         {
-            /* Wait for completion without calling idle function */
-            while (!b_I2C_CompletionFlag[devInfo->deviceInstance])
-            {
-                if (devInfo->idleFunction)
-                {
-                    devInfo->idleFunction(devInfo->functionParam);
-                }
-                else
-                {
-                    __NOP();
-                }
-            };
-            if (g_I2C_ErrorEvent[devInfo->deviceInstance] == ARM_I2C_EVENT_TRANSFER_INCOMPLETE)
-            {
-                pCommDrv->Control(ARM_I2C_ABORT_TRANSFER, 0);
-            }
-            if (g_I2C_ErrorEvent[devInfo->deviceInstance] != ARM_I2C_EVENT_TRANSFER_DONE)
+            /* Wait for completion */
+            status = I2C_WaitCompletion(pCommDrv, devInfo);
+            if (ARM_DRIVER_OK != status)
             {
-                return ARM_DRIVER_ERROR;
+                return status;
             }
         }
         else
@@ -246,24 +291,10 @@ int32_t Register_I2C_Write(ARM_DRIVER_I2C *pCommDrv,
         if (ARM_DRIVER_OK == status)
         {
             /* Wait for completion */
-            while (!b_I2C_CompletionFlag[devInfo->deviceInstance])
+            status = I2C_WaitCompletion(pCommDrv, devInfo);
+            if (ARM_DRIVER_OK != status)
             {
-                if (devInfo->idleFunction)
-                {
-                    devInfo->idleFunction(devInfo->functionParam);
-                }
-                else
-                {
-                    __NOP();
-                }
-            }
-            if (g_I2C_ErrorEvent[devInfo->deviceInstance] == ARM_I2C_EVENT_TRANSFER_INCOMPLETE)
-            {
-                pCommDrv->Control(ARM_I2C_ABORT_TRANSFER, 0);
-            }
-            if (g_I2C_ErrorEvent[devInfo->deviceInstance] != ARM_I2C_EVENT_TRANSFER_DONE)
-            {
-                return ARM_DRIVER_ERROR;
+                return status;
             }
         }
         else
@@ -286,25 +317,7 @@ int32_t Register_I2C_Write(ARM_DRIVER_I2C *pCommDrv,
     if (ARM_DRIVER_OK == status)
     {
         /* Wait for completion */
-        while (!b_I2C_CompletionFlag[devInfo->deviceInstance])
-        {
-            if (devInfo->idleFunction)
-            {
-                devInfo->idleFunction(devInfo->functionParam);
-            }
-            else
-            {
-                __NOP();
-            }
-        }
-        if (g_I2C_ErrorEvent[devInfo->deviceInstance] == ARM_I2C_EVENT_TRANSFER_INCOMPLETE)
-        {
-            pCommDrv->Control(ARM_I2C_ABORT_TRANSFER, 0);
-        }
-        if (g_I2C_ErrorEvent[devInfo->deviceInstance] != ARM_I2C_EVENT_TRANSFER_DONE)
-        {
-            status = ARM_DRIVER_ERROR;
-        }
+        status = I2C_WaitCompletion(pCommDrv, devInfo);
     }
 
     return status;
@@ -325,25 +338,11 @@ int32_t Register_I2C_Read(ARM_DRIVER_I2C *pCommDrv,
     status = pCommDrv->MasterTransmit(slaveAddress, &offset, 1, true);
     if (ARM_DRIVER_OK == status)
     {
-        /* Wait for completion without calling idle function. */
-        while (!b_I2C_CompletionFlag[devInfo->deviceInstance])
-        {
-            if (devInfo->idleFunction)
-            {
-                devInfo->idleFunction(devInfo->functionParam);
-            }
-            else
-            {
-                __NOP();
-            }
-        };
-        if (g_I2C_ErrorEvent[devInfo->deviceInstance] == ARM_I2C_EVENT_TRANSFER_INCOMPLETE)
-        {
-            pCommDrv->Control(ARM_I2C_ABORT_TRANSFER, 0);
-        }
-        if (g_I2C_ErrorEvent[devInfo->deviceInstance] != ARM_I2C_EVENT_TRANSFER_DONE)
+        /* Wait for completion */
+        status = I2C_WaitCompletion(pCommDrv, devInfo);
+        if (ARM_DRIVER_OK != status)
         {
-            return ARM_DRIVER_ERROR;
+            return status;
         }
     }
     else
@@ -358,25 +357,7 @@ int32_t Register_I2C_Read(ARM_DRIVER_I2C *pCommDrv,
     if (ARM_DRIVER_OK == status)
     {
         /* Wait for completion */
-        while (!b_I2C_CompletionFlag[devInfo->deviceInstance])
-        {
-            if (devInfo->idleFunction)
-            {
-                devInfo->idleFunction(devInfo->functionParam);
-            }
-            else
-            {
-                __NOP();
-            }
-        }
-        if (g_I2C_ErrorEvent[devInfo->deviceInstance] == ARM_I2C_EVENT_TRANSFER_INCOMPLETE)
-        {
-            pCommDrv->Control(ARM_I2C_ABORT_TRANSFER, 0);
-        }
-        if (g_I2C_ErrorEvent[devInfo->deviceInstance] != ARM_I2C_EVENT_TRANSFER_DONE)
-        {
-            status = ARM_DRIVER_ERROR;
-        }
+        status = I2C_WaitCompletion(pCommDrv, devInfo);
     }
 
     return status;
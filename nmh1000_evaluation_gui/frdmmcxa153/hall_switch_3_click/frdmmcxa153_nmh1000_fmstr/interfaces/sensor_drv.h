@@ -96,6 +96,11 @@ typedef struct
  */
 typedef void (*registeridlefunction_t)(void *userParam);
 
+/*!
+ * @brief This is the register tick function type, a free running counter timing the transfer timeout.
+ */
+typedef uint32_t (*registertickfunction_t)(void);
+
 /*!
  * @brief This structure defines the device specific info required by register I/O.
  */
@@ -104,6 +109,8 @@ typedef struct
     registeridlefunction_t idleFunction;
     void *functionParam;
     uint8_t deviceInstance;
+    registertickfunction_t tickFunction; /* Elapsed time source, NULL counts polling intervals instead. */
+    uint32_t timeoutTicks;               /* Transfer timeout in tickFunction ticks. */
 } registerDeviceInfo_t;
 
 #endif //_SENSOR_DRV_H
@@ -39,6 +39,8 @@ int32_t NMH1000_I2C_Initialize(
     pSensorHandle->deviceInfo.deviceInstance = index;
     pSensorHandle->deviceInfo.functionParam = NULL;
     pSensorHandle->deviceInfo.idleFunction = NULL;
+    pSensorHandle->deviceInfo.tickFunction = NULL;
+    pSensorHandle->deviceInfo.timeoutTicks = 0;
 
     /*!  Read and store the device's WHO_AM_I.*/
     status = Register_I2C_Read(pBus, &pSensorHandle->deviceInfo, sAddress, NMH1000_WHO_AM_I, 1, &reg);
@@ -62,6 +64,13 @@ void NMH1000_I2C_SetIdleTask(nmh1000_i2c_sensorhandle_t *pSensorHandle, register
     pSensorHandle->deviceInfo.idleFunction = idleTask;
 }
 
+void NMH1000_I2C_SetTimeout(nmh1000_i2c_sensorhandle_t *pSensorHandle, registertickfunction_t tickFunction,
+                            uint32_t timeoutTicks)
+{
+    pSensorHandle->deviceInfo.tickFunction = tickFunction;
+    pSensorHandle->deviceInfo.timeoutTicks = timeoutTicks;
+}
+
 int32_t NMH1000_I2C_Configure(nmh1000_i2c_sensorhandle_t *pSensorHandle, const registerwritelist_t *pRegWriteList)
 {
     int32_t status;
@@ -0,0 +1,78 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/* Generated by tools/gen_nmh1000_regs.py from reg.csv and nmh1000.h, do not edit. */
+
+/**
+ * @file  nmh1000_regs.c
+ * @brief The nmh1000_regs.c file defines the NMH1000 register descriptor table.
+ */
+
+//-----------------------------------------------------------------------
+// SDK Includes
+//-----------------------------------------------------------------------
+#include <stddef.h>
+#include <stdint.h>
+
+#include "nmh1000.h"
+#include "nmh1000_regs.h"
+
+//-----------------------------------------------------------------------
+// Global Variables
+//-----------------------------------------------------------------------
+const nmh1000_reg_desc_t cNmh1000Registers[NMH1000_NUM_REGISTERS] = {
+    {NMH1000_STATUS, NMH1000_REG_READ | NMH1000_REG_VOLATILE, 0x00U, 0x62U}, /* STATUS */
+    {NMH1000_CONTROL_REG1, NMH1000_REG_READ | NMH1000_REG_WRITE | NMH1000_REG_VOLATILE, 0x3DU, 0x00U}, /* CONTROL_REG1 */
+    {NMH1000_RESERVED1, NMH1000_REG_READ, 0x00U, 0x00U}, /* RESERVED */
+    {NMH1000_OUT_M_REG, NMH1000_REG_READ | NMH1000_REG_VOLATILE, 0x00U, 0x00U}, /* OUT_M_REG */
+    {NMH1000_USER_ASSERT_THRESH, NMH1000_REG_READ | NMH1000_REG_WRITE, 0xF8U, 0x00U}, /* USER_ASSERT_THRESH */
+    {NMH1000_USER_CLEAR_THRESH, NMH1000_REG_READ | NMH1000_REG_WRITE, 0xF8U, 0x00U}, /* USER_CLEAR_THRESH */
+    {NMH1000_ODR, NMH1000_REG_READ | NMH1000_REG_WRITE, 0x07U, 0x00U}, /* USER_ODR */
+    {NMH1000_RESERVED2, NMH1000_REG_READ, 0x00U, 0x00U}, /* RESERVED */
+    {NMH1000_WHO_AM_I, NMH1000_REG_READ, 0x00U, 0x01U}, /* WHO_AM_I */
+    {NMH1000_I2C_ADDR, NMH1000_REG_READ | NMH1000_REG_WRITE, 0x7FU, 0x60U}, /* I2C_ADDR */
+};
+
+//-----------------------------------------------------------------------
+// Functions
+//-----------------------------------------------------------------------
+bool NMH1000_REG_IsReadable(uint8_t address)
+{
+    const nmh1000_reg_desc_t *pReg = NMH1000_REG_Find(address);
+
+    return (pReg != NULL) && ((pReg->flags & NMH1000_REG_READ) != 0U);
+}
+
+bool NMH1000_REG_IsWritable(uint8_t address, uint8_t value)
+{
+    const nmh1000_reg_desc_t *pReg = NMH1000_REG_Find(address);
+
+    return (pReg != NULL) && ((pReg->flags & NMH1000_REG_WRITE) != 0U) && ((value & ~pReg->writeMask) == 0U);
+}
+
+bool NMH1000_REG_IsCacheable(uint8_t address)
+{
+    const nmh1000_reg_desc_t *pReg = NMH1000_REG_Find(address);
+
+    return (pReg != NULL) && ((pReg->flags & (NMH1000_REG_READ | NMH1000_REG_VOLATILE)) == NMH1000_REG_READ);
+}
+
+uint8_t NMH1000_REG_BurstLength(uint8_t address, uint8_t maxLen)
+{
+    uint8_t length = 0U;
+
+    if (maxLen > NMH1000_REG_BURST_MAX)
+    {
+        maxLen = NMH1000_REG_BURST_MAX;
+    }
+    while ((length < maxLen) && NMH1000_REG_IsReadable((uint8_t)(address + length)))
+    {
+        length++;
+    }
+
+    return length;
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file deferred_log.h
+ * @brief The deferred_log.h file declares the deferred binary logging facility.
+ *
+ * @details A log site stores only the address of its format string (the format ID) and the raw 32-bit
+ *          arguments into a RAM ring; no formatting is done on target. Format strings are placed in the
+ *          ".rodata.dlog" section so the host tool (tools/dlog_decode.py) can look them up in the ELF and
+ *          expand the records. Each record is:
+ *
+ *          | Offset | Size  | Field                                   |
+ *          |--------|-------|-----------------------------------------|
+ *          | 0      | 1     | sync, DLOG_SYNC                         |
+ *          | 1      | 1     | argument count n (0..DLOG_MAX_ARGS)     |
+ *          | 2      | 4     | format string address (little-endian)   |
+ *          | 6      | 4 * n | arguments (little-endian)               |
+ *
+ *          Arguments must be integers, characters or addresses of string literals (%s is resolved from
+ *          the ELF, so it only works for strings stored in flash).
+ */
+
+#ifndef DEFERRED_LOG_H_
+#define DEFERRED_LOG_H_
+
+/* Standard C Includes */
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "freemaster.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief Set to 0 to compile out all DLOG() sites. */
+#ifndef DLOG_ENABLE
+#define DLOG_ENABLE 1
+#endif
+
+/*! @brief FreeMASTER pipe port the log ring is drained to. */
+#define DLOG_PIPE_PORT (0x22U)
+
+/*! @brief Size of the log ring in bytes, must be a power of two. */
+#define DLOG_RING_SIZE (512U)
+
+/*! @brief Maximum number of arguments per log site. */
+#define DLOG_MAX_ARGS (4U)
+
+#define DLOG_SYNC        (0xD7U)
+#define DLOG_HEADER_SIZE (6U)
+
+/*! @brief This structure defines the deferred log state. */
+typedef struct
+{
+    FMSTR_PIPE_RING ring;            /*!< Log ring, attached to the pipe when one is open. */
+    FMSTR_HPIPE pipe;                /*!< Pipe handle, NULL when draining to the console. */
+    uint8_t buffer[DLOG_RING_SIZE];  /*!< Ring storage. */
+    volatile uint32_t recordCount;   /*!< Records stored. */
+    volatile uint32_t droppedCount;  /*!< Records dropped because the ring was full. */
+} dlog_t;
+
+/*! @brief Log state, exported so it can be mapped into TSA. */
+extern dlog_t g_dlog;
+
+#if DLOG_ENABLE
+/*! @brief Log a format ID and up to DLOG_MAX_ARGS integer arguments, e.g. DLOG("odr=%u err=%d", odr, err). */
+#define DLOG(fmt, ...)                                                                                  \
+    do                                                                                                  \
+    {                                                                                                   \
+        static const char _dlogFmt[] __attribute__((section(".rodata.dlog"), used)) = fmt;             \
+        const uint32_t _dlogArgs[] = {0U, ##__VA_ARGS__};                                               \
+        DLOG_Write(_dlogFmt, (uint8_t)((sizeof(_dlogArgs) / sizeof(_dlogArgs[0])) - 1U), &_dlogArgs[1]); \
+    } while (0)
+#else
+#define DLOG(fmt, ...) \
+    do                 \
+    {                  \
+    } while (0)
+#endif
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+/*! @brief       Initialize the log ring and attach it to a FreeMASTER pipe.
+ *  @param[in]   usePipe  true to drain over FreeMASTER pipe DLOG_PIPE_PORT, false to drain with
+ *                        DLOG_DrainToConsole() when the debug console is not used by FreeMASTER.
+ *  @return      true on success.
+ *  @constraints With usePipe, must be called after FMSTR_Init().
+ *  @reeentrant  No
+ */
+bool DLOG_Init(bool usePipe);
+
+/*! @brief       Store one log record, called by the DLOG() macro.
+ *  @param[in]   fmt   format string placed in the .rodata.dlog section.
+ *  @param[in]   argc  number of arguments.
+ *  @param[in]   argv  arguments.
+ *  @return      void.
+ *  @constraints None, may be called from interrupts.
+ *  @reeentrant  Yes
+ */
+void DLOG_Write(const char *fmt, uint8_t argc, const uint32_t *argv);
+
+/*! @brief       Send pending log bytes to the debug console.
+ *  @return      void.
+ *  @constraints Only when DLOG_Init() was called with usePipe false.
+ *  @reeentrant  No
+ */
+void DLOG_DrainToConsole(void);
+
+#endif // DEFERRED_LOG_H_
@@ -0,0 +1,108 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file health_stats.h
+ * @brief The health_stats.h file declares the runtime health and throughput counters.
+ *
+ * @details The statistics block gathers the main loop and sample rates, CPU idle share, the I2C
+ *          transfer statistics kept by register_io_i2c.c and the FreeMASTER serial frame counters.
+ *          It is published in FreeMASTER TSA table health_table. Writing healthReset from the host
+ *          restarts all counters, the sources keep running and are reported against a baseline.
+ *          Idle time is the time the main loop spends blocked in HEALTH_IdleBegin() ..
+ *          HEALTH_IdleEnd(), including Sleep, interrupts served meanwhile are counted as idle. Time is
+ *          taken from POWER_GetTicks() as the core cycle counter stops in Sleep.
+ */
+
+#ifndef HEALTH_STATS_H_
+#define HEALTH_STATS_H_
+
+/* Standard C Includes */
+#include <stdint.h>
+
+#include "fsl_common.h"
+#include "power_manager.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief Rate measurement window in milliseconds. */
+#define HEALTH_WINDOW_MS (1000U)
+
+/*! @brief This structure defines the health statistics block. */
+typedef struct
+{
+    uint32_t loopsPerSec;        /*!< Main loop passes per second, last window. */
+    uint32_t samplesPerSec;      /*!< Sensor samples per second over all sensors on the bus, last window. */
+    uint32_t idlePercent;        /*!< CPU idle share in percent, last window. */
+    uint32_t loops;              /*!< Main loop passes since reset. */
+    uint32_t samples;            /*!< Sensor samples since reset. */
+    uint32_t i2cTransfers;       /*!< I2C transfers completed since reset. */
+    uint32_t i2cIncomplete;      /*!< ARM_I2C_EVENT_TRANSFER_INCOMPLETE since reset. */
+    uint32_t i2cAddressNack;     /*!< ARM_I2C_EVENT_ADDRESS_NACK since reset. */
+    uint32_t i2cArbitrationLost; /*!< ARM_I2C_EVENT_ARBITRATION_LOST since reset. */
+    uint32_t i2cBusError;        /*!< ARM_I2C_EVENT_BUS_ERROR since reset. */
+    uint32_t i2cBusClear;        /*!< ARM_I2C_EVENT_BUS_CLEAR since reset. */
+    uint32_t i2cTimeouts;        /*!< I2C transfers aborted on timeout since reset. */
+    uint32_t fmstrRxFrames;      /*!< FreeMASTER frames received since reset. */
+    uint32_t fmstrTxFrames;      /*!< FreeMASTER responses sent since reset. */
+    uint32_t fmstrCsErrors;      /*!< Frames rejected with FMSTR_STC_CMDCSERR since reset. */
+    uint32_t fmstrTooLong;       /*!< Frames rejected with FMSTR_STC_CMDTOOLONG since reset. */
+} health_stats_t;
+
+/*! @brief Health statistics, exported so the main loop can count cheaply. */
+extern health_stats_t g_health;
+
+/*! @brief Tick count at HEALTH_IdleBegin(). */
+extern uint32_t g_healthIdleStart;
+
+/*! @brief Idle ticks accumulated in the current window. */
+extern uint32_t g_healthIdleTicks;
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+/*! @brief       Initialize the statistics block and start the first window.
+ *  @param[in]   i2cInstance  I2C device index of the sensor bus.
+ *  @return      void.
+ *  @constraints Call once before the main loop, after POWER_Init().
+ *  @reeentrant  No
+ */
+void HEALTH_Init(uint32_t i2cInstance);
+
+/*! @brief       Handle a reset request, refresh the counters and the rates once per window.
+ *  @return      void.
+ *  @constraints Call once per main loop pass.
+ *  @reeentrant  No
+ */
+void HEALTH_Service(void);
+
+/*! @brief Count one main loop pass. */
+static inline void HEALTH_CountLoop(void)
+{
+    g_health.loops++;
+}
+
+/*! @brief Count the sensor samples taken on the bus. */
+static inline void HEALTH_CountSamples(uint32_t count)
+{
+    g_health.samples += count;
+}
+
+/*! @brief Mark the start of a period the main loop only waits. */
+static inline void HEALTH_IdleBegin(void)
+{
+    g_healthIdleStart = POWER_GetTicks();
+}
+
+/*! @brief Mark the end of a period the main loop only waits. */
+static inline void HEALTH_IdleEnd(void)
+{
+    g_healthIdleTicks += POWER_GetTicks() - g_healthIdleStart;
+}
+
+#endif // HEALTH_STATS_H_
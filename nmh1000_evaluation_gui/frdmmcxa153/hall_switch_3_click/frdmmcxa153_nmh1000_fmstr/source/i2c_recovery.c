@@ -0,0 +1,171 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file  i2c_recovery.c
+ * @brief The i2c_recovery.c file implements the I2C bus fault recovery and retry policy.
+ */
+
+//-----------------------------------------------------------------------
+// SDK Includes
+//-----------------------------------------------------------------------
+#include <string.h>
+#include "fsl_common.h"
+#include "fsl_gpio.h"
+
+#include "deferred_log.h"
+#include "power_manager.h"
+#include "i2c_recovery.h"
+
+//-----------------------------------------------------------------------
+// Local Functions
+//-----------------------------------------------------------------------
+/* Emulate an open-drain output: drive low, or release the line to the pull-up */
+static void i2c_recovery_drive(const gpioHandleKSDK_t *pPin, bool high)
+{
+    gpio_pin_config_t config = {high ? kGPIO_DigitalInput : kGPIO_DigitalOutput, 0U};
+
+    GPIO_PinInit(pPin->base, pPin->pinNumber, &config);
+    SDK_DelayAtLeastUs(I2C_RECOVERY_HALF_PERIOD_US, SystemCoreClock);
+}
+
+static bool i2c_recovery_sda_high(const i2c_recovery_t *pRecovery)
+{
+    return GPIO_PinRead(pRecovery->pSda->base, pRecovery->pSda->pinNumber) != 0U;
+}
+
+/* Clock a slave holding SDA out of its byte and leave the bus idle with a STOP */
+static bool i2c_recovery_bus_clear(const i2c_recovery_t *pRecovery)
+{
+    CLOCK_EnableClock(pRecovery->pScl->clockName);
+    CLOCK_EnableClock(pRecovery->pSda->clockName);
+
+    i2c_recovery_drive(pRecovery->pSda, true);
+    i2c_recovery_drive(pRecovery->pScl, true);
+
+    for (uint32_t pulse = 0; (pulse < I2C_RECOVERY_CLEAR_PULSES) && !i2c_recovery_sda_high(pRecovery); pulse++)
+    {
+        i2c_recovery_drive(pRecovery->pScl, false);
+        i2c_recovery_drive(pRecovery->pScl, true);
+    }
+
+    /* STOP: SDA rises while SCL is high */
+    i2c_recovery_drive(pRecovery->pScl, false);
+    i2c_recovery_drive(pRecovery->pSda, false);
+    i2c_recovery_drive(pRecovery->pScl, true);
+    i2c_recovery_drive(pRecovery->pSda, true);
+
+    return i2c_recovery_sda_high(pRecovery);
+}
+
+static bool i2c_recovery_recover(i2c_recovery_t *pRecovery)
+{
+    ARM_DRIVER_I2C *pBus = pRecovery->pBus;
+    bool cleared;
+    int32_t status;
+
+    /* Uninitialize also hands SCL and SDA back to GPIO */
+    (void)pBus->PowerControl(ARM_POWER_OFF);
+    (void)pBus->Uninitialize();
+
+    cleared = i2c_recovery_bus_clear(pRecovery);
+
+    status = pBus->Initialize(pRecovery->signalEvent);
+    if (ARM_DRIVER_OK == status)
+    {
+        status = pBus->PowerControl(ARM_POWER_FULL);
+    }
+    if (ARM_DRIVER_OK == status)
+    {
+        status = pBus->Control(ARM_I2C_BUS_SPEED, pRecovery->busSpeed);
+    }
+
+    pRecovery->recoveries++;
+    if (!cleared || (ARM_DRIVER_OK != status))
+    {
+        pRecovery->recoveryFailures++;
+        DLOG("i2c recovery failed, sda released %u, driver status %d", cleared, status);
+        return false;
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------
+// Functions
+//-----------------------------------------------------------------------
+void I2C_RECOVERY_Init(i2c_recovery_t *pRecovery,
+                       ARM_DRIVER_I2C *pBus,
+                       ARM_I2C_SignalEvent_t signalEvent,
+                       uint32_t busSpeed,
+                       const gpioHandleKSDK_t *pScl,
+                       const gpioHandleKSDK_t *pSda)
+{
+    memset(pRecovery, 0, sizeof(*pRecovery));
+    pRecovery->pBus = pBus;
+    pRecovery->signalEvent = signalEvent;
+    pRecovery->busSpeed = busSpeed;
+    pRecovery->pScl = pScl;
+    pRecovery->pSda = pSda;
+    pRecovery->ticksPerUs = CLOCK_GetFreq(kCLOCK_CoreSysClk) / 1000000U;
+}
+
+bool I2C_RECOVERY_Ready(i2c_recovery_t *pRecovery)
+{
+    if (!I2C_RECOVERY_BackingOff(pRecovery))
+    {
+        return true;
+    }
+
+    pRecovery->skipped++;
+    return false;
+}
+
+bool I2C_RECOVERY_BackingOff(const i2c_recovery_t *pRecovery)
+{
+    return (pRecovery->backoffUs != 0U) && ((int32_t)(POWER_GetTicks() - pRecovery->retryTicks) < 0);
+}
+
+bool I2C_RECOVERY_Report(i2c_recovery_t *pRecovery, int32_t status)
+{
+    if (ARM_DRIVER_OK == status)
+    {
+        if (pRecovery->backoffUs != 0U)
+        {
+            DLOG("i2c bus back after %u recoveries", pRecovery->recoveries);
+        }
+        pRecovery->consecutive = 0U;
+        pRecovery->backoffUs = 0U;
+        return false;
+    }
+
+    pRecovery->failures++;
+    pRecovery->consecutive++;
+
+    /* Retry plain transactions first, once backing off every failure recovers again */
+    if ((pRecovery->backoffUs == 0U) && (pRecovery->consecutive < I2C_RECOVERY_RETRIES))
+    {
+        return false;
+    }
+
+    (void)i2c_recovery_recover(pRecovery);
+    pRecovery->consecutive = 0U;
+
+    if (pRecovery->backoffUs == 0U)
+    {
+        DLOG("i2c bus fault, status %d, recovering", status);
+        pRecovery->backoffUs = I2C_RECOVERY_BACKOFF_MIN_US;
+    }
+    else if (pRecovery->backoffUs < I2C_RECOVERY_BACKOFF_MAX_US)
+    {
+        pRecovery->backoffUs = MIN(pRecovery->backoffUs * 2U, I2C_RECOVERY_BACKOFF_MAX_US);
+    }
+    pRecovery->retryTicks = POWER_GetTicks() + (pRecovery->backoffUs * pRecovery->ticksPerUs);
+
+    /* A slave clocked out of a byte, or one that was reset while the bus hung, may hold other contents */
+    return true;
+}
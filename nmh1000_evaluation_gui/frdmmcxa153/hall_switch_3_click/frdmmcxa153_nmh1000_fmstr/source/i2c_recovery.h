@@ -0,0 +1,114 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file i2c_recovery.h
+ * @brief The i2c_recovery.h file declares the I2C bus fault recovery and retry policy.
+ *
+ * @details The application reports the outcome of every sensor transaction with I2C_RECOVERY_Report().
+ *          A failed transaction is retried on the next sample period. After I2C_RECOVERY_RETRIES
+ *          consecutive failures the bus is recovered: the CMSIS driver is uninitialized (which returns
+ *          SCL and SDA to GPIO), up to nine SCL pulses are clocked until a slave holding SDA low lets
+ *          go, a STOP is generated and the driver is initialized again. The bus then backs off for
+ *          I2C_RECOVERY_BACKOFF_MIN_US; while I2C_RECOVERY_Ready() returns false no transaction is
+ *          started. Every further failure recovers again and doubles the backoff up to
+ *          I2C_RECOVERY_BACKOFF_MAX_US, the first success returns to normal operation.
+ */
+
+#ifndef I2C_RECOVERY_H_
+#define I2C_RECOVERY_H_
+
+/* Standard C Includes */
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "Driver_I2C.h"
+#include "gpio_driver.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief Consecutive failures tolerated before the bus is recovered. */
+#define I2C_RECOVERY_RETRIES (3U)
+
+/*! @brief Backoff after the first recovery in microseconds. */
+#define I2C_RECOVERY_BACKOFF_MIN_US (1000U)
+
+/*! @brief Longest backoff in microseconds. */
+#define I2C_RECOVERY_BACKOFF_MAX_US (1000000U)
+
+/*! @brief Half of the bus clear SCL period in microseconds, about 100 kHz. */
+#define I2C_RECOVERY_HALF_PERIOD_US (5U)
+
+/*! @brief SCL pulses clocked to release SDA, enough for a slave stuck in any bit of a byte. */
+#define I2C_RECOVERY_CLEAR_PULSES (9U)
+
+/*! @brief This structure defines the recovery state of one I2C bus. */
+typedef struct
+{
+    ARM_DRIVER_I2C *pBus;                /*!< CMSIS driver of the bus. */
+    ARM_I2C_SignalEvent_t signalEvent;   /*!< Event handler the driver is initialized with. */
+    uint32_t busSpeed;                   /*!< ARM_I2C_BUS_SPEED_xxx restored after re-init. */
+    const gpioHandleKSDK_t *pScl;        /*!< SCL pin, used as GPIO during bus clear. */
+    const gpioHandleKSDK_t *pSda;        /*!< SDA pin, used as GPIO during bus clear. */
+    uint32_t ticksPerUs;                 /*!< POWER_GetTicks() ticks per microsecond. */
+    uint32_t retryTicks;                 /*!< POWER_GetTicks() value the backoff ends at. */
+    uint32_t backoffUs;                  /*!< Current backoff, 0 while the bus is healthy. */
+    uint32_t consecutive;                /*!< Failures since the last success or recovery. */
+    uint32_t failures;                   /*!< Failed transactions reported. */
+    uint32_t recoveries;                 /*!< Bus clear and re-init sequences run. */
+    uint32_t recoveryFailures;           /*!< Recoveries that left SDA low or the driver failing. */
+    uint32_t skipped;                    /*!< Transactions held back during a backoff. */
+} i2c_recovery_t;
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+/*! @brief       Initialize the recovery state of a bus whose driver is already initialized.
+ *  @param[in]   pRecovery    recovery state.
+ *  @param[in]   pBus         CMSIS I2C driver of the bus.
+ *  @param[in]   signalEvent  event handler the driver was initialized with.
+ *  @param[in]   busSpeed     ARM_I2C_BUS_SPEED_xxx the bus runs at.
+ *  @param[in]   pScl         SCL pin handle.
+ *  @param[in]   pSda         SDA pin handle.
+ *  @return      void.
+ *  @constraints Call after POWER_Init().
+ *  @reeentrant  No
+ */
+void I2C_RECOVERY_Init(i2c_recovery_t *pRecovery,
+                       ARM_DRIVER_I2C *pBus,
+                       ARM_I2C_SignalEvent_t signalEvent,
+                       uint32_t busSpeed,
+                       const gpioHandleKSDK_t *pScl,
+                       const gpioHandleKSDK_t *pSda);
+
+/*! @brief       Check whether a transaction may be started.
+ *  @param[in]   pRecovery  recovery state.
+ *  @return      false while the bus is backing off after a recovery.
+ *  @constraints None
+ *  @reeentrant  No
+ */
+bool I2C_RECOVERY_Ready(i2c_recovery_t *pRecovery);
+
+/*! @brief       Check whether the bus is backing off, without counting a held back transaction.
+ *  @param[in]   pRecovery  recovery state.
+ *  @return      true while I2C_RECOVERY_Ready() would return false.
+ *  @constraints None
+ *  @reeentrant  Yes
+ */
+bool I2C_RECOVERY_BackingOff(const i2c_recovery_t *pRecovery);
+
+/*! @brief       Report the outcome of a transaction, recover the bus when the policy says so.
+ *  @param[in]   pRecovery  recovery state.
+ *  @param[in]   status     SENSOR_ERROR_NONE / ARM_DRIVER_OK, or the error of the transaction.
+ *  @return      true when the bus was cleared and re-initialized, the devices on it may have lost state.
+ *  @constraints Do not call from an I2C transfer in progress.
+ *  @reeentrant  No
+ */
+bool I2C_RECOVERY_Report(i2c_recovery_t *pRecovery, int32_t status);
+
+#endif // I2C_RECOVERY_H_
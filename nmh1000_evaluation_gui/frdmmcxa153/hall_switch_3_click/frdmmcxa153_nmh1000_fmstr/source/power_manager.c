@@ -0,0 +1,151 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file  power_manager.c
+ * @brief The power_manager.c file implements the sample pacing and low-power idle of the main loop.
+ */
+
+//-----------------------------------------------------------------------
+// SDK Includes
+//-----------------------------------------------------------------------
+#include "fsl_common.h"
+#include "freemaster.h"
+
+#include "power_manager.h"
+
+//-----------------------------------------------------------------------
+// Global Variables
+//-----------------------------------------------------------------------
+power_stats_t g_power;
+volatile uint32_t powerSamplePeriodUs = POWER_DEFAULT_SAMPLE_PERIOD_US;
+volatile uint8_t powerSleepEnable = 1U;
+
+/*! @brief SysTick period counter, incremented by SysTick_Handler in systick_utils.c. */
+extern volatile uint32_t g_ovf_counter;
+
+/*! @brief Power statistics and controls published to FreeMASTER. */
+FMSTR_TSA_TABLE_BEGIN(power_table)
+    FMSTR_TSA_STRUCT(power_stats_t)
+    FMSTR_TSA_MEMBER(power_stats_t, dutyCyclePercent, FMSTR_TSA_UINT32)
+    FMSTR_TSA_MEMBER(power_stats_t, modeTimeMs, FMSTR_TSA_UINT32)
+    FMSTR_TSA_MEMBER(power_stats_t, sleepCount, FMSTR_TSA_UINT32)
+
+    FMSTR_TSA_RO_VAR(g_power, FMSTR_TSA_USERTYPE(power_stats_t))
+    FMSTR_TSA_RO_MEM(power_run_ms, FMSTR_TSA_UINT32, &g_power.modeTimeMs[POWER_MODE_RUN], sizeof(uint32_t))
+    FMSTR_TSA_RO_MEM(power_sleep_ms, FMSTR_TSA_UINT32, &g_power.modeTimeMs[POWER_MODE_SLEEP], sizeof(uint32_t))
+    FMSTR_TSA_RW_VAR(powerSamplePeriodUs, FMSTR_TSA_UINT32)
+    FMSTR_TSA_RW_VAR(powerSleepEnable, FMSTR_TSA_UINT8)
+FMSTR_TSA_TABLE_END()
+
+//-----------------------------------------------------------------------
+// Local Variables
+//-----------------------------------------------------------------------
+static uint32_t powerTickReload;  /* core clock ticks per SysTick period */
+static uint32_t powerTicksPerUs;
+static uint32_t powerTicksPerMs;
+static uint32_t powerLastTicks;   /* end of the last accounted interval */
+static uint32_t powerModeTicks[POWER_MODE_COUNT]; /* remainders not yet converted to ms */
+static uint32_t powerWindowTicks[POWER_MODE_COUNT];
+
+//-----------------------------------------------------------------------
+// Local Functions
+//-----------------------------------------------------------------------
+static void power_account(power_mode_t mode, uint32_t ticks)
+{
+    uint32_t total;
+
+    powerModeTicks[mode] += ticks;
+    g_power.modeTimeMs[mode] += powerModeTicks[mode] / powerTicksPerMs;
+    powerModeTicks[mode] %= powerTicksPerMs;
+
+    powerWindowTicks[mode] += ticks;
+    total = powerWindowTicks[POWER_MODE_RUN] + powerWindowTicks[POWER_MODE_SLEEP];
+    if (total >= (powerTicksPerMs * POWER_WINDOW_MS))
+    {
+        g_power.dutyCyclePercent = (uint32_t)(((uint64_t)powerWindowTicks[POWER_MODE_RUN] * 100U) / total);
+        powerWindowTicks[POWER_MODE_RUN] = 0U;
+        powerWindowTicks[POWER_MODE_SLEEP] = 0U;
+    }
+}
+
+//-----------------------------------------------------------------------
+// Functions
+//-----------------------------------------------------------------------
+void POWER_Init(void)
+{
+    uint32_t coreClk = CLOCK_GetFreq(kCLOCK_CoreSysClk);
+
+    powerTicksPerUs = coreClk / 1000000U;
+    powerTicksPerMs = coreClk / 1000U;
+    powerTickReload = powerTicksPerUs * POWER_TICK_US;
+
+    /* Keep the interrupt and clock source set by BOARD_SystickEnable(), only shorten the period */
+    SysTick->LOAD = powerTickReload - 1U;
+    SysTick->VAL = 0U;
+
+    /* Plain Sleep on WFI, Deep Sleep would stop SysTick */
+    SCB->SCR &= ~SCB_SCR_SLEEPDEEP_Msk;
+
+    powerLastTicks = POWER_GetTicks();
+    g_power.dutyCyclePercent = 100U;
+}
+
+uint32_t POWER_GetTicks(void)
+{
+    uint32_t periods;
+    uint32_t value;
+
+    /* Retry when the tick interrupt ran between the two reads */
+    do
+    {
+        periods = g_ovf_counter;
+        value = SysTick->VAL;
+    } while (periods != g_ovf_counter);
+
+    return (periods * powerTickReload) + (powerTickReload - 1U - value);
+}
+
+uint32_t POWER_GetSamplePeriodUs(void)
+{
+    uint32_t periodUs = powerSamplePeriodUs;
+
+    if (periodUs > POWER_MAX_SAMPLE_PERIOD_US)
+    {
+        periodUs = POWER_MAX_SAMPLE_PERIOD_US;
+        powerSamplePeriodUs = periodUs;
+    }
+
+    return periodUs;
+}
+
+void POWER_Idle(uint32_t wakeTicks)
+{
+    uint32_t now = POWER_GetTicks();
+    uint32_t primask;
+
+    power_account(POWER_MODE_RUN, now - powerLastTicks);
+    powerLastTicks = now;
+
+    if ((powerSleepEnable == 0U) || ((int32_t)(now - wakeTicks) >= 0))
+    {
+        return;
+    }
+
+    /* An interrupt arriving after the check is left pending and makes WFI return at once */
+    primask = DisableGlobalIRQ();
+    __DSB();
+    __WFI();
+    __ISB();
+    EnableGlobalIRQ(primask);
+
+    /* The wake-up interrupt has been served, the tick count is consistent again */
+    now = POWER_GetTicks();
+    power_account(POWER_MODE_SLEEP, now - powerLastTicks);
+    powerLastTicks = now;
+    g_power.sleepCount++;
+}
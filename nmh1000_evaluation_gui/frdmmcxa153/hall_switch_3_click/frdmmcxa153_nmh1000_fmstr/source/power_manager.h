@@ -0,0 +1,106 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file power_manager.h
+ * @brief The power_manager.h file declares the sample pacing and low-power idle of the main loop.
+ *
+ * @details SysTick is reprogrammed to interrupt every POWER_TICK_US and serves both as the wake timer
+ *          and as the time base (POWER_GetTicks(), core clock ticks). When no task is ready the
+ *          scheduler calls POWER_Idle() with the time of the next release, which puts the core to
+ *          Sleep with WFI. Sleep is the deepest mode that keeps all wake sources alive: SysTick is a core
+ *          peripheral and stops in Deep Sleep, and the LPUART, I2C and GPIO keep their clocks, so a
+ *          FreeMASTER start bit wakes the core immediately and is decoded by the UART interrupt
+ *          (FMSTR_LONG_INTR). Requests that need the main loop are served at most one loop pass
+ *          later. Statistics are published in FreeMASTER TSA table power_table. powerSamplePeriodUs is
+ *          the period of the sampling task, it is kept here as the sample rate decides the duty cycle.
+ */
+
+#ifndef POWER_MANAGER_H_
+#define POWER_MANAGER_H_
+
+/* Standard C Includes */
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "fsl_common.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief SysTick wake-up period in microseconds, sets the sample period resolution. */
+#define POWER_TICK_US (1000U)
+
+/*! @brief Sample period after start-up, can be changed by the host through powerSamplePeriodUs. */
+#define POWER_DEFAULT_SAMPLE_PERIOD_US (1000U)
+
+/*! @brief Longest sample period, a period in core clock ticks must stay below half the 32-bit tick range
+ *         (14.3 s at 150 MHz). Longer host settings are clamped by POWER_GetSamplePeriodUs(). */
+#define POWER_MAX_SAMPLE_PERIOD_US (10000000U)
+
+/*! @brief Duty cycle measurement window in milliseconds. */
+#define POWER_WINDOW_MS (1000U)
+
+/*! @brief Power modes the main loop can be in. */
+typedef enum
+{
+    POWER_MODE_RUN = 0, /*!< Core running. */
+    POWER_MODE_SLEEP,   /*!< Core clock gated (WFI), peripherals running. */
+    POWER_MODE_COUNT
+} power_mode_t;
+
+/*! @brief This structure defines the power statistics. */
+typedef struct
+{
+    uint32_t dutyCyclePercent;             /*!< Share of the last window spent in POWER_MODE_RUN. */
+    uint32_t modeTimeMs[POWER_MODE_COUNT]; /*!< Time spent in each mode since start-up. */
+    uint32_t sleepCount;                   /*!< Number of sleep entries. */
+} power_stats_t;
+
+/*! @brief Power statistics. */
+extern power_stats_t g_power;
+
+/*! @brief Sample period in microseconds, 0 samples on every scheduler pass and never sleeps.
+ *         Read it through POWER_GetSamplePeriodUs(), the host may write any value. */
+extern volatile uint32_t powerSamplePeriodUs;
+
+/*! @brief Set to 0 to keep the core running between samples. */
+extern volatile uint8_t powerSleepEnable;
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+/*! @brief       Reprogram SysTick as the wake-up tick and start the statistics.
+ *  @return      void.
+ *  @constraints Call after BOARD_SystickEnable() and before any SysTick time measurement.
+ *  @reeentrant  No
+ */
+void POWER_Init(void);
+
+/*! @brief       Current time in core clock ticks, keeps counting in Sleep.
+ *  @return      free-running tick count, use differences only.
+ *  @constraints Call with interrupts enabled.
+ *  @reeentrant  Yes
+ */
+uint32_t POWER_GetTicks(void);
+
+/*! @brief       Sample period set by the host, clamped to POWER_MAX_SAMPLE_PERIOD_US.
+ *  @return      sample period in microseconds.
+ *  @constraints A clamped value is written back to powerSamplePeriodUs so the host sees it.
+ *  @reeentrant  No
+ */
+uint32_t POWER_GetSamplePeriodUs(void);
+
+/*! @brief       Sleep until the next interrupt unless wakeTicks has already been reached.
+ *  @param[in]   wakeTicks  POWER_GetTicks() time of the next task release.
+ *  @return      void.
+ *  @constraints Call from the scheduler idle hook with interrupts enabled.
+ *  @reeentrant  No
+ */
+void POWER_Idle(uint32_t wakeTicks);
+
+#endif // POWER_MANAGER_H_
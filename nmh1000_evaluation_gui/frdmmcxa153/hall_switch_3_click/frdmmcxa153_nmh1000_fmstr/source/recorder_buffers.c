@@ -0,0 +1,132 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file  recorder_buffers.c
+ * @brief The recorder_buffers.c file implements the runtime-sized FreeMASTER recorder buffers.
+ */
+
+//-----------------------------------------------------------------------
+// SDK Includes
+//-----------------------------------------------------------------------
+#include "fsl_common.h"
+#include "freemaster.h"
+
+#include "recorder_buffers.h"
+
+//-----------------------------------------------------------------------
+// Global Variables
+//-----------------------------------------------------------------------
+/*! @brief Recorder buffer sizes, read-only for the host, REC_BUFFERS_APPCMD_SIZE changes them. */
+rec_buffers_t recBuffers;
+
+/*! @brief Recorder buffer sizes published to FreeMASTER. */
+FMSTR_TSA_TABLE_BEGIN(rec_buffers_table)
+    FMSTR_TSA_STRUCT(rec_buffers_t)
+    FMSTR_TSA_MEMBER(rec_buffers_t, size, FMSTR_TSA_UINT32)
+    FMSTR_TSA_MEMBER(rec_buffers_t, region, FMSTR_TSA_UINT32)
+
+    FMSTR_TSA_RO_VAR(recBuffers, FMSTR_TSA_USERTYPE(rec_buffers_t))
+FMSTR_TSA_TABLE_END()
+
+//-----------------------------------------------------------------------
+// Local Variables
+//-----------------------------------------------------------------------
+/* Left uninitialized by the startup code, FMSTR_RecorderCreate() clears the part it takes */
+static uint8_t recBuffer0[REC_BUFFERS_REGION_0] __attribute__((section(REC_BUFFERS_SECTION_0), aligned(4)));
+static uint8_t recBuffer1[REC_BUFFERS_REGION_1] __attribute__((section(REC_BUFFERS_SECTION_1), aligned(4)));
+
+static uint8_t *const recRegions[REC_BUFFERS_COUNT] = {recBuffer0, recBuffer1};
+
+/* Recorder 0 samples the primary sensor, recorder 1 any sensor of the array read in the sample task */
+static FMSTR_CHAR *const recNames[REC_BUFFERS_COUNT] = {"Primary sensor sample", "Sensor array sample"};
+
+//-----------------------------------------------------------------------
+// Local Functions
+//-----------------------------------------------------------------------
+/* Runs in the FreeMASTER communication context (UART interrupt in FMSTR_LONG_INTR mode) */
+static FMSTR_APPCMD_RESULT rec_buffers_command(FMSTR_APPCMD_CODE code, FMSTR_APPCMD_PDATA pdata, FMSTR_SIZE size)
+{
+    uint32_t requested;
+    uint32_t granted = 0U;
+    uint8_t response[4];
+    uint8_t result;
+
+    (void)code;
+
+    if (size != 5U)
+    {
+        return REC_BUFFERS_RESULT_INVALID;
+    }
+
+    requested = (uint32_t)pdata[1] | ((uint32_t)pdata[2] << 8) | ((uint32_t)pdata[3] << 16) |
+                ((uint32_t)pdata[4] << 24);
+    result = REC_BUFFERS_Resize(pdata[0], requested, &granted);
+
+    /* The host learns the size the recorder really got, little-endian as the request */
+    response[0] = (uint8_t)granted;
+    response[1] = (uint8_t)(granted >> 8);
+    response[2] = (uint8_t)(granted >> 16);
+    response[3] = (uint8_t)(granted >> 24);
+    FMSTR_AppCmdSetResponseData((FMSTR_ADDR)response, sizeof(response));
+    return result;
+}
+
+//-----------------------------------------------------------------------
+// Functions
+//-----------------------------------------------------------------------
+bool REC_BUFFERS_Init(void)
+{
+    bool ok = true;
+
+    recBuffers.region[0] = REC_BUFFERS_REGION_0;
+    recBuffers.region[1] = REC_BUFFERS_REGION_1;
+
+    for (uint8_t i = 0U; i < REC_BUFFERS_COUNT; i++)
+    {
+        ok = (REC_BUFFERS_Resize(i, recBuffers.region[i], NULL) == REC_BUFFERS_RESULT_OK) && ok;
+    }
+
+    (void)FMSTR_RegisterAppCmdCall(REC_BUFFERS_APPCMD_SIZE, rec_buffers_command);
+    return ok;
+}
+
+uint8_t REC_BUFFERS_Resize(uint8_t recIndex, uint32_t size, uint32_t *pSize)
+{
+    FMSTR_REC_BUFF buffCfg;
+    uint8_t result = REC_BUFFERS_RESULT_OK;
+
+    if ((recIndex >= REC_BUFFERS_COUNT) || (size < REC_BUFFERS_MIN_SIZE))
+    {
+        return REC_BUFFERS_RESULT_INVALID;
+    }
+
+    /* Larger requests get what the region holds */
+    if (size > recBuffers.region[recIndex])
+    {
+        size   = recBuffers.region[recIndex];
+        result = REC_BUFFERS_RESULT_CLAMPED;
+    }
+
+    buffCfg.addr          = (FMSTR_ADDR)recRegions[recIndex];
+    buffCfg.size          = (FMSTR_SIZE)size;
+    buffCfg.basePeriod_ns = FMSTR_REC_TIMEBASE;
+    buffCfg.name          = recNames[recIndex];
+
+    /* Refused only while the recorder runs, the host stops it first */
+    if (!FMSTR_RecorderCreate((FMSTR_INDEX)recIndex, &buffCfg))
+    {
+        return REC_BUFFERS_RESULT_BUSY;
+    }
+
+    recBuffers.size[recIndex] = size;
+    if (pSize != NULL)
+    {
+        *pSize = size;
+    }
+    return result;
+}
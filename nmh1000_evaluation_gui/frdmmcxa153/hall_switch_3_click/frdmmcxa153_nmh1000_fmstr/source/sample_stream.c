@@ -0,0 +1,189 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file  sample_stream.c
+ * @brief The sample_stream.c file implements the binary framed sample stream.
+ */
+
+//-----------------------------------------------------------------------
+// SDK Includes
+//-----------------------------------------------------------------------
+#include <string.h>
+
+#include "sample_stream.h"
+
+//-----------------------------------------------------------------------
+// Local Functions
+//-----------------------------------------------------------------------
+/* Free bytes in the ring, the open frame counts as used. */
+static uint16_t sample_stream_free(sample_stream_t *pStream)
+{
+    uint16_t used = (uint16_t)(pStream->ring.wp - pStream->ring.rp);
+
+    return (uint16_t)(SAMPLE_STREAM_RING_SIZE - used - pStream->frameLen);
+}
+
+/* Store one byte beyond the published part of the ring. */
+static void sample_stream_put8(sample_stream_t *pStream, uint16_t pos, uint8_t value)
+{
+    pStream->buffer[(uint16_t)(pStream->ring.wp + pos) & (SAMPLE_STREAM_RING_SIZE - 1U)] = value;
+}
+
+static void sample_stream_put16(sample_stream_t *pStream, uint16_t pos, uint16_t value)
+{
+    sample_stream_put8(pStream, pos, (uint8_t)value);
+    sample_stream_put8(pStream, pos + 1U, (uint8_t)(value >> 8));
+}
+
+static void sample_stream_put32(sample_stream_t *pStream, uint16_t pos, uint32_t value)
+{
+    sample_stream_put16(pStream, pos, (uint16_t)value);
+    sample_stream_put16(pStream, pos + 2U, (uint16_t)(value >> 16));
+}
+
+static void sample_stream_header(sample_stream_t *pStream, uint8_t type, uint32_t timestamp)
+{
+    sample_stream_put8(pStream, 0U, SAMPLE_STREAM_SYNC);
+    sample_stream_put8(pStream, 1U, type);
+    sample_stream_put16(pStream, 2U, pStream->seq++);
+    sample_stream_put32(pStream, 4U, timestamp);
+    sample_stream_put8(pStream, 8U, 0U);
+}
+
+/* Make len bytes following ring.wp visible to the pipe. */
+static void sample_stream_publish(sample_stream_t *pStream, uint16_t len)
+{
+    pStream->ring.wp += len;
+    pStream->frameLen = 0U;
+    pStream->frameCount = 0U;
+}
+
+static void sample_stream_close(sample_stream_t *pStream)
+{
+    if (pStream->frameLen == 0U)
+    {
+        return;
+    }
+
+    sample_stream_put8(pStream, 8U, pStream->frameCount);
+    pStream->framesSent++;
+    pStream->samplesSent += pStream->frameCount;
+    sample_stream_publish(pStream, pStream->frameLen);
+}
+
+/* Emit the overrun marker and open a new DATA frame, false when there is no room yet. */
+static bool sample_stream_open(sample_stream_t *pStream, uint32_t timestamp)
+{
+    uint16_t need = SAMPLE_STREAM_FRAME_MAX_SIZE;
+
+    if (pStream->pendingLost != 0U)
+    {
+        need += SAMPLE_STREAM_GAP_SIZE;
+    }
+
+    if (sample_stream_free(pStream) < need)
+    {
+        return false;
+    }
+
+    if (pStream->pendingLost != 0U)
+    {
+        sample_stream_header(pStream, SAMPLE_STREAM_FRAME_GAP, pStream->pendingLostTimestamp);
+        sample_stream_put32(pStream, SAMPLE_STREAM_HEADER_SIZE, pStream->pendingLost);
+        sample_stream_publish(pStream, SAMPLE_STREAM_GAP_SIZE);
+        pStream->pendingLost = 0U;
+    }
+
+    sample_stream_header(pStream, SAMPLE_STREAM_FRAME_DATA, timestamp);
+    pStream->frameLen = SAMPLE_STREAM_HEADER_SIZE;
+    pStream->frameCount = 0U;
+    pStream->baseTimestamp = timestamp;
+    pStream->lastTimestamp = timestamp;
+
+    return true;
+}
+
+//-----------------------------------------------------------------------
+// Functions
+//-----------------------------------------------------------------------
+bool SAMPLE_STREAM_Init(sample_stream_t *pStream)
+{
+    memset(pStream, 0, sizeof(*pStream));
+    pStream->ring.buff = (FMSTR_ADDR)pStream->buffer;
+    pStream->ring.size = SAMPLE_STREAM_RING_SIZE;
+
+    /* No receive direction and no private transmit buffer, data is sent straight from the ring */
+    pStream->pipe = FMSTR_PipeOpen(SAMPLE_STREAM_PIPE_PORT, NULL, NULL, 0, NULL, 0,
+                                   FMSTR_PIPE_MODE_UINT | FMSTR_PIPE_SIZE_1B, "samples");
+    if (pStream->pipe == NULL)
+    {
+        return false;
+    }
+
+    if (FMSTR_PipeAttachTxRing(pStream->pipe, &pStream->ring) == FMSTR_FALSE)
+    {
+        FMSTR_PipeClose(pStream->pipe);
+        pStream->pipe = NULL;
+        return false;
+    }
+
+    return true;
+}
+
+void SAMPLE_STREAM_Push(sample_stream_t *pStream, uint32_t timestamp, uint8_t value)
+{
+    uint32_t delta;
+
+    if (pStream->pipe == NULL)
+    {
+        return;
+    }
+
+    /* Delta must fit the 16-bit record field, otherwise start a frame with a new base */
+    if (pStream->frameLen != 0U)
+    {
+        delta = timestamp - pStream->lastTimestamp;
+        if (delta > UINT16_MAX)
+        {
+            sample_stream_close(pStream);
+        }
+    }
+
+    if (pStream->frameLen == 0U)
+    {
+        if (!sample_stream_open(pStream, timestamp))
+        {
+            if (pStream->pendingLost == 0U)
+            {
+                pStream->pendingLostTimestamp = timestamp;
+            }
+            pStream->pendingLost++;
+            pStream->samplesLost++;
+            return;
+        }
+    }
+
+    sample_stream_put16(pStream, pStream->frameLen, (uint16_t)(timestamp - pStream->lastTimestamp));
+    sample_stream_put8(pStream, pStream->frameLen + 2U, value);
+    pStream->frameLen += SAMPLE_STREAM_RECORD_SIZE;
+    pStream->frameCount++;
+    pStream->lastTimestamp = timestamp;
+
+    if (pStream->frameCount >= SAMPLE_STREAM_MAX_SAMPLES)
+    {
+        sample_stream_close(pStream);
+    }
+}
+
+void SAMPLE_STREAM_Flush(sample_stream_t *pStream, uint32_t timestamp)
+{
+    if ((pStream->frameLen != 0U) && ((timestamp - pStream->baseTimestamp) >= SAMPLE_STREAM_MAX_FRAME_AGE_US))
+    {
+        sample_stream_close(pStream);
+    }
+}
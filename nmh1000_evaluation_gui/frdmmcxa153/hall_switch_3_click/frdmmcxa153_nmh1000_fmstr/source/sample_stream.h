@@ -0,0 +1,119 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file sample_stream.h
+ * @brief The sample_stream.h file declares the binary framed sample stream sent to the host over a
+ *        FreeMASTER pipe.
+ *
+ * @details All multi-byte fields are little-endian and unaligned. Every frame starts with a 9-byte header:
+ *
+ *          | Offset | Size | Field                                                        |
+ *          |--------|------|--------------------------------------------------------------|
+ *          | 0      | 1    | sync, SAMPLE_STREAM_SYNC                                     |
+ *          | 1      | 1    | type, SAMPLE_STREAM_FRAME_xxx                                |
+ *          | 2      | 2    | sequence number, incremented for every frame emitted         |
+ *          | 4      | 4    | base timestamp [us] of the first sample (or first lost one)  |
+ *          | 8      | 1    | record count                                                 |
+ *
+ *          A DATA frame is followed by <count> 3-byte records {u16 delta time [us] to the previous sample,
+ *          u8 value}; the delta of the first record is 0. A GAP frame has count 0 and is followed by a u32
+ *          number of samples dropped because the pipe ring was full, so the host can account for loss exactly.
+ */
+
+#ifndef SAMPLE_STREAM_H_
+#define SAMPLE_STREAM_H_
+
+/* Standard C Includes */
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "freemaster.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief FreeMASTER pipe port carrying the sample stream. */
+#define SAMPLE_STREAM_PIPE_PORT (0x20U)
+
+/*! @brief Size of the transmit ring in bytes, must be a power of two. */
+#define SAMPLE_STREAM_RING_SIZE (512U)
+
+/*! @brief Maximum number of records in one DATA frame. */
+#define SAMPLE_STREAM_MAX_SAMPLES (32U)
+
+/*! @brief A DATA frame is closed when its first sample gets older than this, limiting stream latency. */
+#define SAMPLE_STREAM_MAX_FRAME_AGE_US (20000U)
+
+#define SAMPLE_STREAM_SYNC        (0xA5U)
+#define SAMPLE_STREAM_HEADER_SIZE (9U)
+#define SAMPLE_STREAM_RECORD_SIZE (3U)
+#define SAMPLE_STREAM_GAP_SIZE    (SAMPLE_STREAM_HEADER_SIZE + 4U)
+#define SAMPLE_STREAM_FRAME_MAX_SIZE \
+    (SAMPLE_STREAM_HEADER_SIZE + (SAMPLE_STREAM_MAX_SAMPLES * SAMPLE_STREAM_RECORD_SIZE))
+
+/*! @brief Frame types. */
+enum
+{
+    SAMPLE_STREAM_FRAME_DATA = 0x01, /*!< Sample records follow the header. */
+    SAMPLE_STREAM_FRAME_GAP  = 0x02, /*!< Producer overrun marker, u32 lost sample count follows the header. */
+};
+
+/*! @brief This structure defines the sample stream state.
+ *  @details The open DATA frame is assembled in place in the pipe ring beyond ring.wp and only becomes
+ *           visible to the pipe when the frame is closed and ring.wp is advanced over it.
+ */
+typedef struct
+{
+    FMSTR_PIPE_RING ring;                    /*!< Transmit ring attached to the pipe. */
+    FMSTR_HPIPE pipe;                        /*!< Pipe handle, NULL when the pipe could not be opened. */
+    uint8_t buffer[SAMPLE_STREAM_RING_SIZE]; /*!< Ring storage. */
+    uint16_t frameLen;                       /*!< Bytes written to the open frame, 0 when no frame is open. */
+    uint8_t frameCount;                      /*!< Records in the open frame. */
+    uint16_t seq;                            /*!< Sequence number of the next frame. */
+    uint32_t baseTimestamp;                  /*!< Timestamp of the first sample in the open frame. */
+    uint32_t lastTimestamp;                  /*!< Timestamp of the last sample in the open frame. */
+    uint32_t pendingLost;                    /*!< Samples dropped since the last GAP frame. */
+    uint32_t pendingLostTimestamp;           /*!< Timestamp of the first sample counted in pendingLost. */
+    uint32_t framesSent;                     /*!< DATA frames published. */
+    uint32_t samplesSent;                    /*!< Samples published. */
+    uint32_t samplesLost;                    /*!< Samples dropped in total. */
+} sample_stream_t;
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+/*! @brief       Open the sample stream pipe and attach the stream ring to it.
+ *  @param[in]   pStream  pointer to the stream.
+ *  @return      true on success, false when the pipe could not be opened.
+ *  @constraints Must be called after FMSTR_Init().
+ *  @reeentrant  No
+ */
+bool SAMPLE_STREAM_Init(sample_stream_t *pStream);
+
+/*! @brief       Append one sample to the stream.
+ *  @details     Samples are dropped and counted when the ring has no room for a new frame; a GAP frame
+ *               is emitted as soon as room is available again.
+ *  @param[in]   pStream    pointer to the stream.
+ *  @param[in]   timestamp  sample timestamp in microseconds (free-running, wraps at 2^32).
+ *  @param[in]   value      sample value.
+ *  @return      void.
+ *  @constraints Must be called from a single context.
+ *  @reeentrant  No
+ */
+void SAMPLE_STREAM_Push(sample_stream_t *pStream, uint32_t timestamp, uint8_t value);
+
+/*! @brief       Publish the open frame if it is older than SAMPLE_STREAM_MAX_FRAME_AGE_US.
+ *  @param[in]   pStream    pointer to the stream.
+ *  @param[in]   timestamp  current time in microseconds.
+ *  @return      void.
+ *  @constraints Must be called from the same context as SAMPLE_STREAM_Push().
+ *  @reeentrant  No
+ */
+void SAMPLE_STREAM_Flush(sample_stream_t *pStream, uint32_t timestamp);
+
+#endif // SAMPLE_STREAM_H_
@@ -0,0 +1,293 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file  task_scheduler.c
+ * @brief The task_scheduler.c file implements the cooperative run-to-completion task scheduler.
+ */
+
+//-----------------------------------------------------------------------
+// SDK Includes
+//-----------------------------------------------------------------------
+#include <string.h>
+#include "fsl_common.h"
+#include "freemaster.h"
+
+#include "cycle_profiler.h"
+#include "power_manager.h"
+#include "task_scheduler.h"
+
+//-----------------------------------------------------------------------
+// Global Variables
+//-----------------------------------------------------------------------
+sched_task_t g_schedTasks[SCHED_MAX_TASKS];
+
+/*! @brief Number of tasks in g_schedTasks. */
+uint8_t schedTaskCount;
+
+/*! @brief Tasks run from SCHED_Yield() while an I2C transfer completed. */
+uint32_t schedYieldRuns;
+
+/*! @brief Written to non-zero by the host to clear the task statistics. */
+volatile uint8_t schedReset;
+
+/*! @brief Task table published to FreeMASTER. */
+FMSTR_TSA_TABLE_BEGIN(sched_table)
+    FMSTR_TSA_STRUCT(sched_task_t)
+    FMSTR_TSA_MEMBER(sched_task_t, periodUs, FMSTR_TSA_UINT32)
+    FMSTR_TSA_MEMBER(sched_task_t, deadlineUs, FMSTR_TSA_UINT32)
+    FMSTR_TSA_MEMBER(sched_task_t, priority, FMSTR_TSA_UINT8)
+    FMSTR_TSA_MEMBER(sched_task_t, runs, FMSTR_TSA_UINT32)
+    FMSTR_TSA_MEMBER(sched_task_t, deadlineMisses, FMSTR_TSA_UINT32)
+    FMSTR_TSA_MEMBER(sched_task_t, skippedPeriods, FMSTR_TSA_UINT32)
+    FMSTR_TSA_MEMBER(sched_task_t, maxResponseUs, FMSTR_TSA_UINT32)
+
+    FMSTR_TSA_RO_VAR(g_schedTasks, FMSTR_TSA_USERTYPE(sched_task_t))
+    FMSTR_TSA_RO_VAR(schedTaskCount, FMSTR_TSA_UINT8)
+    FMSTR_TSA_RO_VAR(schedYieldRuns, FMSTR_TSA_UINT32)
+    FMSTR_TSA_RW_VAR(schedReset, FMSTR_TSA_UINT8)
+FMSTR_TSA_TABLE_END()
+
+//-----------------------------------------------------------------------
+// Local Variables
+//-----------------------------------------------------------------------
+static uint32_t schedTicksPerUs;
+static bool schedStarted;
+static uint32_t schedNestedTicks; /* time of the runs dispatched from SCHED_Yield(), differences only */
+
+//-----------------------------------------------------------------------
+// Local Functions
+//-----------------------------------------------------------------------
+/* Releases are compared as signed tick differences, longer times saturate at half the tick range */
+static uint32_t sched_us_to_ticks(uint32_t us)
+{
+    uint64_t ticks = (uint64_t)us * schedTicksPerUs;
+
+    return (ticks > (uint64_t)INT32_MAX) ? (uint32_t)INT32_MAX : (uint32_t)ticks;
+}
+
+static void sched_set_timing(sched_task_t *pTask, uint32_t now)
+{
+    pTask->periodTicks = sched_us_to_ticks(pTask->periodUs);
+    pTask->deadlineTicks = sched_us_to_ticks((pTask->deadlineUs != 0U) ? pTask->deadlineUs : pTask->periodUs);
+    pTask->releaseTicks = now + pTask->periodTicks;
+}
+
+static void sched_reset_stats(void)
+{
+    for (uint8_t i = 0; i < schedTaskCount; i++)
+    {
+        g_schedTasks[i].runs = 0U;
+        g_schedTasks[i].deadlineMisses = 0U;
+        g_schedTasks[i].skippedPeriods = 0U;
+        g_schedTasks[i].maxResponseUs = 0U;
+    }
+    schedYieldRuns = 0U;
+}
+
+/* Ready task with the lowest priority number, ties go to the task added first */
+static int32_t sched_select(uint32_t now, bool yielding)
+{
+    int32_t best = -1;
+
+    for (uint8_t i = 0; i < schedTaskCount; i++)
+    {
+        const sched_task_t *pTask = &g_schedTasks[i];
+
+        if (pTask->running || (yielding && ((pTask->flags & SCHED_FLAG_USES_BUS) != 0U)))
+        {
+            continue;
+        }
+        if (!pTask->pending && ((int32_t)(now - pTask->releaseTicks) < 0))
+        {
+            continue;
+        }
+        if ((best < 0) || (pTask->priority < g_schedTasks[best].priority))
+        {
+            best = (int32_t)i;
+        }
+    }
+
+    return best;
+}
+
+static void sched_dispatch(int32_t index, uint32_t now)
+{
+    sched_task_t *pTask = &g_schedTasks[index];
+    uint32_t nestedBefore;
+    uint32_t release;
+    uint32_t response;
+
+    if ((int32_t)(now - pTask->releaseTicks) >= 0)
+    {
+        release = pTask->releaseTicks;
+        if (pTask->periodTicks != 0U)
+        {
+            /* Catch up to the latest release, the ones in between are lost */
+            uint32_t behind = (now - release) / pTask->periodTicks;
+
+            pTask->skippedPeriods += behind;
+            release += behind * pTask->periodTicks;
+            pTask->releaseTicks = release + pTask->periodTicks;
+        }
+        else
+        {
+            release = now;
+            pTask->releaseTicks = now;
+        }
+    }
+    else
+    {
+        release = pTask->triggerTicks;
+    }
+    pTask->pending = false;
+
+    nestedBefore = schedNestedTicks;
+    PROF_BEGIN(PROF_MAIN_LOOP);
+    pTask->running = true;
+    pTask->pFunction(pTask->pParam);
+    pTask->running = false;
+    PROF_END(PROF_MAIN_LOOP);
+
+    /* Tasks run from SCHED_Yield() inside this one are charged to themselves only */
+    response = (POWER_GetTicks() - release) - (schedNestedTicks - nestedBefore);
+    pTask->runs++;
+    if ((pTask->deadlineTicks != 0U) && (response > pTask->deadlineTicks))
+    {
+        pTask->deadlineMisses++;
+    }
+    response /= schedTicksPerUs;
+    if (response > pTask->maxResponseUs)
+    {
+        pTask->maxResponseUs = response;
+    }
+}
+
+static uint32_t sched_next_release(uint32_t now)
+{
+    uint32_t wake = now + (UINT32_MAX / 2U);
+
+    for (uint8_t i = 0; i < schedTaskCount; i++)
+    {
+        if ((int32_t)(g_schedTasks[i].releaseTicks - wake) < 0)
+        {
+            wake = g_schedTasks[i].releaseTicks;
+        }
+    }
+
+    return wake;
+}
+
+//-----------------------------------------------------------------------
+// Functions
+//-----------------------------------------------------------------------
+void SCHED_Init(void)
+{
+    memset(g_schedTasks, 0, sizeof(g_schedTasks));
+    schedTaskCount = 0U;
+    schedYieldRuns = 0U;
+    schedStarted = false;
+    schedTicksPerUs = CLOCK_GetFreq(kCLOCK_CoreSysClk) / 1000000U;
+}
+
+int32_t SCHED_AddTask(
+    sched_task_fn_t pFunction, void *pParam, uint32_t periodUs, uint32_t deadlineUs, uint8_t priority, uint8_t flags)
+{
+    sched_task_t *pTask;
+
+    if ((pFunction == NULL) || (schedTaskCount >= SCHED_MAX_TASKS))
+    {
+        return -1;
+    }
+
+    pTask = &g_schedTasks[schedTaskCount];
+    pTask->pFunction = pFunction;
+    pTask->pParam = pParam;
+    pTask->periodUs = periodUs;
+    pTask->deadlineUs = deadlineUs;
+    pTask->priority = priority;
+    pTask->flags = flags;
+    sched_set_timing(pTask, POWER_GetTicks());
+
+    return (int32_t)schedTaskCount++;
+}
+
+void SCHED_SetPeriod(int32_t task, uint32_t periodUs)
+{
+    sched_task_t *pTask = &g_schedTasks[task];
+
+    if (pTask->periodUs != periodUs)
+    {
+        pTask->periodUs = periodUs;
+        sched_set_timing(pTask, POWER_GetTicks());
+    }
+}
+
+void SCHED_Trigger(int32_t task)
+{
+    sched_task_t *pTask = &g_schedTasks[task];
+
+    if (!pTask->pending)
+    {
+        pTask->triggerTicks = POWER_GetTicks();
+        pTask->pending = true;
+    }
+}
+
+void SCHED_Run(sched_idle_fn_t pIdle)
+{
+    schedStarted = true;
+
+    for (;;)
+    {
+        uint32_t now = POWER_GetTicks();
+        int32_t index;
+
+        if (schedReset != 0U)
+        {
+            sched_reset_stats();
+            schedReset = 0U;
+        }
+
+        index = sched_select(now, false);
+        if (index >= 0)
+        {
+            sched_dispatch(index, now);
+        }
+        else if (pIdle != NULL)
+        {
+            pIdle(sched_next_release(now));
+        }
+    }
+}
+
+void SCHED_Yield(void *pParam)
+{
+    uint32_t now;
+    int32_t index;
+
+    (void)pParam;
+    if (!schedStarted)
+    {
+        return;
+    }
+
+    now = POWER_GetTicks();
+    index = sched_select(now, true);
+    if (index >= 0)
+    {
+        uint32_t nestedBefore = schedNestedTicks;
+        PROF_NESTED_BEGIN();
+
+        schedYieldRuns++;
+        sched_dispatch(index, now);
+
+        /* Runs nested deeper are part of this one already */
+        PROF_NESTED_END();
+        schedNestedTicks = nestedBefore + (POWER_GetTicks() - now);
+    }
+}
@@ -0,0 +1,134 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file task_scheduler.h
+ * @brief The task_scheduler.h file declares the cooperative run-to-completion task scheduler.
+ *
+ * @details Tasks are released periodically (periodUs, 0 releases the task on every pass) or on demand
+ *          by SCHED_Trigger(). SCHED_Run() repeatedly runs the ready task with the lowest priority
+ *          number; when nothing is ready it calls the idle hook with the tick count of the next
+ *          release. Each task must return within its deadline, there is no preemption.
+ *
+ *          A run whose release-to-completion time exceeds the deadline (deadlineUs, 0 uses the
+ *          period) counts as a deadline miss, releases that passed while the task was still behind
+ *          count as skipped periods. The task table is published in FreeMASTER TSA table sched_table
+ *          as g_schedTasks, indexed in the order the tasks were added. Writing schedReset from the host
+ *          clears the statistics.
+ *
+ *          SCHED_Yield() is meant as the ISSDK idle function of the sensor handles
+ *          (NMH1000_I2C_SetIdleTask()): while an I2C transfer completes it runs ready tasks that do
+ *          not use the bus (no SCHED_FLAG_USES_BUS) and are not already running. The time of such a
+ *          nested run is taken out of the response time and the profiler probes of the task it
+ *          interrupted, each task is charged with its own work only.
+ *          Time is taken from POWER_GetTicks().
+ */
+
+#ifndef TASK_SCHEDULER_H_
+#define TASK_SCHEDULER_H_
+
+/* Standard C Includes */
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief Maximum number of tasks. */
+#define SCHED_MAX_TASKS (8U)
+
+/*! @brief The task starts I2C transfers and must not run from SCHED_Yield(). */
+#define SCHED_FLAG_USES_BUS (0x01U)
+
+/*! @brief Task entry, runs to completion. */
+typedef void (*sched_task_fn_t)(void *pParam);
+
+/*! @brief Idle hook, may sleep until wakeTicks (POWER_GetTicks() time) or the next interrupt. */
+typedef void (*sched_idle_fn_t)(uint32_t wakeTicks);
+
+/*! @brief This structure defines one task and its statistics. */
+typedef struct
+{
+    sched_task_fn_t pFunction; /*!< Task entry. */
+    void *pParam;              /*!< Task entry parameter. */
+    uint32_t periodUs;         /*!< Release period, 0 releases on every pass. */
+    uint32_t deadlineUs;       /*!< Relative deadline, 0 uses the period. */
+    uint32_t periodTicks;      /*!< periodUs in ticks. */
+    uint32_t deadlineTicks;    /*!< Effective deadline in ticks, 0 for none. */
+    uint32_t releaseTicks;     /*!< Next periodic release. */
+    uint32_t triggerTicks;     /*!< Time of the pending SCHED_Trigger(). */
+    uint8_t priority;          /*!< 0 is the most urgent. */
+    uint8_t flags;             /*!< SCHED_FLAG_xxx. */
+    volatile bool pending;     /*!< Released by SCHED_Trigger(). */
+    bool running;              /*!< Currently on the call stack. */
+    uint32_t runs;             /*!< Completed runs. */
+    uint32_t deadlineMisses;   /*!< Runs that completed after their deadline. */
+    uint32_t skippedPeriods;   /*!< Periodic releases lost while the task was behind. */
+    uint32_t maxResponseUs;    /*!< Longest release-to-completion time. */
+} sched_task_t;
+
+/*! @brief Task table. */
+extern sched_task_t g_schedTasks[SCHED_MAX_TASKS];
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+/*! @brief       Clear the task table.
+ *  @return      void.
+ *  @constraints Call after POWER_Init().
+ *  @reeentrant  No
+ */
+void SCHED_Init(void);
+
+/*! @brief       Add a task, the first periodic release is one period from now.
+ *  @param[in]   pFunction   task entry.
+ *  @param[in]   pParam      task entry parameter.
+ *  @param[in]   periodUs    release period in microseconds, 0 for every pass.
+ *  @param[in]   deadlineUs  relative deadline in microseconds, 0 uses the period.
+ *  @param[in]   priority    0 is the most urgent.
+ *  @param[in]   flags       SCHED_FLAG_xxx.
+ *  @return      task index, or -1 when the table is full.
+ *  @constraints Call before SCHED_Run().
+ *  @reeentrant  No
+ */
+int32_t SCHED_AddTask(
+    sched_task_fn_t pFunction, void *pParam, uint32_t periodUs, uint32_t deadlineUs, uint8_t priority, uint8_t flags);
+
+/*! @brief       Change the period of a task, restarting its schedule when it differs.
+ *  @param[in]   task      task index.
+ *  @param[in]   periodUs  release period in microseconds, 0 for every pass.
+ *  @return      void.
+ *  @constraints Call from a task or before SCHED_Run().
+ *  @reeentrant  No
+ */
+void SCHED_SetPeriod(int32_t task, uint32_t periodUs);
+
+/*! @brief       Release a task at once, in addition to its periodic releases.
+ *  @param[in]   task  task index.
+ *  @return      void.
+ *  @constraints None
+ *  @reeentrant  No
+ */
+void SCHED_Trigger(int32_t task);
+
+/*! @brief       Run tasks forever, calling the idle hook when nothing is ready.
+ *  @param[in]   pIdle  idle hook, may be NULL.
+ *  @return      Does not return.
+ *  @constraints Call from main() after the tasks were added.
+ *  @reeentrant  No
+ */
+void SCHED_Run(sched_idle_fn_t pIdle);
+
+/*! @brief       Run the ready tasks that do not use the bus, for use as ISSDK idle function.
+ *  @param[in]   pParam  unused.
+ *  @return      void.
+ *  @constraints Does nothing before SCHED_Run().
+ *  @reeentrant  No
+ */
+void SCHED_Yield(void *pParam);
+
+#endif // TASK_SCHEDULER_H_
@@ -16,6 +16,12 @@
 gpioHandleKSDK_t D14 = {.base = GPIO4, .pinNumber = 0, .mask = 1 << (0), .clockName = kCLOCK_Gpio4, .portNumber = 4};
 gpioHandleKSDK_t D15 = {.base = GPIO4, .pinNumber = 1, .mask = 1 << (1), .clockName = kCLOCK_Gpio4, .portNumber = 4};
 
+// I2C3 Pin Handles, the LPI2C3 bus of the click board as GPIO for the bus clear
+/* [PIO1_0] FC3_P0 is I2C SDA */
+gpioHandleKSDK_t I2C3_SDA = {.base = GPIO1, .pinNumber = 0, .mask = 1 << (0), .clockName = kCLOCK_Gpio1, .portNumber = 1};
+/* [PIO1_1] FC3_P1 is I2C SCL */
+gpioHandleKSDK_t I2C3_SCL = {.base = GPIO1, .pinNumber = 1, .mask = 1 << (1), .clockName = kCLOCK_Gpio1, .portNumber = 1};
+
 // SPI1 Handle
 /* [PIO0_20] (coords: 74) configured as SPI master-out/slave-in (MOSI) data */
 gpioHandleKSDK_t D11 = {.base = GPIO0, .pinNumber = 24, .mask = 1 << (24), .clockName = kCLOCK_Gpio0, .portNumber = 0};
@@ -22,6 +22,10 @@
 extern gpioHandleKSDK_t D14;
 extern gpioHandleKSDK_t D15;
 
+// I2C3 Pin Handles
+extern gpioHandleKSDK_t I2C3_SDA;
+extern gpioHandleKSDK_t I2C3_SCL;
+
 // SPI7 Handles
 extern gpioHandleKSDK_t D11;
 extern gpioHandleKSDK_t D12;
@@ -40,8 +44,8 @@ extern gpioHandleKSDK_t GREEN_LED;
 extern gpioHandleKSDK_t BLUE_LED;
 
 // I2C_S1: Pin mapping and driver information for default I2C brought to shield
-#define I2C_S1_SCL_PIN      D15
-#define I2C_S1_SDA_PIN      D14
+#define I2C_S1_SCL_PIN      I2C3_SCL
+#define I2C_S1_SDA_PIN      I2C3_SDA
 #define I2C_S1_DRIVER       Driver_I2C3
 #define I2C_S1_DEVICE_INDEX I2C3_INDEX
 #define I2C_S1_SIGNAL_EVENT I2C3_SignalEvent_t
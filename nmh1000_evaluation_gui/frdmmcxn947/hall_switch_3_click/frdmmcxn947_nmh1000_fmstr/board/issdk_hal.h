@@ -26,7 +26,7 @@
 // Pin mapping and driver information for default I2C brought to shield
 // By default, we use I2C_S1 defined in the lpc55s16.h file.
 // Other options: I2C_S2.
-// S1 is on D15:14.  S2 is on A5:4.
+// S1 is LPI2C3 on PIO1_1:0 (click board).  S2 is on A5:4.
 #define I2C_S_SCL_PIN      I2C_S1_SCL_PIN
 #define I2C_S_SDA_PIN      I2C_S1_SDA_PIN
 #define I2C_S_DRIVER       I2C_S1_DRIVER
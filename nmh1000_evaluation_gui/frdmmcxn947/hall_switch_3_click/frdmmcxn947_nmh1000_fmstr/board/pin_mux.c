@@ -903,6 +903,54 @@ void LPUART4_DeinitPins(void)
     /* PORT1_9 (pin B1) is configured as PIO1_9 */
     PORT_SetPinConfig(PORT1, 9U, &port1_9_pinB1_config);
 }
+/* FUNCTION ************************************************************************************************************
+ *
+ * Function Name : BOARD_InitENETPins
+ * Description   : RMII pins of ENET0 to the on-board LAN8741 PHY, used by the FreeMASTER network build.
+ *                 PORT1_21 is taken over from the FXLS8974CF INTF_SEL setting of BOARD_InitPins().
+ *
+ * END ****************************************************************************************************************/
+void BOARD_InitENETPins(void)
+{
+    /* Enables the clock for PORT1: Enables clock */
+    CLOCK_EnableClock(kCLOCK_Port1);
+
+    /* PORT1_4 is configured as ENET0_TX_CLK */
+    PORT_SetPinMux(PORT1, 4U, kPORT_MuxAlt9);
+    PORT1->PCR[4] |= PORT_PCR_IBE(PCR_IBE_ibe1);
+
+    /* PORT1_5 is configured as ENET0_TXEN */
+    PORT_SetPinMux(PORT1, 5U, kPORT_MuxAlt9);
+    PORT1->PCR[5] |= PORT_PCR_IBE(PCR_IBE_ibe1);
+
+    /* PORT1_6 is configured as ENET0_TXD0 */
+    PORT_SetPinMux(PORT1, 6U, kPORT_MuxAlt9);
+    PORT1->PCR[6] |= PORT_PCR_IBE(PCR_IBE_ibe1);
+
+    /* PORT1_7 is configured as ENET0_TXD1 */
+    PORT_SetPinMux(PORT1, 7U, kPORT_MuxAlt9);
+    PORT1->PCR[7] |= PORT_PCR_IBE(PCR_IBE_ibe1);
+
+    /* PORT1_13 is configured as ENET0_RXDV */
+    PORT_SetPinMux(PORT1, 13U, kPORT_MuxAlt9);
+    PORT1->PCR[13] |= PORT_PCR_IBE(PCR_IBE_ibe1);
+
+    /* PORT1_14 is configured as ENET0_RXD0 */
+    PORT_SetPinMux(PORT1, 14U, kPORT_MuxAlt9);
+    PORT1->PCR[14] |= PORT_PCR_IBE(PCR_IBE_ibe1);
+
+    /* PORT1_15 is configured as ENET0_RXD1 */
+    PORT_SetPinMux(PORT1, 15U, kPORT_MuxAlt9);
+    PORT1->PCR[15] |= PORT_PCR_IBE(PCR_IBE_ibe1);
+
+    /* PORT1_20 is configured as ENET0_MDC */
+    PORT_SetPinMux(PORT1, 20U, kPORT_MuxAlt9);
+    PORT1->PCR[20] |= PORT_PCR_IBE(PCR_IBE_ibe1);
+
+    /* PORT1_21 is configured as ENET0_MDIO */
+    PORT_SetPinMux(PORT1, 21U, kPORT_MuxAlt9);
+    PORT1->PCR[21] |= PORT_PCR_IBE(PCR_IBE_ibe1);
+}
 /***********************************************************************************************************************
  * EOF
  **********************************************************************************************************************/
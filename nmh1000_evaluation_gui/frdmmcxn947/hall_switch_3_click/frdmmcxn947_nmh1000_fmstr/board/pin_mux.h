@@ -76,6 +76,12 @@ void LPUART4_InitPins(void);
  */
 void LPUART4_DeinitPins(void);
 
+/*!
+ * @brief Configures the RMII pins of ENET0.
+ *
+ */
+void BOARD_InitENETPins(void);
+
 #if defined(__cplusplus)
 }
 #endif
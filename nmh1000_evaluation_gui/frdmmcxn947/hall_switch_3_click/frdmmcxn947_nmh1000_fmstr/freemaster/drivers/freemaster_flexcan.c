@@ -50,6 +50,11 @@
 #define FMSTR_FLEXCAN_RXMB 2U
 #endif
 
+/* CAN FD framing needs the module initialized by FLEXCAN_FDInit() with 64 byte message buffers */
+#if FMSTR_CAN_FD > 0 && !(defined(FSL_FEATURE_FLEXCAN_HAS_FLEXIBLE_DATA_RATE) && FSL_FEATURE_FLEXCAN_HAS_FLEXIBLE_DATA_RATE)
+#error "FlexCAN of this device does not support CAN FD, set FMSTR_CAN_FD to 0"
+#endif
+
 /******************************************************************************
  * Local macros
  ******************************************************************************/
@@ -87,7 +92,7 @@ static void _FMSTR_FlexCAN_EnableTxInterrupt(FMSTR_BOOL enable);    /* Enable CA
 static void _FMSTR_FlexCAN_EnableRxInterrupt(FMSTR_BOOL enable);    /* Enable CAN Receive interrupt. */
 static void _FMSTR_FlexCAN_EnableRx(void);                          /* Enable/re-initialize Receiver buffer. */
 static FMSTR_SIZE8 _FMSTR_FlexCAN_GetRxFrameLen(void);              /* Return size of received CAN frame. */
-static FMSTR_BCHR _FMSTR_FlexCAN_GetRxFrameByte(FMSTR_SIZE8 index); /* Get data byte at index (0..8). */
+static FMSTR_BCHR _FMSTR_FlexCAN_GetRxFrameByte(FMSTR_SIZE8 index); /* Get data byte at index (0..7 or 0..63). */
 static void _FMSTR_FlexCAN_AckRxFrame(void);           /* Discard received frame and enable receiving a next one. */
 static FMSTR_BOOL _FMSTR_FlexCAN_PrepareTxFrame(void); /* Initialize transmit buffer. */
 static void _FMSTR_FlexCAN_PutTxFrameByte(FMSTR_SIZE8 index, FMSTR_BCHR data); /* Fill one byte of transmit data. */
@@ -105,8 +110,16 @@ static CAN_Type *fmstr_canBaseAddr = NULL;
 #endif
 
 static flexcan_rx_mb_config_t fmstr_rxcfg; /* MB configuration with Raw ID */
-static flexcan_frame_t fmstr_rxmsg;        /* Received frame buffer, valid when length>0 */
-static flexcan_frame_t fmstr_txmsg;        /* Buffer to prepare transmission */
+#if FMSTR_CAN_FD > 0
+static flexcan_fd_frame_t fmstr_rxmsg; /* Received frame buffer, valid when length (DLC) >0 */
+static flexcan_fd_frame_t fmstr_txmsg; /* Buffer to prepare transmission */
+
+/* CAN FD data length code to the number of data bytes */
+static const FMSTR_U8 fmstr_canFdDlc2Len[16] = {0U, 1U, 2U, 3U, 4U, 5U, 6U, 7U, 8U, 12U, 16U, 20U, 24U, 32U, 48U, 64U};
+#else
+static flexcan_frame_t fmstr_rxmsg; /* Received frame buffer, valid when length>0 */
+static flexcan_frame_t fmstr_txmsg; /* Buffer to prepare transmission */
+#endif
 
 /******************************************************************************
  * Driver interface
@@ -137,7 +150,11 @@ static FMSTR_BOOL _FMSTR_FlexCAN_Init(FMSTR_U32 idRx, FMSTR_U32 idTx)
     fmstr_rxcfg.id     = FMSTR_FCAN_ID2IDR(idRx);
     fmstr_rxcfg.format = (idRx & FMSTR_CAN_EXTID) != 0U ? kFLEXCAN_FrameFormatExtend : kFLEXCAN_FrameFormatStandard;
     fmstr_rxcfg.type   = kFLEXCAN_FrameTypeData;
+#if FMSTR_CAN_FD > 0
+    FLEXCAN_SetFDRxMbConfig(fmstr_canBaseAddr, FMSTR_FLEXCAN_RXMB, &fmstr_rxcfg, false);
+#else
     FLEXCAN_SetRxMbConfig(fmstr_canBaseAddr, FMSTR_FLEXCAN_RXMB, &fmstr_rxcfg, false);
+#endif
 
     /* initialize Tx MB */
     FMSTR_MemSet(&fmstr_txmsg, 0, sizeof(fmstr_txmsg));
@@ -145,7 +162,13 @@ static FMSTR_BOOL _FMSTR_FlexCAN_Init(FMSTR_U32 idRx, FMSTR_U32 idTx)
     fmstr_txmsg.format =
         (FMSTR_U8)((idTx & FMSTR_CAN_EXTID) != 0U ? kFLEXCAN_FrameFormatExtend : kFLEXCAN_FrameFormatStandard);
     fmstr_txmsg.type = (FMSTR_U8)kFLEXCAN_FrameTypeData;
+#if FMSTR_CAN_FD > 0
+    fmstr_txmsg.edl = 1U;
+    fmstr_txmsg.brs = (FMSTR_CAN_FD_BRS > 0) ? 1U : 0U;
+    FLEXCAN_SetFDTxMbConfig(fmstr_canBaseAddr, FMSTR_FLEXCAN_TXMB, true);
+#else
     FLEXCAN_SetTxMbConfig(fmstr_canBaseAddr, FMSTR_FLEXCAN_TXMB, true);
+#endif
 
     {
         /* Make sure the RX Message Buffer is unlocked. */
@@ -183,7 +206,11 @@ static void _FMSTR_FlexCAN_EnableRxInterrupt(FMSTR_BOOL enable)
 static void _FMSTR_FlexCAN_EnableRx(void)
 {
     /* enbale receiving into the MB */
+#if FMSTR_CAN_FD > 0
+    FLEXCAN_SetFDRxMbConfig(fmstr_canBaseAddr, FMSTR_FLEXCAN_RXMB, &fmstr_rxcfg, true);
+#else
     FLEXCAN_SetRxMbConfig(fmstr_canBaseAddr, FMSTR_FLEXCAN_RXMB, &fmstr_rxcfg, true);
+#endif
 }
 
 static FMSTR_SIZE8 _FMSTR_FlexCAN_GetRxFrameLen(void)
@@ -203,7 +230,11 @@ static FMSTR_SIZE8 _FMSTR_FlexCAN_GetRxFrameLen(void)
     if (fmstr_rxmsg.length == 0U)
     {
         /* Try to read data, when successful, the MB is acknowledged and set for next receive */
+#if FMSTR_CAN_FD > 0
+        status_t s = FLEXCAN_ReadFDRxMb(fmstr_canBaseAddr, FMSTR_FLEXCAN_RXMB, &fmstr_rxmsg);
+#else
         status_t s = FLEXCAN_ReadRxMb(fmstr_canBaseAddr, FMSTR_FLEXCAN_RXMB, &fmstr_rxmsg);
+#endif
 
         /* Make sure the RX Message Buffer is unlocked. */
         volatile uint32_t dummy = fmstr_canBaseAddr->TIMER;
@@ -216,11 +247,19 @@ static FMSTR_SIZE8 _FMSTR_FlexCAN_GetRxFrameLen(void)
     }
 
     /* we have got some frame, return its length */
+#if FMSTR_CAN_FD > 0
+    return (FMSTR_SIZE8)fmstr_canFdDlc2Len[fmstr_rxmsg.length & 0x0FU];
+#else
     return (FMSTR_SIZE8)fmstr_rxmsg.length;
+#endif
 }
 
 static FMSTR_BCHR _FMSTR_FlexCAN_GetRxFrameByte(FMSTR_SIZE8 index)
 {
+#if FMSTR_CAN_FD > 0
+    /* the first byte of each data word is its most significant byte */
+    return (FMSTR_BCHR)(fmstr_rxmsg.dataWord[index / 4U] >> (8U * (3U - (index % 4U))));
+#else
     FMSTR_BCHR data;
 
     /* need switch as data bytes are not necessarily ordered in the frame */
@@ -253,6 +292,7 @@ static FMSTR_BCHR _FMSTR_FlexCAN_GetRxFrameByte(FMSTR_SIZE8 index)
     }
 
     return data;
+#endif
 }
 
 static void _FMSTR_FlexCAN_AckRxFrame(void)
@@ -284,13 +324,24 @@ static FMSTR_BOOL _FMSTR_FlexCAN_PrepareTxFrame(void)
 #endif /* FMSTR_POLL_DRIVEN */
 
     /* set as transmit-emtpy MB */
+#if FMSTR_CAN_FD > 0
+    FLEXCAN_SetFDTxMbConfig(fmstr_canBaseAddr, FMSTR_FLEXCAN_TXMB, true);
+#else
     FLEXCAN_SetTxMbConfig(fmstr_canBaseAddr, FMSTR_FLEXCAN_TXMB, true);
+#endif
 
     return FMSTR_TRUE;
 }
 
 static void _FMSTR_FlexCAN_PutTxFrameByte(FMSTR_SIZE8 index, FMSTR_BCHR data)
 {
+#if FMSTR_CAN_FD > 0
+    FMSTR_U32 shift = 8U * (3U - (index % 4U));
+
+    /* the first byte of each data word is its most significant byte */
+    fmstr_txmsg.dataWord[index / 4U] =
+        (fmstr_txmsg.dataWord[index / 4U] & ~(0xFFUL << shift)) | ((FMSTR_U32)data << shift);
+#else
     /* need switch as data bytes are not necessarily ordered in the frame */
     switch (index)
     {
@@ -319,15 +370,29 @@ static void _FMSTR_FlexCAN_PutTxFrameByte(FMSTR_SIZE8 index, FMSTR_BCHR data)
             fmstr_txmsg.dataByte7 = data;
             break;
     }
+#endif
 }
 
 static void _FMSTR_FlexCAN_SendTxFrame(FMSTR_SIZE8 len)
 {
     status_t status;
 
+#if FMSTR_CAN_FD > 0
+    FMSTR_U8 dlc = 0U;
+
+    /* the transport passes valid CAN FD lengths only, find the matching code */
+    while (dlc < 15U && fmstr_canFdDlc2Len[dlc] < len)
+    {
+        dlc++;
+    }
+    fmstr_txmsg.length = dlc;
+
+    status = FLEXCAN_WriteFDTxMb(fmstr_canBaseAddr, FMSTR_FLEXCAN_TXMB, &fmstr_txmsg);
+#else
     fmstr_txmsg.length = len;
 
     status = FLEXCAN_WriteTxMb(fmstr_canBaseAddr, FMSTR_FLEXCAN_TXMB, &fmstr_txmsg);
+#endif
     FMSTR_UNUSED(status);
 }
 
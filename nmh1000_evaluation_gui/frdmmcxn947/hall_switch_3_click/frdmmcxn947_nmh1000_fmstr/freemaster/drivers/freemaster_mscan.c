@@ -34,6 +34,11 @@
 #include "freemaster_can.h"
 #include "fsl_mscan.h"
 
+/* only classic CAN frames are implemented by this driver */
+#if FMSTR_CAN_FD > 0
+#error "The MSCAN driver does not support FMSTR_CAN_FD framing"
+#endif
+
 /******************************************************************************
  * Local macros
  ******************************************************************************/
@@ -0,0 +1,472 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * License: NXP LA_OPT_NXP_Software_License
+ *
+ * NXP Confidential. This software is owned or controlled by NXP and may
+ * only be used strictly in accordance with the applicable license terms.
+ * By expressly accepting such terms or by downloading, installing,
+ * activating and/or otherwise using the software, you are agreeing that
+ * you have read, and that you agree to comply with and are bound by,
+ * such license terms.  If you do not agree to be bound by the applicable
+ * license terms, then you may not retain, install, activate or otherwise
+ * use the software.  This code may only be used in a microprocessor,
+ * microcontroller, sensor or digital signal processor ("NXP Product")
+ * supplied directly or indirectly from NXP.  See the full NXP Software
+ * License Agreement in license/LA_OPT_NXP_Software_License.pdf
+ *
+ * FreeMASTER Communication Driver - Network LWIP TCP driver for the raw API
+ */
+
+#include "freemaster.h"
+#include "freemaster_private.h"
+
+/* Numeric identifier to help pre-processor to identify whether our driver is used or not. */
+#define FMSTR_NET_LWIP_RAW_TCP_ID 1
+
+#if (FMSTR_MK_IDSTR(FMSTR_NET_DRV) == FMSTR_NET_LWIP_RAW_TCP_ID)
+
+#include "freemaster_net_lwip_raw_tcp.h"
+
+#if FMSTR_DISABLE == 0
+
+#include "freemaster_protocol.h"
+#include "freemaster_net.h"
+#include "lwip/opt.h"
+#include "lwip/pbuf.h"
+#include "lwip/tcp.h"
+
+/******************************************************************************
+ * Adapter configuration
+ ******************************************************************************/
+#if (defined(FMSTR_SHORT_INTR) && FMSTR_SHORT_INTR) || (defined(FMSTR_LONG_INTR) && FMSTR_LONG_INTR)
+#error The FreeMASTER network TCP lwip raw driver does not support interrupt mode.
+#endif
+
+#if FMSTR_NET_AUTODISCOVERY != 0
+#error The FreeMASTER network TCP lwip raw driver does not support the autodiscovery.
+#endif
+
+#if FMSTR_NET_BLOCKING_TIMEOUT != 0
+#error The FreeMASTER network TCP lwip raw driver cannot block, set FMSTR_NET_BLOCKING_TIMEOUT to 0.
+#endif
+
+/* santiy check of lwip options */
+#if !LWIP_TCP || !LWIP_CALLBACK_API
+#error The LWIP_TCP and LWIP_CALLBACK_API (lwipopts.h) must be enabled!
+#endif
+
+#if FMSTR_SESSION_COUNT > (MEMP_NUM_TCP_PCB - 1)
+#error The MEMP_NUM_TCP_PCB (lwipopts.h) must be (FMSTR_SESSION_COUNT+1) or higher!
+#endif
+
+/* Size of the largest response frame (header, data and CRC) */
+#define FMSTR_RAW_TCP_FRAME_SIZE (FMSTR_COMM_BUFFER_SIZE + 8)
+
+/******************************************************************************
+ * Local types
+ ******************************************************************************/
+
+typedef struct FMSTR_RAW_TCP_SESSION_S
+{
+    struct tcp_pcb *pcb;
+    struct pbuf *rxData;   /* Received data not yet passed to the protocol */
+    FMSTR_BOOL closed;     /* Remote side closed or the connection failed */
+    FMSTR_NET_ADDR address;
+    FMSTR_SIZE txHead;     /* First response byte waiting for room in the TCP send buffer */
+    FMSTR_SIZE txLen;      /* Response bytes waiting for room in the TCP send buffer */
+    FMSTR_BCHR txData[FMSTR_RAW_TCP_FRAME_SIZE];
+} FMSTR_RAW_TCP_SESSION;
+
+/******************************************************************************
+ * Local functions
+ ******************************************************************************/
+
+static FMSTR_BOOL _FMSTR_NetLwipRawTcpInit(void);
+static void _FMSTR_NetLwipRawTcpPoll(void);
+static FMSTR_S32 _FMSTR_NetLwipRawTcpRecv(FMSTR_BPTR msgBuff,
+                                          FMSTR_SIZE msgMaxSize,
+                                          FMSTR_NET_ADDR *recvAddr,
+                                          FMSTR_BOOL *isBroadcast);
+static FMSTR_S32 _FMSTR_NetLwipRawTcpSend(FMSTR_NET_ADDR *sendAddr, FMSTR_BPTR msgBuff, FMSTR_SIZE msgSize);
+static void _FMSTR_NetLwipRawTcpClose(FMSTR_NET_ADDR *addr);
+static void _FMSTR_NetLwipRawTcpGetCaps(FMSTR_NET_IF_CAPS *caps);
+static err_t _FMSTR_NetLwipRawTcpOnAccept(void *arg, struct tcp_pcb *newPcb, err_t err);
+static err_t _FMSTR_NetLwipRawTcpOnRecv(void *arg, struct tcp_pcb *pcb, struct pbuf *p, err_t err);
+static err_t _FMSTR_NetLwipRawTcpOnSent(void *arg, struct tcp_pcb *pcb, u16_t len);
+static void _FMSTR_NetLwipRawTcpOnError(void *arg, err_t err);
+static void _FMSTR_NetAddrToFmstr(const ip_addr_t *remoteAddr, u16_t remotePort, FMSTR_NET_ADDR *fmstrAddr);
+
+/******************************************************************************
+ * Local variables
+ ******************************************************************************/
+
+/* TCP sessions */
+static FMSTR_RAW_TCP_SESSION fmstrRawTcpSessions[FMSTR_SESSION_COUNT];
+/* TCP listen PCB */
+static struct tcp_pcb *fmstrRawTcpListenPcb = NULL;
+/* Session read first by the next receive, moves on so that a busy client cannot starve the others */
+static FMSTR_INDEX fmstrRawTcpNextRead = 0;
+
+/******************************************************************************
+ * Driver interface
+ ******************************************************************************/
+/* Interface of this network TCP driver */
+const FMSTR_NET_DRV_INTF FMSTR_NET_LWIP_RAW_TCP = {
+    .Init    = _FMSTR_NetLwipRawTcpInit,
+    .Poll    = _FMSTR_NetLwipRawTcpPoll,
+    .Recv    = _FMSTR_NetLwipRawTcpRecv,
+    .Send    = _FMSTR_NetLwipRawTcpSend,
+    .Close   = _FMSTR_NetLwipRawTcpClose,
+    .GetCaps = _FMSTR_NetLwipRawTcpGetCaps,
+};
+
+/******************************************************************************
+ * Implementation
+ ******************************************************************************/
+
+static FMSTR_BOOL _FMSTR_NetLwipRawTcpInit(void)
+{
+    struct tcp_pcb *pcb;
+
+    FMSTR_MemSet(&fmstrRawTcpSessions, 0, sizeof(fmstrRawTcpSessions));
+    fmstrRawTcpNextRead = 0;
+
+    /* Create new listen PCB */
+    pcb = tcp_new_ip_type(IPADDR_TYPE_ANY);
+    if (pcb == NULL)
+    {
+        return FMSTR_FALSE;
+    }
+
+    /* Bind to the FreeMASTER port */
+    if (tcp_bind(pcb, IP_ANY_TYPE, FMSTR_NET_PORT) != ERR_OK)
+    {
+        (void)tcp_close(pcb);
+        return FMSTR_FALSE;
+    }
+
+    /* Listen, the original PCB is freed by lwIP on success */
+    fmstrRawTcpListenPcb = tcp_listen_with_backlog(pcb, FMSTR_SESSION_COUNT);
+    if (fmstrRawTcpListenPcb == NULL)
+    {
+        (void)tcp_close(pcb);
+        return FMSTR_FALSE;
+    }
+
+    tcp_accept(fmstrRawTcpListenPcb, _FMSTR_NetLwipRawTcpOnAccept);
+
+    return FMSTR_TRUE;
+}
+
+static FMSTR_RAW_TCP_SESSION *_FMSTR_NetLwipRawTcpSessionFind(FMSTR_NET_ADDR *sendAddr)
+{
+    FMSTR_INDEX i;
+
+    for (i = 0; i < FMSTR_SESSION_COUNT; i++)
+    {
+        /* Find free session */
+        if (sendAddr == NULL)
+        {
+            if (fmstrRawTcpSessions[i].pcb == NULL && fmstrRawTcpSessions[i].closed == FMSTR_FALSE)
+            {
+                return &fmstrRawTcpSessions[i];
+            }
+        }
+        /* Find session by address */
+        else
+        {
+            if ((fmstrRawTcpSessions[i].pcb != NULL || fmstrRawTcpSessions[i].closed != FMSTR_FALSE) &&
+                FMSTR_MemCmp(&fmstrRawTcpSessions[i].address, sendAddr, sizeof(FMSTR_NET_ADDR)) == 0)
+            {
+                return &fmstrRawTcpSessions[i];
+            }
+        }
+    }
+
+    return NULL;
+}
+
+static void _FMSTR_NetLwipRawTcpFlush(FMSTR_RAW_TCP_SESSION *ses)
+{
+    u16_t room;
+
+    if (ses->pcb == NULL || ses->txLen == 0U)
+    {
+        return;
+    }
+
+    /* Queue as much as fits, the rest goes out from the sent callback */
+    room = tcp_sndbuf(ses->pcb);
+    if (room > ses->txLen)
+    {
+        room = (u16_t)ses->txLen;
+    }
+
+    if (room > 0U && tcp_write(ses->pcb, &ses->txData[ses->txHead], room, TCP_WRITE_FLAG_COPY) == ERR_OK)
+    {
+        ses->txHead += room;
+        ses->txLen -= room;
+    }
+
+    (void)tcp_output(ses->pcb);
+}
+
+static err_t _FMSTR_NetLwipRawTcpOnAccept(void *arg, struct tcp_pcb *newPcb, err_t err)
+{
+    FMSTR_RAW_TCP_SESSION *newSes;
+
+    FMSTR_UNUSED(arg);
+
+    if (err != ERR_OK || newPcb == NULL)
+    {
+        return ERR_VAL;
+    }
+
+    /* Refuse the connection when all sessions are taken */
+    newSes = _FMSTR_NetLwipRawTcpSessionFind(NULL);
+    if (newSes == NULL)
+    {
+        tcp_abort(newPcb);
+        return ERR_ABRT;
+    }
+
+    FMSTR_MemSet(newSes, 0, sizeof(FMSTR_RAW_TCP_SESSION));
+    newSes->pcb = newPcb;
+    _FMSTR_NetAddrToFmstr(&newPcb->remote_ip, newPcb->remote_port, &newSes->address);
+
+    /* Responses are written in one piece, do not hold them back for more data */
+    tcp_nagle_disable(newPcb);
+
+    tcp_arg(newPcb, newSes);
+    tcp_recv(newPcb, _FMSTR_NetLwipRawTcpOnRecv);
+    tcp_sent(newPcb, _FMSTR_NetLwipRawTcpOnSent);
+    tcp_err(newPcb, _FMSTR_NetLwipRawTcpOnError);
+
+    return ERR_OK;
+}
+
+static err_t _FMSTR_NetLwipRawTcpOnRecv(void *arg, struct tcp_pcb *pcb, struct pbuf *p, err_t err)
+{
+    FMSTR_RAW_TCP_SESSION *ses = (FMSTR_RAW_TCP_SESSION *)arg;
+
+    FMSTR_UNUSED(pcb);
+
+    if (p == NULL)
+    {
+        /* Remote side closed, the protocol closes the session after the pending data */
+        ses->closed = FMSTR_TRUE;
+        return ERR_OK;
+    }
+
+    if (err != ERR_OK)
+    {
+        (void)pbuf_free(p);
+        return err;
+    }
+
+    /* Keep the data until the protocol asks for it, the window opens as it is consumed */
+    if (ses->rxData == NULL)
+    {
+        ses->rxData = p;
+    }
+    else
+    {
+        pbuf_cat(ses->rxData, p);
+    }
+
+    return ERR_OK;
+}
+
+static err_t _FMSTR_NetLwipRawTcpOnSent(void *arg, struct tcp_pcb *pcb, u16_t len)
+{
+    FMSTR_UNUSED(pcb);
+    FMSTR_UNUSED(len);
+
+    _FMSTR_NetLwipRawTcpFlush((FMSTR_RAW_TCP_SESSION *)arg);
+
+    return ERR_OK;
+}
+
+static void _FMSTR_NetLwipRawTcpOnError(void *arg, err_t err)
+{
+    FMSTR_RAW_TCP_SESSION *ses = (FMSTR_RAW_TCP_SESSION *)arg;
+
+    FMSTR_UNUSED(err);
+
+    /* The PCB is already freed by lwIP */
+    ses->pcb    = NULL;
+    ses->closed = FMSTR_TRUE;
+    ses->txLen  = 0U;
+}
+
+static void _FMSTR_NetLwipRawTcpPoll(void)
+{
+    FMSTR_INDEX i;
+
+    /* The stack itself is run by the application (ethernetif input and sys_check_timeouts) */
+    for (i = 0; i < FMSTR_SESSION_COUNT; i++)
+    {
+        _FMSTR_NetLwipRawTcpFlush(&fmstrRawTcpSessions[i]);
+    }
+}
+
+static FMSTR_S32 _FMSTR_NetLwipRawTcpRecv(FMSTR_BPTR msgBuff,
+                                          FMSTR_SIZE msgMaxSize,
+                                          FMSTR_NET_ADDR *recvAddr,
+                                          FMSTR_BOOL *isBroadcast)
+{
+    FMSTR_RAW_TCP_SESSION *ses = NULL;
+    FMSTR_INDEX i;
+    u16_t len;
+
+    FMSTR_ASSERT(msgBuff != NULL);
+    FMSTR_ASSERT(recvAddr != NULL);
+    FMSTR_ASSERT(isBroadcast != NULL);
+
+    *isBroadcast = FMSTR_FALSE;
+
+    /* Find session with data or a close to report, starting after the last one served */
+    for (i = 0; i < FMSTR_SESSION_COUNT; i++)
+    {
+        FMSTR_RAW_TCP_SESSION *s = &fmstrRawTcpSessions[(fmstrRawTcpNextRead + i) % FMSTR_SESSION_COUNT];
+
+        if (s->rxData != NULL || s->closed != FMSTR_FALSE)
+        {
+            ses                 = s;
+            fmstrRawTcpNextRead = (fmstrRawTcpNextRead + i + 1) % FMSTR_SESSION_COUNT;
+            break;
+        }
+    }
+
+    if (ses == NULL)
+    {
+        return 0;
+    }
+
+    /* Copy address */
+    FMSTR_MemCpy(recvAddr, &ses->address, sizeof(FMSTR_NET_ADDR));
+
+    if (ses->rxData == NULL)
+    {
+        /* Closed and drained */
+        return -1;
+    }
+
+    len = ses->rxData->tot_len;
+    if (len > msgMaxSize)
+    {
+        len = (u16_t)msgMaxSize;
+    }
+
+    len         = pbuf_copy_partial(ses->rxData, msgBuff, len, 0U);
+    ses->rxData = pbuf_free_header(ses->rxData, len);
+
+    /* Open the receive window again */
+    if (ses->pcb != NULL)
+    {
+        tcp_recved(ses->pcb, len);
+    }
+
+    return (FMSTR_S32)len;
+}
+
+static FMSTR_S32 _FMSTR_NetLwipRawTcpSend(FMSTR_NET_ADDR *sendAddr, FMSTR_BPTR msgBuff, FMSTR_SIZE msgSize)
+{
+    FMSTR_RAW_TCP_SESSION *ses = NULL;
+
+    FMSTR_ASSERT(msgBuff != NULL);
+    FMSTR_ASSERT(sendAddr != NULL);
+
+    /* Find session by address */
+    ses = _FMSTR_NetLwipRawTcpSessionFind(sendAddr);
+    if (ses == NULL || ses->pcb == NULL)
+    {
+        /* Same as socket error */
+        return -1;
+    }
+
+    /* Nothing can wait for the ACKs here, the whole frame is taken and sent as the window allows */
+    if (ses->txLen == 0U)
+    {
+        ses->txHead = 0U;
+    }
+    if (msgSize > (sizeof(ses->txData) - ses->txHead - ses->txLen))
+    {
+        return -1;
+    }
+
+    FMSTR_MemCpy(&ses->txData[ses->txHead + ses->txLen], msgBuff, msgSize);
+    ses->txLen += msgSize;
+
+    _FMSTR_NetLwipRawTcpFlush(ses);
+
+    return (FMSTR_S32)msgSize;
+}
+
+static void _FMSTR_NetLwipRawTcpClose(FMSTR_NET_ADDR *addr)
+{
+    FMSTR_RAW_TCP_SESSION *ses = NULL;
+
+    /* Find session by address */
+    ses = _FMSTR_NetLwipRawTcpSessionFind(addr);
+    if (ses == NULL)
+    {
+        /* Session not found */
+        return;
+    }
+
+    if (ses->pcb != NULL)
+    {
+        tcp_arg(ses->pcb, NULL);
+        tcp_recv(ses->pcb, NULL);
+        tcp_sent(ses->pcb, NULL);
+        tcp_err(ses->pcb, NULL);
+
+        /* Close PCB, abort when lwIP has no memory for the FIN */
+        if (tcp_close(ses->pcb) != ERR_OK)
+        {
+            tcp_abort(ses->pcb);
+        }
+    }
+
+    if (ses->rxData != NULL)
+    {
+        (void)pbuf_free(ses->rxData);
+    }
+
+    FMSTR_MemSet(ses, 0, sizeof(FMSTR_RAW_TCP_SESSION));
+}
+
+static void _FMSTR_NetLwipRawTcpGetCaps(FMSTR_NET_IF_CAPS *caps)
+{
+    FMSTR_ASSERT(caps != NULL);
+
+    caps->flags |= FMSTR_NET_IF_CAPS_FLAG_TCP;
+}
+
+static void _FMSTR_NetAddrToFmstr(const ip_addr_t *remoteAddr, u16_t remotePort, FMSTR_NET_ADDR *fmstrAddr)
+{
+    FMSTR_ASSERT(remoteAddr != NULL);
+    FMSTR_ASSERT(fmstrAddr != NULL);
+
+    /* The network layer compares whole addresses */
+    FMSTR_MemSet(fmstrAddr, 0, sizeof(FMSTR_NET_ADDR));
+
+#if LWIP_IPV6
+    if (IP_IS_V6(remoteAddr))
+    {
+        fmstrAddr->type = FMSTR_NET_ADDR_TYPE_V6;
+        FMSTR_MemCpy(fmstrAddr->addr.v6, ip_2_ip6(remoteAddr)->addr, sizeof(fmstrAddr->addr.v6));
+    }
+    else
+#endif
+    {
+        fmstrAddr->type = FMSTR_NET_ADDR_TYPE_V4;
+        FMSTR_MemCpy(fmstrAddr->addr.v4, &ip_2_ip4(remoteAddr)->addr, sizeof(fmstrAddr->addr.v4));
+    }
+    fmstrAddr->port = remotePort;
+}
+
+#endif /* (!(FMSTR_DISABLE)) */
+#endif /* (FMSTR_MK_IDSTR(FMSTR_NET_DRV) == FMSTR_NET_LWIP_RAW_TCP_ID) */
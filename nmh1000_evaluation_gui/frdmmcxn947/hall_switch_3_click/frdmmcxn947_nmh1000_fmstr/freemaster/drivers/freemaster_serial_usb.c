@@ -56,20 +56,15 @@
 #error The USB/CDC driver does not support single wire configuration of UART communication.
 #endif
 
-#define _MIN(a, b) (((a) < (b)) ? (a) : (b))
-#define _MAX(a, b) (((a) > (b)) ? (a) : (b))
-
-/* Bulk endpoint buffer sizes */
-#ifdef USB_DATA_BUFF_SIZE
-/* USB transmit if flushed automatically when full, so it can be smaller than FreeMASTER buffer */
-#define FMSTR_USB_TX_BUFFER_SIZE _MIN(USB_DATA_BUFF_SIZE, FMSTR_COMM_BUFFER_SIZE)
-/* USB receive buffer must accommodate the whole frame at once, so must be at least the FreeMASTER buffer size */
-#define FMSTR_USB_RX_BUFFER_SIZE _MAX(USB_DATA_BUFF_SIZE, FMSTR_COMM_BUFFER_SIZE)
-#else
-#define FMSTR_USB_TX_BUFFER_SIZE FMSTR_COMM_BUFFER_SIZE
-#define FMSTR_USB_RX_BUFFER_SIZE FMSTR_COMM_BUFFER_SIZE
+/* Size of one endpoint buffer, the bulk max packet size of a high-speed device by default. A received
+   transfer ends with a short packet or when the buffer is full, a full-speed device may keep the default. */
+#ifndef FMSTR_USB_PACKET_SIZE
+#define FMSTR_USB_PACKET_SIZE 512U
 #endif
 
+/* Endpoint double buffering: one buffer is owned by the USB controller while the other is processed */
+#define FMSTR_USB_PACKET_COUNT 2U
+
 /******************************************************************************
  * Local functions
  ******************************************************************************/
@@ -86,22 +81,50 @@ static FMSTR_BOOL _FMSTR_SerialUsbIsTransmitterActive(void);
 static void _FMSTR_SerialUsbPutChar(FMSTR_BCHR ch);
 static FMSTR_BCHR _FMSTR_SerialUsbGetChar(void);
 static void _FMSTR_SerialUsbFlush(void);
+static FMSTR_SIZE _FMSTR_SerialUsbGetRxBlock(FMSTR_BPTR *ppData);
+static void _FMSTR_SerialUsbReleaseRxBlock(FMSTR_SIZE size);
+static FMSTR_SIZE _FMSTR_SerialUsbGetTxBlock(FMSTR_BPTR *ppData);
+static void _FMSTR_SerialUsbPutTxBlock(FMSTR_SIZE size);
+
+static void _FMSTR_SerialUsbReset(void);
+static void _FMSTR_SerialUsbRxPrime(void);
+static void _FMSTR_SerialUsbTxQueue(void);
+static void _FMSTR_SerialUsbTxKick(void);
 
 /******************************************************************************
  * Type definitions
  ******************************************************************************/
 
+/* Ownership of an endpoint buffer */
+typedef enum
+{
+    FMSTR_USB_PACKET_FREE,   /* Owned by the driver, empty or being filled */
+    FMSTR_USB_PACKET_PRIMED, /* Owned by the USB controller */
+    FMSTR_USB_PACKET_FULL,   /* Received and not consumed yet, or filled and waiting for transmission */
+} FMSTR_USB_PACKET_STATE;
+
+/* Endpoint buffer state */
+typedef struct FMSTR_USB_PACKET_S
+{
+    volatile FMSTR_USB_PACKET_STATE state;
+    volatile FMSTR_U32 size; /* Received bytes, or bytes filled for transmission */
+} FMSTR_USB_PACKET;
+
 /* Context structure of USB/CDC interface */
 typedef struct FMSTR_USB_CTX_S
 {
-    volatile FMSTR_BOOL txEnabled;                 /* Transmit is enabled */
-    FMSTR_BCHR txBuffer[FMSTR_USB_TX_BUFFER_SIZE]; /* Transmit buffer - max one full USB bulk frame */
-    FMSTR_BCHR rxBuffer[FMSTR_USB_RX_BUFFER_SIZE]; /* Receive buffer - whole FreeMASTER frame must fit */
-    volatile uint32_t txSize;                      /* Data size in transmit buffer */
-    volatile FMSTR_BOOL txActive;                  /* Transmit status (true = transmitting) */
-    volatile FMSTR_BOOL rxEnabled;                 /* Receiver enabled */
-
-    FMSTR_RING_BUFFER rxQueue; /* Receive ring buffer object */
+    volatile FMSTR_BOOL txEnabled; /* Transmit is enabled */
+    volatile FMSTR_BOOL rxEnabled; /* Receiver enabled */
+
+    FMSTR_USB_PACKET rx[FMSTR_USB_PACKET_COUNT]; /* Bulk OUT buffers, used in turn */
+    FMSTR_U32 rxOffset;                          /* Consumed bytes of the oldest received buffer */
+    FMSTR_U8 rxHead;                             /* Oldest received buffer */
+    volatile FMSTR_U8 rxPrime;                   /* Buffer to be given to the controller next */
+
+    FMSTR_USB_PACKET tx[FMSTR_USB_PACKET_COUNT]; /* Bulk IN buffers, used in turn */
+    FMSTR_U8 txFill;                             /* Buffer being filled */
+    volatile FMSTR_U8 txSend;                    /* Oldest buffer waiting for or in transmission */
+    FMSTR_BOOL txLastFull;                       /* Last queued buffer was full, the transfer needs a zero-length end */
 } FMSTR_USB_CTX;
 
 /******************************************************************************
@@ -109,8 +132,15 @@ typedef struct FMSTR_USB_CTX_S
  ******************************************************************************/
 /* Context data of USB/CDC interface */
 static FMSTR_USB_CTX fmstr_usbCtx;
+/* Endpoint buffers, the USB controller accesses them directly */
+USB_DMA_NONINIT_DATA_ALIGN(USB_DATA_ALIGN_SIZE)
+static FMSTR_U8 fmstr_usbRxBuffer[FMSTR_USB_PACKET_COUNT][FMSTR_USB_PACKET_SIZE];
+USB_DMA_NONINIT_DATA_ALIGN(USB_DATA_ALIGN_SIZE)
+static FMSTR_U8 fmstr_usbTxBuffer[FMSTR_USB_PACKET_COUNT][FMSTR_USB_PACKET_SIZE];
 /* Transmit function for USB/CDC interface */
 static FMSTR_TX_FUNC fmstr_txFunc = NULL;
+/* Receive function priming the bulk OUT endpoint, NULL when the application passes its own buffers */
+static FMSTR_RX_FUNC fmstr_rxFunc = NULL;
 /******************************************************************************
  * Driver interface
  ******************************************************************************/
@@ -128,6 +158,10 @@ const FMSTR_SERIAL_DRV_INTF FMSTR_SERIAL_MCUX_USB = {
     .PutChar                         = _FMSTR_SerialUsbPutChar,
     .GetChar                         = _FMSTR_SerialUsbGetChar,
     .Flush                           = _FMSTR_SerialUsbFlush,
+    .GetRxBlock                      = _FMSTR_SerialUsbGetRxBlock,
+    .ReleaseRxBlock                  = _FMSTR_SerialUsbReleaseRxBlock,
+    .GetTxBlock                      = _FMSTR_SerialUsbGetTxBlock,
+    .PutTxBlock                      = _FMSTR_SerialUsbPutTxBlock,
 };
 
 /******************************************************************************
@@ -145,7 +179,8 @@ static FMSTR_BOOL _FMSTR_SerialUsbInit(void)
         return FMSTR_FALSE;
     }
 
-    _FMSTR_RingBuffCreate(&fmstr_usbCtx.rxQueue, fmstr_usbCtx.rxBuffer, sizeof(fmstr_usbCtx.rxBuffer));
+    /* Fails silently until the device is configured, the CONFIGURED event primes again */
+    _FMSTR_SerialUsbReset();
 
     return FMSTR_TRUE;
 }
@@ -210,125 +245,315 @@ static void _FMSTR_SerialUsbEnableRxInterrupt(FMSTR_BOOL enable)
 
 static FMSTR_BOOL _FMSTR_SerialUsbIsTransmitRegEmpty(void)
 {
-    /* Check if transmit is enabled or if it is sending data */
-    if (fmstr_usbCtx.txEnabled == FMSTR_FALSE || fmstr_usbCtx.txActive != FMSTR_FALSE)
+    FMSTR_BPTR pData;
+
+    return _FMSTR_SerialUsbGetTxBlock(&pData) > 0U ? FMSTR_TRUE : FMSTR_FALSE;
+}
+
+/******************************************************************************
+ *
+ * @brief    Returns TRUE if the receive register is full, and it's possible to get received char
+ *
+ ******************************************************************************/
+
+static FMSTR_BOOL _FMSTR_SerialUsbIsReceiveRegFull(void)
+{
+    FMSTR_BPTR pData;
+
+    return _FMSTR_SerialUsbGetRxBlock(&pData) > 0U ? FMSTR_TRUE : FMSTR_FALSE;
+}
+
+/******************************************************************************
+ *
+ * @brief    Returns TRUE if the transmitter is still active
+ *
+ ******************************************************************************/
+
+static FMSTR_BOOL _FMSTR_SerialUsbIsTransmitterActive(void)
+{
+    FMSTR_U8 i;
+
+    for (i = 0U; i < FMSTR_USB_PACKET_COUNT; i++)
     {
-        return FMSTR_FALSE;
+        if (fmstr_usbCtx.tx[i].state != FMSTR_USB_PACKET_FREE)
+        {
+            return FMSTR_TRUE;
+        }
     }
 
-    /* Check, if buffer is not full */
-    if (fmstr_usbCtx.txSize < sizeof(fmstr_usbCtx.txBuffer))
+    return FMSTR_FALSE;
+}
+
+/******************************************************************************
+ *
+ * @brief    The function puts the char for transmit
+ *
+ ******************************************************************************/
+
+static void _FMSTR_SerialUsbPutChar(FMSTR_BCHR ch)
+{
+    FMSTR_BPTR pData;
+
+    /* Make sure there is free space TX buffer before writing */
+    if (_FMSTR_SerialUsbGetTxBlock(&pData) > 0U)
     {
-        return FMSTR_TRUE;
+        *pData = ch;
+        _FMSTR_SerialUsbPutTxBlock(1U);
     }
+}
 
-    /* Send buffer is full -> flush data */
-    _FMSTR_SerialUsbFlush();
+/******************************************************************************
+ *
+ * @brief    The function gets the received char
+ *
+ ******************************************************************************/
 
-    /* Check again, if buffer is not full */
-    if (fmstr_usbCtx.txSize < sizeof(fmstr_usbCtx.txBuffer))
+static FMSTR_BCHR _FMSTR_SerialUsbGetChar(void)
+{
+    FMSTR_BPTR pData;
+    FMSTR_BCHR ch;
+
+    /* Any data in receive buffer? */
+    if (_FMSTR_SerialUsbGetRxBlock(&pData) == 0U)
     {
-        return FMSTR_TRUE;
+        return 0;
     }
 
-    /* Return false, when buffer is full and upper layer cannot call putChar function. */
-    return FMSTR_FALSE;
+    ch = *pData;
+    _FMSTR_SerialUsbReleaseRxBlock(1U);
+    return ch;
 }
 
 /******************************************************************************
  *
- * @brief    Returns TRUE if the receive register is full, and it's possible to get received char
+ * @brief    The function send buffered data
  *
  ******************************************************************************/
 
-static FMSTR_BOOL _FMSTR_SerialUsbIsReceiveRegFull(void)
+static void _FMSTR_SerialUsbFlush(void)
 {
-    if (fmstr_usbCtx.rxEnabled != FMSTR_FALSE)
+    FMSTR_USB_PACKET *pPacket = &fmstr_usbCtx.tx[fmstr_usbCtx.txFill];
+
+    if (pPacket->state != FMSTR_USB_PACKET_FREE)
     {
-        if(_FMSTR_RingBuffHasData(&fmstr_usbCtx.rxQueue) != FMSTR_FALSE)
-        {
-            return FMSTR_TRUE;
-        }
+        return;
     }
 
-    return FMSTR_FALSE;
+    /* Send the partially filled buffer, or an empty one ending a transfer of full packets */
+    if (pPacket->size > 0U || fmstr_usbCtx.txLastFull != FMSTR_FALSE)
+    {
+        _FMSTR_SerialUsbTxQueue();
+        _FMSTR_SerialUsbTxKick();
+    }
 }
 
 /******************************************************************************
  *
- * @brief    Returns TRUE if the transmitter is still active
+ * @brief    Returns received data not consumed yet
  *
  ******************************************************************************/
 
-static FMSTR_BOOL _FMSTR_SerialUsbIsTransmitterActive(void)
+static FMSTR_SIZE _FMSTR_SerialUsbGetRxBlock(FMSTR_BPTR *ppData)
 {
-    return fmstr_usbCtx.txActive;
+    FMSTR_USB_PACKET *pPacket = &fmstr_usbCtx.rx[fmstr_usbCtx.rxHead];
+
+    if (fmstr_usbCtx.rxEnabled == FMSTR_FALSE)
+    {
+        return 0U;
+    }
+
+    /* A zero-length packet carries no data, give the buffer back */
+    if (pPacket->state == FMSTR_USB_PACKET_FULL && pPacket->size == 0U)
+    {
+        _FMSTR_SerialUsbReleaseRxBlock(0U);
+        pPacket = &fmstr_usbCtx.rx[fmstr_usbCtx.rxHead];
+    }
+
+    if (pPacket->state != FMSTR_USB_PACKET_FULL)
+    {
+        return 0U;
+    }
+
+    *ppData = &fmstr_usbRxBuffer[fmstr_usbCtx.rxHead][fmstr_usbCtx.rxOffset];
+    return (FMSTR_SIZE)(pPacket->size - fmstr_usbCtx.rxOffset);
 }
 
 /******************************************************************************
  *
- * @brief    The function puts the char for transmit
+ * @brief    Consume received data, an emptied buffer goes back to the controller
  *
  ******************************************************************************/
 
-static void _FMSTR_SerialUsbPutChar(FMSTR_BCHR ch)
+static void _FMSTR_SerialUsbReleaseRxBlock(FMSTR_SIZE size)
 {
-    /* Make sure there is free space TX buffer before writing */
-    if (fmstr_usbCtx.txSize >= sizeof(fmstr_usbCtx.txBuffer))
+    FMSTR_USB_PACKET *pPacket = &fmstr_usbCtx.rx[fmstr_usbCtx.rxHead];
+
+    fmstr_usbCtx.rxOffset += size;
+    if (fmstr_usbCtx.rxOffset >= pPacket->size)
     {
-        return;
+        fmstr_usbCtx.rxOffset = 0U;
+        fmstr_usbCtx.rxHead   = (FMSTR_U8)((fmstr_usbCtx.rxHead + 1U) % FMSTR_USB_PACKET_COUNT);
+        pPacket->state        = FMSTR_USB_PACKET_FREE;
+
+        _FMSTR_SerialUsbRxPrime();
     }
+}
 
-    fmstr_usbCtx.txBuffer[fmstr_usbCtx.txSize] = ch;
-    fmstr_usbCtx.txSize++;
+/******************************************************************************
+ *
+ * @brief    Returns free space of the buffer being filled
+ *
+ ******************************************************************************/
+
+static FMSTR_SIZE _FMSTR_SerialUsbGetTxBlock(FMSTR_BPTR *ppData)
+{
+    FMSTR_USB_PACKET *pPacket = &fmstr_usbCtx.tx[fmstr_usbCtx.txFill];
 
-    /* When buffer got just full, flush data now */
-    if (fmstr_usbCtx.txSize == sizeof(fmstr_usbCtx.txBuffer))
+    /* Both buffers wait for the controller */
+    if (fmstr_usbCtx.txEnabled == FMSTR_FALSE || pPacket->state != FMSTR_USB_PACKET_FREE)
     {
-        _FMSTR_SerialUsbFlush();
+        return 0U;
     }
+
+    *ppData = &fmstr_usbTxBuffer[fmstr_usbCtx.txFill][pPacket->size];
+    return (FMSTR_SIZE)(FMSTR_USB_PACKET_SIZE - pPacket->size);
 }
 
 /******************************************************************************
  *
- * @brief    The function gets the received char
+ * @brief    Data were filled to the buffer, a full buffer is sent right away
  *
  ******************************************************************************/
 
-static FMSTR_BCHR _FMSTR_SerialUsbGetChar(void)
+static void _FMSTR_SerialUsbPutTxBlock(FMSTR_SIZE size)
 {
-    /* Any data in receive buffer? */
-    if (_FMSTR_RingBuffHasData(&fmstr_usbCtx.rxQueue) == FMSTR_FALSE)
+    FMSTR_USB_PACKET *pPacket = &fmstr_usbCtx.tx[fmstr_usbCtx.txFill];
+
+    pPacket->size += size;
+    if (pPacket->size >= FMSTR_USB_PACKET_SIZE)
     {
-        return 0;
+        _FMSTR_SerialUsbTxQueue();
+        _FMSTR_SerialUsbTxKick();
     }
+}
+
+/******************************************************************************
+ *
+ * @brief    Drop all buffered data and give the first receive buffer to the controller
+ *
+ ******************************************************************************/
+
+static void _FMSTR_SerialUsbReset(void)
+{
+    FMSTR_U8 i;
 
-    return _FMSTR_RingBuffGet(&fmstr_usbCtx.rxQueue);
+    for (i = 0U; i < FMSTR_USB_PACKET_COUNT; i++)
+    {
+        fmstr_usbCtx.rx[i].state = FMSTR_USB_PACKET_FREE;
+        fmstr_usbCtx.rx[i].size  = 0U;
+        fmstr_usbCtx.tx[i].state = FMSTR_USB_PACKET_FREE;
+        fmstr_usbCtx.tx[i].size  = 0U;
+    }
+    fmstr_usbCtx.rxOffset   = 0U;
+    fmstr_usbCtx.rxHead     = 0U;
+    fmstr_usbCtx.rxPrime    = 0U;
+    fmstr_usbCtx.txFill     = 0U;
+    fmstr_usbCtx.txSend     = 0U;
+    fmstr_usbCtx.txLastFull = FMSTR_FALSE;
+
+    _FMSTR_SerialUsbRxPrime();
 }
 
 /******************************************************************************
  *
- * @brief    The function send buffered data
+ * @brief    Give the next free receive buffer to the controller
+ *
+ * Only one buffer is primed at a time, the other one holds data being decoded.
+ * Called from the USB interrupt when a buffer was received and from the
+ * application context when a buffer was consumed. The interrupt only comes
+ * while a buffer is primed, and then this function has nothing to do in the
+ * application context.
  *
  ******************************************************************************/
 
-static void _FMSTR_SerialUsbFlush(void)
+static void _FMSTR_SerialUsbRxPrime(void)
 {
-    if (fmstr_usbCtx.txSize <= 0U)
+    FMSTR_U8 i = fmstr_usbCtx.rxPrime;
+    FMSTR_U8 j;
+
+    if (fmstr_rxFunc == NULL || fmstr_usbCtx.rx[i].state != FMSTR_USB_PACKET_FREE)
     {
         return;
     }
 
-    /* Send data */
-    if (fmstr_txFunc != NULL)
+    for (j = 0U; j < FMSTR_USB_PACKET_COUNT; j++)
+    {
+        if (fmstr_usbCtx.rx[j].state == FMSTR_USB_PACKET_PRIMED)
+        {
+            return;
+        }
+    }
+
+    fmstr_usbCtx.rx[i].state = FMSTR_USB_PACKET_PRIMED;
+    if (fmstr_rxFunc(fmstr_usbRxBuffer[i], FMSTR_USB_PACKET_SIZE) != FMSTR_FALSE)
+    {
+        fmstr_usbCtx.rxPrime = (FMSTR_U8)((i + 1U) % FMSTR_USB_PACKET_COUNT);
+    }
+    else
+    {
+        /* Not configured yet */
+        fmstr_usbCtx.rx[i].state = FMSTR_USB_PACKET_FREE;
+    }
+}
+
+/******************************************************************************
+ *
+ * @brief    Queue the buffer being filled for transmission and fill the next one
+ *
+ ******************************************************************************/
+
+static void _FMSTR_SerialUsbTxQueue(void)
+{
+    FMSTR_USB_PACKET *pPacket = &fmstr_usbCtx.tx[fmstr_usbCtx.txFill];
+
+    fmstr_usbCtx.txLastFull = pPacket->size >= FMSTR_USB_PACKET_SIZE ? FMSTR_TRUE : FMSTR_FALSE;
+    fmstr_usbCtx.txFill     = (FMSTR_U8)((fmstr_usbCtx.txFill + 1U) % FMSTR_USB_PACKET_COUNT);
+    pPacket->state          = FMSTR_USB_PACKET_FULL;
+}
+
+/******************************************************************************
+ *
+ * @brief    Pass the oldest queued buffer to the controller unless one is in transmission
+ *
+ ******************************************************************************/
+
+static void _FMSTR_SerialUsbTxKick(void)
+{
+    FMSTR_U8 i = fmstr_usbCtx.txSend;
+    FMSTR_U8 j;
+
+    if (fmstr_txFunc == NULL || fmstr_usbCtx.tx[i].state != FMSTR_USB_PACKET_FULL)
     {
-        fmstr_usbCtx.txActive = FMSTR_TRUE;
+        return;
+    }
 
-        if (fmstr_txFunc(fmstr_usbCtx.txBuffer, fmstr_usbCtx.txSize) == FMSTR_FALSE)
+    for (j = 0U; j < FMSTR_USB_PACKET_COUNT; j++)
+    {
+        if (fmstr_usbCtx.tx[j].state == FMSTR_USB_PACKET_PRIMED)
         {
-            fmstr_usbCtx.txActive = FMSTR_FALSE;
+            return;
         }
     }
+
+    fmstr_usbCtx.tx[i].state = FMSTR_USB_PACKET_PRIMED;
+    if (fmstr_txFunc(fmstr_usbTxBuffer[i], fmstr_usbCtx.tx[i].size) == FMSTR_FALSE)
+    {
+        /* Not configured or detached, drop the data so that the transmitter does not stall */
+        fmstr_usbCtx.tx[i].size  = 0U;
+        fmstr_usbCtx.tx[i].state = FMSTR_USB_PACKET_FREE;
+        fmstr_usbCtx.txSend      = (FMSTR_U8)((i + 1U) % FMSTR_USB_PACKET_COUNT);
+        _FMSTR_SerialUsbTxKick();
+    }
 }
 
 /******************************************************************************
@@ -342,6 +567,21 @@ void FMSTR_SerialUsbRegisterAppFunctions(FMSTR_TX_FUNC tx_func)
     fmstr_txFunc = tx_func;
 }
 
+/******************************************************************************
+ *
+ * @brief    Register the function priming the bulk OUT endpoint
+ *
+ * With it registered, data are received directly into the driver's double
+ * buffer and the RECEIVED event passes the primed buffer back. Without it,
+ * the application receives into its own buffer and the data are copied.
+ *
+ ******************************************************************************/
+
+void FMSTR_SerialUsbRegisterRxFunction(FMSTR_RX_FUNC rx_func)
+{
+    fmstr_rxFunc = rx_func;
+}
+
 /******************************************************************************
  *
  * @brief    Calling from USB driver when data was received/sent
@@ -350,30 +590,52 @@ void FMSTR_SerialUsbRegisterAppFunctions(FMSTR_TX_FUNC tx_func)
 
 void FMSTR_SerialUsbProcessEvent(FMSTR_SERIAL_USBCDC_EVENT_TYPE type, FMSTR_U8 *data, FMSTR_U32 size)
 {
+    FMSTR_U8 i;
+
     switch (type)
     {
         /* Data sent */
         case FMSTR_SERIAL_USBCDC_EVENT_TYPE_SENT:
-            if (fmstr_usbCtx.txActive != FMSTR_FALSE)
+            i = fmstr_usbCtx.txSend;
+            if (fmstr_usbCtx.tx[i].state == FMSTR_USB_PACKET_PRIMED)
             {
-                fmstr_usbCtx.txSize   = 0;
-                fmstr_usbCtx.txActive = FMSTR_FALSE;
+                fmstr_usbCtx.tx[i].size  = 0U;
+                fmstr_usbCtx.tx[i].state = FMSTR_USB_PACKET_FREE;
+                fmstr_usbCtx.txSend      = (FMSTR_U8)((i + 1U) % FMSTR_USB_PACKET_COUNT);
+                _FMSTR_SerialUsbTxKick();
             }
             break;
 
         /* Data received */
         case FMSTR_SERIAL_USBCDC_EVENT_TYPE_RECEIVED:
             /* Also check if size is sane. It may go invalid (e.g. "negative") on some unexpected events. */
-            if (data != NULL && size < 0x10000UL)
+            if (data != NULL && size <= FMSTR_USB_PACKET_SIZE)
             {
-                for (FMSTR_U32 i = 0U; i < size; i++)
+                /* Primed buffer came back, rxPrime has moved past it */
+                i = (FMSTR_U8)((fmstr_usbCtx.rxPrime + FMSTR_USB_PACKET_COUNT - 1U) % FMSTR_USB_PACKET_COUNT);
+
+                if (fmstr_rxFunc == NULL)
                 {
-                    if (_FMSTR_RingBuffIsSpace(&fmstr_usbCtx.rxQueue) != FMSTR_FALSE)
+                    /* Application's own buffer, copy it when there is a free one */
+                    i = fmstr_usbCtx.rxPrime;
+                    if (fmstr_usbCtx.rx[i].state != FMSTR_USB_PACKET_FREE)
                     {
-                        _FMSTR_RingBuffPut(&fmstr_usbCtx.rxQueue, data[i]);
+                        break;
                     }
+                    FMSTR_MemCpy(fmstr_usbRxBuffer[i], data, size);
+                    fmstr_usbCtx.rxPrime = (FMSTR_U8)((i + 1U) % FMSTR_USB_PACKET_COUNT);
+                }
+                else if (data != fmstr_usbRxBuffer[i] || fmstr_usbCtx.rx[i].state != FMSTR_USB_PACKET_PRIMED)
+                {
+                    break;
                 }
 
+                fmstr_usbCtx.rx[i].size  = size;
+                fmstr_usbCtx.rx[i].state = FMSTR_USB_PACKET_FULL;
+
+                /* Let the host send the next packet while this one is decoded */
+                _FMSTR_SerialUsbRxPrime();
+
 /* If the data are received by USB (usually all at once) we must call ProcessSerial twice
     to allow freemaster to decode packet and also to prepare and send the response. */
 #if FMSTR_LONG_INTR > 0
@@ -382,6 +644,11 @@ void FMSTR_SerialUsbProcessEvent(FMSTR_SERIAL_USBCDC_EVENT_TYPE type, FMSTR_U8 *
             }
             break;
 
+        /* Device configured after enumeration or bus reset, transfers in progress were cancelled */
+        case FMSTR_SERIAL_USBCDC_EVENT_TYPE_CONFIGURED:
+            _FMSTR_SerialUsbReset();
+            break;
+
         default:; /* no action */
             break;
     }
@@ -398,6 +665,11 @@ void FMSTR_SerialUsbRegisterAppFunctions(FMSTR_TX_FUNC tx_func)
     FMSTR_UNUSED(tx_func);
 }
 
+void FMSTR_SerialUsbRegisterRxFunction(FMSTR_RX_FUNC rx_func)
+{
+    FMSTR_UNUSED(rx_func);
+}
+
 void FMSTR_SerialUsbProcessEvent(FMSTR_SERIAL_USBCDC_EVENT_TYPE type, FMSTR_U8 *data, FMSTR_U32 size)
 {
     FMSTR_UNUSED(type);
@@ -42,11 +42,17 @@ typedef enum
 {
     FMSTR_SERIAL_USBCDC_EVENT_TYPE_SENT,     /* Interrupt type, that data was sent via USB CDC */
     FMSTR_SERIAL_USBCDC_EVENT_TYPE_RECEIVED, /* Interrupt type, that data was received from USB CDC */
+    FMSTR_SERIAL_USBCDC_EVENT_TYPE_CONFIGURED, /* Device was configured, pending transfers were cancelled */
 } FMSTR_SERIAL_USBCDC_EVENT_TYPE;
 
-/* Function for sending data via USB CDC. It must be registered from application. */
+/* Function for sending data via USB CDC. It must be registered from application. A zero size
+   sends a zero-length packet. */
 typedef FMSTR_BOOL (*FMSTR_TX_FUNC)(FMSTR_U8 *data, FMSTR_U32 size);
 
+/* Function for receiving data via USB CDC into the given buffer, the RECEIVED event reports its completion.
+   Optional, returns FALSE when the device is not configured. */
+typedef FMSTR_BOOL (*FMSTR_RX_FUNC)(FMSTR_U8 *data, FMSTR_U32 size);
+
 /******************************************************************************
  * inline functions
  ******************************************************************************/
@@ -57,6 +63,8 @@ typedef FMSTR_BOOL (*FMSTR_TX_FUNC)(FMSTR_U8 *data, FMSTR_U32 size);
 
 /* Function for registering USB CDC transmit function.  */
 void FMSTR_SerialUsbRegisterAppFunctions(FMSTR_TX_FUNC tx_func);
+/* Function for registering USB CDC receive function, enables receiving directly into the driver buffers. */
+void FMSTR_SerialUsbRegisterRxFunction(FMSTR_RX_FUNC rx_func);
 /* USB CDC event called from application into FreeMASTER serial interface. */
 void FMSTR_SerialUsbProcessEvent(FMSTR_SERIAL_USBCDC_EVENT_TYPE type, FMSTR_U8 *data, FMSTR_U32 size);
 
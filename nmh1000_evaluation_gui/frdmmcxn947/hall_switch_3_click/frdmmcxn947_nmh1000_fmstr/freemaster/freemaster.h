@@ -112,6 +112,27 @@ typedef unsigned short FMSTR_PIPE_SIZE; /* pipe buffer size type (unsigned, at l
 /* pointer to pipe event handler */
 typedef void (*FMSTR_PPIPEFUNC)(FMSTR_HPIPE pipeHandle);
 
+/* application-owned pipe transmit ring (see FMSTR_PipeAttachTxRing). Both indexes are free-running,
+   the size must be a power of two not bigger than 0x8000. Application is the only writer of wp,
+   the pipe is the only writer of rp. */
+typedef struct
+{
+    FMSTR_ADDR buff;                 /* ring storage */
+    FMSTR_PIPE_SIZE size;            /* ring size in bytes */
+    volatile FMSTR_PIPE_SIZE wp;     /* producer index, advanced by application after data is written */
+    volatile FMSTR_PIPE_SIZE rp;     /* consumer index, advanced when host acknowledges data */
+} FMSTR_PIPE_RING;
+
+/* serial transport statistics (see FMSTR_SerialGetStats). Counters are free-running, they are
+   updated in the communication interrupt in FMSTR_LONG_INTR mode. */
+typedef struct
+{
+    FMSTR_U32 rxFrames;   /* complete frames received, including erroneous ones */
+    FMSTR_U32 txFrames;   /* responses sent */
+    FMSTR_U32 rxCsErrors; /* frames dropped with FMSTR_STC_CMDCSERR */
+    FMSTR_U32 rxTooLong;  /* frames dropped with FMSTR_STC_CMDTOOLONG */
+} FMSTR_SERIAL_STATS;
+
 /* PDBDM buffer type, it is in a public header as user may want to define a custom buffer instance
   (when FMSTR_PDBDM_USER_BUFFER is defined) */
 typedef struct
@@ -236,6 +257,8 @@ extern "C" {
 /* FreeMASTER serial communication API */
 FMSTR_BOOL FMSTR_Init(void); /* general initialization */
 void FMSTR_Poll(void);       /* polling call, use in SHORT_INTR and POLL_DRIVEN modes */
+const FMSTR_SERIAL_STATS *FMSTR_SerialGetStats(void); /* serial transport counters, FMSTR_USE_SERIAL_STATS */
+void FMSTR_ReadCacheInvalidate(void); /* new values published, drop the FMSTR_USE_READ_CACHE responses */
 
 /* Recorder API */
 FMSTR_BOOL FMSTR_RecorderCreate(FMSTR_INDEX recIndex, FMSTR_REC_BUFF *buffCfg);
@@ -281,6 +304,7 @@ FMSTR_PIPE_SIZE FMSTR_PipeRead(FMSTR_HPIPE pipeHandle,
                                FMSTR_ADDR pipeData,
                                FMSTR_PIPE_SIZE pipeDataLen,
                                FMSTR_PIPE_SIZE readGranularity);
+FMSTR_BOOL FMSTR_PipeAttachTxRing(FMSTR_HPIPE pipeHandle, FMSTR_PIPE_RING *txRing);
 
 /* Pipe printing and formatting */
 FMSTR_BOOL FMSTR_PipePuts(FMSTR_HPIPE pipeHandle, const char *text);
@@ -71,6 +71,27 @@
 #error Count of sessions (FMSTR_SESSION_COUNT) cannot be zero!
 #endif
 
+/* memory read responses shared by sessions until FMSTR_ReadCacheInvalidate() (disabled by default) */
+#ifndef FMSTR_USE_READ_CACHE
+#define FMSTR_USE_READ_CACHE 0
+#endif
+
+#if FMSTR_USE_READ_CACHE > 0
+/* number of (address, size) entries */
+#ifndef FMSTR_READ_CACHE_ENTRIES
+#define FMSTR_READ_CACHE_ENTRIES 8U
+#endif
+
+/* bytes of data held by all entries together */
+#ifndef FMSTR_READ_CACHE_SIZE
+#define FMSTR_READ_CACHE_SIZE 256U
+#endif
+
+#if FMSTR_READ_CACHE_ENTRIES > 255
+#error Number of read cache entries MUST be smaller than 256.
+#endif
+#endif
+
 /* transport MUST be defined in configuration */
 #if FMSTR_DISABLE == 0 && !defined(FMSTR_TRANSPORT)
 #error No FreeMASTER communication transport interface is enabled. Please choose the interface (FMSTR_TRANSPORT) or set FMSTR_DISABLE option to 1.
@@ -98,6 +119,11 @@
 #define FMSTR_USE_HASHED_PASSWORDS 0
 #endif
 
+/* Serial large-message frames with 16-bit length and CRC16, offered to hosts through CFG_F1 (disabled by default) */
+#ifndef FMSTR_SERIAL_LARGE_MSG
+#define FMSTR_SERIAL_LARGE_MSG 0
+#endif
+
 /* Build CFG_F1 configuration flags: */
 
 /* CFG_F1 0x01: Big endian */
@@ -106,6 +132,9 @@
 /* CFG_F1 0x02: Remote access enabled */
 #define FMSTR_CFG_F1_ENABLE_REMOTE_ACCESS ((FMSTR_ENABLE_REMOTE_ACCESS != 0U ? 1U : 0U) << 1)
 
+/* CFG_F1 0x04: Serial large-message frames accepted, up to the LM configuration value */
+#define FMSTR_CFG_F1_LARGE_MSG ((FMSTR_SERIAL_LARGE_MSG != 0U ? 1U : 0U) << 2)
+
 /* CFG_F1 0x30: access level which needs passwords */
 #if (defined(FMSTR_RESTRICTED_ACCESS_R_PASSWORD))
 #define FMSTR_CFG_F1_RESTRICTED_ACCESS ((FMSTR_RESTRICTED_ACCESS_R) << 4)
@@ -118,7 +147,9 @@
 #endif
 
 /* CFG_F1 value */
-#define FMSTR_CFG_F1 (FMSTR_CFG_F1_BIG_ENDIAN | FMSTR_CFG_F1_ENABLE_REMOTE_ACCESS | FMSTR_CFG_F1_RESTRICTED_ACCESS)
+#define FMSTR_CFG_F1                                                                        \
+    (FMSTR_CFG_F1_BIG_ENDIAN | FMSTR_CFG_F1_ENABLE_REMOTE_ACCESS | FMSTR_CFG_F1_LARGE_MSG | \
+     FMSTR_CFG_F1_RESTRICTED_ACCESS)
 
 /* read memory commands are ENABLED by default */
 #ifndef FMSTR_USE_READMEM
@@ -162,6 +193,11 @@
 #define FMSTR_DEBUG_TX 0
 #endif
 
+/* Serial transport frame and error counters, see FMSTR_SerialGetStats (disabled by default) */
+#ifndef FMSTR_USE_SERIAL_STATS
+#define FMSTR_USE_SERIAL_STATS 0
+#endif
+
 #if FMSTR_USE_RECORDER > 255
 #error Number of enabled recorders MUST be smaller than 255.
 #endif
@@ -243,6 +279,11 @@
 #define FMSTR_USE_PIPE_PRINTF_VARG FMSTR_USE_PIPE_PRINTF
 #endif
 
+/* "pipe" transmit directly from application-owned ring buffer (disabled by default) */
+#ifndef FMSTR_USE_PIPE_TXRING
+#define FMSTR_USE_PIPE_TXRING 0
+#endif
+
 #if FMSTR_USE_PIPES > 127
 #error Number of enabled pipes MUST be smaller than 127.
 #endif
@@ -53,6 +53,9 @@ static FMSTR_BCHR fmstr_pNetBuffer[FMSTR_COMM_BUFFER_SIZE + 2 + 1 + 1 + 2 + 1];
 static FMSTR_SIZE fmstr_nReceived = 0U;
 static FMSTR_U8 fmstr_nSeqNumber  = 1U;
 
+/* Sender of the partially received frame, valid while fmstr_nReceived is non-zero */
+static FMSTR_NET_ADDR fmstr_partialAddr;
+
 /***********************************
  *  local function prototypes
  ***********************************/
@@ -111,7 +114,7 @@ static FMSTR_BOOL _FMSTR_NetInit(void)
         return FMSTR_FALSE;
     }
 
-    return FMSTR_FALSE;
+    return FMSTR_TRUE;
 }
 
 /*******************************************************************************
@@ -261,6 +264,17 @@ static FMSTR_BOOL _FMSTR_NetProcess(void)
         {
             _FMSTR_NetCloseSession(session);
         }
+        else
+        {
+            /* Connection closed before it sent a complete frame */
+            FMSTR_NET_DRV.Close(&address);
+        }
+
+        /* Drop the partial frame of the closed connection */
+        if (fmstr_nReceived != 0U && FMSTR_MemCmp(&fmstr_partialAddr, &address, sizeof(FMSTR_NET_ADDR)) == 0)
+        {
+            fmstr_nReceived = 0U;
+        }
     }
 
     if (received <= 0)
@@ -268,6 +282,27 @@ static FMSTR_BOOL _FMSTR_NetProcess(void)
         return FMSTR_TRUE;
     }
 
+    if (fmstr_nReceived == 0U)
+    {
+        FMSTR_MemCpy(&fmstr_partialAddr, &address, sizeof(FMSTR_NET_ADDR));
+    }
+    else if (FMSTR_MemCmp(&fmstr_partialAddr, &address, sizeof(FMSTR_NET_ADDR)) != 0)
+    {
+        /* Another session sent data before the partial frame was complete. The partial frame
+           cannot be resumed, close its session and start over with the new data. */
+        session = _FMSTR_FindNetSession(&fmstr_partialAddr, FMSTR_FALSE);
+        if (session != NULL)
+        {
+            _FMSTR_NetCloseSession(session);
+        }
+        for (i = 0U; i < (FMSTR_U16)received; i++)
+        {
+            fmstr_pNetBuffer[i] = fmstr_pNetBuffer[fmstr_nReceived + i];
+        }
+        fmstr_nReceived = 0U;
+        FMSTR_MemCpy(&fmstr_partialAddr, &address, sizeof(FMSTR_NET_ADDR));
+    }
+
     fmstr_nReceived += (FMSTR_SIZE)received;
 
     if (isBroadcast == FMSTR_FALSE)
@@ -293,6 +328,7 @@ static FMSTR_BOOL _FMSTR_NetProcess(void)
         {
             _FMSTR_NetCloseSession(session);
         }
+        fmstr_nReceived = 0U;
         return FMSTR_TRUE;
     }
 
@@ -324,6 +360,7 @@ static FMSTR_BOOL _FMSTR_NetProcess(void)
         {
             _FMSTR_NetCloseSession(session);
         }
+        fmstr_nReceived = 0U;
         return FMSTR_TRUE;
     }
 
@@ -464,6 +501,9 @@ static void _FMSTR_NetCloseSession(FMSTR_NET_SESSION *ses)
 
     /* Free protocol session, if closed socket */
     FMSTR_FreeSession(ses);
+
+    /* Forget the address, a later connection may get the same one */
+    FMSTR_MemSet(ses, 0, sizeof(FMSTR_NET_SESSION));
 }
 
 static FMSTR_NET_SESSION *_FMSTR_FindNetSession(FMSTR_NET_ADDR *addr, FMSTR_BOOL create)
@@ -502,9 +542,15 @@ static FMSTR_NET_SESSION *_FMSTR_FindNetSession(FMSTR_NET_ADDR *addr, FMSTR_BOOL
         }
     }
 
+    /* Lookup only, the address has no session */
+    if (create == FMSTR_FALSE)
+    {
+        return NULL;
+    }
+
     ses = (freeSession != NULL ? freeSession : oldestSession);
 
-    if (ses != NULL && create != FMSTR_FALSE)
+    if (ses != NULL)
     {
         /* If reusing last used session, call protocol to free this session */
         if (ses->lastUsed != 0U)
@@ -86,6 +86,9 @@ typedef struct
     /* pipe configuration */
     FMSTR_PIPE_BUFF rx;
     FMSTR_PIPE_BUFF tx;
+#if FMSTR_USE_PIPE_TXRING > 0
+    FMSTR_PIPE_RING *txRing; /* application-owned transmit ring, replaces tx when set */
+#endif
     FMSTR_PIPE_PORT pipePort;
     FMSTR_PPIPEFUNC pCallback;
 
@@ -164,7 +167,23 @@ static FMSTR_PIPE_SIZE _FMSTR_PipeGetBytesReady(FMSTR_PIPE_BUFF *pipeBuff);
 static void _FMSTR_PipeDiscardBytes(FMSTR_PIPE_BUFF *pipeBuff, FMSTR_SIZE8 countBytes);
 static FMSTR_BPTR _FMSTR_PipeReceive(FMSTR_BPTR msgBuffIO, FMSTR_PIPE *pp, FMSTR_SIZE8 msgBuffSize);
 static FMSTR_BPTR _FMSTR_PipeTransmit(FMSTR_BPTR msgBuffIO, FMSTR_PIPE *pp, FMSTR_SIZE8 msgBuffSize);
-static FMSTR_BOOL _FMSTR_PipeIToAFinalize(FMSTR_HPIPE pipeHandle, FMSTR_PIPE_PRINTF_CTX *pctx);
+static FMSTR_PIPE_SIZE _FMSTR_PipeGetTxBytesFree(FMSTR_PIPE *pp);
+static FMSTR_PIPE_SIZE _FMSTR_PipeGetTxBytesReady(FMSTR_PIPE *pp);
+static void _FMSTR_PipeDiscardTxBytes(FMSTR_PIPE *pp, FMSTR_SIZE8 countBytes);
+#if FMSTR_USE_PIPE_TXRING > 0
+static FMSTR_PIPE_SIZE _FMSTR_PipeRingWrite(FMSTR_PIPE_RING *ring,
+                                            FMSTR_ADDR pipeData,
+                                            FMSTR_PIPE_SIZE pipeDataLen,
+                                            FMSTR_PIPE_SIZE writeGranularity);
+static FMSTR_BPTR _FMSTR_PipeRingTransmit(FMSTR_BPTR msgBuffIO, FMSTR_PIPE_RING *ring, FMSTR_SIZE8 msgBuffSize);
+#endif
+static FMSTR_BOOL _FMSTR_PipeIToAFinalize(FMSTR_HPIPE pipeHandle,
+                                          const FMSTR_CHAR *digits,
+                                          FMSTR_SIZE8 dlen,
+                                          FMSTR_PIPE_PRINTF_CTX *pctx);
+static FMSTR_BOOL _FMSTR_PipeUToA(FMSTR_HPIPE pipeHandle, FMSTR_U32 arg, FMSTR_PIPE_PRINTF_CTX *pctx);
+static FMSTR_BOOL _FMSTR_PipePrintfPutn(FMSTR_HPIPE pipeHandle, const char *str, FMSTR_SIZE len);
+static const char *_FMSTR_PipePrintfText(FMSTR_HPIPE pipeHandle, const char *format, FMSTR_BOOL *ok);
 
 static FMSTR_BOOL _FMSTR_PipePrintfOne(FMSTR_HPIPE pipeHandle,
                                        const char *format,
@@ -291,6 +310,51 @@ void FMSTR_PipeClose(FMSTR_HPIPE pipeHandle)
     }
 }
 
+/******************************************************************************
+ *
+ * @brief  PIPE API: Attach application-owned transmit ring to a pipe
+ *
+ * @param  pipeHandle - pipe opened by FMSTR_PipeOpen (its tx buffer may be NULL)
+ * @param  txRing     - ring descriptor, or NULL to return to the pipe's own tx buffer
+ *
+ * @return FMSTR_TRUE when the ring was accepted
+ *
+ * The pipe transmits straight out of the ring when the host polls the pipe
+ * and only moves txRing->rp once the host acknowledged the data. The
+ * application produces data in place and publishes it by advancing wp, so the
+ * samples are not copied into an intermediate pipe buffer first.
+ *
+ ******************************************************************************/
+
+FMSTR_BOOL FMSTR_PipeAttachTxRing(FMSTR_HPIPE pipeHandle, FMSTR_PIPE_RING *txRing)
+{
+#if FMSTR_USE_PIPE_TXRING > 0
+    FMSTR_PIPE *pp = (FMSTR_PIPE *)pipeHandle;
+
+    if (pp == NULL)
+    {
+        return FMSTR_FALSE;
+    }
+
+    if (txRing != NULL)
+    {
+        /* free-running 16bit indexes need power-of-two size */
+        if (FMSTR_ADDR_VALID(txRing->buff) == FMSTR_FALSE || txRing->size == 0U || txRing->size > 0x8000U ||
+            (txRing->size & (txRing->size - 1U)) != 0U)
+        {
+            return FMSTR_FALSE;
+        }
+    }
+
+    pp->txRing = txRing;
+    return FMSTR_TRUE;
+#else
+    FMSTR_UNUSED(pipeHandle);
+    FMSTR_UNUSED(txRing);
+    return FMSTR_FALSE;
+#endif
+}
+
 /******************************************************************************
  *
  * @brief  PIPE API: Write data to a pipe
@@ -304,9 +368,18 @@ FMSTR_PIPE_SIZE FMSTR_PipeWrite(FMSTR_HPIPE pipeHandle,
 {
     FMSTR_PIPE *pp         = (FMSTR_PIPE *)pipeHandle;
     FMSTR_PIPE_BUFF *pbuff = &pp->tx;
-    FMSTR_PIPE_SIZE total  = _FMSTR_PipeGetBytesFree(pbuff);
+    FMSTR_PIPE_SIZE total;
     FMSTR_PIPE_SIZE s;
 
+#if FMSTR_USE_PIPE_TXRING > 0
+    if (pp->txRing != NULL)
+    {
+        return _FMSTR_PipeRingWrite(pp->txRing, pipeData, pipeDataLen, writeGranularity);
+    }
+#endif
+
+    total = _FMSTR_PipeGetBytesFree(pbuff);
+
     /* when invalid address is given, just return number of bytes free */
     if (pipeData != NULL)
     {
@@ -376,8 +449,7 @@ FMSTR_PIPE_SIZE FMSTR_PipeWrite(FMSTR_HPIPE pipeHandle,
 FMSTR_BOOL FMSTR_PipePuts(FMSTR_HPIPE pipeHandle, const char *text)
 {
     FMSTR_PIPE *pp            = (FMSTR_PIPE *)pipeHandle;
-    FMSTR_PIPE_BUFF *pbuff    = &pp->tx;
-    FMSTR_PIPE_SIZE bytesFree = _FMSTR_PipeGetBytesFree(pbuff);
+    FMSTR_PIPE_SIZE bytesFree = _FMSTR_PipeGetTxBytesFree(pp);
     FMSTR_PIPE_SIZE strLen    = (FMSTR_PIPE_SIZE)FMSTR_StrLen(text);
 
     if (strLen > bytesFree)
@@ -463,65 +535,112 @@ FMSTR_INLINE FMSTR_BOOL _FMSTR_PipePrintfFlush(FMSTR_HPIPE pipeHandle)
 
 /******************************************************************************
  *
- * @brief  Put one character into pipe's printf formating buffer
+ * @brief  Put a run of characters into pipe's printf formating buffer
  *
  *****************************************************************************/
 
-FMSTR_INLINE FMSTR_BOOL _FMSTR_PipePrintfPutc(FMSTR_HPIPE pipeHandle, char c)
+static FMSTR_BOOL _FMSTR_PipePrintfPutn(FMSTR_HPIPE pipeHandle, const char *str, FMSTR_SIZE len)
 {
     FMSTR_PIPE *pp = (FMSTR_PIPE *)pipeHandle;
+    FMSTR_CHAR *dst;
+    FMSTR_SIZE s;
 
-    /* when buffer is full */
-    if (pp->printfBPtr >= FMSTR_PIPES_PRINTF_BUFF_SIZE)
+    while (len > 0U)
     {
-        /* try to flush some bytes */
-        if (_FMSTR_PipePrintfFlush(pipeHandle) == FMSTR_FALSE)
+        /* when buffer is full, try to flush some bytes */
+        if (pp->printfBPtr >= FMSTR_PIPES_PRINTF_BUFF_SIZE)
         {
-            return FMSTR_FALSE;
+            if (_FMSTR_PipePrintfFlush(pipeHandle) == FMSTR_FALSE)
+            {
+                return FMSTR_FALSE;
+            }
         }
-    }
 
-    /* abort if still full */
-    if (pp->printfBPtr >= FMSTR_PIPES_PRINTF_BUFF_SIZE)
-    {
-        return FMSTR_FALSE;
+        s = (FMSTR_SIZE)(FMSTR_PIPES_PRINTF_BUFF_SIZE - pp->printfBPtr);
+        if (s > len)
+        {
+            s = len;
+        }
+
+        /* short runs, plain loop is faster than the generic FMSTR_MemCpy */
+        dst = &pp->printfBuff[pp->printfBPtr];
+        pp->printfBPtr += s;
+        len -= s;
+        while (s-- > 0U)
+        {
+            *dst++ = *str++;
+        }
     }
 
-    pp->printfBuff[pp->printfBPtr++] = c;
     return FMSTR_TRUE;
 }
 
 /******************************************************************************
  *
- * @brief  This function finishes the number formatting, adds spacing, signs
- *         and reverses the string (the input is comming in reversed order)
+ * @brief  Put one character into pipe's printf formating buffer
  *
  *****************************************************************************/
 
-static FMSTR_BOOL _FMSTR_PipeIToAFinalize(FMSTR_HPIPE pipeHandle, FMSTR_PIPE_PRINTF_CTX *pctx)
+FMSTR_INLINE FMSTR_BOOL _FMSTR_PipePrintfPutc(FMSTR_HPIPE pipeHandle, char c)
 {
-    FMSTR_PIPE *pp = (FMSTR_PIPE *)pipeHandle;
-    FMSTR_SIZE bptr, minlen, i, bhalf;
-    FMSTR_CHAR z, sgn;
+    return _FMSTR_PipePrintfPutn(pipeHandle, &c, 1U);
+}
 
-    /* buffer pointer into local variable */
-    bptr = pp->printfBPtr;
+/******************************************************************************
+ *
+ * @brief  Put literal text up to the next '%' or end of format string
+ *
+ * @return The function returns the pointer to the first character not handled
+ *
+ *****************************************************************************/
 
-    /* if anything goes wrong, throw our prepared string away */
-    pp->printfBPtr = 0;
+static const char *_FMSTR_PipePrintfText(FMSTR_HPIPE pipeHandle, const char *format, FMSTR_BOOL *ok)
+{
+    const char *end = format;
 
-    /* zero may come as an empty string from itoa procedures */
-    if (bptr == 0U)
+    while (*end != (FMSTR_CHAR)0 && *end != '%')
     {
-        pp->printfBuff[0] = '0';
-        bptr              = 1;
+        end++;
     }
 
-    /* first strip the zeroes put by itoa */
-    while (bptr > 1U && pp->printfBuff[bptr - 1U] == '0')
-    {
-        bptr--;
-    }
+    *ok = _FMSTR_PipePrintfPutn(pipeHandle, format, (FMSTR_SIZE)(end - format));
+    return end;
+}
+
+/******************************************************************************
+ *
+ * @brief  Pairs of decimal digits "00".."99" used to emit two digits per step
+ *
+ *****************************************************************************/
+
+static const FMSTR_CHAR _FMSTR_PipeDec2Digits[200] = {
+    '0', '0', '0', '1', '0', '2', '0', '3', '0', '4', '0', '5', '0', '6', '0', '7', '0', '8', '0', '9',
+    '1', '0', '1', '1', '1', '2', '1', '3', '1', '4', '1', '5', '1', '6', '1', '7', '1', '8', '1', '9',
+    '2', '0', '2', '1', '2', '2', '2', '3', '2', '4', '2', '5', '2', '6', '2', '7', '2', '8', '2', '9',
+    '3', '0', '3', '1', '3', '2', '3', '3', '3', '4', '3', '5', '3', '6', '3', '7', '3', '8', '3', '9',
+    '4', '0', '4', '1', '4', '2', '4', '3', '4', '4', '4', '5', '4', '6', '4', '7', '4', '8', '4', '9',
+    '5', '0', '5', '1', '5', '2', '5', '3', '5', '4', '5', '5', '5', '6', '5', '7', '5', '8', '5', '9',
+    '6', '0', '6', '1', '6', '2', '6', '3', '6', '4', '6', '5', '6', '6', '6', '7', '6', '8', '6', '9',
+    '7', '0', '7', '1', '7', '2', '7', '3', '7', '4', '7', '5', '7', '6', '7', '7', '7', '8', '7', '9',
+    '8', '0', '8', '1', '8', '2', '8', '3', '8', '4', '8', '5', '8', '6', '8', '7', '8', '8', '8', '9',
+    '9', '0', '9', '1', '9', '2', '9', '3', '9', '4', '9', '5', '9', '6', '9', '7', '9', '8', '9', '9',
+};
+
+/******************************************************************************
+ *
+ * @brief  This function adds spacing and sign to digits prepared by
+ *         _FMSTR_PipeUToA and appends the whole field to the printf buffer
+ *
+ *****************************************************************************/
+
+static FMSTR_BOOL _FMSTR_PipeIToAFinalize(FMSTR_HPIPE pipeHandle,
+                                          const FMSTR_CHAR *digits,
+                                          FMSTR_SIZE8 dlen,
+                                          FMSTR_PIPE_PRINTF_CTX *pctx)
+{
+    FMSTR_PIPE *pp = (FMSTR_PIPE *)pipeHandle;
+    FMSTR_SIZE bptr, flen, pad;
+    FMSTR_CHAR z, sgn;
 
     /* determine sign to print */
     if (pctx->flags.flg.negative != 0U)
@@ -543,25 +662,43 @@ static FMSTR_BOOL _FMSTR_PipeIToAFinalize(FMSTR_HPIPE pipeHandle, FMSTR_PIPE_PRI
         pctx->flags.flg.showsign = 0U;
     }
 
-    /* calculate minimum buffer length needed */
-    minlen = bptr;
+    /* required length should never exceed the buffer length */
+    if (pctx->alen > FMSTR_PIPES_PRINTF_BUFF_SIZE)
+    {
+        pctx->alen = FMSTR_PIPES_PRINTF_BUFF_SIZE;
+    }
+
+    /* calculate field length */
+    flen = dlen;
     if (pctx->flags.flg.showsign != 0U)
     {
-        minlen++;
+        flen++;
     }
 
     /* will it fit? */
-    if (FMSTR_PIPES_PRINTF_BUFF_SIZE < minlen)
+    if (FMSTR_PIPES_PRINTF_BUFF_SIZE < flen)
     {
         return FMSTR_FALSE;
     }
 
-    /* required length should never exceed the buffer length */
-    if (pctx->alen > FMSTR_PIPES_PRINTF_BUFF_SIZE)
+    pad = 0U;
+    if (pctx->alen > flen)
     {
-        pctx->alen = FMSTR_PIPES_PRINTF_BUFF_SIZE;
+        pad  = (FMSTR_SIZE)(pctx->alen - flen);
+        flen = pctx->alen;
+    }
+
+    /* make room for the whole field, so it goes to the pipe in one write */
+    if ((pp->printfBPtr + flen) > FMSTR_PIPES_PRINTF_BUFF_SIZE)
+    {
+        if (_FMSTR_PipePrintfFlush(pipeHandle) == FMSTR_FALSE)
+        {
+            return FMSTR_FALSE;
+        }
     }
 
+    bptr = pp->printfBPtr;
+
     /* choose prefix character (zero, space or sign-extension OCT/HEX/BIN) */
     if (pctx->flags.flg.zeroes != 0U)
     {
@@ -590,162 +727,124 @@ static FMSTR_BOOL _FMSTR_PipeIToAFinalize(FMSTR_HPIPE pipeHandle, FMSTR_PIPE_PRI
         /* the sign will be in front of added zeroes */
         if (pctx->flags.flg.showsign != 0U)
         {
-            pctx->alen--;
+            pp->printfBuff[bptr++] = sgn;
+        }
+
+        while (pad-- > 0U)
+        {
+            pp->printfBuff[bptr++] = z;
         }
     }
     else
     {
-        z = ' ';
+        while (pad-- > 0U)
+        {
+            pp->printfBuff[bptr++] = ' ';
+        }
 
-        /* sign should be in front of the number */
+        /* sign should be right in front of the number */
         if (pctx->flags.flg.showsign != 0U)
         {
-            pp->printfBuff[bptr++]   = sgn;
-            pctx->flags.flg.showsign = 0; /* prevent it to be added again below  */
+            pp->printfBuff[bptr++] = sgn;
         }
     }
 
-    /* now fill to required len */
-    while (bptr < pctx->alen)
-    {
-        pp->printfBuff[bptr++] = z;
-    }
-
-    /* add the sign if needed */
-    if (pctx->flags.flg.showsign != 0U)
+    while (dlen-- > 0U)
     {
-        pp->printfBuff[bptr++] = sgn;
+        pp->printfBuff[bptr++] = *digits++;
     }
 
-    /* buffer contains this number of characters */
     pp->printfBPtr = bptr;
 
-    /* now reverse the string and feed it to pipe */
-    bhalf = bptr / 2U;
-    bptr--;
-    for (i = 0; i < bhalf; i++)
-    {
-        z                        = pp->printfBuff[i];
-        pp->printfBuff[i]        = pp->printfBuff[bptr - i];
-        pp->printfBuff[bptr - i] = z;
-    }
-
     return FMSTR_TRUE;
 }
 
 /******************************************************************************
  *
- * @brief  This function formats the argument into the temporary printf buffer
- *         It is granted by the caller that the buffer is empty before calling.
+ * @brief  Formatting core shared by all integer sizes. Digits are generated
+ *         backwards into a local buffer so no reversal is needed, decimal
+ *         digits are produced in pairs using reciprocal multiplication.
  *
  *****************************************************************************/
 
-static FMSTR_BOOL FMSTR_PipeU8ToA(FMSTR_HPIPE pipeHandle, const FMSTR_U8 *parg, FMSTR_PIPE_PRINTF_CTX *pctx)
+static FMSTR_BOOL _FMSTR_PipeUToA(FMSTR_HPIPE pipeHandle, FMSTR_U32 arg, FMSTR_PIPE_PRINTF_CTX *pctx)
 {
-    FMSTR_PIPE *pp = (FMSTR_PIPE *)pipeHandle;
-    FMSTR_U8 arg   = *parg;
-    FMSTR_U8 dig;
-    FMSTR_INDEX i;
+    FMSTR_CHAR digits[32];
+    FMSTR_CHAR *p = &digits[sizeof(digits)];
+    FMSTR_U32 q, r;
 
     switch (pctx->radix)
     {
         case FMSTR_PIPE_ITOAFMT_CHAR:
-            pp->printfBuff[pp->printfBPtr++] = (FMSTR_CHAR)arg;
+            *--p = (FMSTR_CHAR)arg;
             break;
 
         case FMSTR_PIPE_ITOAFMT_BIN:
-            if (FMSTR_PIPES_PRINTF_BUFF_SIZE < 8U)
+            do
             {
-                return FMSTR_FALSE;
-            }
-
-            for (i = 0; i < 8; i++)
-            {
-                if (arg == 0U)
-                {
-                    break;
-                }
-
-                dig = (FMSTR_U8)'0';
-                dig += (FMSTR_U8)(arg & 1U);
-
-                pp->printfBuff[pp->printfBPtr++] = (FMSTR_CHAR)dig;
+                *--p = (FMSTR_CHAR)('0' + (arg & 1U));
                 arg >>= 1;
-            }
+            } while (arg != 0U);
             break;
 
         case FMSTR_PIPE_ITOAFMT_OCT:
-            if (FMSTR_PIPES_PRINTF_BUFF_SIZE < 3U)
+            do
             {
-                return FMSTR_FALSE;
-            }
-
-            for (i = 0; i < 3; i++)
-            {
-                if (arg == 0U)
-                {
-                    break;
-                }
-
-                dig = (FMSTR_U8)'0';
-                dig += (FMSTR_U8)(arg & 7U);
-
-                pp->printfBuff[pp->printfBPtr++] = (FMSTR_CHAR)dig;
+                *--p = (FMSTR_CHAR)('0' + (arg & 7U));
                 arg >>= 3;
-            }
+            } while (arg != 0U);
             break;
 
         case FMSTR_PIPE_ITOAFMT_DEC:
-            if (FMSTR_PIPES_PRINTF_BUFF_SIZE < 3U)
+            while (arg >= 100U)
             {
-                return FMSTR_FALSE;
+                /* q = arg / 100, exact for the whole 32bit range */
+                q = (FMSTR_U32)(((FMSTR_U64)arg * 0x51EB851FU) >> 37);
+                r = (FMSTR_U32)(arg - (q * 100U)) * 2U;
+                arg = q;
+
+                *--p = _FMSTR_PipeDec2Digits[r + 1U];
+                *--p = _FMSTR_PipeDec2Digits[r];
             }
 
-            for (i = 0; i < 3; i++)
+            if (arg >= 10U)
             {
-                if (arg == 0U)
-                {
-                    break;
-                }
-
-                dig = (FMSTR_U8)'0';
-                dig += (FMSTR_U8)(arg % 10U);
-
-                pp->printfBuff[pp->printfBPtr++] = (FMSTR_CHAR)dig;
-                arg /= 10U;
+                *--p = _FMSTR_PipeDec2Digits[(arg * 2U) + 1U];
+                *--p = _FMSTR_PipeDec2Digits[arg * 2U];
+            }
+            else
+            {
+                *--p = (FMSTR_CHAR)('0' + arg);
             }
             break;
 
         case FMSTR_PIPE_ITOAFMT_HEX:
         default:
-            if (FMSTR_PIPES_PRINTF_BUFF_SIZE < 2U)
-            {
-                return FMSTR_FALSE;
-            }
-
-            for (i = 0; i < 2; i++)
+            do
             {
-                if (arg == 0U)
-                {
-                    break;
-                }
-
-                dig = (FMSTR_U8)(arg & 15U);
-
-                pp->printfBuff[pp->printfBPtr++] =
-                    _FMSTR_XDigit((FMSTR_U8)dig, (FMSTR_BOOL)(pctx->flags.flg.upperc != 0U));
+                *--p = _FMSTR_XDigit((FMSTR_U8)(arg & 15U), (FMSTR_BOOL)(pctx->flags.flg.upperc != 0U));
                 arg >>= 4;
-            }
+            } while (arg != 0U);
             break;
     }
 
-    return _FMSTR_PipeIToAFinalize(pipeHandle, pctx);
+    return _FMSTR_PipeIToAFinalize(pipeHandle, p, (FMSTR_SIZE8)(&digits[sizeof(digits)] - p), pctx);
 }
 
 /******************************************************************************
  *
- * @brief  This function formats the argument into the temporary printf buffer
- *         It is granted by the caller that the buffer is empty before calling.
+ * @brief  This function formats the argument into the printf buffer
+ *
+ *****************************************************************************/
+
+static FMSTR_BOOL FMSTR_PipeU8ToA(FMSTR_HPIPE pipeHandle, const FMSTR_U8 *parg, FMSTR_PIPE_PRINTF_CTX *pctx)
+{
+    return _FMSTR_PipeUToA(pipeHandle, (FMSTR_U32)*parg, pctx);
+}
+
+/******************************************************************************
+ *
+ * @brief  This function formats the argument into the printf buffer
  *
  *****************************************************************************/
 
@@ -769,117 +868,18 @@ static FMSTR_BOOL FMSTR_PipeS8ToA(FMSTR_HPIPE pipeHandle, const FMSTR_S8 *parg,
 
 /******************************************************************************
  *
- * @brief  This function formats the argument into the temporary printf buffer
- *         It is granted by the caller that the buffer is empty before calling.
+ * @brief  This function formats the argument into the printf buffer
  *
  *****************************************************************************/
 
 static FMSTR_BOOL FMSTR_PipeU16ToA(FMSTR_HPIPE pipeHandle, const FMSTR_U16 *parg, FMSTR_PIPE_PRINTF_CTX *pctx)
 {
-    FMSTR_PIPE *pp = (FMSTR_PIPE *)pipeHandle;
-    FMSTR_U16 arg  = *parg;
-    FMSTR_U8 dig;
-    FMSTR_INDEX i;
-
-    switch (pctx->radix)
-    {
-        case FMSTR_PIPE_ITOAFMT_CHAR:
-            pp->printfBuff[pp->printfBPtr++] = (FMSTR_CHAR)arg;
-            break;
-
-        case FMSTR_PIPE_ITOAFMT_BIN:
-            if (FMSTR_PIPES_PRINTF_BUFF_SIZE < 16U)
-            {
-                return FMSTR_FALSE;
-            }
-
-            for (i = 0; i < 16; i++)
-            {
-                if (arg == 0U)
-                {
-                    break;
-                }
-
-                dig = (FMSTR_U8)'0';
-                dig += (FMSTR_U8)(arg & 1U);
-
-                pp->printfBuff[pp->printfBPtr++] = (FMSTR_CHAR)dig;
-                arg >>= 1;
-            }
-            break;
-
-        case FMSTR_PIPE_ITOAFMT_OCT:
-            if (FMSTR_PIPES_PRINTF_BUFF_SIZE < 6U)
-            {
-                return FMSTR_FALSE;
-            }
-
-            for (i = 0; i < 6; i++)
-            {
-                if (arg == 0U)
-                {
-                    break;
-                }
-
-                dig = (FMSTR_U8)'0';
-                dig += (FMSTR_U8)(arg & 7U);
-
-                pp->printfBuff[pp->printfBPtr++] = (FMSTR_CHAR)dig;
-                arg >>= 3;
-            }
-            break;
-
-        case FMSTR_PIPE_ITOAFMT_DEC:
-            if (FMSTR_PIPES_PRINTF_BUFF_SIZE < 5U)
-            {
-                return FMSTR_FALSE;
-            }
-
-            for (i = 0; i < 5; i++)
-            {
-                if (arg == 0U)
-                {
-                    break;
-                }
-
-                dig = (FMSTR_U8)'0';
-                dig += (FMSTR_U8)(arg % 10U);
-
-                pp->printfBuff[pp->printfBPtr++] = (FMSTR_CHAR)dig;
-                arg /= 10U;
-            }
-            break;
-
-        case FMSTR_PIPE_ITOAFMT_HEX:
-        default:
-            if (FMSTR_PIPES_PRINTF_BUFF_SIZE < 4U)
-            {
-                return FMSTR_FALSE;
-            }
-
-            for (i = 0; i < 4; i++)
-            {
-                if (arg == 0U)
-                {
-                    break;
-                }
-
-                dig = (FMSTR_U8)(arg & 15U);
-
-                pp->printfBuff[pp->printfBPtr++] =
-                    _FMSTR_XDigit((FMSTR_U8)dig, (FMSTR_BOOL)(pctx->flags.flg.upperc != 0U));
-                arg >>= 4;
-            }
-            break;
-    }
-
-    return _FMSTR_PipeIToAFinalize(pipeHandle, pctx);
+    return _FMSTR_PipeUToA(pipeHandle, (FMSTR_U32)*parg, pctx);
 }
 
 /******************************************************************************
  *
- * @brief  This function formats the argument into the temporary printf buffer
- *         It is granted by the caller that the buffer is empty before calling.
+ * @brief  This function formats the argument into the printf buffer
  *
  *****************************************************************************/
 
@@ -903,117 +903,18 @@ static FMSTR_BOOL FMSTR_PipeS16ToA(FMSTR_HPIPE pipeHandle, const FMSTR_S16 *parg
 
 /******************************************************************************
  *
- * @brief  This function formats the argument into the temporary printf buffer
- *         It is granted by the caller that the buffer is empty before calling.
+ * @brief  This function formats the argument into the printf buffer
  *
  *****************************************************************************/
 
 static FMSTR_BOOL FMSTR_PipeU32ToA(FMSTR_HPIPE pipeHandle, const FMSTR_U32 *parg, FMSTR_PIPE_PRINTF_CTX *pctx)
 {
-    FMSTR_PIPE *pp = (FMSTR_PIPE *)pipeHandle;
-    FMSTR_U32 arg  = *parg;
-    FMSTR_U8 dig;
-    FMSTR_INDEX i;
-
-    switch (pctx->radix)
-    {
-        case FMSTR_PIPE_ITOAFMT_CHAR:
-            pp->printfBuff[pp->printfBPtr++] = (char)arg;
-            break;
-
-        case FMSTR_PIPE_ITOAFMT_BIN:
-            if (FMSTR_PIPES_PRINTF_BUFF_SIZE < 32U)
-            {
-                return FMSTR_FALSE;
-            }
-
-            for (i = 0; i < 32; i++)
-            {
-                if (arg == 0U)
-                {
-                    break;
-                }
-
-                dig = (FMSTR_U8)'0';
-                dig += (FMSTR_U8)(arg & 1U);
-
-                pp->printfBuff[pp->printfBPtr++] = (FMSTR_CHAR)dig;
-                arg >>= 1;
-            }
-            break;
-
-        case FMSTR_PIPE_ITOAFMT_OCT:
-            if (FMSTR_PIPES_PRINTF_BUFF_SIZE < 11U)
-            {
-                return FMSTR_FALSE;
-            }
-
-            for (i = 0; i < 11; i++)
-            {
-                if (arg == 0U)
-                {
-                    break;
-                }
-
-                dig = (FMSTR_U8)'0';
-                dig += (FMSTR_U8)(arg & 7U);
-
-                pp->printfBuff[pp->printfBPtr++] = (FMSTR_CHAR)dig;
-                arg >>= 3;
-            }
-            break;
-
-        case FMSTR_PIPE_ITOAFMT_DEC:
-            if (FMSTR_PIPES_PRINTF_BUFF_SIZE < 10U)
-            {
-                return FMSTR_FALSE;
-            }
-
-            for (i = 0; i < 10; i++)
-            {
-                if (arg == 0U)
-                {
-                    break;
-                }
-
-                dig = (FMSTR_U8)'0';
-                dig += (FMSTR_U8)(arg % 10U);
-
-                pp->printfBuff[pp->printfBPtr++] = (FMSTR_CHAR)dig;
-                arg /= 10U;
-            }
-            break;
-
-        case FMSTR_PIPE_ITOAFMT_HEX:
-        default:
-            if (FMSTR_PIPES_PRINTF_BUFF_SIZE < 8U)
-            {
-                return FMSTR_FALSE;
-            }
-
-            for (i = 0; i < 8; i++)
-            {
-                if (arg == 0U)
-                {
-                    break;
-                }
-
-                dig = (FMSTR_U8)(arg & 15U);
-
-                pp->printfBuff[pp->printfBPtr++] =
-                    _FMSTR_XDigit((FMSTR_U8)dig, (FMSTR_BOOL)(pctx->flags.flg.upperc != 0U));
-                arg >>= 4;
-            }
-            break;
-    }
-
-    return _FMSTR_PipeIToAFinalize(pipeHandle, pctx);
+    return _FMSTR_PipeUToA(pipeHandle, *parg, pctx);
 }
 
 /******************************************************************************
  *
- * @brief  This function formats the argument into the temporary printf buffer
- *         It is granted by the caller that the buffer is empty before calling.
+ * @brief  This function formats the argument into the printf buffer
  *
  *****************************************************************************/
 
@@ -1192,27 +1093,27 @@ static FMSTR_BOOL _FMSTR_PipePrintfOne(FMSTR_HPIPE pipeHandle,
                 continue;
             }
 
-            /* empty the pipe's temporary buffer */
-            ok = _FMSTR_PipePrintfFlush(pipeHandle);
+            format = FMSTR_PipeParseFormat(format, &ctx);
 
-            if (ok != FMSTR_FALSE)
+            if (ctx.flags.flg.isstring != 0U)
             {
-                format = FMSTR_PipeParseFormat(format, &ctx);
+                const char *psz = (const char *)parg;
 
-                if (ctx.flags.flg.isstring != 0U)
-                {
-                    const char *psz = (const char *)parg;
-                    ok              = FMSTR_PipePuts(pipeHandle, psz != NULL ? psz : "NULL");
-                }
-                else
+                /* string goes to the pipe directly, empty the pipe's temporary buffer first */
+                ok = _FMSTR_PipePrintfFlush(pipeHandle);
+                if (ok != FMSTR_FALSE)
                 {
-                    ok = pItoaFunc(pipeHandle, parg, &ctx);
+                    ok = FMSTR_PipePuts(pipeHandle, psz != NULL ? psz : "NULL");
                 }
             }
+            else
+            {
+                ok = pItoaFunc(pipeHandle, parg, &ctx);
+            }
         }
         else
         {
-            ok = _FMSTR_PipePrintfPutc(pipeHandle, *format++);
+            format = _FMSTR_PipePrintfText(pipeHandle, format, &ok);
         }
     }
 
@@ -1383,27 +1284,28 @@ static FMSTR_BOOL _FMSTR_PipePrintfV(FMSTR_HPIPE pipeHandle, const char *format,
             }
             else
             {
-                ok = _FMSTR_PipePrintfFlush(pipeHandle);
+                format = FMSTR_PipeParseFormat(format, &ctx);
 
-                if (ok != FMSTR_FALSE)
+                if (ctx.flags.flg.isstring != 0U)
                 {
-                    format = FMSTR_PipeParseFormat(format, &ctx);
+                    const char *psz = va_arg(*parg, char *);
 
-                    if (ctx.flags.flg.isstring != 0U)
+                    /* string goes to the pipe directly, empty the pipe's temporary buffer first */
+                    ok = _FMSTR_PipePrintfFlush(pipeHandle);
+                    if (ok != FMSTR_FALSE)
                     {
-                        const char *psz = va_arg(*parg, char *);
-                        ok              = FMSTR_PipePuts(pipeHandle, psz != NULL ? psz : "NULL");
-                    }
-                    else
-                    {
-                        ok = _FMSTR_PipePrintfAny(pipeHandle, parg, &ctx);
+                        ok = FMSTR_PipePuts(pipeHandle, psz != NULL ? psz : "NULL");
                     }
                 }
+                else
+                {
+                    ok = _FMSTR_PipePrintfAny(pipeHandle, parg, &ctx);
+                }
             }
         }
         else
         {
-            ok = _FMSTR_PipePrintfPutc(pipeHandle, *format++);
+            format = _FMSTR_PipePrintfText(pipeHandle, format, &ok);
         }
     }
 
@@ -1640,6 +1542,136 @@ static void _FMSTR_PipeDiscardBytes(FMSTR_PIPE_BUFF *pipeBuff, FMSTR_SIZE8 count
     }
 }
 
+/******************************************************************************
+ *
+ * @brief  Transmit-side accessors, hiding whether the pipe's own tx buffer or
+ *         an application ring is used
+ *
+ ******************************************************************************/
+
+static FMSTR_PIPE_SIZE _FMSTR_PipeGetTxBytesFree(FMSTR_PIPE *pp)
+{
+#if FMSTR_USE_PIPE_TXRING > 0
+    if (pp->txRing != NULL)
+    {
+        return (FMSTR_PIPE_SIZE)(pp->txRing->size - (FMSTR_PIPE_SIZE)(pp->txRing->wp - pp->txRing->rp));
+    }
+#endif
+
+    return _FMSTR_PipeGetBytesFree(&pp->tx);
+}
+
+static FMSTR_PIPE_SIZE _FMSTR_PipeGetTxBytesReady(FMSTR_PIPE *pp)
+{
+#if FMSTR_USE_PIPE_TXRING > 0
+    if (pp->txRing != NULL)
+    {
+        return (FMSTR_PIPE_SIZE)(pp->txRing->wp - pp->txRing->rp);
+    }
+#endif
+
+    return _FMSTR_PipeGetBytesReady(&pp->tx);
+}
+
+static void _FMSTR_PipeDiscardTxBytes(FMSTR_PIPE *pp, FMSTR_SIZE8 countBytes)
+{
+#if FMSTR_USE_PIPE_TXRING > 0
+    if (pp->txRing != NULL)
+    {
+        FMSTR_PIPE_SIZE ready = _FMSTR_PipeGetTxBytesReady(pp);
+
+        /* host can never acknowledge more than was sent */
+        pp->txRing->rp += (FMSTR_PIPE_SIZE)(countBytes > ready ? ready : countBytes);
+        return;
+    }
+#endif
+
+    _FMSTR_PipeDiscardBytes(&pp->tx, countBytes);
+}
+
+#if FMSTR_USE_PIPE_TXRING > 0
+
+/* copy data into the application ring, used when FMSTR_PipeWrite/Printf is called on a ring pipe */
+
+static FMSTR_PIPE_SIZE _FMSTR_PipeRingWrite(FMSTR_PIPE_RING *ring,
+                                            FMSTR_ADDR pipeData,
+                                            FMSTR_PIPE_SIZE pipeDataLen,
+                                            FMSTR_PIPE_SIZE writeGranularity)
+{
+    FMSTR_PIPE_SIZE mask  = (FMSTR_PIPE_SIZE)(ring->size - 1U);
+    FMSTR_PIPE_SIZE total = (FMSTR_PIPE_SIZE)(ring->size - (FMSTR_PIPE_SIZE)(ring->wp - ring->rp));
+    FMSTR_PIPE_SIZE wp, s;
+
+    /* when invalid address is given, just return number of bytes free */
+    if (pipeData == NULL)
+    {
+        return total;
+    }
+
+    if (pipeDataLen > total)
+    {
+        pipeDataLen = total;
+    }
+
+    if (writeGranularity > 1U)
+    {
+        pipeDataLen /= writeGranularity;
+        pipeDataLen *= writeGranularity;
+    }
+
+    if (pipeDataLen > 0U)
+    {
+        wp = (FMSTR_PIPE_SIZE)(ring->wp & mask);
+        s  = (FMSTR_PIPE_SIZE)(ring->size - wp);
+        if (s > pipeDataLen)
+        {
+            s = pipeDataLen;
+        }
+
+        FMSTR_MemCpy(ring->buff + wp, pipeData, s);
+        if (pipeDataLen > s)
+        {
+            FMSTR_MemCpy(ring->buff, pipeData + s, (FMSTR_SIZE)(pipeDataLen - s));
+        }
+
+        /* publish data only after it is stored */
+        ring->wp += pipeDataLen;
+    }
+
+    return pipeDataLen;
+}
+
+/* put data into the comm buffer straight from application ring, ring's RP is not modified */
+
+static FMSTR_BPTR _FMSTR_PipeRingTransmit(FMSTR_BPTR msgBuffIO, FMSTR_PIPE_RING *ring, FMSTR_SIZE8 msgBuffSize)
+{
+    FMSTR_PIPE_SIZE rp = (FMSTR_PIPE_SIZE)(ring->rp & (ring->size - 1U));
+    FMSTR_PIPE_SIZE s;
+
+    if (msgBuffSize > 0U)
+    {
+        /* contiguous part up to the end of ring */
+        s = (FMSTR_PIPE_SIZE)(ring->size - rp);
+        if (s > (FMSTR_PIPE_SIZE)msgBuffSize)
+        {
+            s = (FMSTR_PIPE_SIZE)msgBuffSize;
+        }
+
+        msgBuffIO = FMSTR_CopyToBuffer(msgBuffIO, ring->buff + rp, (FMSTR_SIZE8)s);
+
+        /* rest of frame from a (wrapped) beginning of ring */
+        msgBuffSize -= (FMSTR_SIZE8)s;
+        if (msgBuffSize > 0U)
+        {
+            msgBuffIO = FMSTR_CopyToBuffer(msgBuffIO, ring->buff, msgBuffSize);
+        }
+    }
+
+    return msgBuffIO;
+}
+
+#endif /* FMSTR_USE_PIPE_TXRING */
+
 /* get data from frame into our Rx buffer, we are already sure it fits */
 
 static FMSTR_BPTR _FMSTR_PipeReceive(FMSTR_BPTR msgBuffIO, FMSTR_PIPE *pp, FMSTR_SIZE8 msgBuffSize)
@@ -1908,7 +1940,7 @@ FMSTR_BPTR FMSTR_PipeFrame(FMSTR_SESSION *session, FMSTR_BPTR msgBuffIO, FMSTR_S
         /* discard bytes from pipe's transmit buffer */
         if (skipLen > 0U)
         {
-            _FMSTR_PipeDiscardBytes(&pp->tx, skipLen);
+            _FMSTR_PipeDiscardTxBytes(pp, skipLen);
         }
 
         /* next come (msgSize-2) bytes to be received */
@@ -1955,9 +1987,11 @@ FMSTR_BPTR FMSTR_PipeFrame(FMSTR_SESSION *session, FMSTR_BPTR msgBuffIO, FMSTR_S
     /* now put our output data */
     {
         /* how many bytes are waiting to be sent? */
-        FMSTR_PIPE_SIZE txAvail = _FMSTR_PipeGetBytesReady(&pp->tx);
-        /* how many bytes I can safely put? */
-        FMSTR_U8 txToSend = (FMSTR_U8)FMSTR_COMM_BUFFER_SIZE - 3U;
+        FMSTR_PIPE_SIZE txAvail = _FMSTR_PipeGetTxBytesReady(pp);
+        /* how many bytes I can safely put? The count is acknowledged in one byte, larger
+           (network) buffers are limited to 255 */
+        FMSTR_U8 txToSend =
+            ((FMSTR_COMM_BUFFER_SIZE - 3U) > 0xFFU) ? 0xFFU : (FMSTR_U8)(FMSTR_COMM_BUFFER_SIZE - 3U);
 
         /* round to bus width */
         txToSend /= FMSTR_CFG_BUS_WIDTH;
@@ -1979,7 +2013,16 @@ FMSTR_BPTR FMSTR_PipeFrame(FMSTR_SESSION *session, FMSTR_BPTR msgBuffIO, FMSTR_S
         /* put data */
         if (txToSend != 0U)
         {
-            response = _FMSTR_PipeTransmit(response, pp, txToSend);
+#if FMSTR_USE_PIPE_TXRING > 0
+            if (pp->txRing != NULL)
+            {
+                response = _FMSTR_PipeRingTransmit(response, pp->txRing, txToSend);
+            }
+            else
+#endif
+            {
+                response = _FMSTR_PipeTransmit(response, pp, txToSend);
+            }
         }
     }
 
@@ -2044,6 +2087,14 @@ FMSTR_PIPE_SIZE FMSTR_PipeRead(FMSTR_HPIPE pipeHandle,
     return 0U;
 }
 
+FMSTR_BOOL FMSTR_PipeAttachTxRing(FMSTR_HPIPE pipeHandle, FMSTR_PIPE_RING *txRing)
+{
+    FMSTR_UNUSED(pipeHandle);
+    FMSTR_UNUSED(txRing);
+
+    return FMSTR_FALSE;
+}
+
 /*lint -efile(766, freemaster_protocol.h) include file is not used in this case */
 
 #endif /* FMSTR_USE_PIPES  && (!FMSTR_DISABLE) */
@@ -198,6 +198,11 @@ void FMSTR_SendResponse(FMSTR_BPTR response, FMSTR_SIZE length, FMSTR_U8 statusC
 FMSTR_BOOL FMSTR_ProtocolDecoder(FMSTR_BPTR msgBuffIO, FMSTR_SIZE msgSize, FMSTR_U8 cmdCode, void *identification);
 FMSTR_BOOL FMSTR_SendTestFrame(FMSTR_BPTR msgBuffIO, FMSTR_SESSION *session);
 
+#if FMSTR_USE_READ_CACHE > 0
+FMSTR_BPTR FMSTR_ReadCacheGet(FMSTR_BPTR destBuff, FMSTR_ADDR srcAddr, FMSTR_SIZE size);
+FMSTR_BPTR FMSTR_ReadCacheFill(FMSTR_BPTR destBuff, FMSTR_ADDR srcAddr, FMSTR_SIZE size);
+#endif
+
 #if FMSTR_USE_APPCMD > 0
 FMSTR_BOOL FMSTR_InitAppCmds(void);
 FMSTR_BPTR FMSTR_StoreAppCmd(FMSTR_SESSION *session, FMSTR_BPTR msgBuffIO, FMSTR_SIZE msgSize, FMSTR_U8 *retStatus);
@@ -369,6 +374,11 @@ FMSTR_SIZE FMSTR_GetAlignmentCorrection(FMSTR_ADDR addr, FMSTR_SIZE size);
 #error Pipe printf buffer should not exceed 255 (see FMSTR_PIPES_PRINTF_BUFF_SIZE)
 #endif
 
+/* application rings are indexed in bytes */
+#if FMSTR_USE_PIPE_TXRING > 0 && FMSTR_CFG_BUS_WIDTH > 1
+#error Pipe transmit rings are only supported on byte-addressable platforms (see FMSTR_USE_PIPE_TXRING)
+#endif
+
 /* obsolete configuration options */
 #if defined(FMSTR_MAX_PIPES_COUNT)
 #warning The FMSTR_MAX_PIPES_COUNT option is obsolete. Specify number of used pipes as FMSTR_USE_PIPES
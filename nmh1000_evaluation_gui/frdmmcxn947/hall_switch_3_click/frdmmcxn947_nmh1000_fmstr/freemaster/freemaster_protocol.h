@@ -49,6 +49,7 @@
 #define FMSTR_CANSPC_PING       0xC0U
 #define FMSTR_NET_PING          0xC0U
 #define FMSTR_NET_DISCOVERY     0xC1U
+#define FMSTR_SERIAL_LARGE      0xC2U /* serial large-message frame: command, 16-bit length, data and CRC16 follow */
 
 /*-------------------------------------
   response message - status byte
@@ -249,12 +249,16 @@ FMSTR_BOOL FMSTR_InitRec(void)
  * @param    recBuffer - user buffer pointer
  * @param    recBuffSize - buffer size
  *
+ * A recorder created before gets the new buffer when it is not running, the
+ * host has to configure it again.
  *
  ******************************************************************************/
 
 FMSTR_BOOL FMSTR_RecorderCreate(FMSTR_INDEX recIndex, FMSTR_REC_BUFF *buffCfg)
 {
     FMSTR_REC_BUFF *recBuff;
+    FMSTR_REC_BUFF newBuff;
+    FMSTR_LP_REC recorder;
     FMSTR_SIZE alignment;
 
     /* Check the input parameters */
@@ -287,22 +291,30 @@ FMSTR_BOOL FMSTR_RecorderCreate(FMSTR_INDEX recIndex, FMSTR_REC_BUFF *buffCfg)
         return FMSTR_FALSE;
     }
 
-    /* The buffer should not yet be used */
+    /* A buffer already in use may only be replaced while the recorder is idle */
     if (FMSTR_ADDR_VALID(recBuff->addr) != FMSTR_FALSE)
     {
-        return FMSTR_FALSE;
-    }
+        recorder = (FMSTR_LP_REC)FMSTR_CAST_ADDR_TO_PTR(recBuff->addr);
+        if (recorder->flags.flg.isRunning != 0U)
+        {
+            return FMSTR_FALSE;
+        }
 
-    /* Set up the recorder buffer */
-    *recBuff = *buffCfg;
+        /* FMSTR_Recorder() sees no recorder until the new buffer is ready */
+        recBuff->addr = NULL;
+    }
 
-    /* Clean up the buffer */
-    FMSTR_MemSet(recBuff->addr, 0, recBuff->size);
+    /* Clean up the buffer, it may be uninitialized memory */
+    newBuff = *buffCfg;
+    FMSTR_MemSet(newBuff.addr, 0, newBuff.size);
 
     /* Align buffer base address */
-    alignment = FMSTR_GetAlignmentCorrection(recBuff->addr, FMSTR_REC_STRUCT_ALIGN);
-    recBuff->addr += alignment;
-    recBuff->size -= alignment;
+    alignment = FMSTR_GetAlignmentCorrection(newBuff.addr, FMSTR_REC_STRUCT_ALIGN);
+    newBuff.addr += alignment;
+    newBuff.size -= alignment;
+
+    /* Set up the recorder buffer */
+    *recBuff = newBuff;
 
     return FMSTR_TRUE;
 }
@@ -40,7 +40,7 @@
  *  local variables
  ***********************************/
 
-/* FreeMASTER communication buffer (in/out) plus the STS, LEN(LEB) and CRC bytes */
+/* FreeMASTER communication buffer (in/out) plus the STS, LEN(LEB) and CRC bytes, large-message frames fit too */
 static FMSTR_BCHR fmstr_pCommBuffer[FMSTR_COMM_BUFFER_SIZE + 1 + 4 + 2];
 
 /* FreeMASTER runtime flags */
@@ -56,6 +56,8 @@ typedef volatile union
         unsigned bTxLastCharSOB : 1;   /* last transmitted char was equal to SOB  */
         unsigned bRxLastCharSOB : 1;   /* last received character was SOB */
         unsigned bRxMsgLengthNext : 1; /* expect the length byte next time */
+        unsigned bTxBlockSOB : 1;      /* initial SOB not yet put into a transmit packet */
+        unsigned bRxLarge : 1;         /* large-message frame received, answered the same way */
     } flg;
 
 } FMSTR_SERIAL_FLAGS;
@@ -63,15 +65,25 @@ typedef volatile union
 static FMSTR_SERIAL_FLAGS _fmstr_wFlags;
 
 /* receive and transmit buffers and counters */
-static FMSTR_SIZE8 fmstr_nTxTodo; /* transmission to-do counter (0 when tx is idle) */
-static FMSTR_SIZE8 fmstr_nRxTodo; /* reception to-do counter (0 when rx is idle) */
-static FMSTR_BPTR fmstr_pTxBuff;  /* pointer to next byte to transmit */
-static FMSTR_BPTR fmstr_pRxBuff;  /* pointer to next free place in RX buffer */
-static FMSTR_BCHR fmstr_nRxCrc8;  /* checksum of data being received for short messages */
+static FMSTR_SIZE fmstr_nTxTodo; /* transmission to-do counter (0 when tx is idle) */
+static FMSTR_SIZE fmstr_nRxTodo; /* reception to-do counter (0 when rx is idle) */
+static FMSTR_BPTR fmstr_pTxBuff; /* pointer to next byte to transmit */
+static FMSTR_BPTR fmstr_pRxBuff; /* pointer to next free place in RX buffer */
+static FMSTR_BCHR fmstr_nRxCrc8; /* checksum of data being received for short messages */
+#if FMSTR_SERIAL_LARGE_MSG > 0
+static FMSTR_U16 fmstr_nRxCrc16; /* checksum of large-message frames */
+#endif
+
+#if FMSTR_USE_SERIAL_STATS > 0
+static FMSTR_SERIAL_STATS fmstr_serialStats; /* frame and error counters */
+#endif
 
 /* Maximal length of message to use 8 bit CRC8. */
 #define FMSTR_SHORT_MSG_LEN 128
 
+/* Large-message frames: command or status, 16-bit length, then the data */
+#define FMSTR_LARGE_MSG_HDR 3U
+
 #if FMSTR_DEBUG_TX > 0
 /* The poll counter is used to roughly measure duration of test frame transmission.
  * The test frame will be sent once per N.times this measured period. */
@@ -89,6 +101,11 @@ static void _FMSTR_Listen(void);
 static void _FMSTR_SendError(FMSTR_BCHR nErrCode);
 static FMSTR_BOOL _FMSTR_Tx(FMSTR_BCHR *getTxChar);
 static FMSTR_BOOL _FMSTR_Rx(FMSTR_BCHR rxChar);
+#if FMSTR_SERIAL_LARGE_MSG > 0
+static FMSTR_BOOL _FMSTR_RxLarge(FMSTR_BCHR rxChar);
+#endif
+static FMSTR_BOOL _FMSTR_TxBlocks(void);
+static void _FMSTR_RxBlocks(void);
 
 /***********************************
  *  local variables
@@ -184,8 +201,13 @@ void FMSTR_ProcessSerial(void)
     /* transmitter active and empty? */
     if (_fmstr_wFlags.flg.bTxActive != 0U)
     {
+        /* block driver takes whole packets, the response may already be complete */
+        if (FMSTR_SERIAL_DRV.GetTxBlock != NULL)
+        {
+            endOfPacket = (_fmstr_wFlags.flg.bTxWaitTC == 0U) ? _FMSTR_TxBlocks() : FMSTR_FALSE;
+        }
         /* able to accept another character? */
-        while (FMSTR_SERIAL_DRV.IsTransmitRegEmpty() != FMSTR_FALSE)
+        else while (FMSTR_SERIAL_DRV.IsTransmitRegEmpty() != FMSTR_FALSE)
         {
             FMSTR_BCHR ch;
             /* just put the byte into the SCI transmit buffer */
@@ -236,8 +258,13 @@ void FMSTR_ProcessSerial(void)
     /* transmitter not active, able to receive */
     else
     {
+        /* block driver hands over whole received packets */
+        if (FMSTR_SERIAL_DRV.GetRxBlock != NULL)
+        {
+            _FMSTR_RxBlocks();
+        }
         /* data byte received? */
-        while (FMSTR_SERIAL_DRV.IsReceiveRegFull() != FMSTR_FALSE)
+        else while (FMSTR_SERIAL_DRV.IsReceiveRegFull() != FMSTR_FALSE)
         {
             FMSTR_BCHR rxChar = 0U;
             rxChar            = FMSTR_SERIAL_DRV.GetChar();
@@ -267,6 +294,97 @@ void FMSTR_ProcessSerial(void)
     }
 }
 
+/******************************************************************************
+ *
+ * @brief    Encode the response into transmit packets of a block driver
+ *
+ * @return Non-zero when the whole response was handed over to the driver
+ *
+ * Fills every free packet the driver offers, the rest of the response waits
+ * for the next call.
+ *
+ ******************************************************************************/
+
+static FMSTR_BOOL _FMSTR_TxBlocks(void)
+{
+    FMSTR_BOOL endOfPacket = FMSTR_FALSE;
+    FMSTR_BPTR pBlock;
+    FMSTR_SIZE size;
+
+    while (endOfPacket == FMSTR_FALSE)
+    {
+        FMSTR_SIZE i = 0U;
+
+        size = FMSTR_SERIAL_DRV.GetTxBlock(&pBlock);
+        if (size == 0U)
+        {
+            break;
+        }
+
+        if (_fmstr_wFlags.flg.bTxBlockSOB != 0U)
+        {
+            pBlock[i++]                    = FMSTR_SOB;
+            _fmstr_wFlags.flg.bTxBlockSOB = 0U;
+        }
+
+        /* SOB replication of _FMSTR_Tx applies as with the character drivers */
+        while (i < size)
+        {
+            endOfPacket = _FMSTR_Tx(&pBlock[i]);
+            if (endOfPacket != FMSTR_FALSE)
+            {
+                break;
+            }
+            i++;
+        }
+
+        if (i > 0U)
+        {
+            FMSTR_SERIAL_DRV.PutTxBlock(i);
+        }
+    }
+
+    return endOfPacket;
+}
+
+/******************************************************************************
+ *
+ * @brief    Decode received packets of a block driver
+ *
+ * Consumes the received data up to the end of a frame. Data following the
+ * frame stay in the driver until the response is sent.
+ *
+ ******************************************************************************/
+
+static void _FMSTR_RxBlocks(void)
+{
+    FMSTR_BPTR pBlock;
+    FMSTR_SIZE size;
+
+    while ((size = FMSTR_SERIAL_DRV.GetRxBlock(&pBlock)) > 0U)
+    {
+        FMSTR_BOOL endOfFrame = FMSTR_FALSE;
+        FMSTR_SIZE i          = 0U;
+
+        while ((i < size) && (endOfFrame == FMSTR_FALSE))
+        {
+#if FMSTR_DEBUG_LEVEL >= 3
+            FMSTR_DEBUG_PRINTF("FMSTR Rx: %02x\n", (FMSTR_U8)pBlock[i]);
+#endif
+            endOfFrame = _FMSTR_Rx(pBlock[i]);
+            i++;
+        }
+
+        FMSTR_SERIAL_DRV.ReleaseRxBlock(i);
+
+        /* a response is being sent, stop receiving */
+        if (_fmstr_wFlags.flg.bTxActive != 0U)
+        {
+            break;
+        }
+    }
+}
+
 /******************************************************************************
  *
  * @brief    Start listening on a serial line
@@ -278,6 +396,8 @@ void FMSTR_ProcessSerial(void)
 static void _FMSTR_Listen(void)
 {
     fmstr_nRxTodo = 0U;
+    /* also the following responses (debug test frames) are standard frames */
+    _fmstr_wFlags.flg.bRxLarge = 0U;
 
     /* disable transmitter state machine */
     _fmstr_wFlags.flg.bTxActive = 0U;
@@ -323,6 +443,13 @@ static void _FMSTR_SendError(FMSTR_BCHR nErrCode)
 #endif
 
     /* fill & send single-byte response */
+#if FMSTR_SERIAL_LARGE_MSG > 0
+    if (_fmstr_wFlags.flg.bRxLarge != 0U)
+    {
+        _FMSTR_SerialSendResponse(&fmstr_pCommBuffer[FMSTR_LARGE_MSG_HDR], 0U, nErrCode, NULL);
+        return;
+    }
+#endif
     _FMSTR_SerialSendResponse(&fmstr_pCommBuffer[2], 0U, nErrCode, NULL);
 }
 
@@ -343,11 +470,48 @@ static void _FMSTR_SerialSendResponse(FMSTR_BPTR pResponse,
                                       FMSTR_U8 statusCode,
                                       void *identification)
 {
-    FMSTR_SIZE8 i;
+    FMSTR_SIZE i;
     FMSTR_U8 c;
 
     FMSTR_UNUSED(identification);
 
+#if FMSTR_USE_SERIAL_STATS > 0
+    fmstr_serialStats.txFrames++;
+#endif
+
+#if FMSTR_SERIAL_LARGE_MSG > 0
+    /* the answer to a large-message frame always carries the 16-bit length and CRC16 */
+    if (_fmstr_wFlags.flg.bRxLarge != 0U)
+    {
+        FMSTR_U16 crc16;
+
+        if (nLength > FMSTR_COMM_BUFFER_SIZE || pResponse != &fmstr_pCommBuffer[FMSTR_LARGE_MSG_HDR])
+        {
+            statusCode = FMSTR_STC_RSPBUFFOVF;
+            nLength    = 0U;
+        }
+
+        fmstr_pCommBuffer[0] = (FMSTR_BCHR)statusCode;
+        fmstr_pCommBuffer[1] = (FMSTR_BCHR)(nLength >> 8);
+        fmstr_pCommBuffer[2] = (FMSTR_BCHR)nLength;
+
+        /* status, length and data, the big-endian CRC16 follows */
+        FMSTR_Crc16Init(&crc16);
+        pResponse = fmstr_pCommBuffer;
+        for (i = 0U; i < nLength + FMSTR_LARGE_MSG_HDR; i++)
+        {
+            pResponse = FMSTR_ValueFromBuffer8(&c, pResponse);
+            FMSTR_Crc16AddByte(&crc16, c);
+        }
+        pResponse = FMSTR_ValueToBuffer8(pResponse, (FMSTR_U8)(crc16 >> 8));
+        pResponse = FMSTR_ValueToBuffer8(pResponse, (FMSTR_U8)crc16);
+
+        fmstr_pTxBuff = fmstr_pCommBuffer;
+        fmstr_nTxTodo = nLength + FMSTR_LARGE_MSG_HDR + 2U;
+        goto start_tx;
+    }
+#endif
+
     if (nLength > 254U || pResponse != &fmstr_pCommBuffer[2])
     {
         /* The Serial driver doesn't support bigger responses than 254 bytes, change the response to status error */
@@ -358,7 +522,7 @@ static void _FMSTR_SerialSendResponse(FMSTR_BPTR pResponse,
     /* remember the buffer to be sent */
     fmstr_pTxBuff = fmstr_pCommBuffer;
     /* Send the message with status, length and checksum. SOB is not counted as it is sent right here. */
-    fmstr_nTxTodo = (FMSTR_SIZE8)(nLength + 3U);
+    fmstr_nTxTodo = nLength + 3U;
 
     if ((statusCode & FMSTR_STSF_VARLEN) != 0U)
     {
@@ -387,6 +551,9 @@ static void _FMSTR_SerialSendResponse(FMSTR_BPTR pResponse,
     /* store checksum after the message */
     pResponse = FMSTR_ValueToBuffer8(pResponse, fmstr_nRxCrc8);
 
+#if FMSTR_SERIAL_LARGE_MSG > 0
+start_tx:
+#endif
     /* now transmitting the response */
     _fmstr_wFlags.flg.bTxActive = 1U;
     _fmstr_wFlags.flg.bTxWaitTC = 0U;
@@ -402,9 +569,17 @@ static void _FMSTR_SerialSendResponse(FMSTR_BPTR pResponse,
     FMSTR_DEBUG_PRINTF("FMSTR Tx: %02x\n", (FMSTR_U8)FMSTR_SOB);
 #endif
 
-    /* kick on the SCI transmission (also clears TX Empty flag on some platforms) */
-    (void)FMSTR_SERIAL_DRV.IsTransmitRegEmpty();
-    FMSTR_SERIAL_DRV.PutChar(FMSTR_SOB);
+    /* block driver gets the SOB with the first packet */
+    if (FMSTR_SERIAL_DRV.GetTxBlock != NULL)
+    {
+        _fmstr_wFlags.flg.bTxBlockSOB = 1U;
+    }
+    else
+    {
+        /* kick on the SCI transmission (also clears TX Empty flag on some platforms) */
+        (void)FMSTR_SERIAL_DRV.IsTransmitRegEmpty();
+        FMSTR_SERIAL_DRV.PutChar(FMSTR_SOB);
+    }
 
     /* TX interrupt enable, RX interrupt disable */
 #if FMSTR_LONG_INTR > 0 || FMSTR_SHORT_INTR > 0
@@ -491,6 +666,19 @@ static FMSTR_BOOL _FMSTR_Rx(FMSTR_BCHR rxChar)
         /* reset receiving process */
         fmstr_pRxBuff = fmstr_pCommBuffer;
 
+#if FMSTR_SERIAL_LARGE_MSG > 0
+        /* large-message frame, the command code comes next */
+        pflg->flg.bRxLarge = (rxChar == FMSTR_SERIAL_LARGE) ? 1U : 0U;
+        if (pflg->flg.bRxLarge != 0U)
+        {
+            FMSTR_Crc16Init(&fmstr_nRxCrc16);
+            fmstr_nRxTodo              = 0;
+            pflg->flg.bRxMsgLengthNext = 1U;
+            pflg->flg.bRxLastCharSOB   = 0U;
+            return FMSTR_FALSE;
+        }
+#endif
+
         FMSTR_Crc8Init(&fmstr_nRxCrc8);
         FMSTR_Crc8AddByte(&fmstr_nRxCrc8, rxChar);
 
@@ -505,6 +693,13 @@ static FMSTR_BOOL _FMSTR_Rx(FMSTR_BCHR rxChar)
         return FMSTR_FALSE;
     }
 
+#if FMSTR_SERIAL_LARGE_MSG > 0
+    if (pflg->flg.bRxLarge != 0U)
+    {
+        return _FMSTR_RxLarge(rxChar);
+    }
+#endif
+
     /* we are waiting for the length byte */
     if (pflg->flg.bRxMsgLengthNext != 0U)
     {
@@ -512,7 +707,7 @@ static FMSTR_BOOL _FMSTR_Rx(FMSTR_BCHR rxChar)
         FMSTR_DEBUG_PRINTF("FMSTR Rx Frame length: 0x%x\n", rxChar);
 #endif
         /* total data length and the checksum */
-        fmstr_nRxTodo = (FMSTR_SIZE8)(rxChar + 1U);
+        fmstr_nRxTodo = (FMSTR_SIZE)rxChar + 1U;
         FMSTR_Crc8AddByte(&fmstr_nRxCrc8, rxChar);
 
         *(fmstr_pRxBuff++) = rxChar;
@@ -535,14 +730,24 @@ static FMSTR_BOOL _FMSTR_Rx(FMSTR_BCHR rxChar)
             FMSTR_DEBUG_PRINTF("FMSTR Rx Checksum: 0x%x, expected: 0x%x\n", rxChar, fmstr_nRxCrc8);
 #endif
 
+#if FMSTR_USE_SERIAL_STATS > 0
+            fmstr_serialStats.rxFrames++;
+#endif
+
             /* receive buffer overflow? */
             if (fmstr_pRxBuff == NULL)
             {
+#if FMSTR_USE_SERIAL_STATS > 0
+                fmstr_serialStats.rxTooLong++;
+#endif
                 _FMSTR_SendError(FMSTR_STC_CMDTOOLONG);
             }
             /* checksum error? */
             else if (fmstr_nRxCrc8 != rxChar)
             {
+#if FMSTR_USE_SERIAL_STATS > 0
+                fmstr_serialStats.rxCsErrors++;
+#endif
                 _FMSTR_SendError(FMSTR_STC_CMDCSERR);
             }
             /* message is okay */
@@ -596,6 +801,104 @@ static FMSTR_BOOL _FMSTR_Rx(FMSTR_BCHR rxChar)
     return FMSTR_FALSE;
 }
 
+#if FMSTR_SERIAL_LARGE_MSG > 0
+
+/******************************************************************************
+ *
+ * @brief  Handle received character of a large-message frame
+ *
+ * @param  rxChar  The character to be processed
+ *
+ * The frame is SOB, FMSTR_SERIAL_LARGE, command, 16-bit big-endian length,
+ * data and big-endian CRC16 of the command, length and data. The command,
+ * length and data are stored the same way as the response is built.
+ *
+ ******************************************************************************/
+
+static FMSTR_BOOL _FMSTR_RxLarge(FMSTR_BCHR rxChar)
+{
+    FMSTR_SERIAL_FLAGS *pflg = &_fmstr_wFlags;
+
+    /* not receiving (the rest of a frame already answered) */
+    if (pflg->flg.bRxMsgLengthNext == 0U && fmstr_nRxTodo == 0U)
+    {
+        return FMSTR_FALSE;
+    }
+
+    /* the received CRC16 is added as well, a valid frame leaves zero */
+    FMSTR_Crc16AddByte(&fmstr_nRxCrc16, rxChar);
+
+    /* is there still a space in the buffer? (data and the CRC16) */
+    if (fmstr_pRxBuff != NULL)
+    {
+        /*lint -e{946} pointer arithmetic is okay here (same array) */
+        if (fmstr_pRxBuff < (fmstr_pCommBuffer + FMSTR_LARGE_MSG_HDR + FMSTR_COMM_BUFFER_SIZE + 2U))
+        {
+            *fmstr_pRxBuff++ = rxChar;
+        }
+        else
+        {
+            /* keep receiving up to the end of the frame, as in _FMSTR_Rx */
+            fmstr_pRxBuff = NULL;
+        }
+    }
+
+    /* command code and the 16-bit length */
+    if (pflg->flg.bRxMsgLengthNext != 0U)
+    {
+        /*lint -e{946} pointer arithmetic is okay here (same array) */
+        if (fmstr_pRxBuff == &fmstr_pCommBuffer[FMSTR_LARGE_MSG_HDR])
+        {
+            fmstr_nRxTodo = ((((FMSTR_SIZE)fmstr_pCommBuffer[1]) << 8) | (FMSTR_SIZE)fmstr_pCommBuffer[2]) + 2U;
+            pflg->flg.bRxMsgLengthNext = 0U;
+        }
+        return FMSTR_FALSE;
+    }
+
+    /* was it the last byte of the message (checksum)? */
+    fmstr_nRxTodo--;
+    if (fmstr_nRxTodo > 0U)
+    {
+        return FMSTR_FALSE;
+    }
+
+#if FMSTR_USE_SERIAL_STATS > 0
+    fmstr_serialStats.rxFrames++;
+#endif
+
+    /* receive buffer overflow? */
+    if (fmstr_pRxBuff == NULL)
+    {
+#if FMSTR_USE_SERIAL_STATS > 0
+        fmstr_serialStats.rxTooLong++;
+#endif
+        _FMSTR_SendError(FMSTR_STC_CMDTOOLONG);
+    }
+    /* checksum error? */
+    else if (fmstr_nRxCrc16 != 0U)
+    {
+#if FMSTR_USE_SERIAL_STATS > 0
+        fmstr_serialStats.rxCsErrors++;
+#endif
+        _FMSTR_SendError(FMSTR_STC_CMDCSERR);
+    }
+    /* message is okay */
+    else
+    {
+        FMSTR_BOOL processed;
+        FMSTR_SIZE size = (((FMSTR_SIZE)fmstr_pCommBuffer[1]) << 8) | (FMSTR_SIZE)fmstr_pCommBuffer[2];
+
+        /* do decode now! use "serial" as a globally unique pointer value as our identifier */
+        processed = FMSTR_ProtocolDecoder(&fmstr_pCommBuffer[FMSTR_LARGE_MSG_HDR], size, fmstr_pCommBuffer[0],
+                                          (void *)"serial");
+        FMSTR_UNUSED(processed);
+    }
+
+    return FMSTR_TRUE;
+}
+
+#endif /* FMSTR_SERIAL_LARGE_MSG > 0 */
+
 /******************************************************************************
  *
  * @brief    Serial communication initialization
@@ -622,6 +925,7 @@ static FMSTR_BOOL _FMSTR_SerialInit(void)
     FMSTR_ASSERT_RETURN(FMSTR_SERIAL_DRV.PutChar != NULL, FMSTR_FALSE);
     FMSTR_ASSERT_RETURN(FMSTR_SERIAL_DRV.GetChar != NULL, FMSTR_FALSE);
     FMSTR_ASSERT_RETURN(FMSTR_SERIAL_DRV.Flush != NULL, FMSTR_FALSE);
+    FMSTR_ASSERT_RETURN((FMSTR_SERIAL_DRV.GetRxBlock == NULL) == (FMSTR_SERIAL_DRV.PutTxBlock == NULL), FMSTR_FALSE);
 
 #if FMSTR_SHORT_INTR || FMSTR_LONG_INTR
     FMSTR_ASSERT_RETURN(FMSTR_SERIAL_DRV.EnableTransmitInterrupt != NULL, FMSTR_FALSE);
@@ -696,4 +1000,22 @@ static void _FMSTR_SerialPoll(void)
 #endif
 }
 
+#if FMSTR_USE_SERIAL_STATS > 0
+
+/*******************************************************************************
+ *
+ * @brief    API: Get the serial transport frame and error counters
+ *
+ * The counters are free-running and never cleared by the driver. Application
+ * should keep its own baseline to report counts since a reset.
+ *
+ *******************************************************************************/
+
+const FMSTR_SERIAL_STATS *FMSTR_SerialGetStats(void)
+{
+    return &fmstr_serialStats;
+}
+
+#endif /* FMSTR_USE_SERIAL_STATS > 0 */
+
 #endif /* !(FMSTR_DISABLE) */
@@ -49,8 +49,12 @@
     #define FMSTR_SERIAL_SINGLEWIRE 0
 #endif
 
-#if FMSTR_COMM_BUFFER_SIZE > 254
-    #error FMSTR_COMM_BUFFER_SIZE must be set less than 254 on Serial transport.
+#if FMSTR_SERIAL_LARGE_MSG > 0
+    #if FMSTR_COMM_BUFFER_SIZE > 0xFFF0
+    #error FMSTR_COMM_BUFFER_SIZE must fit the 16-bit length of the serial large-message frames.
+    #endif
+#elif FMSTR_COMM_BUFFER_SIZE > 254
+    #error FMSTR_COMM_BUFFER_SIZE must be set less than 254 on Serial transport, or enable FMSTR_SERIAL_LARGE_MSG.
 #endif
 
 #if FMSTR_SHORT_INTR > 0
@@ -94,6 +98,14 @@ typedef struct FMSTR_SERIAL_DRV_INTF_S
     FMSTR_BCHR (*GetChar)(void);                        /* Receive character */
     void (*Flush)(void);                                /* Transmit-flush all buffered data */
     void (*Poll)(void);                                 /* General poll call (optional) */
+
+    /* Packet interface of block-oriented drivers like USB CDC (optional, all four or none). When set, the
+       serial layer decodes whole received packets and encodes the response directly into transmit packets
+       instead of moving single characters through GetChar and PutChar. */
+    FMSTR_SIZE (*GetRxBlock)(FMSTR_BPTR *ppData);       /* Returns received bytes not consumed yet and their address, 0 if none */
+    void (*ReleaseRxBlock)(FMSTR_SIZE size);            /* Given number of bytes of the block were consumed */
+    FMSTR_SIZE (*GetTxBlock)(FMSTR_BPTR *ppData);       /* Returns free space of the next transmit packet and its address, 0 if none */
+    void (*PutTxBlock)(FMSTR_SIZE size);                /* Given number of bytes were filled, transmit the packet */
 } FMSTR_SERIAL_DRV_INTF;
 
 /******************************************************************************
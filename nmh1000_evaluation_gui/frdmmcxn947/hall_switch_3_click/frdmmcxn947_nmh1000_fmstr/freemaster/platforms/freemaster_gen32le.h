@@ -56,12 +56,20 @@ typedef unsigned int FMSTR_BOOL;    /* general boolean type  */
 
 typedef unsigned char FMSTR_U8;       /* smallest memory entity */
 typedef unsigned short FMSTR_U16;     /* 16bit value */
+#if defined(__LP64__)
+typedef unsigned int FMSTR_U32;       /* 32bit value, long is 64bit in host builds (socket driver) */
+#else
 typedef unsigned long FMSTR_U32;      /* 32bit value */
+#endif
 typedef unsigned long long FMSTR_U64; /* 64bit value */
 
 typedef signed char FMSTR_S8;       /* signed 8bit value */
 typedef signed short FMSTR_S16;     /* signed 16bit value */
+#if defined(__LP64__)
+typedef signed int FMSTR_S32;       /* signed 32bit value */
+#else
 typedef signed long FMSTR_S32;      /* signed 32bit value */
+#endif
 typedef signed long long FMSTR_S64; /* signed 64bit value */
 
 typedef float FMSTR_FLOAT;   /* float value */
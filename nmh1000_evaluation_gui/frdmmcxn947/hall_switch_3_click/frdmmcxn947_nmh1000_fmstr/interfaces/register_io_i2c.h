@@ -18,6 +18,36 @@
 #include "sensor_drv.h"
 #include "Driver_I2C.h"
 
+/*! @brief This structure defines the transfer statistics of one I2C instance.
+ *  @details Updated from the signal event handlers, so the counters are free-running and written in
+ *           interrupt context. Each error counter counts the transfers whose event had that bit set.
+ */
+typedef struct
+{
+    uint32_t transfers;       /*!< Transfers completed, with or without error. */
+    uint32_t incomplete;      /*!< ARM_I2C_EVENT_TRANSFER_INCOMPLETE */
+    uint32_t addressNack;     /*!< ARM_I2C_EVENT_ADDRESS_NACK */
+    uint32_t arbitrationLost; /*!< ARM_I2C_EVENT_ARBITRATION_LOST */
+    uint32_t busError;        /*!< ARM_I2C_EVENT_BUS_ERROR */
+    uint32_t busClear;        /*!< ARM_I2C_EVENT_BUS_CLEAR */
+    uint32_t timeouts;        /*!< Transfers aborted after REGISTER_I2C_TIMEOUT_US */
+} registerI2cStats_t;
+
+/*! @brief Longest wait for a transfer to complete before it is aborted, in microseconds. Without a tick
+ *         function in registerDeviceInfo_t the polling intervals are counted, which leaves out the time
+ *         the idle function spends; a caller with an idle function sets tickFunction and timeoutTicks. */
+#ifndef REGISTER_I2C_TIMEOUT_US
+#define REGISTER_I2C_TIMEOUT_US (10000U)
+#endif
+
+/*! @brief Completion polling interval, in microseconds. */
+#ifndef REGISTER_I2C_POLL_US
+#define REGISTER_I2C_POLL_US (1U)
+#endif
+
+/*! @brief Transfer statistics, indexed by the I2C device index. */
+extern volatile registerI2cStats_t g_I2C_Stats[];
+
 #if defined(I2C0)
 /*! @brief The I2C0 device index. */
 #define I2C0_INDEX 0
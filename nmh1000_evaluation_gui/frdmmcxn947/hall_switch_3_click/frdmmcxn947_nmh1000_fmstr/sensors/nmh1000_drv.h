@@ -72,6 +72,17 @@ int32_t NMH1000_I2C_Initialize(
  */
 void NMH1000_I2C_SetIdleTask(nmh1000_i2c_sensorhandle_t *pSensorHandle, registeridlefunction_t idleTask, void *userParam);
 
+/*! @brief      :  The interface function to set the time base of the I2C transfer timeout.
+ *  @param[in]  :  nmh1000_i2c_sensorhandle_t *pSensorHandle, handle to the sensor handle.
+ *  @param[in]  :  registertickfunction_t tickFunction, free running tick counter, NULL to count polling intervals.
+ *  @param[in]  :  uint32_t timeoutTicks, transfer timeout in ticks of tickFunction.
+ *  @return        void.
+ *  @constraints   This can be called any number of times only after NMH1000_I2C_Initialize().
+ *  @reeentrant    No
+ */
+void NMH1000_I2C_SetTimeout(nmh1000_i2c_sensorhandle_t *pSensorHandle, registertickfunction_t tickFunction,
+                            uint32_t timeoutTicks);
+
 /*! @brief       The interface function to configure he sensor.
  *  @details     This function configure the sensor with requested ODR, Range and registers in the regsiter pair array.
  *  @param[in]   pSensorHandle      handle to the sensor.
@@ -0,0 +1,101 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/* Generated by tools/gen_nmh1000_regs.py from reg.csv and nmh1000.h, do not edit. */
+
+/**
+ * @file nmh1000_regs.h
+ * @brief The nmh1000_regs.h file declares the NMH1000 register descriptor table.
+ *
+ * @details One descriptor per register, indexed by register address. Writes to registers without
+ *          NMH1000_REG_WRITE or setting reserved bits are rejected before they reach the bus.
+ *          Registers without NMH1000_REG_VOLATILE only change when written and may be served from
+ *          a shadow copy. NMH1000_REG_BurstLength() gives the registers one transfer may cover.
+ */
+
+#ifndef NMH1000_REGS_H_
+#define NMH1000_REGS_H_
+
+/* Standard C Includes */
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief Number of registers, NMH1000_STATUS .. NMH1000_I2C_ADDR. */
+#define NMH1000_NUM_REGISTERS (10U)
+
+/*! @brief Most registers one read transfer may cover. */
+#define NMH1000_REG_BURST_MAX (1U)
+
+/*! @brief Descriptor flags. */
+#define NMH1000_REG_READ     (0x01U) /*!< Register can be read. */
+#define NMH1000_REG_WRITE    (0x02U) /*!< Register can be written. */
+#define NMH1000_REG_VOLATILE (0x04U) /*!< Sensor changes the value by itself, do not cache. */
+
+/*! @brief This structure defines one register. */
+typedef struct
+{
+    uint8_t address;    /*!< Register address. */
+    uint8_t flags;      /*!< NMH1000_REG_xxx. */
+    uint8_t writeMask;  /*!< Bits that may be written, the others are reserved. */
+    uint8_t resetValue; /*!< Value after POR or soft reset. */
+} nmh1000_reg_desc_t;
+
+/*! @brief Register descriptors, indexed by register address. */
+extern const nmh1000_reg_desc_t cNmh1000Registers[NMH1000_NUM_REGISTERS];
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+/*! @brief       Look up the descriptor of a register.
+ *  @param[in]   address  register address.
+ *  @return      descriptor, or NULL when there is no such register.
+ *  @constraints None
+ *  @reeentrant  Yes
+ */
+static inline const nmh1000_reg_desc_t *NMH1000_REG_Find(uint8_t address)
+{
+    return (address < NMH1000_NUM_REGISTERS) ? &cNmh1000Registers[address] : (const nmh1000_reg_desc_t *)0;
+}
+
+/*! @brief       Check whether a register exists and can be read.
+ *  @param[in]   address  register address.
+ *  @return      true when the register can be read.
+ *  @constraints None
+ *  @reeentrant  Yes
+ */
+bool NMH1000_REG_IsReadable(uint8_t address);
+
+/*! @brief       Check whether a value may be written to a register.
+ *  @param[in]   address  register address.
+ *  @param[in]   value    value to write.
+ *  @return      true when the register is writable and the value leaves the reserved bits clear.
+ *  @constraints None
+ *  @reeentrant  Yes
+ */
+bool NMH1000_REG_IsWritable(uint8_t address, uint8_t value);
+
+/*! @brief       Check whether the last value read or written is still the register contents.
+ *  @param[in]   address  register address.
+ *  @return      true when the register is readable and not volatile.
+ *  @constraints None
+ *  @reeentrant  Yes
+ */
+bool NMH1000_REG_IsCacheable(uint8_t address);
+
+/*! @brief       Number of consecutive readable registers one transfer can read from an address.
+ *  @param[in]   address  first register address.
+ *  @param[in]   maxLen   most registers wanted.
+ *  @return      1 .. MIN(maxLen, NMH1000_REG_BURST_MAX), 0 when the first register cannot be read.
+ *  @constraints None
+ *  @reeentrant  Yes
+ */
+uint8_t NMH1000_REG_BurstLength(uint8_t address, uint8_t maxLen);
+
+#endif // NMH1000_REGS_H_
@@ -0,0 +1,119 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file  cycle_profiler.c
+ * @brief The cycle_profiler.c file implements the DWT cycle counter based hot-path profiler.
+ */
+
+//-----------------------------------------------------------------------
+// SDK Includes
+//-----------------------------------------------------------------------
+#include <string.h>
+#include "fsl_common.h"
+#include "freemaster.h"
+
+#include "cycle_profiler.h"
+
+#if PROF_ENABLE
+
+//-----------------------------------------------------------------------
+// Global Variables
+//-----------------------------------------------------------------------
+prof_probe_t g_profProbes[PROF_NUM_PROBES];
+uint32_t g_profNestedCycles;
+
+/*! @brief Core clock the cycle counts are based on. */
+uint32_t profCoreClockHz;
+
+/*! @brief Written to non-zero by the host to clear all probes. */
+volatile uint8_t profReset;
+
+/*! @brief Probe statistics published to FreeMASTER under the probe names. */
+FMSTR_TSA_TABLE_BEGIN(prof_table)
+    FMSTR_TSA_STRUCT(prof_probe_t)
+    FMSTR_TSA_MEMBER(prof_probe_t, count, FMSTR_TSA_UINT32)
+    FMSTR_TSA_MEMBER(prof_probe_t, last, FMSTR_TSA_UINT32)
+    FMSTR_TSA_MEMBER(prof_probe_t, min, FMSTR_TSA_UINT32)
+    FMSTR_TSA_MEMBER(prof_probe_t, max, FMSTR_TSA_UINT32)
+    FMSTR_TSA_MEMBER(prof_probe_t, total, FMSTR_TSA_UINT64)
+    FMSTR_TSA_MEMBER(prof_probe_t, hist, FMSTR_TSA_UINT32)
+
+    FMSTR_TSA_RO_MEM(prof_main_loop, FMSTR_TSA_USERTYPE(prof_probe_t), &g_profProbes[PROF_MAIN_LOOP], sizeof(prof_probe_t))
+    FMSTR_TSA_RO_MEM(prof_fmstr_poll, FMSTR_TSA_USERTYPE(prof_probe_t), &g_profProbes[PROF_FMSTR_POLL], sizeof(prof_probe_t))
+    FMSTR_TSA_RO_MEM(prof_fmstr_isr, FMSTR_TSA_USERTYPE(prof_probe_t), &g_profProbes[PROF_FMSTR_ISR], sizeof(prof_probe_t))
+    FMSTR_TSA_RO_MEM(prof_host_cmds, FMSTR_TSA_USERTYPE(prof_probe_t), &g_profProbes[PROF_HOST_CMDS], sizeof(prof_probe_t))
+    FMSTR_TSA_RO_MEM(prof_i2c_read, FMSTR_TSA_USERTYPE(prof_probe_t), &g_profProbes[PROF_I2C_READ], sizeof(prof_probe_t))
+    FMSTR_TSA_RO_MEM(prof_switch_logic, FMSTR_TSA_USERTYPE(prof_probe_t), &g_profProbes[PROF_SWITCH_LOGIC], sizeof(prof_probe_t))
+    FMSTR_TSA_RO_MEM(prof_led_update, FMSTR_TSA_USERTYPE(prof_probe_t), &g_profProbes[PROF_LED_UPDATE], sizeof(prof_probe_t))
+    FMSTR_TSA_RO_VAR(profCoreClockHz, FMSTR_TSA_UINT32)
+    FMSTR_TSA_RW_VAR(profReset, FMSTR_TSA_UINT8)
+FMSTR_TSA_TABLE_END()
+
+//-----------------------------------------------------------------------
+// Local Functions
+//-----------------------------------------------------------------------
+static void prof_clear(void)
+{
+    memset(g_profProbes, 0, sizeof(g_profProbes));
+    for (uint32_t i = 0; i < PROF_NUM_PROBES; i++)
+    {
+        g_profProbes[i].min = UINT32_MAX;
+    }
+}
+
+//-----------------------------------------------------------------------
+// Functions
+//-----------------------------------------------------------------------
+void PROF_Init(void)
+{
+    prof_clear();
+    profCoreClockHz = CLOCK_GetFreq(kCLOCK_CoreSysClk);
+
+    /* Trace must be enabled for DWT to count */
+    DCB->DEMCR |= DCB_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0U;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+void PROF_Record(prof_probe_id_t id, uint32_t cycles)
+{
+    prof_probe_t *pProbe = &g_profProbes[id];
+    uint32_t bin;
+
+    pProbe->count++;
+    pProbe->last = cycles;
+    pProbe->total += cycles;
+    if (cycles < pProbe->min)
+    {
+        pProbe->min = cycles;
+    }
+    if (cycles > pProbe->max)
+    {
+        pProbe->max = cycles;
+    }
+
+    /* floor(log2(cycles)), 0 and 1 cycle both land in bin 0 */
+    bin = (cycles > 1U) ? (31U - __CLZ(cycles)) : 0U;
+    if (bin >= PROF_HIST_BINS)
+    {
+        bin = PROF_HIST_BINS - 1U;
+    }
+    pProbe->hist[bin]++;
+}
+
+void PROF_Service(void)
+{
+    if (profReset != 0U)
+    {
+        /* An interrupt probe may be updated while clearing, a torn first sample is acceptable */
+        prof_clear();
+        profReset = 0U;
+    }
+}
+
+#endif // PROF_ENABLE
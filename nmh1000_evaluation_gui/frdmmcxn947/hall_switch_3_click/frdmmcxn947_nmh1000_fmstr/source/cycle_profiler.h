@@ -0,0 +1,122 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file cycle_profiler.h
+ * @brief The cycle_profiler.h file declares the DWT cycle counter based hot-path profiler.
+ *
+ * @details A code region is measured by PROF_BEGIN(id) ... PROF_END(id). Each probe accumulates the
+ *          number of runs, total/min/max/last cycles and a log2 histogram (bin n counts runs that took
+ *          2^n .. 2^(n+1)-1 cycles). The probes are published in FreeMASTER TSA table prof_table.
+ *          Interrupts taken inside a measured region are included in its time. Tasks the scheduler runs
+ *          nested from SCHED_Yield() are not: PROF_NESTED_BEGIN() ... PROF_NESTED_END() adds their
+ *          cycles to g_profNestedCycles and PROF_END() subtracts what was added since PROF_BEGIN().
+ *          With PROF_ENABLE set to 0 the macros expand to nothing.
+ */
+
+#ifndef CYCLE_PROFILER_H_
+#define CYCLE_PROFILER_H_
+
+/* Standard C Includes */
+#include <stdint.h>
+
+#include "fsl_common.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief Set to 0 to compile the profiler out completely. */
+#ifndef PROF_ENABLE
+#define PROF_ENABLE 1
+#endif
+
+/*! @brief Number of log2 histogram bins, the last bin collects everything longer. */
+#define PROF_HIST_BINS (24U)
+
+/*! @brief Probe points. */
+typedef enum
+{
+    PROF_MAIN_LOOP = 0, /*!< One task run of the scheduler. */
+    PROF_FMSTR_POLL,    /*!< FMSTR_Poll(). */
+    PROF_FMSTR_ISR,     /*!< FMSTR_SerialIsr() in FMSTR_LONG_INTR mode, or the USB interrupt. */
+    PROF_HOST_CMDS,     /*!< Host register commands, mailbox and queued. */
+    PROF_I2C_READ,      /*!< Sensor output read, dominated by I2C completion waits. */
+    PROF_SWITCH_LOGIC,  /*!< Recorder and stream update of the sample task. */
+    PROF_LED_UPDATE,    /*!< Threshold comparison and LED of the LED task. */
+    PROF_NUM_PROBES
+} prof_probe_id_t;
+
+/*! @brief This structure defines the statistics of one probe. */
+typedef struct
+{
+    uint32_t count;                /*!< Number of measured runs. */
+    uint32_t last;                 /*!< Cycles of the last run. */
+    uint32_t min;                  /*!< Shortest run in cycles. */
+    uint32_t max;                  /*!< Longest run in cycles. */
+    uint64_t total;                /*!< Sum of all runs in cycles. */
+    uint32_t hist[PROF_HIST_BINS]; /*!< log2 histogram of run length. */
+} prof_probe_t;
+
+#if PROF_ENABLE
+
+/*! @brief Probe statistics, indexed by prof_probe_id_t. */
+extern prof_probe_t g_profProbes[PROF_NUM_PROBES];
+
+/*! @brief Cycles spent in nested task runs, only differences are meaningful. */
+extern uint32_t g_profNestedCycles;
+
+#define PROF_CYCLES()  (DWT->CYCCNT)
+#define PROF_BEGIN(id)                              \
+    const uint32_t _profStart_##id = PROF_CYCLES(); \
+    const uint32_t _profNested_##id = g_profNestedCycles
+#define PROF_END(id) \
+    PROF_Record((id), (PROF_CYCLES() - _profStart_##id) - (g_profNestedCycles - _profNested_##id))
+
+/* Around a nested task run, the runs nested deeper are part of its cycles already */
+#define PROF_NESTED_BEGIN()                          \
+    const uint32_t _profNestedStart = PROF_CYCLES(); \
+    const uint32_t _profNestedBefore = g_profNestedCycles
+#define PROF_NESTED_END() g_profNestedCycles = _profNestedBefore + (PROF_CYCLES() - _profNestedStart)
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+/*! @brief       Enable the DWT cycle counter and clear all probes.
+ *  @return      void.
+ *  @constraints None
+ *  @reeentrant  No
+ */
+void PROF_Init(void);
+
+/*! @brief       Account one run of a probe.
+ *  @param[in]   id      probe.
+ *  @param[in]   cycles  run length in core clock cycles.
+ *  @return      void.
+ *  @constraints A probe must only be recorded from one context (main loop or one interrupt).
+ *  @reeentrant  No
+ */
+void PROF_Record(prof_probe_id_t id, uint32_t cycles);
+
+/*! @brief       Clear the probes when the host requested it by writing profReset.
+ *  @return      void.
+ *  @constraints Call from the main loop.
+ *  @reeentrant  No
+ */
+void PROF_Service(void);
+
+#else
+
+#define PROF_BEGIN(id)
+#define PROF_END(id)
+#define PROF_Init()
+#define PROF_NESTED_BEGIN()
+#define PROF_NESTED_END()
+#define PROF_Service()
+
+#endif // PROF_ENABLE
+
+#endif // CYCLE_PROFILER_H_
@@ -0,0 +1,119 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file  deferred_log.c
+ * @brief The deferred_log.c file implements the deferred binary logging facility.
+ */
+
+//-----------------------------------------------------------------------
+// SDK Includes
+//-----------------------------------------------------------------------
+#include <string.h>
+#include "fsl_common.h"
+#include "fsl_debug_console.h"
+
+#include "deferred_log.h"
+
+//-----------------------------------------------------------------------
+// Global Variables
+//-----------------------------------------------------------------------
+dlog_t g_dlog;
+
+//-----------------------------------------------------------------------
+// Local Functions
+//-----------------------------------------------------------------------
+static void dlog_put32(uint16_t pos, uint32_t value)
+{
+    uint8_t *buff = g_dlog.buffer;
+
+    buff[pos & (DLOG_RING_SIZE - 1U)] = (uint8_t)value;
+    buff[(uint16_t)(pos + 1U) & (DLOG_RING_SIZE - 1U)] = (uint8_t)(value >> 8);
+    buff[(uint16_t)(pos + 2U) & (DLOG_RING_SIZE - 1U)] = (uint8_t)(value >> 16);
+    buff[(uint16_t)(pos + 3U) & (DLOG_RING_SIZE - 1U)] = (uint8_t)(value >> 24);
+}
+
+//-----------------------------------------------------------------------
+// Functions
+//-----------------------------------------------------------------------
+bool DLOG_Init(bool usePipe)
+{
+    memset(&g_dlog, 0, sizeof(g_dlog));
+    g_dlog.ring.buff = (FMSTR_ADDR)g_dlog.buffer;
+    g_dlog.ring.size = DLOG_RING_SIZE;
+
+    if (!usePipe)
+    {
+        return true;
+    }
+
+    g_dlog.pipe = FMSTR_PipeOpen(DLOG_PIPE_PORT, NULL, NULL, 0, NULL, 0, FMSTR_PIPE_MODE_UINT | FMSTR_PIPE_SIZE_1B,
+                                 "dlog");
+    if (g_dlog.pipe == NULL)
+    {
+        return false;
+    }
+
+    if (FMSTR_PipeAttachTxRing(g_dlog.pipe, &g_dlog.ring) == FMSTR_FALSE)
+    {
+        FMSTR_PipeClose(g_dlog.pipe);
+        g_dlog.pipe = NULL;
+        return false;
+    }
+
+    return true;
+}
+
+void DLOG_Write(const char *fmt, uint8_t argc, const uint32_t *argv)
+{
+    uint16_t len = (uint16_t)(DLOG_HEADER_SIZE + (4U * argc));
+    uint16_t wp;
+    uint32_t primask;
+
+    if (argc > DLOG_MAX_ARGS)
+    {
+        argc = DLOG_MAX_ARGS;
+        len = (uint16_t)(DLOG_HEADER_SIZE + (4U * DLOG_MAX_ARGS));
+    }
+
+    /* Records may come from interrupts as well, keep them whole */
+    primask = DisableGlobalIRQ();
+
+    wp = g_dlog.ring.wp;
+    if ((uint16_t)(DLOG_RING_SIZE - (uint16_t)(wp - g_dlog.ring.rp)) < len)
+    {
+        g_dlog.droppedCount++;
+        EnableGlobalIRQ(primask);
+        return;
+    }
+
+    g_dlog.buffer[wp & (DLOG_RING_SIZE - 1U)] = DLOG_SYNC;
+    g_dlog.buffer[(uint16_t)(wp + 1U) & (DLOG_RING_SIZE - 1U)] = argc;
+    dlog_put32((uint16_t)(wp + 2U), (uint32_t)(uintptr_t)fmt);
+    for (uint8_t i = 0; i < argc; i++)
+    {
+        dlog_put32((uint16_t)(wp + DLOG_HEADER_SIZE + (4U * i)), argv[i]);
+    }
+
+    /* Publish the record to the pipe */
+    g_dlog.ring.wp = (uint16_t)(wp + len);
+    g_dlog.recordCount++;
+
+    EnableGlobalIRQ(primask);
+}
+
+void DLOG_DrainToConsole(void)
+{
+    uint16_t rp = g_dlog.ring.rp;
+
+    while (rp != g_dlog.ring.wp)
+    {
+        DbgConsole_Putchar(g_dlog.buffer[rp & (DLOG_RING_SIZE - 1U)]);
+        rp++;
+        g_dlog.ring.rp = rp;
+    }
+}
@@ -0,0 +1,123 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file  eth_link.c
+ * @brief The eth_link.c file implements the Ethernet bring-up of the FreeMASTER network build.
+ */
+
+#include "freemaster_cfg.h"
+
+#if NMH1000_FMSTR_NET
+
+//-----------------------------------------------------------------------
+// SDK Includes
+//-----------------------------------------------------------------------
+#include "fsl_common.h"
+#include "fsl_enet.h"
+#include "fsl_phylan8741.h"
+#include "board.h"
+#include "pin_mux.h"
+
+#include "lwip/init.h"
+#include "lwip/netif.h"
+#include "lwip/timeouts.h"
+#include "netif/ethernet.h"
+#include "ethernetif.h"
+
+#include "power_manager.h"
+#include "eth_link.h"
+
+//-----------------------------------------------------------------------
+// Local Variables
+//-----------------------------------------------------------------------
+static struct netif ethNetif;
+static phy_lan8741_resource_t ethPhyResource;
+static phy_handle_t ethPhyHandle;
+static uint32_t ethTicksPerMs;
+static uint32_t ethLastTicks; /* end of the last interval added to ethNowMs */
+static uint32_t ethNowMs;
+
+/* Memory the ENET DMA cannot reach, the ethernetif port keeps its buffers out of it */
+static const mem_range_t ethNonDmaMemory[] = BOARD_ENET_NON_DMA_MEMORY_ARRAY;
+
+//-----------------------------------------------------------------------
+// Local Functions
+//-----------------------------------------------------------------------
+static status_t eth_link_mdio_write(uint8_t phyAddr, uint8_t regAddr, uint16_t data)
+{
+    return ENET_MDIOWrite(ENET0, phyAddr, regAddr, data);
+}
+
+static status_t eth_link_mdio_read(uint8_t phyAddr, uint8_t regAddr, uint16_t *pData)
+{
+    return ENET_MDIORead(ENET0, phyAddr, regAddr, pData);
+}
+
+//-----------------------------------------------------------------------
+// Functions
+//-----------------------------------------------------------------------
+/* lwIP time base in milliseconds (NO_SYS), derived from the SysTick time of the power manager */
+u32_t sys_now(void)
+{
+    uint32_t now = POWER_GetTicks();
+    uint32_t ms = (now - ethLastTicks) / ethTicksPerMs;
+
+    ethLastTicks += ms * ethTicksPerMs;
+    ethNowMs += ms;
+    return ethNowMs;
+}
+
+bool ETH_LINK_Init(void)
+{
+    ip4_addr_t ipAddr, netmask, gateway;
+    ethernetif_config_t config = {
+        .phyHandle = &ethPhyHandle,
+        .phyAddr = BOARD_ENET0_PHY_ADDRESS,
+        .phyOps = &phylan8741_ops,
+        .phyResource = &ethPhyResource,
+        .srcClockHz = CLOCK_GetCoreSysClkFreq(),
+        .macAddress = ETH_LINK_MAC_ADDR,
+        .non_dma_memory = ethNonDmaMemory,
+    };
+
+    ethTicksPerMs = CLOCK_GetCoreSysClkFreq() / 1000U;
+    ethLastTicks = POWER_GetTicks();
+    ethNowMs = 0U;
+
+    /*! RMII pins, 50 MHz reference clock from the PHY and ENET0 out of reset */
+    BOARD_InitENETPins();
+    CLOCK_AttachClk(MUX_A(CM_ENETRMIICLKSEL, 0));
+    CLOCK_EnableClock(kCLOCK_Enet);
+    SYSCON0->PRESETCTRL2 = SYSCON_PRESETCTRL2_ENET_RST_MASK;
+    SYSCON0->PRESETCTRL2 &= ~SYSCON_PRESETCTRL2_ENET_RST_MASK;
+    SYSCON0->ENET_PHY_INTF_SEL |= SYSCON_ENET_PHY_INTF_SEL_PHY_SEL(1);
+
+    /*! PHY management */
+    ENET_SetSMI(ENET0, CLOCK_GetCoreSysClkFreq());
+    ethPhyResource.read = eth_link_mdio_read;
+    ethPhyResource.write = eth_link_mdio_write;
+
+    IP4_ADDR(&ipAddr, ETH_LINK_IP_ADDR);
+    IP4_ADDR(&netmask, ETH_LINK_NETMASK);
+    IP4_ADDR(&gateway, ETH_LINK_GATEWAY);
+
+    lwip_init();
+    (void)netif_add(&ethNetif, &ipAddr, &netmask, &gateway, &config, ethernetif0_init, ethernet_input);
+    netif_set_default(&ethNetif);
+    netif_set_up(&ethNetif);
+
+    return ethernetif_wait_linkup(&ethNetif, ETH_LINK_WAIT_MS) == ERR_OK;
+}
+
+void ETH_LINK_Poll(void)
+{
+    ethernetif_input(&ethNetif);
+    sys_check_timeouts();
+}
+
+#endif /* NMH1000_FMSTR_NET */
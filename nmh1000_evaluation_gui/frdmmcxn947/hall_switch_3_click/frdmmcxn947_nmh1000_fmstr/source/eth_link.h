@@ -0,0 +1,67 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file eth_link.h
+ * @brief The eth_link.h file declares the Ethernet bring-up of the FreeMASTER network build.
+ *
+ * @details Built with NMH1000_FMSTR_NET (freemaster_cfg.h). ENET0 is brought up in RMII mode with the
+ *          on-board LAN8741 PHY and a static IPv4 address, lwIP runs without an operating system
+ *          (NO_SYS, source/lwipopts.h) on the raw API. The stack is driven from the main loop:
+ *          ETH_LINK_Poll() moves the received frames into lwIP and runs its timers, FreeMASTER serves
+ *          its TCP sessions from the callbacks of freemaster_net_lwip_raw_tcp.c. Built by the Debug_NET
+ *          configuration of the project, the lwIP, ENET driver, PHY driver and ethernetif port
+ *          sources it adds are copied from the MCUXpresso SDK by tools/import_sdk_components.py.
+ */
+
+#ifndef ETH_LINK_H_
+#define ETH_LINK_H_
+
+/* Standard C Includes */
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief Static IPv4 address, netmask and gateway of the board. */
+#ifndef ETH_LINK_IP_ADDR
+#define ETH_LINK_IP_ADDR 192U, 168U, 0U, 102U
+#endif
+#ifndef ETH_LINK_NETMASK
+#define ETH_LINK_NETMASK 255U, 255U, 255U, 0U
+#endif
+#ifndef ETH_LINK_GATEWAY
+#define ETH_LINK_GATEWAY 192U, 168U, 0U, 100U
+#endif
+
+/*! @brief Locally administered MAC address. */
+#ifndef ETH_LINK_MAC_ADDR
+#define ETH_LINK_MAC_ADDR {0x02U, 0x12U, 0x13U, 0x10U, 0x15U, 0x25U}
+#endif
+
+/*! @brief How long ETH_LINK_Init() waits for the cable, the link may also come up later. */
+#define ETH_LINK_WAIT_MS (5000U)
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+/*! @brief       Bring up ENET0, the PHY and lwIP with the static address.
+ *  @return      true when the link is up, false when it is not up yet.
+ *  @constraints Call after POWER_Init() and before FMSTR_Init(), which opens the listen PCB.
+ *  @reeentrant  No
+ */
+bool ETH_LINK_Init(void);
+
+/*! @brief       Pass the received frames to lwIP and run its timers.
+ *  @return      void.
+ *  @constraints Call from the main loop before FMSTR_Poll().
+ *  @reeentrant  No
+ */
+void ETH_LINK_Poll(void);
+
+#endif // ETH_LINK_H_
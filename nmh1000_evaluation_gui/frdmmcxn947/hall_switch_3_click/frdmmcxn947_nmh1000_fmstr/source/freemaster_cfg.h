@@ -27,10 +27,37 @@
 //! Enable/Disable FreeMASTER support as a whole
 #define FMSTR_DISABLE           0   // To disable all FreeMASTER functionalities
 
+//! Select FreeMASTER over TCP on the Ethernet port instead of the debug UART (lwIP raw API, see eth_link.h), set by the Debug_NET configuration
+#ifndef NMH1000_FMSTR_NET
+#define NMH1000_FMSTR_NET       0
+#endif
+
+//! Select FreeMASTER over SEGGER RTT through the MCU-Link probe instead of the debug UART, set by the Debug_RTT configuration
+#ifndef NMH1000_FMSTR_RTT
+#define NMH1000_FMSTR_RTT       0
+#endif
+
+//! Select FreeMASTER over USB CDC-ACM on the high-speed USB port instead of the debug UART (see usb_link.h), set by the Debug_USB configuration
+#ifndef NMH1000_FMSTR_USB
+#define NMH1000_FMSTR_USB       0
+#endif
+
+#if (NMH1000_FMSTR_NET + NMH1000_FMSTR_RTT + NMH1000_FMSTR_USB) > 1
+#error Select one of NMH1000_FMSTR_NET, NMH1000_FMSTR_RTT and NMH1000_FMSTR_USB
+#endif
+
+#define NMH1000_FMSTR_UART      (!NMH1000_FMSTR_NET && !NMH1000_FMSTR_RTT && !NMH1000_FMSTR_USB)
+
 //! Select interrupt or poll-driven serial communication
+#if !NMH1000_FMSTR_UART
+#define FMSTR_LONG_INTR         0   // Complete message processing in interrupt
+#define FMSTR_SHORT_INTR        0   // Queuing done in interrupt
+#define FMSTR_POLL_DRIVEN       1   // No interrupt needed, polling only
+#else
 #define FMSTR_LONG_INTR         1   // Complete message processing in interrupt
 #define FMSTR_SHORT_INTR        0   // Queuing done in interrupt
 #define FMSTR_POLL_DRIVEN       0   // No interrupt needed, polling only
+#endif
 
 // List of standard FreeMASTER transports and their low-level drivers. See more options in src/drivers.
 // FMSTR_SERIAL   -   Standard serial transport protocol (Used by various types of UART peripherals as USB CDC implementation)
@@ -46,8 +73,33 @@
 // FMSTR_PDBDM    -   Packet Driven BDM (direct memory access via JTAG, SWD or BDM debug probes). No low-level driver used.
 
 //! Select communication interface
+#if NMH1000_FMSTR_NET
+#define FMSTR_TRANSPORT         FMSTR_NET       // Use network transport layer
+#define FMSTR_NET_DRV           FMSTR_NET_LWIP_RAW_TCP // Use lwIP raw API TCP driver, no RTOS needed
+#define FMSTR_NET_PORT          3344    // TCP port the host connects to
+#define FMSTR_NET_BLOCKING_TIMEOUT 0    // FMSTR_Poll() must not block the scheduler
+#define FMSTR_SESSION_COUNT     3       // Concurrent host connections, each may lock its own scope or recorder
+#define FMSTR_USE_READ_CACHE    1       // Sessions reading the same memory within one sample period share the copy
+#define FMSTR_READ_CACHE_ENTRIES 16     // Distinct (address, size) reads kept per sample period
+#define FMSTR_READ_CACHE_SIZE   512     // Bytes kept per sample period, the registers struct and the scope variables
+#elif NMH1000_FMSTR_RTT
+#define FMSTR_TRANSPORT         FMSTR_NET       // RTT is a virtual network interface
+#define FMSTR_NET_DRV           FMSTR_NET_SEGGER_RTT // SEGGER_RTT.c, SEGGER_RTT.h and SEGGER_RTT_Conf.h in rtt/, see tools/import_sdk_components.py
+#define FMSTR_NET_SEGGER_RTT_BUFFER_INDEX 1     // Own buffers, RTT terminal 0 stays free for logs
+#define FMSTR_NET_SEGGER_RTT_UP_SIZE (2 * (FMSTR_COMM_BUFFER_SIZE + 8)) // A reply left unread by a timed-out command does not block the next
+#define FMSTR_NET_SEGGER_RTT_DOWN_SIZE (FMSTR_COMM_BUFFER_SIZE + 8)    // One request, commands are sent one at a time
+#define FMSTR_SESSION_COUNT     1       // RTT carries a single session
+#elif NMH1000_FMSTR_USB
+#define FMSTR_TRANSPORT         FMSTR_SERIAL    // Serial framing over the CDC-ACM bulk endpoints
+#define FMSTR_SERIAL_DRV        FMSTR_SERIAL_MCUX_USB // Double-buffered endpoints, whole packets to the serial layer
+#define FMSTR_USE_SERIAL_STATS  1   // Count frames and errors for the health statistics
+#define FMSTR_SERIAL_LARGE_MSG  1   // 16-bit length frames for the 1 kB communication buffer
+#else
 #define FMSTR_TRANSPORT         FMSTR_SERIAL    // Use serial transport layer */
 #define FMSTR_SERIAL_DRV        FMSTR_SERIAL_MCUX_LPUART // Use serial driver for USART */
+#define FMSTR_USE_SERIAL_STATS  1   // Count frames and errors for the health statistics
+#define FMSTR_SERIAL_LARGE_MSG  1   // 16-bit length frames for the 1 kB communication buffer
+#endif
 
 //! Define communication interface base address or leave undefined for runtime setting
 // #undef FMSTR_SERIAL_BASE   // Serial base will be assigned in runtime (when FMSTR_USE_UART)
@@ -58,7 +110,7 @@
 #define FMSTR_FLEXCAN_RXMB      1
 
 //! Input/output communication buffer size
-#define FMSTR_COMM_BUFFER_SIZE  0   // Set to 0 for "automatic"
+#define FMSTR_COMM_BUFFER_SIZE  1024 // Responses of up to 1 kB, serial recorder uploads use large-message frames
 
 //! Receive FIFO queue size (use with FMSTR_SHORT_INTR only)
 #define FMSTR_COMM_RQUEUE_SIZE  32  // Set to 0 for "default"
@@ -76,7 +128,7 @@
 #define FMSTR_USE_RECORDER      2   // Specify number of supported recorders
 
 //! Built-in recorder buffer
-#define FMSTR_REC_BUFF_SIZE     1024    // Built-in buffer size of recorder #0. Set to 0 to use runtime settings.
+#define FMSTR_REC_BUFF_SIZE     0       // None built in, recorder_buffers.c creates both recorders at runtime
 
 //! Recorder time base, specifies how often the recorder is called in the user app.
 #define FMSTR_REC_TIMEBASE      FMSTR_REC_BASE_MILLISEC(0)  // 0 = "unknown"
@@ -90,6 +142,7 @@
 
 // Pipes as data streaming over FreeMASTER protocol
 #define FMSTR_USE_PIPES         3   // Specify number of supported pipe objects
+#define FMSTR_USE_PIPE_TXRING   1   // Allow pipes to transmit directly from application ring buffers
 
 // Enable/Disable read/write memory commands
 #define FMSTR_USE_READMEM       1   // Enable read memory commands
@@ -0,0 +1,25 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file freemaster_usb.h
+ * @brief The freemaster_usb.h file adapts freemaster_serial_usb.c to the CDC-ACM device of usb_link.c.
+ *
+ * @details Included by the FreeMASTER USB CDC driver after the USB stack headers. Each endpoint buffer
+ *          of the driver holds one high-speed bulk packet; at full speed a buffer takes several
+ *          packets and a transfer still ends with the first short packet.
+ */
+
+#ifndef FREEMASTER_USB_H_
+#define FREEMASTER_USB_H_
+
+#include "usb_device_descriptor.h"
+
+/*! @brief Endpoint buffer size of freemaster_serial_usb.c, one high-speed bulk packet. */
+#define FMSTR_USB_PACKET_SIZE HS_CDC_VCOM_BULK_PACKET_SIZE
+
+#endif // FREEMASTER_USB_H_
@@ -0,0 +1,155 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file  health_stats.c
+ * @brief The health_stats.c file implements the runtime health and throughput counters.
+ */
+
+//-----------------------------------------------------------------------
+// SDK Includes
+//-----------------------------------------------------------------------
+#include <string.h>
+#include "fsl_common.h"
+#include "freemaster.h"
+
+#include "register_io_i2c.h"
+#include "health_stats.h"
+
+//-----------------------------------------------------------------------
+// Global Variables
+//-----------------------------------------------------------------------
+health_stats_t g_health;
+uint32_t g_healthIdleStart;
+uint32_t g_healthIdleTicks;
+
+/*! @brief Written to non-zero by the host to restart all counters. */
+volatile uint8_t healthReset;
+
+/*! @brief Health statistics published to FreeMASTER. */
+FMSTR_TSA_TABLE_BEGIN(health_table)
+    FMSTR_TSA_STRUCT(health_stats_t)
+    FMSTR_TSA_MEMBER(health_stats_t, loopsPerSec, FMSTR_TSA_UINT32)
+    FMSTR_TSA_MEMBER(health_stats_t, samplesPerSec, FMSTR_TSA_UINT32)
+    FMSTR_TSA_MEMBER(health_stats_t, idlePercent, FMSTR_TSA_UINT32)
+    FMSTR_TSA_MEMBER(health_stats_t, loops, FMSTR_TSA_UINT32)
+    FMSTR_TSA_MEMBER(health_stats_t, samples, FMSTR_TSA_UINT32)
+    FMSTR_TSA_MEMBER(health_stats_t, i2cTransfers, FMSTR_TSA_UINT32)
+    FMSTR_TSA_MEMBER(health_stats_t, i2cIncomplete, FMSTR_TSA_UINT32)
+    FMSTR_TSA_MEMBER(health_stats_t, i2cAddressNack, FMSTR_TSA_UINT32)
+    FMSTR_TSA_MEMBER(health_stats_t, i2cArbitrationLost, FMSTR_TSA_UINT32)
+    FMSTR_TSA_MEMBER(health_stats_t, i2cBusError, FMSTR_TSA_UINT32)
+    FMSTR_TSA_MEMBER(health_stats_t, i2cBusClear, FMSTR_TSA_UINT32)
+    FMSTR_TSA_MEMBER(health_stats_t, i2cTimeouts, FMSTR_TSA_UINT32)
+    FMSTR_TSA_MEMBER(health_stats_t, fmstrRxFrames, FMSTR_TSA_UINT32)
+    FMSTR_TSA_MEMBER(health_stats_t, fmstrTxFrames, FMSTR_TSA_UINT32)
+    FMSTR_TSA_MEMBER(health_stats_t, fmstrCsErrors, FMSTR_TSA_UINT32)
+    FMSTR_TSA_MEMBER(health_stats_t, fmstrTooLong, FMSTR_TSA_UINT32)
+
+    FMSTR_TSA_RO_VAR(g_health, FMSTR_TSA_USERTYPE(health_stats_t))
+    FMSTR_TSA_RW_VAR(healthReset, FMSTR_TSA_UINT8)
+FMSTR_TSA_TABLE_END()
+
+//-----------------------------------------------------------------------
+// Local Variables
+//-----------------------------------------------------------------------
+static uint32_t healthI2cInstance;
+static uint32_t healthWindowTicks;
+static uint32_t healthWindowStart;
+static uint32_t healthWindowLoops;
+static uint32_t healthWindowSamples;
+
+/* Source counter values at the last reset */
+static registerI2cStats_t healthI2cBase;
+#if FMSTR_USE_SERIAL_STATS > 0
+static FMSTR_SERIAL_STATS healthSerialBase;
+#endif
+
+//-----------------------------------------------------------------------
+// Local Functions
+//-----------------------------------------------------------------------
+static void health_restart(void)
+{
+    memset(&g_health, 0, sizeof(g_health));
+    healthI2cBase = g_I2C_Stats[healthI2cInstance];
+#if FMSTR_USE_SERIAL_STATS > 0
+    healthSerialBase = *FMSTR_SerialGetStats();
+#endif
+
+    healthWindowLoops = 0U;
+    healthWindowSamples = 0U;
+    g_healthIdleTicks = 0U;
+    healthWindowStart = POWER_GetTicks();
+}
+
+static void health_refresh_counters(void)
+{
+    const volatile registerI2cStats_t *pI2c = &g_I2C_Stats[healthI2cInstance];
+
+    g_health.i2cTransfers = pI2c->transfers - healthI2cBase.transfers;
+    g_health.i2cIncomplete = pI2c->incomplete - healthI2cBase.incomplete;
+    g_health.i2cAddressNack = pI2c->addressNack - healthI2cBase.addressNack;
+    g_health.i2cArbitrationLost = pI2c->arbitrationLost - healthI2cBase.arbitrationLost;
+    g_health.i2cBusError = pI2c->busError - healthI2cBase.busError;
+    g_health.i2cBusClear = pI2c->busClear - healthI2cBase.busClear;
+    g_health.i2cTimeouts = pI2c->timeouts - healthI2cBase.timeouts;
+
+#if FMSTR_USE_SERIAL_STATS > 0
+    /* The network transport keeps no frame counters, the fmstr fields stay 0 there */
+    const FMSTR_SERIAL_STATS *pSerial = FMSTR_SerialGetStats();
+
+    g_health.fmstrRxFrames = (uint32_t)(pSerial->rxFrames - healthSerialBase.rxFrames);
+    g_health.fmstrTxFrames = (uint32_t)(pSerial->txFrames - healthSerialBase.txFrames);
+    g_health.fmstrCsErrors = (uint32_t)(pSerial->rxCsErrors - healthSerialBase.rxCsErrors);
+    g_health.fmstrTooLong = (uint32_t)(pSerial->rxTooLong - healthSerialBase.rxTooLong);
+#endif
+}
+
+//-----------------------------------------------------------------------
+// Functions
+//-----------------------------------------------------------------------
+void HEALTH_Init(uint32_t i2cInstance)
+{
+    healthI2cInstance = i2cInstance;
+    healthWindowTicks = (CLOCK_GetFreq(kCLOCK_CoreSysClk) / 1000U) * HEALTH_WINDOW_MS;
+
+    health_restart();
+}
+
+void HEALTH_Service(void)
+{
+    uint32_t elapsed;
+
+    if (healthReset != 0U)
+    {
+        health_restart();
+        healthReset = 0U;
+        return;
+    }
+
+    elapsed = POWER_GetTicks() - healthWindowStart;
+    if (elapsed < healthWindowTicks)
+    {
+        return;
+    }
+
+    /* Scale to a full second in case the loop overshot the window */
+    g_health.loopsPerSec =
+        (uint32_t)(((uint64_t)(g_health.loops - healthWindowLoops) * healthWindowTicks * 1000U) /
+                   ((uint64_t)elapsed * HEALTH_WINDOW_MS));
+    g_health.samplesPerSec =
+        (uint32_t)(((uint64_t)(g_health.samples - healthWindowSamples) * healthWindowTicks * 1000U) /
+                   ((uint64_t)elapsed * HEALTH_WINDOW_MS));
+    g_health.idlePercent = (uint32_t)(((uint64_t)g_healthIdleTicks * 100U) / elapsed);
+
+    health_refresh_counters();
+
+    healthWindowLoops = g_health.loops;
+    healthWindowSamples = g_health.samples;
+    g_healthIdleTicks = 0U;
+    healthWindowStart += elapsed;
+}
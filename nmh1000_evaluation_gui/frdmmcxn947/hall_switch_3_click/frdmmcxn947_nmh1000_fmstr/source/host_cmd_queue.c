@@ -0,0 +1,92 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file  host_cmd_queue.c
+ * @brief The host_cmd_queue.c file implements the lock-free host command queue.
+ */
+
+//-----------------------------------------------------------------------
+// SDK Includes
+//-----------------------------------------------------------------------
+#include <string.h>
+#include "fsl_common.h"
+
+#include "host_cmd_queue.h"
+
+//-----------------------------------------------------------------------
+// Functions
+//-----------------------------------------------------------------------
+void HOST_CMD_Init(host_cmd_queue_t *pQueue)
+{
+    memset(pQueue, 0, sizeof(*pQueue));
+    pQueue->nextSeq = 1U;
+}
+
+bool HOST_CMD_Push(host_cmd_queue_t *pQueue, uint8_t code, uint8_t offset, uint8_t value, uint16_t *pSeq)
+{
+    uint16_t head = pQueue->head;
+    host_cmd_t *pSlot;
+    host_cmd_completion_t *pDone;
+
+    /* The completion record of a slot is only reused once the consumer has released it. */
+    if ((uint16_t)(head - pQueue->tail) >= HOST_CMD_QUEUE_DEPTH)
+    {
+        pQueue->overflowCount++;
+        return false;
+    }
+
+    pSlot = &pQueue->slots[head & HOST_CMD_QUEUE_MASK];
+    pSlot->seq = pQueue->nextSeq++;
+    pSlot->code = code;
+    pSlot->offset = offset;
+    pSlot->value = value;
+
+    pDone = &pQueue->completions[head & HOST_CMD_QUEUE_MASK];
+    pDone->seq = pSlot->seq;
+    pDone->value = 0;
+    pDone->status = HOST_CMD_STATUS_PENDING;
+
+    if (pSeq != NULL)
+    {
+        *pSeq = pSlot->seq;
+    }
+
+    /* Slot contents must be visible before the consumer sees the new head. */
+    __DMB();
+    pQueue->head = head + 1U;
+
+    return true;
+}
+
+const host_cmd_t *HOST_CMD_Peek(host_cmd_queue_t *pQueue)
+{
+    uint16_t tail = pQueue->tail;
+
+    if (tail == pQueue->head)
+    {
+        return NULL;
+    }
+
+    /* Read the slot only after head was observed. */
+    __DMB();
+    return &pQueue->slots[tail & HOST_CMD_QUEUE_MASK];
+}
+
+void HOST_CMD_Complete(host_cmd_queue_t *pQueue, uint8_t status, uint8_t value)
+{
+    uint16_t tail = pQueue->tail;
+    host_cmd_completion_t *pDone = &pQueue->completions[tail & HOST_CMD_QUEUE_MASK];
+
+    pDone->value = value;
+    pDone->status = status;
+    pQueue->lastDoneSeq = pDone->seq;
+
+    /* Completion must be visible before the producer may reuse the slot. */
+    __DMB();
+    pQueue->tail = tail + 1U;
+}
@@ -0,0 +1,127 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file host_cmd_queue.h
+ * @brief The host_cmd_queue.h file declares the single-producer/single-consumer queue used to pass
+ *        register commands from the FreeMASTER communication context to the acquisition loop.
+ */
+
+#ifndef HOST_CMD_QUEUE_H_
+#define HOST_CMD_QUEUE_H_
+
+/* Standard C Includes */
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief Number of queue slots, must be a power of two. */
+#define HOST_CMD_QUEUE_DEPTH (16U)
+#define HOST_CMD_QUEUE_MASK  (HOST_CMD_QUEUE_DEPTH - 1U)
+
+/*! @brief FreeMASTER application command codes accepted by the queue. */
+enum
+{
+    HOST_CMD_WRITE_REG = 0x10, /*!< args: offset, value */
+    HOST_CMD_READ_REG  = 0x11, /*!< args: offset */
+    HOST_CMD_READ_ALL  = 0x12, /*!< no args */
+};
+
+/*! @brief Application command result codes returned to the host when a command is submitted. */
+enum
+{
+    HOST_CMD_RESULT_QUEUED  = 0x00, /*!< Command queued, response data holds the 16-bit sequence number. */
+    HOST_CMD_RESULT_FULL    = 0x01, /*!< Queue full, command dropped, host should retry. */
+    HOST_CMD_RESULT_INVALID = 0x02, /*!< Malformed command arguments. */
+};
+
+/*! @brief Completion status of a queued command. */
+enum
+{
+    HOST_CMD_STATUS_FREE    = 0x00, /*!< Slot never used. */
+    HOST_CMD_STATUS_PENDING = 0x01, /*!< Command queued, not yet executed. */
+    HOST_CMD_STATUS_DONE    = 0x02, /*!< Command executed successfully. */
+    HOST_CMD_STATUS_ERROR   = 0x03, /*!< Command executed with error. */
+};
+
+/*! @brief This structure defines one queued host command. */
+typedef struct
+{
+    uint16_t seq;   /*!< Sequence number assigned by the producer. */
+    uint8_t code;   /*!< One of HOST_CMD_xxx. */
+    uint8_t offset; /*!< Register offset. */
+    uint8_t value;  /*!< Register value to write. */
+} host_cmd_t;
+
+/*! @brief This structure defines the completion record of a host command, stored in the slot the command used. */
+typedef struct
+{
+    uint16_t seq;   /*!< Sequence number the record belongs to. */
+    uint8_t status; /*!< One of HOST_CMD_STATUS_xxx. */
+    uint8_t value;  /*!< Register value read back (read commands). */
+} host_cmd_completion_t;
+
+/*! @brief This structure defines the host command queue.
+ *  @details head is only written by the producer (FreeMASTER context), tail only by the consumer (main loop).
+ *           Both are free-running and wrap naturally, so no lock is needed on a single core.
+ */
+typedef struct
+{
+    host_cmd_t slots[HOST_CMD_QUEUE_DEPTH];
+    host_cmd_completion_t completions[HOST_CMD_QUEUE_DEPTH];
+    volatile uint16_t head;          /*!< Producer index. */
+    volatile uint16_t tail;          /*!< Consumer index. */
+    uint16_t nextSeq;                /*!< Next sequence number to assign (producer). */
+    volatile uint16_t lastDoneSeq;   /*!< Sequence number of the last completed command (consumer). */
+    volatile uint32_t overflowCount; /*!< Commands rejected because the queue was full. */
+} host_cmd_queue_t;
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+/*! @brief       Initialize the host command queue.
+ *  @param[in]   pQueue  pointer to the queue.
+ *  @return      void.
+ *  @constraints Must be called before FreeMASTER communication is started.
+ *  @reeentrant  No
+ */
+void HOST_CMD_Init(host_cmd_queue_t *pQueue);
+
+/*! @brief       Append a command to the queue (producer side).
+ *  @param[in]   pQueue  pointer to the queue.
+ *  @param[in]   code    command code.
+ *  @param[in]   offset  register offset.
+ *  @param[in]   value   register value.
+ *  @param[out]  pSeq    sequence number assigned to the command, may be NULL.
+ *  @return      true when queued, false when the queue is full.
+ *  @constraints Only one producer context may call this function.
+ *  @reeentrant  No
+ */
+bool HOST_CMD_Push(host_cmd_queue_t *pQueue, uint8_t code, uint8_t offset, uint8_t value, uint16_t *pSeq);
+
+/*! @brief       Get the oldest pending command without removing it (consumer side).
+ *  @param[in]   pQueue  pointer to the queue.
+ *  @return      pointer to the command, NULL when the queue is empty.
+ *  @constraints Only one consumer context may call this function. The slot stays owned by the consumer
+ *               until HOST_CMD_Complete() is called.
+ *  @reeentrant  No
+ */
+const host_cmd_t *HOST_CMD_Peek(host_cmd_queue_t *pQueue);
+
+/*! @brief       Record the completion of the command returned by HOST_CMD_Peek() and release its slot.
+ *  @param[in]   pQueue  pointer to the queue.
+ *  @param[in]   status  HOST_CMD_STATUS_DONE or HOST_CMD_STATUS_ERROR.
+ *  @param[in]   value   value read back, ignored for write commands.
+ *  @return      void.
+ *  @constraints Only one consumer context may call this function.
+ *  @reeentrant  No
+ */
+void HOST_CMD_Complete(host_cmd_queue_t *pQueue, uint8_t status, uint8_t value);
+
+#endif // HOST_CMD_QUEUE_H_
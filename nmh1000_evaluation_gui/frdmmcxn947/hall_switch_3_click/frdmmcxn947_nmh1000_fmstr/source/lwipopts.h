@@ -0,0 +1,64 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file lwipopts.h
+ * @brief The lwipopts.h file configures lwIP for the FreeMASTER network build (NMH1000_FMSTR_NET).
+ *
+ * @details No operating system, the raw API only and IPv4 with ARP and ICMP so the board answers
+ *          ping. One TCP PCB per FreeMASTER session plus the listen PCB; the send buffer holds a
+ *          whole response of FMSTR_COMM_BUFFER_SIZE so a reply never waits for an ACK.
+ */
+
+#ifndef LWIPOPTS_H_
+#define LWIPOPTS_H_
+
+#include "freemaster_cfg.h"
+
+/* Bare-metal, the application calls ethernetif_input() and sys_check_timeouts() */
+#define NO_SYS              1
+#define LWIP_NETCONN        0
+#define LWIP_SOCKET         0
+#define SYS_LIGHTWEIGHT_PROT 0
+
+/* Protocols */
+#define LWIP_IPV4           1
+#define LWIP_IPV6           0
+#define LWIP_ARP            1
+#define LWIP_ICMP           1
+#define LWIP_UDP            0
+#define LWIP_TCP            1
+#define LWIP_DHCP           0
+#define LWIP_CALLBACK_API   1
+#define LWIP_NETIF_LINK_CALLBACK 1
+
+/* Memory */
+#define MEM_ALIGNMENT       4
+#define MEM_SIZE            (16 * 1024)
+#define MEMP_NUM_PBUF       16
+#define MEMP_NUM_TCP_PCB    (FMSTR_SESSION_COUNT + 1)
+#define MEMP_NUM_TCP_PCB_LISTEN 1
+#define MEMP_NUM_TCP_SEG    32
+#define PBUF_POOL_SIZE      16
+#define PBUF_POOL_BUFSIZE   LWIP_MEM_ALIGN_SIZE(TCP_MSS + 40 + PBUF_LINK_ENCAPSULATION_HLEN + PBUF_LINK_HLEN)
+
+/* TCP */
+#define TCP_MSS             1460
+#define TCP_SND_BUF         (2 * TCP_MSS)
+#define TCP_SND_QUEUELEN    ((4 * TCP_SND_BUF) / TCP_MSS)
+#define TCP_WND             (2 * TCP_MSS)
+#define TCP_LISTEN_BACKLOG  1
+#define LWIP_TCP_KEEPALIVE  1
+
+#if TCP_SND_BUF < (FMSTR_COMM_BUFFER_SIZE + 8)
+#error TCP_SND_BUF must hold one FreeMASTER response
+#endif
+
+/* No statistics */
+#define LWIP_STATS          0
+
+#endif // LWIPOPTS_H_
@@ -0,0 +1,304 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file  nmh1000_array.c
+ * @brief The nmh1000_array.c file implements the manager of several NMH1000 sensors on one I2C bus.
+ */
+
+//-----------------------------------------------------------------------
+// SDK Includes
+//-----------------------------------------------------------------------
+#include <stdio.h>
+#include <string.h>
+#include "fsl_common.h"
+#include "freemaster.h"
+
+//-----------------------------------------------------------------------
+// ISSDK Includes
+//-----------------------------------------------------------------------
+#include "issdk_hal.h"
+#include "register_io_i2c.h"
+#include "nmh1000_array.h"
+
+//-----------------------------------------------------------------------
+// Local Functions
+//-----------------------------------------------------------------------
+/* Check for an NMH1000 at an address and set the handle up for it */
+static bool nmh1000_array_probe(nmh1000_i2c_sensorhandle_t *pHandle, ARM_DRIVER_I2C *pBus, uint8_t index,
+                                uint16_t address)
+{
+    return NMH1000_I2C_Initialize(pHandle, pBus, index, address, NMH1000_WHO_AM_I_VALUE) == SENSOR_ERROR_NONE;
+}
+
+/* Move the sensor answering at the default address to a new address */
+static bool nmh1000_array_readdress(ARM_DRIVER_I2C *pBus, uint8_t index, uint16_t newAddress)
+{
+    nmh1000_i2c_sensorhandle_t handle;
+
+    if (!nmh1000_array_probe(&handle, pBus, index, NMH1000_I2C_ADDR_VAL))
+    {
+        return false;
+    }
+
+    /* The sensor answers at the new address as soon as the write completes */
+    (void)Register_I2C_Write(pBus, &handle.deviceInfo, NMH1000_I2C_ADDR_VAL, NMH1000_I2C_ADDR, (uint8_t)newAddress, 0,
+                             false);
+
+    return nmh1000_array_probe(&handle, pBus, index, newAddress);
+}
+
+static void nmh1000_array_add(nmh1000_array_t *pArray, const nmh1000_i2c_sensorhandle_t *pHandle)
+{
+    nmh1000_array_device_t *pDev = &pArray->devices[pArray->deviceCount];
+    uint8_t slot = pArray->deviceCount;
+
+    memset(pDev, 0, sizeof(*pDev));
+    pDev->handle = *pHandle;
+    pDev->shadow[NMH1000_I2C_ADDR] = (uint8_t)pHandle->slaveAddress;
+    pDev->shadow[NMH1000_WHO_AM_I] = NMH1000_WHO_AM_I_VALUE;
+    pDev->shadowValid = (1U << NMH1000_I2C_ADDR) | (1U << NMH1000_WHO_AM_I);
+
+    (void)snprintf(pDev->tsaName[0], NMH1000_ARRAY_TSA_NAME_LEN, "nmh1000_%u_samples", slot);
+    (void)snprintf(pDev->tsaName[1], NMH1000_ARRAY_TSA_NAME_LEN, "nmh1000_%u_count", slot);
+    (void)snprintf(pDev->tsaName[2], NMH1000_ARRAY_TSA_NAME_LEN, "nmh1000_%u_regs", slot);
+    (void)snprintf(pDev->tsaName[3], NMH1000_ARRAY_TSA_NAME_LEN, "nmh1000_%u_period", slot);
+
+    pArray->deviceCount++;
+}
+
+static bool nmh1000_array_read(nmh1000_array_t *pArray, uint8_t slot, const registerreadlist_t *pReadList,
+                               uint32_t timestamp)
+{
+    nmh1000_array_device_t *pDev = &pArray->devices[slot];
+    uint8_t value;
+
+    if (NMH1000_I2C_ReadData(&pDev->handle, pReadList, &value) != SENSOR_ERROR_NONE)
+    {
+        pDev->readErrors++;
+        pArray->readErrors++;
+        return false;
+    }
+
+    pDev->samples[pDev->sampleCount & (NMH1000_ARRAY_SAMPLES - 1U)] = value;
+    pDev->sampleCount++;
+    pDev->lastTimestamp = timestamp;
+    pArray->totalSamples++;
+
+    return true;
+}
+
+//-----------------------------------------------------------------------
+// Functions
+//-----------------------------------------------------------------------
+int32_t NMH1000_ARRAY_Init(nmh1000_array_t *pArray, ARM_DRIVER_I2C *pBus, uint8_t index,
+                           nmh1000_array_enable_t enableHook)
+{
+    nmh1000_i2c_sensorhandle_t handle;
+
+    if ((pArray == NULL) || (pBus == NULL))
+    {
+        return SENSOR_ERROR_INVALID_PARAM;
+    }
+
+    memset(pArray, 0, sizeof(*pArray));
+
+    /* Without a hook there is no way to tell sensors at the default address apart, take just one */
+    if ((enableHook == NULL) && nmh1000_array_probe(&handle, pBus, index, NMH1000_I2C_ADDR_VAL))
+    {
+        nmh1000_array_add(pArray, &handle);
+    }
+
+    for (uint8_t slot = 0; slot < NMH1000_ARRAY_MAX_DEVICES; slot++)
+    {
+        uint16_t address = NMH1000_ARRAY_ADDR_BASE + slot;
+
+        if (pArray->deviceCount >= NMH1000_ARRAY_MAX_DEVICES)
+        {
+            break;
+        }
+
+        if (enableHook != NULL)
+        {
+            enableHook(slot);
+        }
+
+        /* A sensor kept its address from a previous enumeration, otherwise move a new one there */
+        if (nmh1000_array_probe(&handle, pBus, index, address))
+        {
+            nmh1000_array_add(pArray, &handle);
+        }
+        else if ((enableHook != NULL) && nmh1000_array_readdress(pBus, index, address))
+        {
+            (void)nmh1000_array_probe(&handle, pBus, index, address);
+            nmh1000_array_add(pArray, &handle);
+            pArray->readdressed++;
+        }
+    }
+
+    return (pArray->deviceCount > 0U) ? SENSOR_ERROR_NONE : SENSOR_ERROR_INIT;
+}
+
+int32_t NMH1000_ARRAY_Configure(nmh1000_array_t *pArray, const registerwritelist_t *pRegWriteList)
+{
+    int32_t status;
+
+    for (uint8_t slot = 0; slot < pArray->deviceCount; slot++)
+    {
+        nmh1000_array_device_t *pDev = &pArray->devices[slot];
+
+        status = NMH1000_I2C_Configure(&pDev->handle, pRegWriteList);
+        if (SENSOR_ERROR_NONE != status)
+        {
+            return status;
+        }
+
+        /* Refresh every readable register in the bursts the descriptor table allows */
+        for (uint8_t offset = NMH1000_STATUS; offset < NMH1000_NUM_REGISTERS;)
+        {
+            uint8_t length = NMH1000_REG_BurstLength(offset, (uint8_t)(NMH1000_NUM_REGISTERS - offset));
+
+            if (length == 0U)
+            {
+                offset++;
+                continue;
+            }
+            if (Register_I2C_Read(pDev->handle.pCommDrv, &pDev->handle.deviceInfo, pDev->handle.slaveAddress, offset,
+                                  length, &pDev->shadow[offset]) == ARM_DRIVER_OK)
+            {
+                pDev->shadowValid |= ((1U << length) - 1U) << offset;
+            }
+            else
+            {
+                pDev->shadowValid &= ~(((1U << length) - 1U) << offset);
+            }
+            offset += length;
+        }
+    }
+
+    return SENSOR_ERROR_NONE;
+}
+
+void NMH1000_ARRAY_SetIdleTask(nmh1000_array_t *pArray, registeridlefunction_t idleTask, void *userParam)
+{
+    for (uint8_t slot = 0; slot < pArray->deviceCount; slot++)
+    {
+        NMH1000_I2C_SetIdleTask(&pArray->devices[slot].handle, idleTask, userParam);
+    }
+}
+
+void NMH1000_ARRAY_SetTimeout(nmh1000_array_t *pArray, registertickfunction_t tickFunction, uint32_t timeoutTicks)
+{
+    for (uint8_t slot = 0; slot < pArray->deviceCount; slot++)
+    {
+        NMH1000_I2C_SetTimeout(&pArray->devices[slot].handle, tickFunction, timeoutTicks);
+    }
+}
+
+int32_t NMH1000_ARRAY_Service(nmh1000_array_t *pArray, const registerreadlist_t *pReadList, uint32_t timestamp,
+                              uint32_t *pReadMask)
+{
+    int32_t status = SENSOR_ERROR_NONE;
+    uint32_t readMask = 0U;
+
+    if (pArray->deviceCount == 0U)
+    {
+        *pReadMask = 0U;
+        return SENSOR_ERROR_INIT;
+    }
+
+    if (pArray->schedule == NMH1000_ARRAY_SCHED_PERIOD)
+    {
+        for (uint8_t slot = 0; slot < pArray->deviceCount; slot++)
+        {
+            nmh1000_array_device_t *pDev = &pArray->devices[slot];
+
+            if ((int32_t)(timestamp - pDev->nextDueUs) < 0)
+            {
+                continue;
+            }
+            pDev->nextDueUs = timestamp + pDev->periodUs;
+
+            if (nmh1000_array_read(pArray, slot, pReadList, timestamp))
+            {
+                readMask |= 1UL << slot;
+            }
+            else
+            {
+                status = SENSOR_ERROR_READ;
+            }
+        }
+    }
+    else
+    {
+        uint8_t slot = pArray->nextSlot;
+
+        if (nmh1000_array_read(pArray, slot, pReadList, timestamp))
+        {
+            readMask |= 1UL << slot;
+        }
+        else
+        {
+            status = SENSOR_ERROR_READ;
+        }
+        pArray->nextSlot = (uint8_t)((slot + 1U) % pArray->deviceCount);
+    }
+
+    *pReadMask = readMask;
+    return status;
+}
+
+void NMH1000_ARRAY_UpdateShadow(nmh1000_array_t *pArray, uint8_t slot, uint8_t offset, uint8_t value)
+{
+    if ((slot < pArray->deviceCount) && (offset < NMH1000_NUM_REGISTERS))
+    {
+        pArray->devices[slot].shadow[offset] = value;
+        pArray->devices[slot].shadowValid |= 1U << offset;
+    }
+}
+
+void NMH1000_ARRAY_InvalidateShadow(nmh1000_array_t *pArray, uint8_t slot)
+{
+    /* The next read of each register goes to the bus and fills the shadow again */
+    if (slot < pArray->deviceCount)
+    {
+        pArray->devices[slot].shadowValid = 0U;
+    }
+}
+
+bool NMH1000_ARRAY_ReadShadow(const nmh1000_array_t *pArray, uint8_t slot, uint8_t offset, uint8_t *pValue)
+{
+    if ((slot >= pArray->deviceCount) || !NMH1000_REG_IsCacheable(offset) ||
+        ((pArray->devices[slot].shadowValid & (1U << offset)) == 0U))
+    {
+        return false;
+    }
+
+    *pValue = pArray->devices[slot].shadow[offset];
+    return true;
+}
+
+bool NMH1000_ARRAY_PublishTsa(nmh1000_array_t *pArray)
+{
+    bool ok = true;
+
+    for (uint8_t slot = 0; slot < pArray->deviceCount; slot++)
+    {
+        nmh1000_array_device_t *pDev = &pArray->devices[slot];
+
+        ok &= FMSTR_TsaAddVar(pDev->tsaName[0], FMSTR_TSA_UINT8, pDev->samples, sizeof(pDev->samples),
+                              FMSTR_TSA_INFO_RO_VAR) != FMSTR_FALSE;
+        ok &= FMSTR_TsaAddVar(pDev->tsaName[1], FMSTR_TSA_UINT32, &pDev->sampleCount, sizeof(pDev->sampleCount),
+                              FMSTR_TSA_INFO_RO_VAR) != FMSTR_FALSE;
+        ok &= FMSTR_TsaAddVar(pDev->tsaName[2], FMSTR_TSA_UINT8, pDev->shadow, sizeof(pDev->shadow),
+                              FMSTR_TSA_INFO_RO_VAR) != FMSTR_FALSE;
+        ok &= FMSTR_TsaAddVar(pDev->tsaName[3], FMSTR_TSA_UINT32, (FMSTR_TSATBL_VOIDPTR)&pDev->periodUs,
+                              sizeof(pDev->periodUs), FMSTR_TSA_INFO_RW_VAR) != FMSTR_FALSE;
+    }
+
+    return ok;
+}
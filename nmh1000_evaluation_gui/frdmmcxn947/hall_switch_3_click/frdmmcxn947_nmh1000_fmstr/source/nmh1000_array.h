@@ -0,0 +1,211 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file nmh1000_array.h
+ * @brief The nmh1000_array.h file declares the manager of several NMH1000 sensors on one I2C bus.
+ *
+ * @details Every NMH1000 powers up at NMH1000_I2C_ADDR_VAL. To run several of them on one bus the
+ *          fixture must bring them up one at a time; it does so from the enable hook passed to
+ *          NMH1000_ARRAY_Init(), which is called before slot n is probed. Each newly enabled sensor
+ *          answering at the default address is moved to NMH1000_ARRAY_ADDR_BASE + n through its
+ *          NMH1000_I2C_ADDR register. Without a hook no sensor is re-addressed: the sensor at the
+ *          default address becomes slot 0 and sensors already answering at NMH1000_ARRAY_ADDR_BASE + n
+ *          are picked up as further slots.
+ *
+ *          Reads are scheduled round-robin (one sensor per NMH1000_ARRAY_Service() call) or by
+ *          period (every sensor whose periodUs elapsed). Per-sensor sample rings, counters and
+ *          register shadows are published to FreeMASTER by NMH1000_ARRAY_PublishTsa() as dynamic TSA
+ *          entries named nmh1000_<slot>_samples, nmh1000_<slot>_count, nmh1000_<slot>_regs and the
+ *          writable read period nmh1000_<slot>_period.
+ *
+ *          Shadow entries of registers the descriptor table marks cacheable are served by
+ *          NMH1000_ARRAY_ReadShadow() once they were read or written successfully.
+ */
+
+#ifndef NMH1000_ARRAY_H_
+#define NMH1000_ARRAY_H_
+
+/* Standard C Includes */
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "freemaster.h"
+#include "nmh1000_drv.h"
+#include "nmh1000_regs.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief Maximum number of sensors on the bus. */
+#ifndef NMH1000_ARRAY_MAX_DEVICES
+#define NMH1000_ARRAY_MAX_DEVICES (4U)
+#endif
+
+/*! @brief Address given to slot 0 when re-addressing, slot n gets base + n. */
+#define NMH1000_ARRAY_ADDR_BASE (NMH1000_I2C_ADDR_VAL + 1U)
+
+/*! @brief Samples kept per sensor, must be a power of two. */
+#define NMH1000_ARRAY_SAMPLES (32U)
+
+/*! @brief Slot whose sensor is driven by the host register commands and the switch output. */
+#define NMH1000_ARRAY_PRIMARY (0U)
+
+/*! @brief Dynamic TSA entries added per sensor. */
+#define NMH1000_ARRAY_TSA_ENTRIES (4U)
+
+/*! @brief Dynamic TSA buffer size needed by NMH1000_ARRAY_PublishTsa(), including alignment slack. */
+#define NMH1000_ARRAY_TSA_BUFF_SIZE \
+    ((NMH1000_ARRAY_MAX_DEVICES * NMH1000_ARRAY_TSA_ENTRIES * sizeof(FMSTR_TSA_ENTRY)) + sizeof(FMSTR_ADDR))
+
+#define NMH1000_ARRAY_TSA_NAME_LEN (20U)
+
+/*! @brief Read scheduling policies. */
+typedef enum
+{
+    NMH1000_ARRAY_SCHED_ROUND_ROBIN = 0, /*!< One sensor per service call, in slot order. */
+    NMH1000_ARRAY_SCHED_PERIOD      = 1, /*!< Every sensor whose periodUs elapsed. */
+} nmh1000_array_sched_t;
+
+/*! @brief Fixture hook that powers or selects the sensor of a slot before it is probed. */
+typedef void (*nmh1000_array_enable_t)(uint8_t slot);
+
+/*! @brief This structure defines the state of one sensor of the array. */
+typedef struct
+{
+    nmh1000_i2c_sensorhandle_t handle;             /*!< Driver handle, slave address is per sensor. */
+    uint8_t shadow[NMH1000_NUM_REGISTERS];         /*!< Last known register contents. */
+    uint16_t shadowValid;                          /*!< Bit n set when shadow[n] holds the register. */
+    uint8_t samples[NMH1000_ARRAY_SAMPLES];        /*!< Sample ring, newest at (sampleCount - 1). */
+    uint32_t sampleCount;                          /*!< Samples taken, also the ring write index. */
+    uint32_t lastTimestamp;                        /*!< Timestamp of the newest sample in microseconds. */
+    volatile uint32_t periodUs;                    /*!< Read period in NMH1000_ARRAY_SCHED_PERIOD, host writable. */
+    uint32_t nextDueUs;                            /*!< Next read time in NMH1000_ARRAY_SCHED_PERIOD. */
+    uint32_t readErrors;                           /*!< Failed sample reads. */
+    char tsaName[NMH1000_ARRAY_TSA_ENTRIES][NMH1000_ARRAY_TSA_NAME_LEN]; /*!< Dynamic TSA names. */
+} nmh1000_array_device_t;
+
+/*! @brief This structure defines the sensor array on one bus. */
+typedef struct
+{
+    nmh1000_array_device_t devices[NMH1000_ARRAY_MAX_DEVICES]; /*!< Sensors, slot order. */
+    uint8_t deviceCount;                                       /*!< Sensors found. */
+    uint8_t readdressed;                                       /*!< Sensors moved off the default address. */
+    volatile uint8_t schedule;                                 /*!< nmh1000_array_sched_t, host writable. */
+    uint8_t nextSlot;                                          /*!< Round-robin position. */
+    uint32_t totalSamples;                                     /*!< Samples taken on the bus. */
+    uint32_t readErrors;                                       /*!< Failed sample reads on the bus. */
+} nmh1000_array_t;
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+/*! @brief       Enumerate the sensors on the bus and re-address them when an enable hook is given.
+ *  @param[in]   pArray      array state.
+ *  @param[in]   pBus        CMSIS I2C driver of the bus.
+ *  @param[in]   index       I2C device index of the bus.
+ *  @param[in]   enableHook  fixture hook bringing up one sensor per slot, or NULL.
+ *  @return      SENSOR_ERROR_NONE when at least one sensor was found, SENSOR_ERROR_INIT otherwise.
+ *  @constraints None
+ *  @reeentrant  No
+ */
+int32_t NMH1000_ARRAY_Init(nmh1000_array_t *pArray, ARM_DRIVER_I2C *pBus, uint8_t index,
+                           nmh1000_array_enable_t enableHook);
+
+/*! @brief       Apply a register configuration to every sensor and refresh the register shadows.
+ *  @param[in]   pArray          array state.
+ *  @param[in]   pRegWriteList   configuration to apply.
+ *  @return      SENSOR_ERROR_NONE, or the error of the first sensor that failed.
+ *  @constraints Call after NMH1000_ARRAY_Init().
+ *  @reeentrant  No
+ */
+int32_t NMH1000_ARRAY_Configure(nmh1000_array_t *pArray, const registerwritelist_t *pRegWriteList);
+
+/*! @brief       Install the idle function called on every sensor handle while an I2C transfer completes.
+ *  @param[in]   pArray     array state.
+ *  @param[in]   idleTask   idle function, or NULL to busy-wait.
+ *  @param[in]   userParam  idle function parameter.
+ *  @return      void.
+ *  @constraints Call after NMH1000_ARRAY_Init(), handle copies taken before do not get it.
+ *  @reeentrant  No
+ */
+void NMH1000_ARRAY_SetIdleTask(nmh1000_array_t *pArray, registeridlefunction_t idleTask, void *userParam);
+
+/*! @brief       Install the time base of the I2C transfer timeout on every sensor handle.
+ *  @param[in]   pArray        array state.
+ *  @param[in]   tickFunction  free running tick counter, or NULL to count polling intervals.
+ *  @param[in]   timeoutTicks  transfer timeout in ticks of tickFunction.
+ *  @return      void.
+ *  @constraints Call after NMH1000_ARRAY_Init(), handle copies taken before do not get it.
+ *  @reeentrant  No
+ */
+void NMH1000_ARRAY_SetTimeout(nmh1000_array_t *pArray, registertickfunction_t tickFunction, uint32_t timeoutTicks);
+
+/*! @brief       Read the sensors that are due according to the schedule.
+ *  @param[in]   pArray      array state.
+ *  @param[in]   pReadList   output register read list.
+ *  @param[in]   timestamp   current time in microseconds.
+ *  @param[out]  pReadMask   bit n set when slot n was read successfully.
+ *  @return      SENSOR_ERROR_NONE, or SENSOR_ERROR_READ when any read failed.
+ *  @constraints Call after NMH1000_ARRAY_Init().
+ *  @reeentrant  No
+ */
+int32_t NMH1000_ARRAY_Service(nmh1000_array_t *pArray, const registerreadlist_t *pReadList, uint32_t timestamp,
+                              uint32_t *pReadMask);
+
+/*! @brief       Record a register value written to or read from a sensor outside of the manager.
+ *  @param[in]   pArray  array state.
+ *  @param[in]   slot    sensor slot.
+ *  @param[in]   offset  register offset.
+ *  @param[in]   value   register value.
+ *  @return      void.
+ *  @constraints None
+ *  @reeentrant  No
+ */
+void NMH1000_ARRAY_UpdateShadow(nmh1000_array_t *pArray, uint8_t slot, uint8_t offset, uint8_t value);
+
+/*! @brief       Forget the register shadow of a sensor that may have lost its register contents.
+ *  @param[in]   pArray  array state.
+ *  @param[in]   slot    sensor slot.
+ *  @return      void.
+ *  @constraints Call after a bus recovery, a soft reset or a re-address of the sensor.
+ *  @reeentrant  No
+ */
+void NMH1000_ARRAY_InvalidateShadow(nmh1000_array_t *pArray, uint8_t slot);
+
+/*! @brief       Read a register from the shadow instead of the bus.
+ *  @param[in]   pArray  array state.
+ *  @param[in]   slot    sensor slot.
+ *  @param[in]   offset  register offset.
+ *  @param[out]  pValue  shadowed value.
+ *  @return      true when the register is cacheable and its shadow is valid, false to read the bus.
+ *  @constraints None
+ *  @reeentrant  No
+ */
+bool NMH1000_ARRAY_ReadShadow(const nmh1000_array_t *pArray, uint8_t slot, uint8_t offset, uint8_t *pValue);
+
+/*! @brief       Add the per-sensor variables to the FreeMASTER dynamic TSA table.
+ *  @param[in]   pArray  array state.
+ *  @return      true when all entries were added.
+ *  @constraints Call after FMSTR_SetUpTsaBuff() with at least NMH1000_ARRAY_TSA_BUFF_SIZE bytes.
+ *  @reeentrant  No
+ */
+bool NMH1000_ARRAY_PublishTsa(nmh1000_array_t *pArray);
+
+/*! @brief       Newest sample of a slot.
+ *  @param[in]   pArray  array state.
+ *  @param[in]   slot    sensor slot.
+ *  @return      last sample value.
+ */
+static inline uint8_t NMH1000_ARRAY_LastSample(const nmh1000_array_t *pArray, uint8_t slot)
+{
+    const nmh1000_array_device_t *pDev = &pArray->devices[slot];
+
+    return pDev->samples[(pDev->sampleCount - 1U) & (NMH1000_ARRAY_SAMPLES - 1U)];
+}
+
+#endif // NMH1000_ARRAY_H_
@@ -26,7 +26,13 @@
 #endif
 #include "fsl_common.h"
 #include "freemaster.h"
+#if NMH1000_FMSTR_NET
+#include "eth_link.h"
+#elif NMH1000_FMSTR_USB
+#include "usb_link.h"
+#elif NMH1000_FMSTR_UART
 #include "freemaster_serial_uart.h"
+#endif
 //-----------------------------------------------------------------------
 // CMSIS Includes
 //-----------------------------------------------------------------------
@@ -37,14 +43,46 @@
 //-----------------------------------------------------------------------
 #include "issdk_hal.h"
 #include "nmh1000_drv.h"
+#include "nmh1000_regs.h"
 #include "gpio_driver.h"
 #include "systick_utils.h"
+#include "host_cmd_queue.h"
+#include "sample_stream.h"
+#include "deferred_log.h"
+#include "cycle_profiler.h"
+#include "health_stats.h"
+#include "power_manager.h"
+#include "nmh1000_array.h"
+#include "i2c_recovery.h"
+#include "task_scheduler.h"
+#include "recorder_buffers.h"
 
 
 #define NMH1000_DATA_SIZE (1) /* 1 byte Mag Data. */
-#define NMH1000_NUM_REGISTERS (NMH1000_I2C_ADDR + 1)
 #define THRESHOLD 50
 
+/*! @brief Set to 1 to measure FMSTR_PipePrintf throughput once at startup (takes 1 second). */
+#ifndef PIPE_PRINTF_BENCHMARK
+#define PIPE_PRINTF_BENCHMARK 0
+#endif
+#define PIPE_PRINTF_BENCHMARK_PORT (0x21U)
+
+/*! @brief Task periods in microseconds, the sample task runs at powerSamplePeriodUs. */
+#define FMSTR_TASK_PERIOD_US (1000U)
+#define HOST_TASK_PERIOD_US  (10000U)
+#define LED_TASK_PERIOD_US   (10000U)
+#define STATS_TASK_PERIOD_US (10000U)
+
+/*! @brief Task priorities, 0 is the most urgent. */
+enum
+{
+    TASK_PRIO_SAMPLE = 0,
+    TASK_PRIO_FMSTR,
+    TASK_PRIO_HOST,
+    TASK_PRIO_LED,
+    TASK_PRIO_STATS
+};
+
 /*! @brief Register settings for Normal Mode. */
 const registerwritelist_t cNmh1000ConfigNormal[] = {
     {NMH1000_ODR, NMH1000_USER_ODR_ODR_10X_HSP, NMH1000_USER_ODR_ODR_MASK},
@@ -76,14 +114,66 @@ typedef struct
     uint8_t readall_trigger;
     uint8_t threshold;
     uint8_t mag_switch_flag;
+    /* Batch write: register n gets writeall_value[n] when bit n of writeall_mask is set, bits left set failed */
+    uint8_t writeall_value[NMH1000_NUM_REGISTERS];
+    uint16_t writeall_mask;
+    uint8_t writeall_trigger;
 } host_io_output_vars_t;
 
 host_io_output_vars_t registers;
 
+/*! @brief Register commands queued by the host through FreeMASTER application commands. */
+host_cmd_queue_t hostCmdQueue;
+
+/*! @brief Binary framed mag samples streamed to the Host over a FreeMASTER pipe. */
+sample_stream_t sampleStream;
+
+/*! @brief NMH1000 sensors on the I2C bus, slot NMH1000_ARRAY_PRIMARY is the one the Host registers address. */
+nmh1000_array_t sensorArray;
+
+/*! @brief Storage for the per-sensor TSA entries added at runtime. */
+static FMSTR_U8 tsaDynamicBuffer[NMH1000_ARRAY_TSA_BUFF_SIZE];
+
+/*! @brief Fault recovery and retry state of the sensor I2C bus. */
+i2c_recovery_t i2cRecovery;
+
+/*! @brief Scheduler task indices of the tasks that are retimed or triggered. */
+static int32_t taskSample;
+static int32_t taskHost;
+
+/*! @brief Free-running microsecond timebase for stream timestamps, recorded by the GUI as the
+ *         time of each live point. */
+static int32_t timestampStart;
+static uint32_t timestampTicks;
+static uint32_t timestampUs;
+static uint32_t ticksPerUs;
+
+#if PIPE_PRINTF_BENCHMARK
+/*! @brief Formatted pipe lines per second measured at startup. */
+uint32_t printfBenchLinesPerSec;
+#endif
+
+#if NMH1000_FMSTR_UART
 static void init_freemaster_lpuart(void);
+#endif
 static int32_t apply_register_write(nmh1000_i2c_sensorhandle_t nmh1000Driver, uint8_t offset, uint8_t value);
 static int32_t apply_register_read(nmh1000_i2c_sensorhandle_t nmh1000Driver, uint8_t read_offset, uint8_t *read_value);
 static int32_t apply_register_readall(nmh1000_i2c_sensorhandle_t nmh1000Driver, host_io_output_vars_t *registers);
+static int32_t apply_register_writeall(nmh1000_i2c_sensorhandle_t nmh1000Driver, host_io_output_vars_t *registers);
+static FMSTR_APPCMD_RESULT submit_host_command(FMSTR_APPCMD_CODE code, FMSTR_APPCMD_PDATA pdata, FMSTR_SIZE size);
+static void service_host_commands(nmh1000_i2c_sensorhandle_t nmh1000Driver);
+static uint32_t sample_timestamp_us(void);
+static bool host_work_pending(void);
+static void report_bus_status(int32_t status);
+static void sample_task(void *pParam);
+static void fmstr_task(void *pParam);
+static void host_task(void *pParam);
+static void led_task(void *pParam);
+static void stats_task(void *pParam);
+static void scheduler_idle(uint32_t wakeTicks);
+#if PIPE_PRINTF_BENCHMARK
+static void run_printf_benchmark(void);
+#endif
 
 /*! @brief Target-side Address (TSA) translation structures and macros
  *  With TSA enabled, the user describes the global and static variables using
@@ -107,13 +197,71 @@ FMSTR_TSA_TABLE_BEGIN(main_table)
     FMSTR_TSA_MEMBER(host_io_output_vars_t, readall_trigger, FMSTR_TSA_UINT8)
     FMSTR_TSA_MEMBER(host_io_output_vars_t, threshold, FMSTR_TSA_UINT8)
     FMSTR_TSA_MEMBER(host_io_output_vars_t, mag_switch_flag, FMSTR_TSA_UINT8)
+    FMSTR_TSA_MEMBER(host_io_output_vars_t, writeall_value, FMSTR_TSA_UINT8)
+    FMSTR_TSA_MEMBER(host_io_output_vars_t, writeall_mask, FMSTR_TSA_UINT16)
+    FMSTR_TSA_MEMBER(host_io_output_vars_t, writeall_trigger, FMSTR_TSA_UINT8)
+
+    /* Add host command queue completion records to TSA mapped memory */
+    FMSTR_TSA_STRUCT(host_cmd_completion_t)
+    FMSTR_TSA_MEMBER(host_cmd_completion_t, seq, FMSTR_TSA_UINT16)
+    FMSTR_TSA_MEMBER(host_cmd_completion_t, status, FMSTR_TSA_UINT8)
+    FMSTR_TSA_MEMBER(host_cmd_completion_t, value, FMSTR_TSA_UINT8)
+
+    FMSTR_TSA_STRUCT(host_cmd_queue_t)
+    FMSTR_TSA_MEMBER(host_cmd_queue_t, completions, FMSTR_TSA_USERTYPE(host_cmd_completion_t))
+    FMSTR_TSA_MEMBER(host_cmd_queue_t, lastDoneSeq, FMSTR_TSA_UINT16)
+    FMSTR_TSA_MEMBER(host_cmd_queue_t, overflowCount, FMSTR_TSA_UINT32)
+
+    /* Add sample stream statistics to TSA mapped memory */
+    FMSTR_TSA_STRUCT(sample_stream_t)
+    FMSTR_TSA_MEMBER(sample_stream_t, seq, FMSTR_TSA_UINT16)
+    FMSTR_TSA_MEMBER(sample_stream_t, framesSent, FMSTR_TSA_UINT32)
+    FMSTR_TSA_MEMBER(sample_stream_t, samplesSent, FMSTR_TSA_UINT32)
+    FMSTR_TSA_MEMBER(sample_stream_t, samplesLost, FMSTR_TSA_UINT32)
+
+    /* Add deferred log counters to TSA mapped memory */
+    FMSTR_TSA_STRUCT(dlog_t)
+    FMSTR_TSA_MEMBER(dlog_t, recordCount, FMSTR_TSA_UINT32)
+    FMSTR_TSA_MEMBER(dlog_t, droppedCount, FMSTR_TSA_UINT32)
+
+    /* Add sensor array summary to TSA mapped memory, per-sensor data is added at runtime */
+    FMSTR_TSA_STRUCT(nmh1000_array_t)
+    FMSTR_TSA_MEMBER(nmh1000_array_t, deviceCount, FMSTR_TSA_UINT8)
+    FMSTR_TSA_MEMBER(nmh1000_array_t, readdressed, FMSTR_TSA_UINT8)
+    FMSTR_TSA_MEMBER(nmh1000_array_t, totalSamples, FMSTR_TSA_UINT32)
+    FMSTR_TSA_MEMBER(nmh1000_array_t, readErrors, FMSTR_TSA_UINT32)
+
+    /* Add I2C bus recovery counters to TSA mapped memory */
+    FMSTR_TSA_STRUCT(i2c_recovery_t)
+    FMSTR_TSA_MEMBER(i2c_recovery_t, backoffUs, FMSTR_TSA_UINT32)
+    FMSTR_TSA_MEMBER(i2c_recovery_t, failures, FMSTR_TSA_UINT32)
+    FMSTR_TSA_MEMBER(i2c_recovery_t, recoveries, FMSTR_TSA_UINT32)
+    FMSTR_TSA_MEMBER(i2c_recovery_t, recoveryFailures, FMSTR_TSA_UINT32)
+    FMSTR_TSA_MEMBER(i2c_recovery_t, skipped, FMSTR_TSA_UINT32)
 
 	/* Declare TSA memory mapped output variables as Read-Write(RW) or READ-ONLY(RO) */
 	FMSTR_TSA_RW_VAR(registers, FMSTR_TSA_USERTYPE(host_io_output_vars_t))
+	FMSTR_TSA_RO_VAR(hostCmdQueue, FMSTR_TSA_USERTYPE(host_cmd_queue_t))
+	FMSTR_TSA_RO_VAR(sampleStream, FMSTR_TSA_USERTYPE(sample_stream_t))
+	FMSTR_TSA_RO_VAR(timestampUs, FMSTR_TSA_UINT32)
+	FMSTR_TSA_RO_VAR(g_dlog, FMSTR_TSA_USERTYPE(dlog_t))
+	FMSTR_TSA_RO_VAR(sensorArray, FMSTR_TSA_USERTYPE(nmh1000_array_t))
+	FMSTR_TSA_RW_MEM(sensorArray_schedule, FMSTR_TSA_UINT8, &sensorArray.schedule, sizeof(sensorArray.schedule))
+	FMSTR_TSA_RO_VAR(i2cRecovery, FMSTR_TSA_USERTYPE(i2c_recovery_t))
+#if PIPE_PRINTF_BENCHMARK
+	FMSTR_TSA_RO_VAR(printfBenchLinesPerSec, FMSTR_TSA_UINT32)
+#endif
 FMSTR_TSA_TABLE_END()
 
 FMSTR_TSA_TABLE_LIST_BEGIN()
     FMSTR_TSA_TABLE(main_table)
+    FMSTR_TSA_TABLE(health_table)
+    FMSTR_TSA_TABLE(power_table)
+    FMSTR_TSA_TABLE(sched_table)
+    FMSTR_TSA_TABLE(rec_buffers_table)
+#if PROF_ENABLE
+    FMSTR_TSA_TABLE(prof_table)
+#endif
 FMSTR_TSA_TABLE_LIST_END()
 
 /*******************************************************************************
@@ -122,7 +270,7 @@ FMSTR_TSA_TABLE_LIST_END()
 /*! -----------------------------------------------------------------------
  *  @brief       This is the The main function implementation.
  *  @details     This function invokes board initializes routines, then then brings up the sensor and
- *               finally enters an endless loop to continuously read available samples.
+ *               finally runs the sampling and host tasks on the cooperative scheduler.
  *  @param[in]   void This is no input parameter.
  *  @return      void  There is no return value.
  *  @constraints None
@@ -139,8 +287,12 @@ int main(void)
     BOARD_InitPins();
     BOARD_BootClockRUN();
     BOARD_SystickEnable();
+    POWER_Init();
     BOARD_InitDebugConsole();
 
+    /*! Start the cycle counter used by the hot-path profiler. */
+    PROF_Init();
+
     /*! Initialize the I2C driver. */
     status = I2Cdrv->Initialize(I2C_S_SIGNAL_EVENT);
     if (ARM_DRIVER_OK != status)
@@ -162,110 +314,310 @@ int main(void)
         return -1;
     }
 
+    /*! Bus faults from here on are recovered instead of ending the application */
+    I2C_RECOVERY_Init(&i2cRecovery, I2Cdrv, I2C_S_SIGNAL_EVENT, ARM_I2C_BUS_SPEED_FAST, &I2C_S_SCL_PIN, &I2C_S_SDA_PIN);
+
     /*! Initialize RGB LED pin used by FRDM board */
     gpioDriver->pin_init(&GREEN_LED, GPIO_DIRECTION_OUT, NULL, NULL, NULL);
 
-	status = NMH1000_I2C_Initialize(&nmh1000Driver, &I2C_S_DRIVER, I2C_S_DEVICE_INDEX, NMH1000_I2C_ADDR_VAL,
-			NMH1000_WHO_AM_I_VALUE);
+	/*! Enumerate the sensors on the bus, the FRDM board has no per-sensor enable so none is re-addressed */
+	status = NMH1000_ARRAY_Init(&sensorArray, &I2C_S_DRIVER, I2C_S_DEVICE_INDEX, NULL);
     if (SENSOR_ERROR_NONE != status)
     {
         //PRINTF("\r\n NMH1000 Sensor Initialization Failed, Err = %d\r\n", status);
         return -1;
     }
+    nmh1000Driver = sensorArray.devices[NMH1000_ARRAY_PRIMARY].handle;
 
-    uint8_t magData = 0;
     registers.threshold = 50;
 
-    /*! Configure the NMH1000 sensor. */
-    status = NMH1000_I2C_Configure(&nmh1000Driver, cNmh1000ConfigNormal);
+    /*! Configure the NMH1000 sensors. */
+    status = NMH1000_ARRAY_Configure(&sensorArray, cNmh1000ConfigNormal);
     if (SENSOR_ERROR_NONE != status)
     {
         //PRINTF("\r\nNMH1000 now active and entering data read loop...\r\n");
         return -1;
     }
 
-    /* FreeMASTER comm Initalization */
+    /* FreeMASTER comm Initalization, a missing cable is not fatal as the link may come up later.
+       RTT needs none, FMSTR_Init() sets up its buffers */
+#if NMH1000_FMSTR_NET
+    (void)ETH_LINK_Init();
+#elif NMH1000_FMSTR_USB
+    (void)USB_LINK_Init();
+#elif NMH1000_FMSTR_UART
     init_freemaster_lpuart();
+#endif
+
+    /*! Host command queue must be ready before the first application command can arrive */
+    HOST_CMD_Init(&hostCmdQueue);
 
     /*! FreeMASTER Driver Initialization */
     FMSTR_Init();
+#if NMH1000_FMSTR_USB
+    /*! Enumerate only now, the driver's endpoint buffers are set up by FMSTR_Init() */
+    USB_LINK_Start();
+#endif
+
+    /*! Publish the per-sensor variables, the dynamic table is cleared by FMSTR_Init() */
+    FMSTR_SetUpTsaBuff((FMSTR_ADDR)tsaDynamicBuffer, sizeof(tsaDynamicBuffer));
+    (void)NMH1000_ARRAY_PublishTsa(&sensorArray);
+
+    /*! Route register application commands into the host command queue */
+    FMSTR_RegisterAppCmdCall(HOST_CMD_WRITE_REG, submit_host_command);
+    FMSTR_RegisterAppCmdCall(HOST_CMD_READ_REG, submit_host_command);
+    FMSTR_RegisterAppCmdCall(HOST_CMD_READ_ALL, submit_host_command);
+
+    /*! Create both recorders in their own memory regions, the host may resize them later */
+    (void)REC_BUFFERS_Init();
+
+    /*! Drain deferred log records over a FreeMASTER pipe, the debug UART is taken by FreeMASTER */
+    DLOG_Init(true);
+    DLOG("nmh1000 fmstr started, core clock %u Hz", CLOCK_GetFreq(kCLOCK_CoreSysClk));
+
+    /*! Open the binary sample stream pipe, streaming is optional so a failure is not fatal */
+    SAMPLE_STREAM_Init(&sampleStream);
+    ticksPerUs = CLOCK_GetFreq(kCLOCK_CoreSysClk) / 1000000U;
+    BOARD_SystickStart(&timestampStart);
 
-	for(;;) /* Forever loop */
-	{
-    	/*! FreeMASTER host communication polling mode */
-		FMSTR_Poll();
-
-	    /*! Check for any write register trigger from Host */
-		if (registers.trigger == 1)
-		{
-		    /*! Apply Register Write */
-			status = apply_register_write(nmh1000Driver, registers.offset, registers.value);
-		    if (SENSOR_ERROR_NONE != status)
-		    {
-                return status;
-		    }
-
-		    if (registers.offset == NMH1000_ODR)
-		    {
-		    	registers.odr = registers.value;
-		    }
-		    registers.trigger = 0;
-		}
-
-	    /*! Check for any read register trigger from Host */
-		if (registers.read_trigger == 1)
-		{
-		    /*! Apply Register Write */
-			status = apply_register_read(nmh1000Driver, registers.read_offset, &(registers.read_value));
-		    if (SENSOR_ERROR_NONE != status)
-		    {
-	            return status;
-		    }
-		    if (registers.offset == NMH1000_ODR)
-		    {
-		    	registers.odr = registers.read_value;
-		    }
-		    registers.read_trigger = 0;
-		}
-
-	    /*! Check for any read all register trigger from Host */
-		if (registers.readall_trigger == 1)
-		{
-		    /*! Apply Register Write */
-			status = apply_register_readall(nmh1000Driver, &registers);
-		    if (SENSOR_ERROR_NONE != status)
-		    {
-	            return status;
-		    }
-		    if (registers.offset == NMH1000_ODR)
-		    {
-		    	registers.odr = registers.readall_value[NMH1000_ODR];
-		    }
-		    registers.readall_trigger = 0;
-		    registers.readall_size = NMH1000_I2C_ADDR;
-		}
-
-		/* get the mag output data */
-        status = NMH1000_I2C_ReadData(&nmh1000Driver, cNmh1000OutputNormal, &magData);
-        if (ARM_DRIVER_OK != status)
+    /*! Start the loop, bus and link health counters */
+    HEALTH_Init(I2C_S_DEVICE_INDEX);
+
+#if PIPE_PRINTF_BENCHMARK
+    run_printf_benchmark();
+#endif
+
+    /*! Run the application as cooperative tasks, the idle hook sleeps until the next release */
+    SCHED_Init();
+    taskSample = SCHED_AddTask(sample_task, NULL, POWER_GetSamplePeriodUs(), 0U, TASK_PRIO_SAMPLE, SCHED_FLAG_USES_BUS);
+    (void)SCHED_AddTask(fmstr_task, NULL, FMSTR_TASK_PERIOD_US, 0U, TASK_PRIO_FMSTR, 0U);
+    taskHost = SCHED_AddTask(host_task, &nmh1000Driver, HOST_TASK_PERIOD_US, 0U, TASK_PRIO_HOST, SCHED_FLAG_USES_BUS);
+    (void)SCHED_AddTask(led_task, NULL, LED_TASK_PERIOD_US, 0U, TASK_PRIO_LED, 0U);
+    (void)SCHED_AddTask(stats_task, NULL, STATS_TASK_PERIOD_US, 0U, TASK_PRIO_STATS, 0U);
+
+    /*! I2C completion waits run the tasks that do not need the bus */
+    NMH1000_ARRAY_SetIdleTask(&sensorArray, SCHED_Yield, NULL);
+    NMH1000_I2C_SetIdleTask(&nmh1000Driver, SCHED_Yield, NULL);
+
+    /*! The idle tasks may outlast the polling, time out transfers by elapsed SysTick time instead */
+    NMH1000_ARRAY_SetTimeout(&sensorArray, POWER_GetTicks, REGISTER_I2C_TIMEOUT_US * ticksPerUs);
+    NMH1000_I2C_SetTimeout(&nmh1000Driver, POWER_GetTicks, REGISTER_I2C_TIMEOUT_US * ticksPerUs);
+
+    SCHED_Run(scheduler_idle);
+}
+
+/*!
+ * @brief Read the sensors due and stream the primary sample, runs once per sample period
+ */
+static void sample_task(void *pParam)
+{
+    uint32_t timestamp;
+    uint32_t readMask;
+    int32_t status;
+
+    (void)pParam;
+
+    /* Follow sample period changes from the host */
+    SCHED_SetPeriod(taskSample, POWER_GetSamplePeriodUs());
+
+    /* Skip the sample while the bus backs off after a fault */
+    if (!I2C_RECOVERY_Ready(&i2cRecovery))
+    {
+        return;
+    }
+
+    timestamp = sample_timestamp_us();
+
+    /* get the mag output data of the sensors due */
+    PROF_BEGIN(PROF_I2C_READ);
+    status = NMH1000_ARRAY_Service(&sensorArray, cNmh1000OutputNormal, timestamp, &readMask);
+    PROF_END(PROF_I2C_READ);
+
+    /* A failed read costs this sample, the bus is recovered after repeated failures */
+    report_bus_status(status);
+    HEALTH_CountSamples((uint32_t)__builtin_popcount(readMask));
+
+    /* Update the mag output in TSA memory mapped variable and append it to the binary stream */
+    PROF_BEGIN(PROF_SWITCH_LOGIC);
+    if ((readMask & (1UL << NMH1000_ARRAY_PRIMARY)) != 0U)
+    {
+        registers.m_out = NMH1000_ARRAY_LastSample(&sensorArray, NMH1000_ARRAY_PRIMARY);
+        SAMPLE_STREAM_Push(&sampleStream, timestamp, registers.m_out);
+
+        /* Recorder 0 takes the live values the GUI acquires in bulk, one point per sample */
+        FMSTR_Recorder(0);
+    }
+
+    /* Recorder 1 takes a point whenever any sensor of the array was read */
+    if (readMask != 0U)
+    {
+        FMSTR_Recorder(1);
+    }
+#if FMSTR_USE_READ_CACHE > 0
+    /* New values are published, host reads from here on copy them again */
+    if (readMask != 0U)
+    {
+        FMSTR_ReadCacheInvalidate();
+    }
+#endif
+    SAMPLE_STREAM_Flush(&sampleStream, timestamp);
+    PROF_END(PROF_SWITCH_LOGIC);
+}
+
+/*!
+ * @brief FreeMASTER host communication polling mode
+ */
+static void fmstr_task(void *pParam)
+{
+    (void)pParam;
+
+    PROF_BEGIN(PROF_FMSTR_POLL);
+#if NMH1000_FMSTR_NET
+    ETH_LINK_Poll();
+#endif
+    FMSTR_Poll();
+    PROF_END(PROF_FMSTR_POLL);
+}
+
+/*!
+ * @brief Serve the register triggers and queued register commands of the Host
+ */
+static void host_task(void *pParam)
+{
+    nmh1000_i2c_sensorhandle_t *pDriver = (nmh1000_i2c_sensorhandle_t *)pParam;
+    int32_t status;
+
+    /* No transaction while the bus backs off after a fault, triggers and queued commands stay pending */
+    if (!host_work_pending() || !I2C_RECOVERY_Ready(&i2cRecovery))
+    {
+        return;
+    }
+
+    PROF_BEGIN(PROF_HOST_CMDS);
+
+    /*! Check for any write register trigger from Host */
+    if (registers.trigger == 1)
+    {
+        status = apply_register_write(*pDriver, registers.offset, registers.value);
+        report_bus_status(status);
+        if (SENSOR_ERROR_NONE != status)
+        {
+            DLOG("register 0x%02x write failed, status %d", registers.offset, status);
+        }
+        else if (registers.offset == NMH1000_ODR)
         {
-            return -1;
+            registers.odr = registers.value;
         }
+        registers.trigger = 0;
+    }
 
-        /* Update the mag output in TSA memory mapped variable */
-        registers.m_out = magData;
-        if (registers.m_out > registers.threshold)
+    /*! Check for any read register trigger from Host */
+    if (registers.read_trigger == 1)
+    {
+        status = apply_register_read(*pDriver, registers.read_offset, &(registers.read_value));
+        report_bus_status(status);
+        if (SENSOR_ERROR_NONE != status)
+        {
+            DLOG("register 0x%02x read failed, status %d", registers.read_offset, status);
+        }
+        else if (registers.read_offset == NMH1000_ODR)
         {
-        	registers.mag_switch_flag = 1;
-        	gpioDriver->clr_pin(&GREEN_LED);
+            registers.odr = registers.read_value;
+        }
+        registers.read_trigger = 0;
+    }
+
+    /*! Check for any read all register trigger from Host */
+    if (registers.readall_trigger == 1)
+    {
+        status = apply_register_readall(*pDriver, &registers);
+        report_bus_status(status);
+        if (SENSOR_ERROR_NONE != status)
+        {
+            DLOG("register read all failed, status %d", status);
         }
         else
         {
-        	registers.mag_switch_flag = 0;
-        	gpioDriver->set_pin(&GREEN_LED);
+            registers.odr = registers.readall_value[NMH1000_ODR];
+        }
+        registers.readall_trigger = 0;
+        registers.readall_size = NMH1000_I2C_ADDR;
+    }
+
+    /*! Check for a batch register write from Host */
+    if (registers.writeall_trigger == 1)
+    {
+        status = apply_register_writeall(*pDriver, &registers);
+        report_bus_status(status);
+        if (SENSOR_ERROR_NONE != status)
+        {
+            DLOG("register batch write failed, mask 0x%04x status %d", registers.writeall_mask, status);
         }
-	}
- }
+        registers.writeall_trigger = 0;
+    }
+
+    /*! Drain register commands queued by the Host */
+    service_host_commands(*pDriver);
+
+#if FMSTR_USE_READ_CACHE > 0
+    /*! Register results are visible to the Host without waiting for the next sample */
+    FMSTR_ReadCacheInvalidate();
+#endif
+
+    PROF_END(PROF_HOST_CMDS);
+}
+
+/*!
+ * @brief Drive the switch flag and the LED from the last mag output
+ */
+static void led_task(void *pParam)
+{
+    GENERIC_DRIVER_GPIO *gpioDriver = &Driver_GPIO_KSDK;
+
+    (void)pParam;
+
+    PROF_BEGIN(PROF_LED_UPDATE);
+    if (registers.m_out > registers.threshold)
+    {
+        registers.mag_switch_flag = 1;
+        gpioDriver->clr_pin(&GREEN_LED);
+    }
+    else
+    {
+        registers.mag_switch_flag = 0;
+        gpioDriver->set_pin(&GREEN_LED);
+    }
+    PROF_END(PROF_LED_UPDATE);
+}
+
+/*!
+ * @brief Serve the profiler and health statistics
+ */
+static void stats_task(void *pParam)
+{
+    (void)pParam;
+
+    PROF_Service();
+    HEALTH_Service();
+}
+
+/*!
+ * @brief Nothing is ready: serve pending host requests at once, otherwise sleep until the next release.
+ *        Requests held back by a bus backoff wait for the periodic release of the host task.
+ */
+static void scheduler_idle(uint32_t wakeTicks)
+{
+    if (host_work_pending() && !I2C_RECOVERY_BackingOff(&i2cRecovery))
+    {
+        SCHED_Trigger(taskHost);
+        return;
+    }
+
+    HEALTH_CountLoop();
+    HEALTH_IdleBegin();
+    POWER_Idle(wakeTicks);
+    HEALTH_IdleEnd();
+}
 
 /*!
  * @brief Service register write trigger from Host
@@ -274,10 +626,11 @@ int32_t apply_register_write(nmh1000_i2c_sensorhandle_t nmh1000Driver, uint8_t o
 {
     int32_t status;
 
-	if (offset > NMH1000_NUM_REGISTERS)
-	{
-		return SENSOR_ERROR_INVALID_PARAM;
-	}
+    /* Read-only registers and reserved bits are refused without bus traffic */
+    if (!NMH1000_REG_IsWritable(offset, value))
+    {
+        return SENSOR_ERROR_INVALID_PARAM;
+    }
 
 	registerwritelist_t nmh1000_register_write[] = {
 	     /*! Set register offset with provided value */
@@ -290,6 +643,17 @@ int32_t apply_register_write(nmh1000_i2c_sensorhandle_t nmh1000Driver, uint8_t o
         return SENSOR_ERROR_WRITE;
     }
 
+    /* A soft reset restores every register, a re-address may leave the sensor unreachable */
+    if (((offset == NMH1000_CONTROL_REG1) && ((value & NMH1000_CONTROL_REG1_RST_MASK) != 0U)) ||
+        (offset == NMH1000_I2C_ADDR))
+    {
+        NMH1000_ARRAY_InvalidateShadow(&sensorArray, NMH1000_ARRAY_PRIMARY);
+        return SENSOR_ERROR_NONE;
+    }
+
+    /* Keep the array register shadow of the primary sensor in step */
+    NMH1000_ARRAY_UpdateShadow(&sensorArray, NMH1000_ARRAY_PRIMARY, offset, value);
+
     return SENSOR_ERROR_NONE;
 }
 
@@ -300,10 +664,16 @@ int32_t apply_register_read(nmh1000_i2c_sensorhandle_t nmh1000Driver, uint8_t re
 {
     int32_t status;
 
-	if (read_offset > NMH1000_NUM_REGISTERS)
-	{
-		return SENSOR_ERROR_INVALID_PARAM;
-	}
+    if (!NMH1000_REG_IsReadable(read_offset))
+    {
+        return SENSOR_ERROR_INVALID_PARAM;
+    }
+
+    /* Registers that only change when written are answered from the shadow */
+    if (NMH1000_ARRAY_ReadShadow(&sensorArray, NMH1000_ARRAY_PRIMARY, read_offset, read_value))
+    {
+        return SENSOR_ERROR_NONE;
+    }
 
 	registerreadlist_t nmh1000_register_read[] = {
 		     /*! Set register offset with provided value */
@@ -314,6 +684,7 @@ int32_t apply_register_read(nmh1000_i2c_sensorhandle_t nmh1000Driver, uint8_t re
     {
         return SENSOR_ERROR_WRITE;
     }
+    NMH1000_ARRAY_UpdateShadow(&sensorArray, NMH1000_ARRAY_PRIMARY, read_offset, *read_value);
 
     return SENSOR_ERROR_NONE;
 }
@@ -324,22 +695,247 @@ int32_t apply_register_read(nmh1000_i2c_sensorhandle_t nmh1000Driver, uint8_t re
 int32_t apply_register_readall(nmh1000_i2c_sensorhandle_t nmh1000Driver, host_io_output_vars_t *registers)
 {
     int32_t status;
+    uint8_t length;
 
-	for (int reg_offset = NMH1000_STATUS; reg_offset <= NMH1000_I2C_ADDR; reg_offset++)
-	{
-		registerreadlist_t nmh1000_register_readall[] = {
-				 /*! Set register offset with provided value */
-				{.readFrom = reg_offset, .numBytes = 1}, __END_READ_DATA__};
-		status = NMH1000_I2C_ReadData(&nmh1000Driver, nmh1000_register_readall, &(registers->readall_value[reg_offset]));
-		if (SENSOR_ERROR_NONE != status)
-		{
-			return SENSOR_ERROR_READ;
-		}
-	}
+    /* Always from the bus, this also resynchronizes the shadow */
+    for (uint8_t reg_offset = NMH1000_STATUS; reg_offset < NMH1000_NUM_REGISTERS; reg_offset += length)
+    {
+        length = NMH1000_REG_BurstLength(reg_offset, (uint8_t)(NMH1000_NUM_REGISTERS - reg_offset));
+        if (length == 0U)
+        {
+            length = 1U;
+            continue;
+        }
+
+        registerreadlist_t nmh1000_register_readall[] = {{.readFrom = reg_offset, .numBytes = length},
+                                                         __END_READ_DATA__};
+        status = NMH1000_I2C_ReadData(&nmh1000Driver, nmh1000_register_readall, &(registers->readall_value[reg_offset]));
+        if (SENSOR_ERROR_NONE != status)
+        {
+            return SENSOR_ERROR_READ;
+        }
+        for (uint8_t i = 0; i < length; i++)
+        {
+            NMH1000_ARRAY_UpdateShadow(&sensorArray, NMH1000_ARRAY_PRIMARY, reg_offset + i,
+                                       registers->readall_value[reg_offset + i]);
+        }
+    }
 
     return SENSOR_ERROR_NONE;
 }
 
+/*!
+ * @brief Service batch register write trigger from Host, the registers written are cleared from writeall_mask
+ */
+int32_t apply_register_writeall(nmh1000_i2c_sensorhandle_t nmh1000Driver, host_io_output_vars_t *registers)
+{
+    int32_t result = SENSOR_ERROR_NONE;
+    int32_t status;
+
+    for (uint8_t reg_offset = NMH1000_STATUS; reg_offset < NMH1000_NUM_REGISTERS; reg_offset++)
+    {
+        if ((registers->writeall_mask & (1U << reg_offset)) == 0U)
+        {
+            continue;
+        }
+
+        status = apply_register_write(nmh1000Driver, reg_offset, registers->writeall_value[reg_offset]);
+        if (SENSOR_ERROR_NONE == status)
+        {
+            registers->writeall_mask &= (uint16_t)~(1U << reg_offset);
+            if (reg_offset == NMH1000_ODR)
+            {
+                registers->odr = registers->writeall_value[reg_offset];
+            }
+            continue;
+        }
+
+        /* A refused register does not stop the batch, a bus error does */
+        if (SENSOR_ERROR_NONE == result)
+        {
+            result = status;
+        }
+        if (SENSOR_ERROR_INVALID_PARAM != status)
+        {
+            break;
+        }
+    }
+
+    return result;
+}
+
+/*!
+ * @brief Queue a register command received as FreeMASTER application command.
+ *        Runs in the FreeMASTER communication context (UART interrupt in FMSTR_LONG_INTR mode).
+ */
+static FMSTR_APPCMD_RESULT submit_host_command(FMSTR_APPCMD_CODE code, FMSTR_APPCMD_PDATA pdata, FMSTR_SIZE size)
+{
+    uint16_t seq;
+    uint8_t offset = 0;
+    uint8_t value = 0;
+
+    switch (code)
+    {
+        case HOST_CMD_WRITE_REG:
+            if (size != 2U)
+            {
+                return HOST_CMD_RESULT_INVALID;
+            }
+            offset = pdata[0];
+            value = pdata[1];
+            break;
+        case HOST_CMD_READ_REG:
+            if (size != 1U)
+            {
+                return HOST_CMD_RESULT_INVALID;
+            }
+            offset = pdata[0];
+            break;
+        case HOST_CMD_READ_ALL:
+            break;
+        default:
+            return HOST_CMD_RESULT_INVALID;
+    }
+
+    if (!HOST_CMD_Push(&hostCmdQueue, code, offset, value, &seq))
+    {
+        return HOST_CMD_RESULT_FULL;
+    }
+
+    /* Hand the sequence number back so the host can match the completion record. */
+    FMSTR_AppCmdSetResponseData((FMSTR_ADDR)&seq, sizeof(seq));
+    return HOST_CMD_RESULT_QUEUED;
+}
+
+/*!
+ * @brief Execute all register commands queued by the Host and publish their completion.
+ */
+static void service_host_commands(nmh1000_i2c_sensorhandle_t nmh1000Driver)
+{
+    const host_cmd_t *pCmd;
+    int32_t status;
+    uint8_t value;
+
+    while ((pCmd = HOST_CMD_Peek(&hostCmdQueue)) != NULL)
+    {
+        value = 0;
+        switch (pCmd->code)
+        {
+            case HOST_CMD_WRITE_REG:
+                status = apply_register_write(nmh1000Driver, pCmd->offset, pCmd->value);
+                if ((SENSOR_ERROR_NONE == status) && (pCmd->offset == NMH1000_ODR))
+                {
+                    registers.odr = pCmd->value;
+                }
+                break;
+            case HOST_CMD_READ_REG:
+                status = apply_register_read(nmh1000Driver, pCmd->offset, &value);
+                if ((SENSOR_ERROR_NONE == status) && (pCmd->offset == NMH1000_ODR))
+                {
+                    registers.odr = value;
+                }
+                break;
+            case HOST_CMD_READ_ALL:
+                status = apply_register_readall(nmh1000Driver, &registers);
+                if (SENSOR_ERROR_NONE == status)
+                {
+                    registers.odr = registers.readall_value[NMH1000_ODR];
+                    registers.readall_size = NMH1000_I2C_ADDR;
+                }
+                break;
+            default:
+                status = SENSOR_ERROR_INVALID_PARAM;
+                break;
+        }
+
+        report_bus_status(status);
+        if (SENSOR_ERROR_NONE != status)
+        {
+            DLOG("host cmd 0x%02x seq %u offset 0x%02x failed, status %d", pCmd->code, pCmd->seq, pCmd->offset,
+                 status);
+        }
+
+        HOST_CMD_Complete(&hostCmdQueue, (SENSOR_ERROR_NONE == status) ? HOST_CMD_STATUS_DONE : HOST_CMD_STATUS_ERROR,
+                          value);
+    }
+}
+
+/*!
+ * @brief Feed the outcome of a sensor transaction to the bus recovery, rejected parameters never reached the bus
+ */
+static void report_bus_status(int32_t status)
+{
+    if ((SENSOR_ERROR_INVALID_PARAM != status) && I2C_RECOVERY_Report(&i2cRecovery, status))
+    {
+        /* Register contents after a bus clear are unknown, shadowed reads go to the bus again */
+        for (uint8_t slot = 0; slot < sensorArray.deviceCount; slot++)
+        {
+            NMH1000_ARRAY_InvalidateShadow(&sensorArray, slot);
+        }
+    }
+}
+
+/*!
+ * @brief Advance the microsecond timebase, carrying sub-microsecond ticks over to the next call.
+ */
+static uint32_t sample_timestamp_us(void)
+{
+    timestampTicks += (uint32_t)BOARD_SystickElapsedTicks(&timestampStart);
+    BOARD_SystickStart(&timestampStart);
+
+    timestampUs += timestampTicks / ticksPerUs;
+    timestampTicks %= ticksPerUs;
+
+    return timestampUs;
+}
+
+/*!
+ * @brief Check for host requests the main loop still has to serve
+ */
+static bool host_work_pending(void)
+{
+    return (registers.trigger == 1) || (registers.read_trigger == 1) || (registers.readall_trigger == 1) ||
+           (registers.writeall_trigger == 1) || (HOST_CMD_Peek(&hostCmdQueue) != NULL);
+}
+
+#if PIPE_PRINTF_BENCHMARK
+/*!
+ * @brief Format typical log lines into a pipe for one second and record the rate.
+ *        The pipe drains into a ring which is emptied after every line, so only
+ *        the formatting cost is measured, not the serial link.
+ */
+static void run_printf_benchmark(void)
+{
+    static uint8_t sink[128];
+    FMSTR_PIPE_RING ring = {.buff = (FMSTR_ADDR)sink, .size = sizeof(sink)};
+    uint32_t coreClk = CLOCK_GetFreq(kCLOCK_CoreSysClk);
+    uint32_t lines = 0;
+    int32_t start, ticks;
+    FMSTR_HPIPE pipe;
+
+    pipe = FMSTR_PipeOpen(PIPE_PRINTF_BENCHMARK_PORT, NULL, NULL, 0, NULL, 0, FMSTR_PIPE_TYPE_ANSI_TERMINAL, "bench");
+    if ((pipe == NULL) || (FMSTR_PipeAttachTxRing(pipe, &ring) == FMSTR_FALSE))
+    {
+        return;
+    }
+
+    BOARD_SystickStart(&start);
+    do
+    {
+        for (uint32_t i = 0; i < 64U; i++, lines++)
+        {
+            FMSTR_PipePrintf(pipe, "t=%u m=%u f=%d\r\n", lines * 1237U, lines & 0xFFU, (int)(lines % 7U) - 3);
+            ring.rp = ring.wp;
+        }
+        ticks = BOARD_SystickElapsedTicks(&start);
+    } while ((uint32_t)ticks < coreClk);
+
+    printfBenchLinesPerSec = (uint32_t)(((uint64_t)lines * coreClk) / (uint32_t)ticks);
+    FMSTR_PipeClose(pipe);
+}
+#endif
+
+#if NMH1000_FMSTR_UART
 /*!
  * @brief LPUART Module initialization (LPUART is a the standard block included e.g. in K66F)
  */
@@ -387,7 +983,12 @@ static void init_freemaster_lpuart(void)
 
 void BOARD_UART_IRQ_HANDLER(void)
 {
+    PROF_BEGIN(PROF_FMSTR_ISR);
+
     /* Call FreeMASTER Interrupt routine handler */
     FMSTR_SerialIsr();
+
+    PROF_END(PROF_FMSTR_ISR);
 }
 #endif
+#endif /* NMH1000_FMSTR_UART */
@@ -0,0 +1,104 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file recorder_buffers.h
+ * @brief The recorder_buffers.h file declares the runtime-sized FreeMASTER recorder buffers.
+ *
+ * @details Each recorder owns a memory region of its own, a linker section placed by the project linker
+ *          script. The recorders are created with the whole region by REC_BUFFERS_Init(), the host may
+ *          then resize them with the REC_BUFFERS_APPCMD_SIZE application command. Sizes above the
+ *          region are clamped to it. The recorder must be idle and it loses its configuration, the
+ *          host configures it again after the resize.
+ *          On the MCXN947 recorder 0 takes SRAMX and recorder 1 SRAMH, banks the application does
+ *          not use otherwise. The MCXA153 keeps both buffers in its 24 KB of SRAM.
+ */
+
+#ifndef RECORDER_BUFFERS_H_
+#define RECORDER_BUFFERS_H_
+
+/* Standard C Includes */
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "freemaster.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief Recorders created by this module, FMSTR_REC_BUFF_SIZE must be 0 so none is built in. */
+#define REC_BUFFERS_COUNT (2U)
+
+#if FMSTR_REC_BUFF_SIZE > 0
+#error FMSTR_REC_BUFF_SIZE must be 0, recorder 0 is created by recorder_buffers.c
+#endif
+#if FMSTR_USE_RECORDER < REC_BUFFERS_COUNT
+#error FMSTR_USE_RECORDER must cover the recorders of recorder_buffers.c
+#endif
+
+/*! @brief Memory regions of the recorders, NOLOAD sections of the MCUXpresso managed linker script. */
+#if defined(CPU_MCXN947VDF_cm33_core0)
+#define REC_BUFFERS_SECTION_0 ".noinit.$SRAMX"
+#define REC_BUFFERS_REGION_0  (96U * 1024U)
+#define REC_BUFFERS_SECTION_1 ".noinit.$SRAMH"
+#define REC_BUFFERS_REGION_1  (32U * 1024U)
+#else
+#define REC_BUFFERS_SECTION_0 ".noinit"
+#define REC_BUFFERS_REGION_0  (1024U)
+#define REC_BUFFERS_SECTION_1 ".noinit"
+#define REC_BUFFERS_REGION_1  (1024U)
+#endif
+
+/*! @brief Smallest buffer accepted, the recorder structure and a few samples. */
+#define REC_BUFFERS_MIN_SIZE (256U)
+
+/*! @brief FreeMASTER application command setting a recorder buffer size, next to the HOST_CMD_xxx codes.
+ *  @details args: recorder index (1 byte), requested size (4 bytes, little-endian).
+ *           The response data holds the size the recorder got (4 bytes, little-endian).
+ */
+#define REC_BUFFERS_APPCMD_SIZE (0x13U)
+
+/*! @brief Application command result codes of REC_BUFFERS_APPCMD_SIZE. */
+enum
+{
+    REC_BUFFERS_RESULT_OK      = 0x00, /*!< Recorder created with the requested size. */
+    REC_BUFFERS_RESULT_CLAMPED = 0x01, /*!< Recorder created with the whole region, smaller than requested. */
+    REC_BUFFERS_RESULT_BUSY    = 0x02, /*!< Recorder is running, stop it first. */
+    REC_BUFFERS_RESULT_INVALID = 0x03, /*!< Malformed arguments, unknown recorder or size below REC_BUFFERS_MIN_SIZE. */
+};
+
+/*! @brief This structure defines the recorder buffer sizes published to FreeMASTER. */
+typedef struct
+{
+    uint32_t size[REC_BUFFERS_COUNT];   /*!< Current buffer size of each recorder. */
+    uint32_t region[REC_BUFFERS_COUNT]; /*!< Largest size of each recorder, its memory region. */
+} rec_buffers_t;
+
+/*! @brief Recorder buffer sizes, published in FreeMASTER TSA table rec_buffers_table. */
+extern rec_buffers_t recBuffers;
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+/*! @brief       Create the recorders with their whole regions and register the resize command.
+ *  @return      true when all recorders were created.
+ *  @constraints Call after FMSTR_Init(), the initialization clears the recorder table.
+ *  @reeentrant  No
+ */
+bool REC_BUFFERS_Init(void);
+
+/*! @brief       Give a recorder a buffer of another size, clamped to its region.
+ *  @param[in]   recIndex  recorder index.
+ *  @param[in]   size      requested size in bytes.
+ *  @param[out]  pSize     size the recorder got, may be NULL.
+ *  @return      one of REC_BUFFERS_RESULT_xxx.
+ *  @constraints The recorder must not be running. Called in the FreeMASTER communication context.
+ *  @reeentrant  No
+ */
+uint8_t REC_BUFFERS_Resize(uint8_t recIndex, uint32_t size, uint32_t *pSize);
+
+#endif // RECORDER_BUFFERS_H_
@@ -0,0 +1,69 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file usb_device_config.h
+ * @brief The usb_device_config.h file configures the MCUXpresso SDK USB device stack for the FreeMASTER USB build.
+ *
+ * @details Built with NMH1000_FMSTR_USB (freemaster_cfg.h). One CDC-ACM device on the EHCI controller
+ *          of the high-speed USB port, interrupt driven without an operating system.
+ */
+
+#ifndef USB_DEVICE_CONFIG_H_
+#define USB_DEVICE_CONFIG_H_
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/* Controllers, only the high-speed EHCI controller (USB1) is used */
+#define USB_DEVICE_CONFIG_KHCI         (0U)
+#define USB_DEVICE_CONFIG_EHCI         (1U)
+#define USB_DEVICE_CONFIG_LPCIP3511FS  (0U)
+#define USB_DEVICE_CONFIG_LPCIP3511HS  (0U)
+#define USB_DEVICE_CONFIG_NUM \
+    (USB_DEVICE_CONFIG_KHCI + USB_DEVICE_CONFIG_EHCI + USB_DEVICE_CONFIG_LPCIP3511FS + USB_DEVICE_CONFIG_LPCIP3511HS)
+
+/* Classes */
+#define USB_DEVICE_CONFIG_HID          (0U)
+#define USB_DEVICE_CONFIG_CDC_ACM      (1U)
+#define USB_DEVICE_CONFIG_MSC          (0U)
+#define USB_DEVICE_CONFIG_AUDIO        (0U)
+#define USB_DEVICE_CONFIG_PHDC         (0U)
+#define USB_DEVICE_CONFIG_VIDEO        (0U)
+#define USB_DEVICE_CONFIG_CCID         (0U)
+#define USB_DEVICE_CONFIG_PRINTER      (0U)
+#define USB_DEVICE_CONFIG_DFU          (0U)
+
+/* Device */
+#define USB_DEVICE_CONFIG_SELF_POWER   (1U)
+#define USB_DEVICE_CONFIG_ENDPOINTS    (4U)   /* Control, CDC notification, bulk data */
+#define USB_DEVICE_CONFIG_USE_TASK     (0U)   /* Transfers complete in the USB interrupt */
+#define USB_DEVICE_CONFIG_MAX_MESSAGES (8U)
+#define USB_DEVICE_CONFIG_USB20_TEST_MODE   (0U)
+#define USB_DEVICE_CONFIG_CV_TEST      (0U)
+#define USB_DEVICE_CONFIG_COMPLIANCE_TEST   (0U)
+
+#if ((defined(USB_DEVICE_CONFIG_EHCI)) && (USB_DEVICE_CONFIG_EHCI > 0U))
+/* One dTD per primed buffer of freemaster_serial_usb.c plus the control transfers */
+#define USB_DEVICE_CONFIG_EHCI_MAX_DTD          (16U)
+#define USB_DEVICE_CONFIG_EHCI_ERROR_HANDLING   (0U)
+#define USB_DEVICE_CONFIG_EHCI_TEST_MODE        (0U)
+#define USB_DEVICE_CONFIG_EHCI_ID_PIN_DETECT    (0U)
+#endif
+
+/* The endpoint buffers are in non-cacheable SRAM, the Cortex-M33 has no data cache */
+#define USB_DEVICE_CONFIG_BUFFER_PROPERTY_CACHEABLE (0U)
+
+/* No suspend handling, remote wakeup or charger detection; POWER_Idle() only enters Sleep */
+#define USB_DEVICE_CONFIG_KEEP_ALIVE_MODE  (0U)
+#define USB_DEVICE_CONFIG_LOW_POWER_MODE   (0U)
+#define USB_DEVICE_CONFIG_REMOTE_WAKEUP    (0U)
+#define USB_DEVICE_CONFIG_DETACH_ENABLE    (0U)
+#define USB_DEVICE_CONFIG_ERROR_HANDLING   (0U)
+#define USB_DEVICE_CHARGER_DETECT_ENABLE   (0U)
+
+#endif // USB_DEVICE_CONFIG_H_
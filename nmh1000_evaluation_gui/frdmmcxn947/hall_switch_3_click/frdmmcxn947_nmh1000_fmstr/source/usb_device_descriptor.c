@@ -0,0 +1,329 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file  usb_device_descriptor.c
+ * @brief The usb_device_descriptor.c file defines the USB descriptors of the FreeMASTER CDC-ACM device.
+ */
+
+#include "freemaster_cfg.h"
+
+#if NMH1000_FMSTR_USB
+
+//-----------------------------------------------------------------------
+// SDK Includes
+//-----------------------------------------------------------------------
+#include "usb_device_config.h"
+#include "usb.h"
+#include "usb_device.h"
+#include "usb_device_class.h"
+#include "usb_device_cdc_acm.h"
+
+#include "usb_device_descriptor.h"
+
+//-----------------------------------------------------------------------
+// Global Variables
+//-----------------------------------------------------------------------
+/* Notification endpoint of the communication interface */
+static usb_device_endpoint_struct_t cdcCicEndpoints[USB_CDC_VCOM_ENDPOINT_CIC_COUNT] = {
+    {USB_CDC_VCOM_INTERRUPT_IN_ENDPOINT | (USB_IN << USB_DESCRIPTOR_ENDPOINT_ADDRESS_DIRECTION_SHIFT),
+     USB_ENDPOINT_INTERRUPT, HS_CDC_VCOM_INTERRUPT_IN_PACKET_SIZE, HS_CDC_VCOM_INTERRUPT_IN_INTERVAL},
+};
+
+/* Bulk endpoints of the data interface */
+static usb_device_endpoint_struct_t cdcDicEndpoints[USB_CDC_VCOM_ENDPOINT_DIC_COUNT] = {
+    {USB_CDC_VCOM_BULK_IN_ENDPOINT | (USB_IN << USB_DESCRIPTOR_ENDPOINT_ADDRESS_DIRECTION_SHIFT),
+     USB_ENDPOINT_BULK, HS_CDC_VCOM_BULK_PACKET_SIZE, 0U},
+    {USB_CDC_VCOM_BULK_OUT_ENDPOINT | (USB_OUT << USB_DESCRIPTOR_ENDPOINT_ADDRESS_DIRECTION_SHIFT),
+     USB_ENDPOINT_BULK, HS_CDC_VCOM_BULK_PACKET_SIZE, 0U},
+};
+
+static usb_device_interface_struct_t cdcCicInterface[] = {
+    {0U, {USB_CDC_VCOM_ENDPOINT_CIC_COUNT, cdcCicEndpoints}, NULL},
+};
+
+static usb_device_interface_struct_t cdcDicInterface[] = {
+    {0U, {USB_CDC_VCOM_ENDPOINT_DIC_COUNT, cdcDicEndpoints}, NULL},
+};
+
+static usb_device_interfaces_struct_t cdcInterfaces[USB_CDC_VCOM_INTERFACE_COUNT] = {
+    {USB_CDC_VCOM_CIC_CLASS, USB_CDC_VCOM_CIC_SUBCLASS, USB_CDC_VCOM_CIC_PROTOCOL, USB_CDC_VCOM_COMM_INTERFACE_INDEX,
+     cdcCicInterface, sizeof(cdcCicInterface) / sizeof(usb_device_interface_struct_t)},
+    {USB_CDC_VCOM_DIC_CLASS, USB_CDC_VCOM_DIC_SUBCLASS, USB_CDC_VCOM_DIC_PROTOCOL, USB_CDC_VCOM_DATA_INTERFACE_INDEX,
+     cdcDicInterface, sizeof(cdcDicInterface) / sizeof(usb_device_interface_struct_t)},
+};
+
+static usb_device_interface_list_t cdcInterfaceList[USB_DEVICE_CONFIGURATION_COUNT] = {
+    {USB_CDC_VCOM_INTERFACE_COUNT, cdcInterfaces},
+};
+
+usb_device_class_struct_t g_UsbDeviceCdcVcomConfig = {
+    cdcInterfaceList,
+    kUSB_DeviceClassTypeCdc,
+    USB_DEVICE_CONFIGURATION_COUNT,
+};
+
+USB_DMA_INIT_DATA_ALIGN(USB_DATA_ALIGN_SIZE)
+static uint8_t deviceDescriptor[] = {
+    USB_DESCRIPTOR_LENGTH_DEVICE,
+    USB_DESCRIPTOR_TYPE_DEVICE,
+    USB_SHORT_GET_LOW(USB_DEVICE_SPECIFIC_BCD_VERSION),
+    USB_SHORT_GET_HIGH(USB_DEVICE_SPECIFIC_BCD_VERSION),
+    USB_DEVICE_CLASS,
+    USB_DEVICE_SUBCLASS,
+    USB_DEVICE_PROTOCOL,
+    USB_CONTROL_MAX_PACKET_SIZE,
+    USB_SHORT_GET_LOW(USB_DEVICE_VID),
+    USB_SHORT_GET_HIGH(USB_DEVICE_VID),
+    USB_SHORT_GET_LOW(USB_DEVICE_PID),
+    USB_SHORT_GET_HIGH(USB_DEVICE_PID),
+    USB_SHORT_GET_LOW(USB_DEVICE_DEMO_BCD_VERSION),
+    USB_SHORT_GET_HIGH(USB_DEVICE_DEMO_BCD_VERSION),
+    0x01U, /* iManufacturer */
+    0x02U, /* iProduct */
+    0x00U, /* iSerialNumber */
+    USB_DEVICE_CONFIGURATION_COUNT,
+};
+
+/* Packet sizes are patched by USB_DeviceSetSpeed() */
+USB_DMA_INIT_DATA_ALIGN(USB_DATA_ALIGN_SIZE)
+static uint8_t configurationDescriptor[] = {
+    USB_DESCRIPTOR_LENGTH_CONFIGURE,
+    USB_DESCRIPTOR_TYPE_CONFIGURE,
+    USB_SHORT_GET_LOW(USB_DESCRIPTOR_LENGTH_CONFIGURATION_ALL),
+    USB_SHORT_GET_HIGH(USB_DESCRIPTOR_LENGTH_CONFIGURATION_ALL),
+    USB_CDC_VCOM_INTERFACE_COUNT,
+    USB_CDC_VCOM_CONFIGURE_INDEX,
+    0x00U,
+    (USB_DESCRIPTOR_CONFIGURE_ATTRIBUTE_D7_MASK) |
+        (USB_DEVICE_CONFIG_SELF_POWER << USB_DESCRIPTOR_CONFIGURE_ATTRIBUTE_SELF_POWERED_SHIFT),
+    USB_DEVICE_MAX_POWER,
+
+    /* Communication interface */
+    USB_DESCRIPTOR_LENGTH_INTERFACE,
+    USB_DESCRIPTOR_TYPE_INTERFACE,
+    USB_CDC_VCOM_COMM_INTERFACE_INDEX,
+    0x00U,
+    USB_CDC_VCOM_ENDPOINT_CIC_COUNT,
+    USB_CDC_VCOM_CIC_CLASS,
+    USB_CDC_VCOM_CIC_SUBCLASS,
+    USB_CDC_VCOM_CIC_PROTOCOL,
+    0x00U,
+
+    /* CDC header functional descriptor, CDC 1.10 */
+    USB_DESCRIPTOR_LENGTH_CDC_HEADER_FUNC,
+    USB_DESCRIPTOR_TYPE_CDC_CS_INTERFACE,
+    USB_CDC_HEADER_FUNC_DESC,
+    0x10U,
+    0x01U,
+
+    /* Call management functional descriptor, no call management */
+    USB_DESCRIPTOR_LENGTH_CDC_CALL_MANAG,
+    USB_DESCRIPTOR_TYPE_CDC_CS_INTERFACE,
+    USB_CDC_CALL_MANAGEMENT_FUNC_DESC,
+    0x00U,
+    USB_CDC_VCOM_DATA_INTERFACE_INDEX,
+
+    /* Abstract control management functional descriptor, line coding and serial state */
+    USB_DESCRIPTOR_LENGTH_CDC_ABSTRACT,
+    USB_DESCRIPTOR_TYPE_CDC_CS_INTERFACE,
+    USB_CDC_ABSTRACT_CONTROL_FUNC_DESC,
+    0x02U,
+
+    /* Union functional descriptor */
+    USB_DESCRIPTOR_LENGTH_CDC_UNION_FUNC,
+    USB_DESCRIPTOR_TYPE_CDC_CS_INTERFACE,
+    USB_CDC_UNION_FUNC_DESC,
+    USB_CDC_VCOM_COMM_INTERFACE_INDEX,
+    USB_CDC_VCOM_DATA_INTERFACE_INDEX,
+
+    /* Notification endpoint */
+    USB_DESCRIPTOR_LENGTH_ENDPOINT,
+    USB_DESCRIPTOR_TYPE_ENDPOINT,
+    USB_CDC_VCOM_INTERRUPT_IN_ENDPOINT | (USB_IN << USB_DESCRIPTOR_ENDPOINT_ADDRESS_DIRECTION_SHIFT),
+    USB_ENDPOINT_INTERRUPT,
+    USB_SHORT_GET_LOW(HS_CDC_VCOM_INTERRUPT_IN_PACKET_SIZE),
+    USB_SHORT_GET_HIGH(HS_CDC_VCOM_INTERRUPT_IN_PACKET_SIZE),
+    HS_CDC_VCOM_INTERRUPT_IN_INTERVAL,
+
+    /* Data interface */
+    USB_DESCRIPTOR_LENGTH_INTERFACE,
+    USB_DESCRIPTOR_TYPE_INTERFACE,
+    USB_CDC_VCOM_DATA_INTERFACE_INDEX,
+    0x00U,
+    USB_CDC_VCOM_ENDPOINT_DIC_COUNT,
+    USB_CDC_VCOM_DIC_CLASS,
+    USB_CDC_VCOM_DIC_SUBCLASS,
+    USB_CDC_VCOM_DIC_PROTOCOL,
+    0x00U,
+
+    /* Bulk IN endpoint */
+    USB_DESCRIPTOR_LENGTH_ENDPOINT,
+    USB_DESCRIPTOR_TYPE_ENDPOINT,
+    USB_CDC_VCOM_BULK_IN_ENDPOINT | (USB_IN << USB_DESCRIPTOR_ENDPOINT_ADDRESS_DIRECTION_SHIFT),
+    USB_ENDPOINT_BULK,
+    USB_SHORT_GET_LOW(HS_CDC_VCOM_BULK_PACKET_SIZE),
+    USB_SHORT_GET_HIGH(HS_CDC_VCOM_BULK_PACKET_SIZE),
+    0x00U,
+
+    /* Bulk OUT endpoint */
+    USB_DESCRIPTOR_LENGTH_ENDPOINT,
+    USB_DESCRIPTOR_TYPE_ENDPOINT,
+    USB_CDC_VCOM_BULK_OUT_ENDPOINT | (USB_OUT << USB_DESCRIPTOR_ENDPOINT_ADDRESS_DIRECTION_SHIFT),
+    USB_ENDPOINT_BULK,
+    USB_SHORT_GET_LOW(HS_CDC_VCOM_BULK_PACKET_SIZE),
+    USB_SHORT_GET_HIGH(HS_CDC_VCOM_BULK_PACKET_SIZE),
+    0x00U,
+};
+
+/* A high-speed capable device describes its full-speed operation */
+USB_DMA_INIT_DATA_ALIGN(USB_DATA_ALIGN_SIZE)
+static uint8_t deviceQualifierDescriptor[] = {
+    USB_DESCRIPTOR_LENGTH_DEVICE_QUALITIER,
+    USB_DESCRIPTOR_TYPE_DEVICE_QUALITIER,
+    USB_SHORT_GET_LOW(USB_DEVICE_SPECIFIC_BCD_VERSION),
+    USB_SHORT_GET_HIGH(USB_DEVICE_SPECIFIC_BCD_VERSION),
+    USB_DEVICE_CLASS,
+    USB_DEVICE_SUBCLASS,
+    USB_DEVICE_PROTOCOL,
+    USB_CONTROL_MAX_PACKET_SIZE,
+    USB_DEVICE_CONFIGURATION_COUNT,
+    0x00U,
+};
+
+USB_DMA_INIT_DATA_ALIGN(USB_DATA_ALIGN_SIZE)
+static uint8_t languageString[] = {
+    2U + 2U,
+    USB_DESCRIPTOR_TYPE_STRING,
+    0x09U,
+    0x04U, /* English (United States) */
+};
+
+USB_DMA_INIT_DATA_ALIGN(USB_DATA_ALIGN_SIZE)
+static uint8_t manufacturerString[] = {
+    2U + 2U * 3U,
+    USB_DESCRIPTOR_TYPE_STRING,
+    'N', 0x00U, 'X', 0x00U, 'P', 0x00U,
+};
+
+USB_DMA_INIT_DATA_ALIGN(USB_DATA_ALIGN_SIZE)
+static uint8_t productString[] = {
+    2U + 2U * 18U,
+    USB_DESCRIPTOR_TYPE_STRING,
+    'N', 0x00U, 'M', 0x00U, 'H', 0x00U, '1', 0x00U, '0', 0x00U, '0', 0x00U, '0', 0x00U, ' ', 0x00U, 'F', 0x00U,
+    'r', 0x00U, 'e', 0x00U, 'e', 0x00U, 'M', 0x00U, 'A', 0x00U, 'S', 0x00U, 'T', 0x00U, 'E', 0x00U, 'R', 0x00U,
+};
+
+static uint8_t *const stringDescriptors[USB_DEVICE_STRING_COUNT] = {
+    languageString,
+    manufacturerString,
+    productString,
+};
+
+//-----------------------------------------------------------------------
+// Functions
+//-----------------------------------------------------------------------
+usb_status_t USB_DeviceGetDeviceDescriptor(usb_device_handle handle,
+                                           usb_device_get_device_descriptor_struct_t *deviceDescriptorReq)
+{
+    (void)handle;
+
+    deviceDescriptorReq->buffer = deviceDescriptor;
+    deviceDescriptorReq->length = USB_DESCRIPTOR_LENGTH_DEVICE;
+    return kStatus_USB_Success;
+}
+
+usb_status_t USB_DeviceGetConfigurationDescriptor(usb_device_handle handle,
+                                                  usb_device_get_configuration_descriptor_struct_t *configurationReq)
+{
+    (void)handle;
+
+    if (USB_CDC_VCOM_CONFIGURE_INDEX > configurationReq->configuration)
+    {
+        configurationReq->buffer = configurationDescriptor;
+        configurationReq->length = USB_DESCRIPTOR_LENGTH_CONFIGURATION_ALL;
+        return kStatus_USB_Success;
+    }
+    return kStatus_USB_InvalidRequest;
+}
+
+usb_status_t USB_DeviceGetStringDescriptor(usb_device_handle handle,
+                                           usb_device_get_string_descriptor_struct_t *stringReq)
+{
+    (void)handle;
+
+    if (stringReq->stringIndex == 0U)
+    {
+        stringReq->buffer = languageString;
+        stringReq->length = sizeof(languageString);
+        return kStatus_USB_Success;
+    }
+    if ((stringReq->languageId != 0x0409U) || (stringReq->stringIndex >= USB_DEVICE_STRING_COUNT))
+    {
+        return kStatus_USB_InvalidRequest;
+    }
+    stringReq->buffer = stringDescriptors[stringReq->stringIndex];
+    stringReq->length = stringDescriptors[stringReq->stringIndex][0];
+    return kStatus_USB_Success;
+}
+
+usb_status_t USB_DeviceGetDeviceQualifierDescriptor(usb_device_handle handle,
+                                                    usb_device_get_device_qualifier_descriptor_struct_t *qualifierReq)
+{
+    (void)handle;
+
+    qualifierReq->buffer = deviceQualifierDescriptor;
+    qualifierReq->length = USB_DESCRIPTOR_LENGTH_DEVICE_QUALITIER;
+    return kStatus_USB_Success;
+}
+
+usb_status_t USB_DeviceSetSpeed(usb_device_handle handle, uint8_t speed)
+{
+    bool highSpeed = (USB_SPEED_HIGH == speed);
+    uint16_t bulkSize = highSpeed ? HS_CDC_VCOM_BULK_PACKET_SIZE : FS_CDC_VCOM_BULK_PACKET_SIZE;
+    usb_descriptor_union_t *descriptorHead;
+    usb_descriptor_union_t *descriptorTail;
+    uint32_t i;
+
+    (void)handle;
+
+    /* Endpoint descriptors of the configuration descriptor */
+    descriptorHead = (usb_descriptor_union_t *)&configurationDescriptor[0];
+    descriptorTail = (usb_descriptor_union_t *)&configurationDescriptor[USB_DESCRIPTOR_LENGTH_CONFIGURATION_ALL - 1U];
+    while (descriptorHead < descriptorTail)
+    {
+        if (descriptorHead->common.bDescriptorType == USB_DESCRIPTOR_TYPE_ENDPOINT)
+        {
+            if (descriptorHead->endpoint.bmAttributes == USB_ENDPOINT_INTERRUPT)
+            {
+                descriptorHead->endpoint.bInterval =
+                    highSpeed ? HS_CDC_VCOM_INTERRUPT_IN_INTERVAL : FS_CDC_VCOM_INTERRUPT_IN_INTERVAL;
+                USB_SHORT_TO_LITTLE_ENDIAN_ADDRESS(
+                    highSpeed ? HS_CDC_VCOM_INTERRUPT_IN_PACKET_SIZE : FS_CDC_VCOM_INTERRUPT_IN_PACKET_SIZE,
+                    descriptorHead->endpoint.wMaxPacketSize);
+            }
+            else
+            {
+                USB_SHORT_TO_LITTLE_ENDIAN_ADDRESS(bulkSize, descriptorHead->endpoint.wMaxPacketSize);
+            }
+        }
+        descriptorHead = (usb_descriptor_union_t *)((uint8_t *)descriptorHead + descriptorHead->common.bLength);
+    }
+
+    /* Endpoint structures the class driver opens the endpoints with */
+    cdcCicEndpoints[0].maxPacketSize =
+        highSpeed ? HS_CDC_VCOM_INTERRUPT_IN_PACKET_SIZE : FS_CDC_VCOM_INTERRUPT_IN_PACKET_SIZE;
+    cdcCicEndpoints[0].interval = highSpeed ? HS_CDC_VCOM_INTERRUPT_IN_INTERVAL : FS_CDC_VCOM_INTERRUPT_IN_INTERVAL;
+    for (i = 0U; i < USB_CDC_VCOM_ENDPOINT_DIC_COUNT; i++)
+    {
+        cdcDicEndpoints[i].maxPacketSize = bulkSize;
+    }
+
+    return kStatus_USB_Success;
+}
+
+#endif /* NMH1000_FMSTR_USB */
@@ -0,0 +1,109 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file usb_device_descriptor.h
+ * @brief The usb_device_descriptor.h file declares the USB descriptors of the FreeMASTER CDC-ACM device.
+ *
+ * @details One configuration with the CDC communication interface (notification endpoint) and the
+ *          data interface (bulk IN and OUT). The bulk packet size follows the enumerated speed, 512
+ *          bytes at high speed and 64 bytes at full speed, see USB_DeviceSetSpeed().
+ */
+
+#ifndef USB_DEVICE_DESCRIPTOR_H_
+#define USB_DEVICE_DESCRIPTOR_H_
+
+#include "usb.h"
+#include "usb_device.h"
+#include "usb_device_class.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define USB_DEVICE_SPECIFIC_BCD_VERSION (0x0200U)
+#define USB_DEVICE_DEMO_BCD_VERSION     (0x0101U)
+
+/*! @brief NXP vendor ID with the PID of the SDK virtual COM examples, the host binds its CDC-ACM driver. */
+#define USB_DEVICE_VID (0x1FC9U)
+#define USB_DEVICE_PID (0x0094U)
+
+#define USB_DEVICE_CLASS    (0x02U)
+#define USB_DEVICE_SUBCLASS (0x00U)
+#define USB_DEVICE_PROTOCOL (0x00U)
+#define USB_DEVICE_MAX_POWER (0x32U) /* 100 mA in 2 mA units */
+
+#define USB_DEVICE_CONFIGURATION_COUNT (1U)
+#define USB_DEVICE_STRING_COUNT        (3U)
+#define USB_DEVICE_LANGUAGE_COUNT      (1U)
+
+#define USB_CDC_VCOM_CONFIGURE_INDEX (1U)
+
+#define USB_CDC_VCOM_INTERFACE_COUNT      (2U)
+#define USB_CDC_VCOM_COMM_INTERFACE_INDEX (0U)
+#define USB_CDC_VCOM_DATA_INTERFACE_INDEX (1U)
+
+#define USB_CDC_VCOM_ENDPOINT_CIC_COUNT    (1U)
+#define USB_CDC_VCOM_ENDPOINT_DIC_COUNT    (2U)
+#define USB_CDC_VCOM_INTERRUPT_IN_ENDPOINT (1U)
+#define USB_CDC_VCOM_BULK_IN_ENDPOINT      (2U)
+#define USB_CDC_VCOM_BULK_OUT_ENDPOINT     (2U)
+
+#define HS_CDC_VCOM_INTERRUPT_IN_PACKET_SIZE (16U)
+#define FS_CDC_VCOM_INTERRUPT_IN_PACKET_SIZE (16U)
+#define HS_CDC_VCOM_INTERRUPT_IN_INTERVAL    (0x07U) /* 2^(7-1) microframes = 8 ms */
+#define FS_CDC_VCOM_INTERRUPT_IN_INTERVAL    (0x08U) /* 8 ms */
+#define HS_CDC_VCOM_BULK_PACKET_SIZE         (512U)
+#define FS_CDC_VCOM_BULK_PACKET_SIZE         (64U)
+
+#define USB_CDC_VCOM_CIC_CLASS    (0x02U) /* Communications interface class */
+#define USB_CDC_VCOM_CIC_SUBCLASS (0x02U) /* Abstract control model */
+#define USB_CDC_VCOM_CIC_PROTOCOL (0x00U)
+#define USB_CDC_VCOM_DIC_CLASS    (0x0AU) /* Data interface class */
+#define USB_CDC_VCOM_DIC_SUBCLASS (0x00U)
+#define USB_CDC_VCOM_DIC_PROTOCOL (0x00U)
+
+#define USB_DESCRIPTOR_LENGTH_CDC_HEADER_FUNC (5U)
+#define USB_DESCRIPTOR_LENGTH_CDC_CALL_MANAG  (5U)
+#define USB_DESCRIPTOR_LENGTH_CDC_ABSTRACT    (4U)
+#define USB_DESCRIPTOR_LENGTH_CDC_UNION_FUNC  (5U)
+#define USB_DESCRIPTOR_TYPE_CDC_CS_INTERFACE  (0x24U)
+
+#define USB_DESCRIPTOR_LENGTH_CONFIGURATION_ALL                                                           \
+    (USB_DESCRIPTOR_LENGTH_CONFIGURE + (2U * USB_DESCRIPTOR_LENGTH_INTERFACE) +                           \
+     USB_DESCRIPTOR_LENGTH_CDC_HEADER_FUNC + USB_DESCRIPTOR_LENGTH_CDC_CALL_MANAG +                       \
+     USB_DESCRIPTOR_LENGTH_CDC_ABSTRACT + USB_DESCRIPTOR_LENGTH_CDC_UNION_FUNC +                          \
+     (3U * USB_DESCRIPTOR_LENGTH_ENDPOINT))
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+/*! @brief CDC-ACM class information passed to USB_DeviceClassInit(). */
+extern usb_device_class_struct_t g_UsbDeviceCdcVcomConfig;
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+/*! @brief       Select the endpoint packet sizes of the enumerated speed.
+ *  @param[in]   handle The USB device handle.
+ *  @param[in]   speed  USB_SPEED_HIGH or USB_SPEED_FULL.
+ *  @return      kStatus_USB_Success.
+ *  @constraints Call on bus reset, before the host reads the configuration descriptor.
+ *  @reeentrant  No
+ */
+usb_status_t USB_DeviceSetSpeed(usb_device_handle handle, uint8_t speed);
+
+/*! @brief Descriptor requests of the device callback (kUSB_DeviceEventGetxxxDescriptor). */
+usb_status_t USB_DeviceGetDeviceDescriptor(usb_device_handle handle,
+                                           usb_device_get_device_descriptor_struct_t *deviceDescriptor);
+usb_status_t USB_DeviceGetConfigurationDescriptor(
+    usb_device_handle handle, usb_device_get_configuration_descriptor_struct_t *configurationDescriptor);
+usb_status_t USB_DeviceGetStringDescriptor(usb_device_handle handle,
+                                           usb_device_get_string_descriptor_struct_t *stringDescriptor);
+usb_status_t USB_DeviceGetDeviceQualifierDescriptor(
+    usb_device_handle handle, usb_device_get_device_qualifier_descriptor_struct_t *deviceQualifierDescriptor);
+
+#endif // USB_DEVICE_DESCRIPTOR_H_
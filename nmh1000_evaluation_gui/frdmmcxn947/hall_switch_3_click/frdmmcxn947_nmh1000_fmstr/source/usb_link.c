@@ -0,0 +1,304 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file  usb_link.c
+ * @brief The usb_link.c file implements the USB CDC-ACM device of the FreeMASTER USB build.
+ */
+
+#include "freemaster_cfg.h"
+
+#if NMH1000_FMSTR_USB
+
+//-----------------------------------------------------------------------
+// SDK Includes
+//-----------------------------------------------------------------------
+#include "fsl_common.h"
+#include "board.h"
+#include "clock_config.h"
+
+#include "usb_device_config.h"
+#include "usb.h"
+#include "usb_device.h"
+#include "usb_device_class.h"
+#include "usb_device_cdc_acm.h"
+#include "usb_device_ch9.h"
+#include "usb_phy.h"
+
+#include "freemaster.h"
+#include "freemaster_serial_usb.h"
+
+#include "usb_device_descriptor.h"
+#include "cycle_profiler.h"
+#include "usb_link.h"
+
+//-----------------------------------------------------------------------
+// Macros
+//-----------------------------------------------------------------------
+#define USB_LINK_CONTROLLER_ID kUSB_ControllerEhci0
+
+/* Line coding is stored only to be read back, 115200 8N1 until the host sets its own */
+#define USB_LINK_LINE_CODING_SIZE (7U)
+
+//-----------------------------------------------------------------------
+// Local Functions
+//-----------------------------------------------------------------------
+static usb_status_t usb_link_device_callback(usb_device_handle handle, uint32_t event, void *param);
+static usb_status_t usb_link_cdc_callback(class_handle_t handle, uint32_t event, void *param);
+
+//-----------------------------------------------------------------------
+// Local Variables
+//-----------------------------------------------------------------------
+static usb_device_handle usbLinkDevice;
+static class_handle_t usbLinkCdc;
+static volatile bool usbLinkConfigured;
+static uint8_t usbLinkConfiguration;
+static uint8_t usbLinkSpeed;
+
+USB_DMA_NONINIT_DATA_ALIGN(USB_DATA_ALIGN_SIZE)
+static uint8_t usbLinkLineCoding[USB_LINK_LINE_CODING_SIZE];
+
+static usb_device_class_config_struct_t usbLinkClassConfig[] = {
+    {usb_link_cdc_callback, 0, &g_UsbDeviceCdcVcomConfig},
+};
+
+static usb_device_class_config_list_struct_t usbLinkClassConfigList = {
+    usbLinkClassConfig,
+    usb_link_device_callback,
+    1U,
+};
+
+//-----------------------------------------------------------------------
+// Local Functions
+//-----------------------------------------------------------------------
+/* Endpoint functions of freemaster_serial_usb.c, called from FMSTR_Poll() and the USB interrupt */
+static FMSTR_BOOL usb_link_send(FMSTR_U8 *data, FMSTR_U32 size)
+{
+    if (!usbLinkConfigured)
+    {
+        return FMSTR_FALSE;
+    }
+    return (USB_DeviceCdcAcmSend(usbLinkCdc, USB_CDC_VCOM_BULK_IN_ENDPOINT, data, size) == kStatus_USB_Success) ?
+               FMSTR_TRUE :
+               FMSTR_FALSE;
+}
+
+static FMSTR_BOOL usb_link_recv(FMSTR_U8 *data, FMSTR_U32 size)
+{
+    if (!usbLinkConfigured)
+    {
+        return FMSTR_FALSE;
+    }
+    return (USB_DeviceCdcAcmRecv(usbLinkCdc, USB_CDC_VCOM_BULK_OUT_ENDPOINT, data, size) == kStatus_USB_Success) ?
+               FMSTR_TRUE :
+               FMSTR_FALSE;
+}
+
+static usb_status_t usb_link_cdc_callback(class_handle_t handle, uint32_t event, void *param)
+{
+    usb_device_endpoint_callback_message_struct_t *epMessage = (usb_device_endpoint_callback_message_struct_t *)param;
+    usb_device_cdc_acm_request_param_struct_t *acmRequest = (usb_device_cdc_acm_request_param_struct_t *)param;
+    usb_status_t error = kStatus_USB_InvalidRequest;
+
+    switch (event)
+    {
+        case kUSB_DeviceCdcEventSendResponse:
+            FMSTR_SerialUsbProcessEvent(FMSTR_SERIAL_USBCDC_EVENT_TYPE_SENT, epMessage->buffer, epMessage->length);
+            error = kStatus_USB_Success;
+            break;
+
+        case kUSB_DeviceCdcEventRecvResponse:
+            /* A cancelled transfer reports USB_CANCELLED_TRANSFER_LENGTH, the driver ignores it */
+            FMSTR_SerialUsbProcessEvent(FMSTR_SERIAL_USBCDC_EVENT_TYPE_RECEIVED, epMessage->buffer,
+                                        epMessage->length);
+            error = kStatus_USB_Success;
+            break;
+
+        case kUSB_DeviceCdcEventSerialStateNotif:
+            ((usb_device_cdc_acm_struct_t *)handle)->hasSentState = 0U;
+            error = kStatus_USB_Success;
+            break;
+
+        case kUSB_DeviceCdcEventGetLineCoding:
+            *(acmRequest->buffer) = usbLinkLineCoding;
+            *(acmRequest->length) = USB_LINK_LINE_CODING_SIZE;
+            error = kStatus_USB_Success;
+            break;
+
+        case kUSB_DeviceCdcEventSetLineCoding:
+            /* The data stage lands in usbLinkLineCoding, the rate has no effect on a virtual port */
+            if (acmRequest->isSetup == 1U)
+            {
+                *(acmRequest->buffer) = usbLinkLineCoding;
+                *(acmRequest->length) = USB_LINK_LINE_CODING_SIZE;
+            }
+            else
+            {
+                *(acmRequest->length) = 0U;
+            }
+            error = kStatus_USB_Success;
+            break;
+
+        case kUSB_DeviceCdcEventSetControlLineState:
+            /* FreeMASTER answers whether the host asserts DTR or not */
+            error = kStatus_USB_Success;
+            break;
+
+        default:
+            break;
+    }
+
+    return error;
+}
+
+static usb_status_t usb_link_device_callback(usb_device_handle handle, uint32_t event, void *param)
+{
+    usb_status_t error = kStatus_USB_InvalidRequest;
+    uint16_t *temp16   = (uint16_t *)param;
+    uint8_t *temp8     = (uint8_t *)param;
+
+    switch (event)
+    {
+        case kUSB_DeviceEventBusReset:
+            usbLinkConfigured    = false;
+            usbLinkConfiguration = 0U;
+            /* The endpoint packet sizes follow the speed the host chose */
+            if (USB_DeviceClassGetSpeed(USB_LINK_CONTROLLER_ID, &usbLinkSpeed) == kStatus_USB_Success)
+            {
+                (void)USB_DeviceSetSpeed(handle, usbLinkSpeed);
+            }
+            error = kStatus_USB_Success;
+            break;
+
+        case kUSB_DeviceEventSetConfiguration:
+            if (*temp8 == 0U)
+            {
+                usbLinkConfigured    = false;
+                usbLinkConfiguration = 0U;
+                error                = kStatus_USB_Success;
+            }
+            else if (*temp8 == USB_CDC_VCOM_CONFIGURE_INDEX)
+            {
+                usbLinkConfigured    = true;
+                usbLinkConfiguration = *temp8;
+                /* Drop what a previous host left behind and prime the bulk OUT endpoint */
+                FMSTR_SerialUsbProcessEvent(FMSTR_SERIAL_USBCDC_EVENT_TYPE_CONFIGURED, NULL, 0U);
+                error = kStatus_USB_Success;
+            }
+            else
+            {
+                /* Unknown configuration */
+            }
+            break;
+
+        case kUSB_DeviceEventSetInterface:
+            /* Only alternate setting 0 exists */
+            if ((usbLinkConfigured) && ((*temp16 & 0x00FFU) == 0U))
+            {
+                error = kStatus_USB_Success;
+            }
+            break;
+
+        case kUSB_DeviceEventGetConfiguration:
+            *temp8 = usbLinkConfiguration;
+            error  = kStatus_USB_Success;
+            break;
+
+        case kUSB_DeviceEventGetInterface:
+            /* Alternate setting 0 of the requested interface */
+            *temp16 = (uint16_t)(*temp16 & 0xFF00U);
+            error   = kStatus_USB_Success;
+            break;
+
+        case kUSB_DeviceEventGetDeviceDescriptor:
+            error = USB_DeviceGetDeviceDescriptor(handle, (usb_device_get_device_descriptor_struct_t *)param);
+            break;
+
+        case kUSB_DeviceEventGetConfigurationDescriptor:
+            error = USB_DeviceGetConfigurationDescriptor(handle,
+                                                         (usb_device_get_configuration_descriptor_struct_t *)param);
+            break;
+
+        case kUSB_DeviceEventGetStringDescriptor:
+            error = USB_DeviceGetStringDescriptor(handle, (usb_device_get_string_descriptor_struct_t *)param);
+            break;
+
+        case kUSB_DeviceEventGetDeviceQualifierDescriptor:
+            error = USB_DeviceGetDeviceQualifierDescriptor(
+                handle, (usb_device_get_device_qualifier_descriptor_struct_t *)param);
+            break;
+
+        default:
+            break;
+    }
+
+    return error;
+}
+
+/* USB1 reference from the 24 MHz crystal, 480 MHz PHY PLL and the controller clock */
+static void usb_link_clock_init(void)
+{
+    usb_phy_config_struct_t phyConfig = {
+        BOARD_USB_PHY_D_CAL,
+        BOARD_USB_PHY_TXCAL45DP,
+        BOARD_USB_PHY_TXCAL45DM,
+    };
+
+    (void)CLOCK_SetupExtClocking(BOARD_XTAL0_CLK_HZ);
+    SYSCON->CLOCK_CTRL |= SYSCON_CLOCK_CTRL_CLKIN_ENA_MASK | SYSCON_CLOCK_CTRL_CLKIN_ENA_FM_USBH_LPT_MASK;
+    CLOCK_EnableClock(kCLOCK_UsbHs);
+    CLOCK_EnableClock(kCLOCK_UsbHsPhy);
+    (void)CLOCK_EnableUsbhsPhyPllClock(kCLOCK_Usbphy480M, BOARD_XTAL0_CLK_HZ);
+    (void)CLOCK_EnableUsbhsClock();
+    (void)USB_EhciPhyInit(USB_LINK_CONTROLLER_ID, BOARD_XTAL0_CLK_HZ, &phyConfig);
+}
+
+//-----------------------------------------------------------------------
+// Functions
+//-----------------------------------------------------------------------
+bool USB_LINK_Init(void)
+{
+    /* 115200 baud, 1 stop bit, no parity, 8 data bits */
+    usbLinkLineCoding[0] = 0x00U;
+    usbLinkLineCoding[1] = 0xC2U;
+    usbLinkLineCoding[2] = 0x01U;
+    usbLinkLineCoding[3] = 0x00U;
+    usbLinkLineCoding[4] = 0x00U;
+    usbLinkLineCoding[5] = 0x00U;
+    usbLinkLineCoding[6] = 0x08U;
+
+    usbLinkConfigured = false;
+    FMSTR_SerialUsbRegisterAppFunctions(usb_link_send);
+    FMSTR_SerialUsbRegisterRxFunction(usb_link_recv);
+
+    usb_link_clock_init();
+    if (USB_DeviceClassInit(USB_LINK_CONTROLLER_ID, &usbLinkClassConfigList, &usbLinkDevice) != kStatus_USB_Success)
+    {
+        return false;
+    }
+    usbLinkCdc = usbLinkClassConfigList.config->classHandle;
+
+    NVIC_SetPriority(USB1_HS_IRQn, USB_LINK_IRQ_PRIORITY);
+    return true;
+}
+
+void USB_LINK_Start(void)
+{
+    EnableIRQ(USB1_HS_IRQn);
+    (void)USB_DeviceRun(usbLinkDevice);
+}
+
+/* Enumeration and the bulk transfer completions, the FreeMASTER protocol itself runs in FMSTR_Poll() */
+void USB1_HS_IRQHandler(void)
+{
+    PROF_BEGIN(PROF_FMSTR_ISR);
+    USB_DeviceEhciIsrFunction(usbLinkDevice);
+    PROF_END(PROF_FMSTR_ISR);
+    SDK_ISR_EXIT_BARRIER;
+}
+
+#endif /* NMH1000_FMSTR_USB */
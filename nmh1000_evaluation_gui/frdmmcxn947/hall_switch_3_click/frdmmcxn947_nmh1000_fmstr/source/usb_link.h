@@ -0,0 +1,56 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file usb_link.h
+ * @brief The usb_link.h file declares the USB CDC-ACM device of the FreeMASTER USB build.
+ *
+ * @details Built with NMH1000_FMSTR_USB (freemaster_cfg.h). The high-speed USB port (USB1, EHCI
+ *          controller with the on-chip HS PHY) enumerates as a virtual COM port, FreeMASTER keeps
+ *          its serial framing on top of it. The bulk endpoints are double buffered in
+ *          freemaster_serial_usb.c: the USB interrupt hands each completed packet to the driver and
+ *          primes the other buffer at once, FMSTR_Poll() decodes whole packets and builds the
+ *          response in packets of 512 bytes. The baud rate set by the host is accepted and ignored.
+ *          Built by the Debug_USB configuration of the project, the USB device stack and the
+ *          CDC-ACM class driver it adds are copied from the MCUXpresso SDK by
+ *          tools/import_sdk_components.py.
+ */
+
+#ifndef USB_LINK_H_
+#define USB_LINK_H_
+
+/* Standard C Includes */
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief USB interrupt priority, below the other interrupts left at the default priority 0. */
+#ifndef USB_LINK_IRQ_PRIORITY
+#define USB_LINK_IRQ_PRIORITY (3U)
+#endif
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+/*! @brief       Clock the USB1 controller and PHY, set up the CDC-ACM class and register the endpoint
+ *               functions of the FreeMASTER USB driver.
+ *  @return      true on success.
+ *  @constraints Call after POWER_Init() and before FMSTR_Init(), which needs the functions registered.
+ *  @reeentrant  No
+ */
+bool USB_LINK_Init(void);
+
+/*! @brief       Connect to the bus, the host enumerates the device from the USB interrupt.
+ *  @return      void.
+ *  @constraints Call after FMSTR_Init(), the driver buffers must be ready before the first transfer.
+ *  @reeentrant  No
+ */
+void USB_LINK_Start(void);
+
+#endif // USB_LINK_H_
@@ -55,7 +55,7 @@ int32_t BOARD_SystickElapsedTicks(int32_t *pStart)
 
     // Subtract the stored start ticks and check for wraparound down through zero.
     elapsed = *pStart - (SYST_CVR & 0x00FFFFFF);
-    elapsed += SYST_RVR * (g_ovf_counter - g_ovf_stamp);
+    elapsed += (SYST_RVR + 1) * (g_ovf_counter - g_ovf_stamp);
 
     return elapsed;
 }
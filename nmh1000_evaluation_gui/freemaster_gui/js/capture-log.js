@@ -0,0 +1,181 @@
+/** Streaming capture of live samples to a local file */
+
+/**
+ * Appends CSV lines to a file opened through the FreeMASTER service. Lines are collected into
+ * chunks and written one chunk at a time, so only the chunk being written and the lines that
+ * arrived meanwhile are held in memory. Lines arriving while maxPendingChars are already
+ * waiting are dropped and counted instead of growing the backlog.
+ *
+ * Samples carry the time they were taken on the board. Where the file does not hold every
+ * sample between two rows, because the source skipped some or lines were dropped here, a
+ * record GAP,<last time>,<next time>,<dropped lines> is written before the next sample.
+ * @param {PCM} pcm - FreeMASTER connection
+ * @param {function} on_status - called with {bytes, bytesPerSecond, dropped} every status period
+ */
+function CaptureLog(pcm, on_status) {
+  this.pcm = pcm;
+  this.on_status = on_status;
+  this.chunkChars = 64 * 1024;      // write as soon as this much is pending
+  this.maxPendingChars = 4 * 1024 * 1024;
+  this.statusMs = 1000;             // pending lines are also written at this period
+  this.handle = null;
+  this.active = false;              // lines are accepted
+  this.pending = [];
+  this.pendingChars = 0;
+  this.writing = Promise.resolve();
+  this.busy = false;
+  this.bytes = 0;
+  this.dropped = 0;
+  this.last_bytes = 0;              // rate reference of the previous status
+  this.last_time = 0;
+  this.timer = null;
+  this.last_t = null;               // time of the last sample written
+  this.gap_pending = false;         // a GAP record precedes the next sample
+  this.skipped = 0;                 // samples dropped since the last one written
+}
+
+/**
+ * Creates or truncates the file and writes the header line
+ * @param {string} path - file path on the machine running the FreeMASTER service
+ * @param {string} header - first line, without line end
+ * @returns {Promise} resolved once the file is open
+ */
+CaptureLog.prototype.open = function (path, header) {
+  return this.pcm.LocalFileOpen(path, 'w')
+    .then(resp => {
+      if (resp.status !== 'OK') {
+        throw resp.error;
+      }
+      this.handle = resp.data;
+      this.active = true;
+      this.bytes = 0;
+      this.dropped = 0;
+      this.last_bytes = 0;
+      this.last_time = performance.now();
+      this.last_t = null;
+      this.gap_pending = false;
+      this.skipped = 0;
+      this.timer = setInterval(() => this.tick(), this.statusMs);
+      this.append(header);
+    });
+};
+
+/**
+ * Queues one line, the line end is added here
+ * @param {string} line - CSV line
+ */
+CaptureLog.prototype.append = function (line) {
+  if (!this.active) {
+    return;
+  }
+  if (this.pendingChars >= this.maxPendingChars) {
+    this.dropped++;
+    return;
+  }
+  this.pending.push(line, '\r\n');
+  this.pendingChars += line.length + 2;
+  if (this.pendingChars >= this.chunkChars) {
+    this.flush();
+  }
+};
+
+/**
+ * Queues one sample row, preceded by a GAP record when samples are missing before it
+ * @param {number} t - board time of the sample in seconds
+ * @param {Array} values - sample values
+ */
+CaptureLog.prototype.sample = function (t, values) {
+  if (!this.active) {
+    return;
+  }
+  if (this.pendingChars >= this.maxPendingChars) {
+    this.dropped++;
+    this.skipped++;
+    this.gap_pending = true;
+    return;
+  }
+  if (this.gap_pending && this.last_t !== null) {
+    this.append(['GAP', this.last_t.toFixed(6), t.toFixed(6), this.skipped].join(','));
+  }
+  this.gap_pending = false;
+  this.skipped = 0;
+  this.last_t = t;
+  this.append([t.toFixed(6)].concat(values).join(','));
+};
+
+/** Marks a discontinuity in the source, the next sample is preceded by a GAP record */
+CaptureLog.prototype.gap = function () {
+  this.gap_pending = true;
+};
+
+/**
+ * Writes the pending lines unless a write is already in progress, the write completion picks
+ * up whatever arrived meanwhile
+ * @returns {Promise} resolved when the write issued or already in progress completed, never rejected
+ */
+CaptureLog.prototype.flush = function () {
+  if (this.busy || this.pendingChars == 0 || this.handle === null) {
+    return this.writing;
+  }
+  var chunk = this.pending.join('');
+  this.pending = [];
+  this.pendingChars = 0;
+  this.busy = true;
+  this.writing = this.pcm.LocalFileWriteString(this.handle, chunk, false)
+    .then(resp => {
+      if (resp.status !== 'OK') {
+        throw resp.error;
+      }
+      this.bytes += resp.data;
+    })
+    .catch(err => console.error(err, 'Capture write failed'))
+    .finally(() => {
+      this.busy = false;
+      if (this.pendingChars >= this.chunkChars) {
+        this.flush();
+      }
+    });
+  return this.writing;
+};
+
+/** Writes what is pending and reports the write rate */
+CaptureLog.prototype.tick = function () {
+  var now = performance.now();
+  var rate = (this.bytes - this.last_bytes) * 1000 / (now - this.last_time);
+
+  this.last_bytes = this.bytes;
+  this.last_time = now;
+  this.flush();
+  if (this.on_status) {
+    this.on_status({ bytes: this.bytes, bytesPerSecond: rate, dropped: this.dropped });
+  }
+};
+
+/**
+ * Writes until nothing is pending
+ * @returns {Promise} resolved once all lines were written
+ */
+CaptureLog.prototype.drain = function () {
+  return this.flush()
+    .then(() => (this.busy || this.pendingChars > 0) ? this.drain() : undefined);
+};
+
+/**
+ * Stops accepting lines, writes the remaining ones and closes the file
+ * @returns {Promise} resolved once the file is closed
+ */
+CaptureLog.prototype.close = function () {
+  var handle = this.handle;
+
+  if (!this.active) {
+    return Promise.resolve();
+  }
+  this.active = false;
+  clearInterval(this.timer);
+  return this.drain()
+    .then(() => {
+      this.handle = null;
+      this.tick();
+      return this.pcm.LocalFileClose(handle);
+    });
+};
@@ -868,6 +868,185 @@
             return jrpc.call('WriteVariable', [name, value]);
         };
 
+        /*
+         * Read batching state: the struct reads are coalesced into, cached symbol/variable
+         * information and the reads queued in the current tick.
+         */
+        var self = this;
+        var batchStruct = null;
+        var batchInfo = {};
+        var batchQueue = [];
+
+        /**
+         * Enables coalescing of {@link PCM#ReadVariableBatched ReadVariableBatched} and
+         * {@link PCM#ReadUIntArrayBatched ReadUIntArrayBatched} reads into one memory read
+         * over a contiguous structure. Field addresses and sizes come from the TSA or ELF symbols.
+         *
+         * @example
+         * let result = await pcm.EnableReadBatching('registers');
+         * if (result.status === "OK") {
+         *     let [trigger, value] = await Promise.all([
+         *         pcm.ReadVariableBatched('read_trigger'),
+         *         pcm.ReadVariableBatched('read_value')]);
+         * }
+         *
+         * @param   {string} symbol Name of the structure whose fields are read in batches.
+         * @returns {Promise<FML_Response>} In case of success, resolved promise will contain data property of type {@link SymbolInfo SymbolInfo}.
+         */
+        this.EnableReadBatching = function(symbol) {
+            return self.GetSymbolInfo(symbol)
+                .then(result => {
+                    if (result.status === "OK") {
+                        batchStruct = result.data;
+                    }
+                    return result;
+                });
+        };
+
+        /**
+         * Reads a variable like {@link PCM#ReadVariable ReadVariable}. Integer variables inside the
+         * structure given to {@link PCM#EnableReadBatching EnableReadBatching} are read together with
+         * all other batched reads issued in the same tick.
+         *
+         * @param   {string} name Variable name.
+         * @returns {Promise<FML_Response>} In case of success, resolved promise will contain data property of type number representing variable value.
+         */
+        this.ReadVariableBatched = function(name) {
+            return batch_queue({ name: name, info: () => self.GetVariableInfo(name), read: () => self.ReadVariable(name) });
+        };
+
+        /**
+         * Reads an array of unsigned integers like {@link PCM#ReadUIntArray ReadUIntArray}, batched
+         * with the other reads of the same tick when the array lies inside the batching structure.
+         *
+         * @param   {string} addr   Symbol name.
+         * @param   {number} size   Number of elements.
+         * @param   {number} elSize Element size, can be 1, 2, or 4.
+         * @returns {Promise<FML_Response>} In case of success, resolved promise will contain data property of type Array<number>.
+         */
+        this.ReadUIntArrayBatched = function(addr, size, elSize) {
+            return batch_queue({
+                name: addr,
+                count: size,
+                elSize: elSize,
+                info: () => self.GetSymbolInfo(addr),
+                read: () => self.ReadUIntArray(addr, size, elSize)
+            });
+        };
+
+        function batch_queue(item) {
+            return new Promise((resolve, reject) => {
+                item.resolve = resolve;
+                item.reject = reject;
+                batchQueue.push(item);
+                if (batchQueue.length == 1) {
+                    // flush once the caller's synchronous code has queued everything
+                    Promise.resolve().then(batch_flush);
+                }
+            });
+        }
+
+        function batch_lookup(item) {
+            if (!(item.name in batchInfo)) {
+                // only successful lookups stay cached, a failed one (e.g. before the board
+                // connected) is forgotten so the next read of the name asks again
+                batchInfo[item.name] = item.info()
+                    .then(result => {
+                        if (result.status !== "OK") {
+                            throw result.error;
+                        }
+                        return result.data;
+                    })
+                    .catch(() => {
+                        delete batchInfo[item.name];
+                        return null;
+                    });
+            }
+            return batchInfo[item.name];
+        }
+
+        function batch_read_direct(item) {
+            item.read().then(item.resolve, item.reject);
+        }
+
+        function batch_field_bytes(item, info) {
+            return (item.count !== undefined) ? item.count * item.elSize : info.size;
+        }
+
+        function batch_unpack(bytes, offset, size, signed) {
+            var value = 0;
+            for (var i = size - 1; i >= 0; --i) {
+                value = value * 256 + bytes[offset + i];
+            }
+            if (signed && value >= Math.pow(2, 8 * size - 1)) {
+                value -= Math.pow(2, 8 * size);
+            }
+            return value;
+        }
+
+        function batch_flush() {
+            var items = batchQueue;
+            batchQueue = [];
+
+            Promise.all(items.map(batch_lookup)).then(infos => {
+                var batched = [];
+                var start = Infinity;
+                var end = 0;
+
+                items.forEach((item, i) => {
+                    var info = infos[i];
+                    var integer = (item.count !== undefined) || (info && (info.type === "uint" || info.type === "int"));
+                    if (!batchStruct || !info || !integer || info.addr < batchStruct.addr ||
+                        info.addr + batch_field_bytes(item, info) > batchStruct.addr + batchStruct.size) {
+                        batch_read_direct(item);
+                        return;
+                    }
+                    item.addr = info.addr;
+                    item.varInfo = info;
+                    start = Math.min(start, info.addr);
+                    end = Math.max(end, info.addr + batch_field_bytes(item, info));
+                    batched.push(item);
+                });
+
+                if (batched.length == 0) {
+                    return;
+                }
+                if (batched.length == 1) {
+                    batch_read_direct(batched[0]);
+                    return;
+                }
+
+                self.ReadUIntArray(start, end - start, 1)
+                    .then(result => {
+                        batched.forEach(item => {
+                            if (result.status !== "OK") {
+                                item.resolve(result);
+                                return;
+                            }
+                            var offset = item.addr - start;
+                            var data;
+                            if (item.count !== undefined) {
+                                data = [];
+                                for (var i = 0; i < item.count; ++i) {
+                                    data.push(batch_unpack(result.data, offset + i * item.elSize, item.elSize, false));
+                                }
+                            } else {
+                                var info = item.varInfo;
+                                data = batch_unpack(result.data, offset, info.size, info.type === "int");
+                                if (info.shift) {
+                                    data = Math.floor(data / Math.pow(2, info.shift));
+                                }
+                                if (info.mask) {
+                                    data = data & info.mask;
+                                }
+                            }
+                            item.resolve({ status: "OK", data: data });
+                        });
+                    })
+                    .catch(err => batched.forEach(item => item.reject(err)));
+            });
+        }
+
         /**
          * Defines a scope with a specific ID.
          *
@@ -0,0 +1,210 @@
+/** Live chart data pipeline: fixed-size sample ring, LTTB downsampling and frame-batched redraws */
+
+/**
+ * Fixed-capacity ring of (time, value) samples kept in typed arrays, the oldest samples are
+ * overwritten once it is full so memory and redraw cost stay bounded however long it runs.
+ * @param {number} capacity - number of samples kept
+ */
+function SampleRing(capacity) {
+  this.capacity = capacity;
+  this.time = new Float64Array(capacity);
+  this.value = new Float32Array(capacity);
+  this.head = 0;  // index of the next write
+  this.count = 0; // samples held
+}
+
+/**
+ * Appends a sample
+ * @param {number} t - time in seconds
+ * @param {number} v - value
+ */
+SampleRing.prototype.push = function (t, v) {
+  this.time[this.head] = t;
+  this.value[this.head] = v;
+  this.head = (this.head + 1) % this.capacity;
+  if (this.count < this.capacity) {
+    this.count++;
+  }
+};
+
+/** Ring index of the i-th oldest sample */
+SampleRing.prototype.index = function (i) {
+  var k = this.head - this.count + i;
+  if (k < 0) {
+    k += this.capacity;
+  } else if (k >= this.capacity) {
+    k -= this.capacity;
+  }
+  return k;
+};
+
+SampleRing.prototype.clear = function () {
+  this.head = 0;
+  this.count = 0;
+};
+
+/**
+ * Largest-triangle-three-buckets downsampling of a ring into chart points. Keeps the first and
+ * last sample and from every bucket in between the one spanning the largest triangle with the
+ * previous pick and the next bucket's average, which preserves peaks and edges. A NaN value
+ * marks a break in the trace and is always picked so the break survives downsampling.
+ * @param {SampleRing} ring - samples
+ * @param {number} threshold - number of points wanted, usually the plot width in pixels
+ * @param {Array<Object>} out - reused {x, y} points, resized to the result length
+ * @returns {Array<Object>} out
+ */
+function lttb(ring, threshold, out) {
+  var n = ring.count;
+  var time = ring.time;
+  var value = ring.value;
+  var i;
+
+  if (threshold >= n || threshold < 3) {
+    out.length = n;
+    for (i = 0; i < n; ++i) {
+      var k = ring.index(i);
+      out[i] = out[i] || {};
+      out[i].x = time[k];
+      out[i].y = value[k];
+    }
+    return out;
+  }
+
+  var every = (n - 2) / (threshold - 2);
+  var a = 0; // index of the previous pick
+  out.length = threshold;
+  out[0] = out[0] || {};
+  out[0].x = time[ring.index(0)];
+  out[0].y = value[ring.index(0)];
+
+  for (var bucket = 0; bucket < threshold - 2; ++bucket) {
+    // average of the next bucket
+    var nextStart = Math.floor((bucket + 1) * every) + 1;
+    var nextEnd = Math.min(Math.floor((bucket + 2) * every) + 1, n);
+    var avgX = 0;
+    var avgY = 0;
+    var avgN = 0;
+    for (i = nextStart; i < nextEnd; ++i) {
+      var kn = ring.index(i);
+      if (!isNaN(value[kn])) {
+        avgX += time[kn];
+        avgY += value[kn];
+        avgN++;
+      }
+    }
+    avgX /= avgN;
+    avgY /= avgN;
+
+    // point of this bucket with the largest triangle
+    var start = Math.floor(bucket * every) + 1;
+    var end = Math.floor((bucket + 1) * every) + 1;
+    var ka = ring.index(a);
+    var ax = time[ka];
+    var ay = value[ka];
+    var maxArea = -1;
+    var pick = start;
+    var brk = false;
+    for (i = start; i < end; ++i) {
+      var kb = ring.index(i);
+      if (isNaN(value[kb])) {
+        pick = i;
+        brk = true;
+        break;
+      }
+      var area = Math.abs((ax - avgX) * (value[kb] - ay) - (ax - time[kb]) * (avgY - ay));
+      if (area > maxArea) {
+        maxArea = area;
+        pick = i;
+      }
+    }
+
+    var kp = ring.index(pick);
+    out[bucket + 1] = out[bucket + 1] || {};
+    out[bucket + 1].x = time[kp];
+    out[bucket + 1].y = value[kp];
+    if (!brk) {
+      a = pick;
+    }
+  }
+
+  var kl = ring.index(n - 1);
+  out[threshold - 1] = out[threshold - 1] || {};
+  out[threshold - 1].x = time[kl];
+  out[threshold - 1].y = value[kl];
+  return out;
+}
+
+/**
+ * Line chart fed from a SampleRing. Samples may arrive at any rate, the chart is redrawn at most
+ * once per animation frame and only with as many points as the plot is wide.
+ * @param {HTMLCanvasElement} canvas - chart canvas
+ * @param {string} label - dataset label
+ * @param {number} capacity - samples kept
+ */
+function LiveChart(canvas, label, capacity) {
+  this.ring = new SampleRing(capacity);
+  this.points = [];
+  this.dirty = false;
+  this.frame = 0;
+  this.chart = new Chart(canvas.getContext('2d'), {
+    type: 'line',
+    data: {
+      datasets: [{
+        label: label,
+        data: this.points,
+        borderColor: '#44627C',
+        borderWidth: 1,
+        fill: false,
+        lineTension: 0,
+        pointRadius: 0
+      }]
+    },
+    options: {
+      animation: false,
+      hover: { mode: null },
+      tooltips: { enabled: false },
+      responsiveAnimationDuration: 0,
+      scales: {
+        xAxes: [{ type: 'linear', scaleLabel: { display: true, labelString: 'Time [s]' } }]
+      }
+    }
+  });
+}
+
+/**
+ * Appends a sample, the redraw happens on the next animation frame
+ * @param {number} t - time in seconds
+ * @param {number} v - value
+ */
+LiveChart.prototype.push = function (t, v) {
+  this.ring.push(t, v);
+  this.invalidate();
+};
+
+/**
+ * Breaks the trace, the next sample is not joined to the previous one
+ * @param {number} t - time in seconds of the next sample
+ */
+LiveChart.prototype.gap = function (t) {
+  this.push(t, NaN);
+};
+
+LiveChart.prototype.clear = function () {
+  this.ring.clear();
+  this.invalidate();
+};
+
+LiveChart.prototype.invalidate = function () {
+  if (!this.dirty) {
+    this.dirty = true;
+    this.frame = requestAnimationFrame(() => this.draw());
+  }
+};
+
+LiveChart.prototype.draw = function () {
+  var width = this.chart.chartArea ? Math.round(this.chart.chartArea.right - this.chart.chartArea.left) : 0;
+
+  this.dirty = false;
+  lttb(this.ring, Math.max(width, 3), this.points);
+  this.chart.update(0);
+};
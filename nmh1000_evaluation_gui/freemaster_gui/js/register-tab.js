@@ -183,66 +183,147 @@ function fill_description_table(data) {
     .remove();
 }
 
+/** Delay between checks of a pending register operation, and how many checks before giving up */
+var REGISTER_POLL_MS = 20;
+var REGISTER_POLL_ATTEMPTS = 100;
+
 /**
- * The register tab loop
+ * Reads a trigger, project variables by name and struct members without one by symbol
+ * @param {string} trigger - variable name, or symbol such as 'registers.writeall_trigger'
  */
-function register_tab_loop() {
+function read_trigger(trigger) {
+  if (trigger.indexOf('.') < 0) {
+    return pcm.ReadVariableBatched(trigger);
+  }
+  return pcm.ReadUIntArrayBatched(trigger, 1, 1)
+    .then(response => ({ status: response.status, data: response.status === 'OK' ? response.data[0] : undefined }));
+}
 
-  if (reading) {
-    return;
+/**
+ * Waits until the firmware cleared an operation trigger, only runs while an operation is pending.
+ * The result reads are issued together with every trigger check, the batching layer turns them
+ * into a single read of the registers structure.
+ * @param {string} trigger - trigger variable name or symbol
+ * @param {Function} reads - returns the array of result read promises
+ * @param {number} [attempts] - checks left
+ * @returns {Promise} resolved with the result responses once the trigger reads 0
+ */
+function wait_trigger_cleared(trigger, reads, attempts = REGISTER_POLL_ATTEMPTS) {
+  return Promise.all([read_trigger(trigger)].concat(reads()))
+    .then(responses => {
+      if (responses[0].status === 'OK' && responses[0].data == 0) {
+        return responses.slice(1);
+      }
+      if (attempts <= 1) {
+        throw new Error(trigger + ' not cleared by the board');
+      }
+      return new Promise(resolve => setTimeout(resolve, REGISTER_POLL_MS))
+        .then(() => wait_trigger_cleared(trigger, reads, attempts - 1));
+    });
+}
+
+/**
+ * Formats a register value the way reg.csv stores it
+ * @param {number} value - register value
+ */
+function register_value_hex(value) {
+  return '0x' + value.toString(16).padStart(2, '0');
+}
+
+/**
+ * Completes a single register read started by set_read_register_flag
+ */
+function complete_register_read() {
+  wait_trigger_cleared('read_trigger', () => [pcm.ReadVariableBatched('read_value')])
+    .then(([response]) => {
+      csv_parsed_data[read_register_index][4] = register_value_hex(response.data);
+      fill_registers_table(csv_parsed_data);
+      fill_bitfield_table(csv_parsed_data[read_register_index]);
+    })
+    .catch(err => console.error(err, 'Register read failed'))
+    .finally(() => {
+      read_register_index = 0;
+    });
+}
+
+/**
+ * Number of registers the firmware reads back, one past the highest address reg.csv lists
+ * @param {Array} registers - Array of registers entries from csv
+ */
+function register_count(registers) {
+  var count = 0;
+  for (var i = 1; i < registers.length; ++i) {
+    var addr = parseInt(registers[i][1], 16);
+    if (!isNaN(addr)) {
+      count = Math.max(count, addr + 1);
+    }
   }
+  return count;
+}
 
-  reading = true;
-
-  // Read the last selected register
-  pcm.ReadVariable('read_trigger')
-    .then(response => {
-      if (response.data == 0 && read_register_index) {
-        pcm.ReadVariable('read_value')
-          .then(response => {
-            var reg_value_hex = response.data.toString(16);
-            reg_value_hex = reg_value_hex.padStart(2, '0');
-            reg_value_hex = '0x' + reg_value_hex;
-            csv_parsed_data[read_register_index][4] = reg_value_hex;
-            fill_registers_table(csv_parsed_data);
-            fill_bitfield_table(csv_parsed_data[read_register_index]);
-            read_register_index = 0;
-            reading = false;
-          });
-      } else {
-        reading = false;
+/**
+ * Reads all registers from the board in one burst
+ * @param {number} count - number of registers
+ * @returns {Promise<Array<number>>} register values indexed by address
+ */
+function read_all_registers(count) {
+  return pcm.WriteVariable('readall_trigger', 1)
+    .then(() => wait_trigger_cleared('readall_trigger',
+      () => [pcm.ReadUIntArrayBatched('registers.readall_value', count, 1)]))
+    .then(([response]) => {
+      if (response.status !== 'OK') {
+        throw response.error;
       }
+      return response.data;
     });
+}
 
-    var regall_size;
-	pcm.ReadVariable('readall_size')
-	.then(response => {
-	  regall_size = response;
-	});
-
-  // Read all registers
-  pcm.ReadVariable('readall_trigger')
-    .then(response => {
-      if (response.data == 0 && read_all_registers_flag) {
-        pcm.ReadUIntArray('registers.readall_value', regall_size, 1)
-          .then(response => {
-            for (var i = 1; i < csv_parsed_data.length; ++i) {
-              var addr = parseInt(csv_parsed_data[i][1], 16);
-			  if (csv_parsed_data[i][0].trim() == 'RESERVED'){
-				  continue;
-			  }
-              var reg_value_hex = response.data[addr].toString(16);
-              reg_value_hex = reg_value_hex.padStart(2, '0');
-              reg_value_hex = '0x' + reg_value_hex;
-              csv_parsed_data[i][4] = reg_value_hex;
-            }
-            fill_registers_table(csv_parsed_data);
-            read_all_registers_flag = 0;
-          });
-      } else {
-        reading = false;
+/** Layout of the batch write block in the registers structure, looked up once */
+var write_batch_layout;
+
+function get_write_batch_layout() {
+  if (!write_batch_layout) {
+    write_batch_layout = Promise.all([
+      pcm.GetSymbolInfo('registers.writeall_value'),
+      pcm.GetSymbolInfo('registers.writeall_mask'),
+      pcm.GetSymbolInfo('registers.writeall_trigger')
+    ]).then(([values, mask, trigger]) => {
+      if (values.status !== 'OK' || mask.status !== 'OK' || trigger.status !== 'OK') {
+        write_batch_layout = undefined;
+        throw new Error('Firmware has no batch register write');
       }
+      return {
+        addr: values.data.addr,
+        mask: mask.data.addr - values.data.addr,
+        trigger: trigger.data.addr - values.data.addr,
+        size: trigger.data.addr + 1 - values.data.addr
+      };
     });
+  }
+  return write_batch_layout;
+}
+
+/**
+ * Writes several registers with a single memory write of values, mask and trigger
+ * @param {Array<number>} values - register values indexed by address
+ * @param {number} mask - bit n set to write register n
+ * @returns {Promise<number>} mask of the registers the firmware failed to write
+ */
+function write_register_batch(values, mask) {
+  return get_write_batch_layout()
+    .then(layout => {
+      var bytes = new Array(layout.size).fill(0);
+      values.forEach((value, addr) => {
+        bytes[addr] = value;
+      });
+      bytes[layout.mask] = mask & 0xFF;
+      bytes[layout.mask + 1] = (mask >> 8) & 0xFF;
+      bytes[layout.trigger] = 1;
+      return pcm.WriteUIntArray(layout.addr, 1, bytes);
+    })
+    .then(() => wait_trigger_cleared('registers.writeall_trigger',
+      () => [pcm.ReadUIntArrayBatched('registers.writeall_mask', 1, 2)]))
+    .then(([response]) => response.data[0]);
 }
 
 /*
@@ -297,7 +378,8 @@ function set_read_register_flag() {
   Promise.all([
     pcm.WriteVariable('read_offset', offset),
     pcm.WriteVariable('read_trigger', 1)
-  ]).catch(err => alert('Could not write'));
+  ]).then(complete_register_read)
+    .catch(err => alert('Could not write'));
 }
 
 /*
@@ -305,7 +387,21 @@ function set_read_register_flag() {
  */
 function set_read_all_registers_flag() {
   read_all_registers_flag = 1;
-  pcm.WriteVariable('readall_trigger', 1).catch(err => alert('Could not write'));
+  read_all_registers(register_count(csv_parsed_data))
+    .then(values => {
+      for (var i = 1; i < csv_parsed_data.length; ++i) {
+        var addr = parseInt(csv_parsed_data[i][1], 16);
+        if (csv_parsed_data[i][0].trim() == 'RESERVED' || !(addr < values.length)) {
+          continue;
+        }
+        csv_parsed_data[i][4] = register_value_hex(values[addr]);
+      }
+      fill_registers_table(csv_parsed_data);
+    })
+    .catch(err => alert('Could not read'))
+    .finally(() => {
+      read_all_registers_flag = 0;
+    });
 }
 
 /**
@@ -340,17 +436,36 @@ function load_csv(e) {
 }
 
 /**
- * Writes all register values
+ * Writes the register values of a configuration that differ from the board.
+ * Takes a snapshot of all registers, then sends only the changed writable ones as one batch.
  * @param {object} registers - Array of registers entries from csv
  */
 function write_all_registers(registers) {
-  for (var i = 1; i < registers.length; ++i) {
-    if (registers[i][3] !== 'R') {
-      Promise.all([
-        pcm.WriteVariable('Offset', parseInt(registers[i][1], 16)),
-        pcm.WriteVariable('Value', parseInt(registers[i][4], 16)),
-        pcm.WriteVariable('Trigger', 1)
-      ]).catch(err => alert('Could not write'));
-    }
-  }
+  var count = register_count(registers);
+  read_all_registers(count)
+    .then(current => {
+      var values = new Array(count).fill(0);
+      var mask = 0;
+      for (var i = 1; i < registers.length; ++i) {
+        var addr = parseInt(registers[i][1], 16);
+        var value = parseInt(registers[i][4], 16);
+        if (registers[i][0].trim() == 'RESERVED' || registers[i][2].trim() == 'R' || isNaN(addr) || isNaN(value)) {
+          continue;
+        }
+        if (current[addr] !== value) {
+          values[addr] = value;
+          mask |= 1 << addr;
+        }
+      }
+      return mask ? write_register_batch(values, mask) : 0;
+    })
+    .then(failed => {
+      if (failed) {
+        var names = registers.slice(1)
+          .filter(row => failed & (1 << parseInt(row[1], 16)))
+          .map(row => row[0].trim());
+        alert('Could not write ' + names.join(', '));
+      }
+    })
+    .catch(err => alert('Could not write'));
 }
\ No newline at end of file
@@ -0,0 +1,168 @@
+#!/usr/bin/env python3
+#
+# Copyright 2024 NXP
+# All rights reserved.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+"""Expand deferred log records (source/deferred_log.h) captured from the board.
+
+The firmware sends only the address of each format string plus raw 32-bit
+arguments. This tool builds the format table from the DLOG() strings in the
+firmware ELF and turns the captured byte stream back into text.
+
+    dlog_decode.py firmware.axf capture.bin
+    dlog_decode.py firmware.axf - < capture.bin
+    dlog_decode.py --list firmware.axf
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+DLOG_SYNC = 0xD7
+DLOG_HEADER_SIZE = 6
+DLOG_MAX_ARGS = 4
+DLOG_SYMBOL_PREFIX = "_dlogFmt"
+
+SHT_PROGBITS = 1
+SHT_SYMTAB = 2
+SHF_ALLOC = 0x2
+
+# C conversion spec: flags, width, precision, length modifier, conversion
+FORMAT_SPEC = re.compile(r"%([-+ #0]*)(\d*)(?:\.(\d+))?(hh|h|ll|l|z|j|t)?([diouxXcsp%])")
+
+
+class Elf32:
+    """Just enough of an ELF32 little-endian reader to resolve constant strings."""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            self.data = f.read()
+        if self.data[:4] != b"\x7fELF" or self.data[4] != 1 or self.data[5] != 1:
+            raise ValueError("%s is not a 32-bit little-endian ELF file" % path)
+
+        shoff, = struct.unpack_from("<I", self.data, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from("<HHH", self.data, 0x2E)
+        self.sections = []
+        for i in range(shnum):
+            fields = struct.unpack_from("<IIIIIIIIII", self.data, shoff + i * shentsize)
+            self.sections.append(dict(zip(
+                ("name", "type", "flags", "addr", "offset", "size", "link", "info", "align", "entsize"), fields)))
+
+    def read_string(self, addr):
+        """Return the zero-terminated string at a target address, or None when it is not in the image."""
+        for sec in self.sections:
+            if sec["type"] == SHT_PROGBITS and sec["flags"] & SHF_ALLOC and \
+                    sec["addr"] <= addr < sec["addr"] + sec["size"]:
+                start = sec["offset"] + addr - sec["addr"]
+                end = self.data.find(b"\0", start, sec["offset"] + sec["size"])
+                if end < 0:
+                    return None
+                return self.data[start:end].decode("latin-1")
+        return None
+
+    def symbols(self):
+        for sec in self.sections:
+            if sec["type"] != SHT_SYMTAB:
+                continue
+            strtab = self.sections[sec["link"]]
+            for off in range(sec["offset"], sec["offset"] + sec["size"], 16):
+                name, value, size, info, other, shndx = struct.unpack_from("<IIIBBH", self.data, off)
+                start = strtab["offset"] + name
+                yield self.data[start:self.data.index(b"\0", start)].decode("latin-1"), value
+
+
+def format_table(elf):
+    """Map format ID (string address) to format string for every DLOG() site."""
+    table = {}
+    for name, value in elf.symbols():
+        if name.startswith(DLOG_SYMBOL_PREFIX):
+            text = elf.read_string(value)
+            if text is not None:
+                table[value] = text
+    return table
+
+
+def expand(elf, fmt, args):
+    """Format a record the way printf would have done on target."""
+    args = list(args)
+
+    def convert(match):
+        flags, width, precision, length, conv = match.groups()
+        if conv == "%":
+            return "%"
+        if not args:
+            return "<missing>"
+        value = args.pop(0)
+        if conv in "di":
+            bits = {"hh": 8, "h": 16}.get(length, 32)
+            value &= (1 << bits) - 1
+            if value & (1 << (bits - 1)):
+                value -= 1 << bits
+            conv = "d"
+        elif conv == "u":
+            conv = "d"
+        elif conv == "c":
+            value = chr(value & 0xFF)
+        elif conv == "s":
+            text = elf.read_string(value)
+            value = text if text is not None else "<0x%08x>" % value
+        elif conv == "p":
+            conv, flags, width = "x", "#", width or ""
+        spec = "%" + flags + width + ("." + precision if precision else "") + conv
+        return spec % value
+
+    return FORMAT_SPEC.sub(convert, fmt)
+
+
+def decode(elf, table, stream, out):
+    data = stream.read()
+    pos = 0
+    while pos + DLOG_HEADER_SIZE <= len(data):
+        sync, argc, fmt_id = struct.unpack_from("<BBI", data, pos)
+        fmt = table.get(fmt_id)
+        if fmt is None and not table:
+            # stripped image without symbols, trust any string in it
+            fmt = elf.read_string(fmt_id)
+        if sync != DLOG_SYNC or argc > DLOG_MAX_ARGS or fmt is None:
+            # lost sync, e.g. capture started in the middle of a record
+            pos += 1
+            continue
+        end = pos + DLOG_HEADER_SIZE + 4 * argc
+        if end > len(data):
+            break
+        args = struct.unpack_from("<%dI" % argc, data, pos + DLOG_HEADER_SIZE)
+        out.write(expand(elf, fmt, args) + "\n")
+        pos = end
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("elf", help="firmware image (.axf/.elf) the log was produced by")
+    parser.add_argument("capture", nargs="?", help="captured dlog pipe bytes, '-' for stdin")
+    parser.add_argument("--list", action="store_true", help="print the format table and exit")
+    opts = parser.parse_args()
+
+    elf = Elf32(opts.elf)
+    table = format_table(elf)
+
+    if opts.list:
+        for fmt_id in sorted(table):
+            print("0x%08x  %s" % (fmt_id, table[fmt_id]))
+        return 0
+
+    if opts.capture is None:
+        parser.error("capture file is required")
+
+    if opts.capture == "-":
+        decode(elf, table, sys.stdin.buffer, sys.stdout)
+    else:
+        with open(opts.capture, "rb") as f:
+            decode(elf, table, f, sys.stdout)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,109 @@
+#!/bin/sh
+#
+# Copyright 2024 NXP
+# All rights reserved.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+# End-to-end check of fmstr_capture against the host builds of ../fmstr_net_host, no board needed:
+# fmstr_pty_host stands in for the board serial port, fmstr_net_host for the network build.
+# Every mode is run on each and the output checked against the sample counter of the host build.
+# Run through "make check".
+
+set -eu
+
+HOST_DIR=../fmstr_net_host
+WORK=$(mktemp -d)
+HOST_PID=
+
+cleanup()
+{
+    if [ -n "$HOST_PID" ]; then
+        kill "$HOST_PID" 2>/dev/null || true
+        wait "$HOST_PID" 2>/dev/null || true
+    fi
+    rm -rf "$WORK"
+}
+trap cleanup EXIT INT TERM
+
+fail()
+{
+    echo "FAIL: $*" >&2
+    exit 1
+}
+
+# Start a host build and wait for its start-up line, HOST_INFO is the word after the given prefix
+start_host()
+{
+    "$HOST_DIR/$1" >/dev/null 2>"$WORK/host.log" &
+    HOST_PID=$!
+    for _ in $(seq 50); do
+        HOST_INFO=$(sed -n "s/.*$2 *\([^ ]*\).*/\1/p" "$WORK/host.log")
+        if [ -n "$HOST_INFO" ]; then
+            return
+        fi
+        sleep 0.1
+    done
+    fail "$1 did not start"
+}
+
+stop_host()
+{
+    kill "$HOST_PID"
+    wait "$HOST_PID" 2>/dev/null || true
+    HOST_PID=
+}
+
+# CSV of time,m_out,hostSampleCount: rows in time order without the count going back, GAP rows
+# starting at the row before them. With runs=1 the count steps by exactly one between rows of a
+# run, the only place samples may be missing is a GAP.
+# Prints the sample and gap counts.
+check_csv()
+{
+    awk -F, -v what="$2" -v runs="$3" '
+        NR == 1 { next }
+        $1 == "GAP" { if (prev == "" || $2 != prev) { print what ": GAP does not start at the last row " NR > "/dev/stderr"; bad = 1 }
+                      gaps++; gap = 1; next }
+        {
+            if (prev != "" && $1 + 0 < prev + 0) { print what ": time goes back at row " NR > "/dev/stderr"; bad = 1 }
+            if (prev != "" && $3 < cnt) { print what ": sample count goes back at row " NR > "/dev/stderr"; bad = 1 }
+            if (runs && prev != "" && !gap && $3 != cnt + 1) { print what ": samples missing within a run at row " NR > "/dev/stderr"; bad = 1 }
+            prev = $1; cnt = $3; gap = 0; rows++
+        }
+        END { if (bad) exit 1; print rows, gaps + 0 }' "$1" || fail "$2"
+}
+
+run_modes()
+{
+    device=$1
+    name=$2
+
+    ./fmstr_capture -d "$device" --list >"$WORK/list" 2>/dev/null || fail "$name: --list"
+    grep -q "^registers " "$WORK/list" || fail "$name: registers missing from the TSA"
+
+    ./fmstr_capture -d "$device" -m scope -n 500 -o "$WORK/scope.csv" registers.m_out hostSampleCount 2>/dev/null ||
+        fail "$name: scope capture"
+    set -- $(check_csv "$WORK/scope.csv" "$name scope" 0)
+    [ "$1" -eq 500 ] || fail "$name scope: $1 samples instead of 500"
+
+    ./fmstr_capture -d "$device" -m recorder -t 3 -o "$WORK/rec.csv" registers.m_out hostSampleCount 2>/dev/null ||
+        fail "$name: recorder capture"
+    set -- $(check_csv "$WORK/rec.csv" "$name recorder" 1)
+    [ "$2" -ge 1 ] || fail "$name recorder: no GAP between $1 samples of several runs"
+    echo "$name: recorder $1 samples, $2 gaps"
+
+    ./fmstr_capture -d "$device" -m pipe -p 1 -t 1 -o "$WORK/pipe.bin" 2>/dev/null || fail "$name: pipe capture"
+    [ -s "$WORK/pipe.bin" ] || fail "$name pipe: no data"
+}
+
+make -s -C "$HOST_DIR" fmstr_pty_host fmstr_net_host
+
+start_host fmstr_pty_host "serial port"
+run_modes "$HOST_INFO" pty
+stop_host
+
+start_host fmstr_net_host "listening on"
+run_modes "tcp:$HOST_INFO" tcp
+stop_host
+
+echo "fmstr_capture: all checks passed"
@@ -0,0 +1,458 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file  fmstr_capture.cpp
+ * @brief The fmstr_capture.cpp file implements a headless FreeMASTER capture client.
+ *
+ * @details Talks to the board directly over its serial port, network, RTT or CAN transport, without the
+ *          FreeMASTER desktop application, and streams samples to a file for as long as a soak
+ *          test runs:
+ *
+ *              fmstr_capture -d /dev/ttyACM0 --list
+ *              fmstr_capture -d /dev/ttyACM0 -m scope -o out.csv registers.m_out switchThreshold
+ *              fmstr_capture -d /dev/ttyACM0 -m recorder -f bin -t 3600 -o out.bin registers.m_out
+ *              fmstr_capture -d /dev/ttyACM0 -m pipe -p 1 -o stream.bin
+ *              fmstr_capture -d tcp:192.168.0.102:3344 -m scope -o out.csv registers.m_out
+ *              fmstr_capture -d rtt:/fmstr_rtt -m scope -o out.csv registers.m_out
+ *              fmstr_capture -d canfd:can0 -m recorder -t 60 -o out.csv registers.m_out
+ *
+ *          scope     reads the variables back to back, one sample per round trip.
+ *          recorder  lets the board sample into its recorder buffer at full rate, then stops it,
+ *                    reads the buffer and starts again; samples taken during the read are lost.
+ *          pipe      writes the raw bytes the board sends through a pipe port.
+ *
+ *          CSV rows hold the time in seconds and one column per variable. Binary records hold the
+ *          time as a little-endian double followed by the raw variable bytes in the listed order.
+ *          Each recorder run starts at the capture time the recorder was started. Its points follow
+ *          at the board's base period when it reports one, otherwise they are spread evenly over the
+ *          time the buffer took to fill. Samples the board takes while a run is read are not
+ *          captured, so every run after the first is preceded by a gap record: a CSV row
+ *          GAP,<last>,<next> with the times of the points around the gap, or a binary record with a
+ *          NaN time and zeroed variable bytes.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <getopt.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "fmstr_client.h"
+
+namespace
+{
+volatile std::sig_atomic_t stopRequested = 0;
+
+void OnSignal(int)
+{
+    stopRequested = 1;
+}
+
+double Seconds(std::chrono::steady_clock::time_point since)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - since).count();
+}
+
+struct Options
+{
+    std::string device;
+    unsigned baud = 115200;
+    std::string mode = "scope";
+    std::string output = "-";
+    bool binary = false;
+    double duration = 0.0;
+    uint64_t samples = 0;
+    uint8_t instance = 0;
+    uint8_t port = 0;
+    bool list = false;
+    std::vector<std::string> variables;
+};
+
+/* Sample sink, CSV or binary records */
+class Writer
+{
+public:
+    Writer(const Options &opt, const std::vector<FmstrVariable> &vars) : vars_(vars), binary_(opt.binary)
+    {
+        file_ = (opt.output == "-") ? stdout : std::fopen(opt.output.c_str(), binary_ ? "wb" : "w");
+        if (file_ == nullptr)
+        {
+            throw FmstrError("cannot create " + opt.output);
+        }
+        std::setvbuf(file_, nullptr, _IOFBF, 1U << 16);
+        if (!binary_ && !vars.empty())
+        {
+            std::fputs("time", file_);
+            for (const auto &v : vars)
+            {
+                std::fprintf(file_, ",%s", v.name.c_str());
+            }
+            std::fputc('\n', file_);
+        }
+    }
+
+    ~Writer()
+    {
+        if (file_ != stdout)
+        {
+            std::fclose(file_);
+        }
+        else
+        {
+            std::fflush(file_);
+        }
+    }
+
+    /* One point: the variables' raw bytes back to back */
+    void Sample(double t, const uint8_t *point)
+    {
+        if (binary_)
+        {
+            size_t size = 0;
+
+            std::fwrite(&t, sizeof(t), 1, file_);
+            for (const auto &v : vars_)
+            {
+                size += v.size;
+            }
+            std::fwrite(point, 1, size, file_);
+        }
+        else
+        {
+            std::fprintf(file_, "%.6f", t);
+            for (const auto &v : vars_)
+            {
+                std::fprintf(file_, ",%s", v.Format(point).c_str());
+                point += v.size;
+            }
+            std::fputc('\n', file_);
+        }
+        samples_++;
+    }
+
+    /* Samples between from and to were not captured */
+    void Gap(double from, double to)
+    {
+        if (binary_)
+        {
+            double marker = std::nan("");
+            size_t size = 0;
+
+            std::fwrite(&marker, sizeof(marker), 1, file_);
+            for (const auto &v : vars_)
+            {
+                size += v.size;
+            }
+            std::vector<uint8_t> zeros(size);
+            std::fwrite(zeros.data(), 1, size, file_);
+        }
+        else
+        {
+            std::fprintf(file_, "GAP,%.6f,%.6f\n", from, to);
+        }
+    }
+
+    void Raw(const std::vector<uint8_t> &data)
+    {
+        std::fwrite(data.data(), 1, data.size(), file_);
+        bytes_ += data.size();
+    }
+
+    uint64_t Samples() const { return samples_; }
+    uint64_t Bytes() const { return bytes_; }
+
+private:
+    std::vector<FmstrVariable> vars_;
+    bool binary_;
+    std::FILE *file_;
+    uint64_t samples_ = 0;
+    uint64_t bytes_ = 0;
+};
+
+/* Once per second: progress on stderr */
+class Progress
+{
+public:
+    Progress(const FmstrLink &link, const Writer &writer) : link_(link), writer_(writer) {}
+
+    bool Done(const Options &opt)
+    {
+        double t = Seconds(start_);
+
+        if (t - last_ >= 1.0)
+        {
+            const FmstrLinkStats &s = link_.Stats();
+
+            std::fprintf(stderr, "\r%8.0f s  %10llu samples  %8.0f samples/s  %7.1f kB/s link  %llu retries",
+                         t, (unsigned long long)writer_.Samples(), (writer_.Samples() - lastSamples_) / (t - last_),
+                         (s.rxBytes + s.txBytes - lastBytes_) / 1024.0 / (t - last_), (unsigned long long)s.retries);
+            last_ = t;
+            lastSamples_ = writer_.Samples();
+            lastBytes_ = s.rxBytes + s.txBytes;
+        }
+        return (stopRequested != 0) || ((opt.duration > 0.0) && (t >= opt.duration)) ||
+               ((opt.samples != 0U) && (writer_.Samples() >= opt.samples));
+    }
+
+    std::chrono::steady_clock::time_point Start() const { return start_; }
+
+private:
+    const FmstrLink &link_;
+    const Writer &writer_;
+    std::chrono::steady_clock::time_point start_ = std::chrono::steady_clock::now();
+    double last_ = 0.0;
+    uint64_t lastSamples_ = 0;
+    uint64_t lastBytes_ = 0;
+};
+
+void CaptureScope(FmstrClient &client, FmstrLink &link, const Options &opt, const std::vector<FmstrVariable> &vars)
+{
+    Writer writer(opt, vars);
+    Progress progress(link, writer);
+    uint32_t total = 0;
+
+    for (const auto &v : vars)
+    {
+        total += v.size;
+    }
+    client.SetupScope(opt.instance, vars);
+    while (!progress.Done(opt))
+    {
+        std::vector<uint8_t> point = client.ReadScope(opt.instance, total);
+
+        writer.Sample(Seconds(progress.Start()), point.data());
+    }
+}
+
+void CaptureRecorder(FmstrClient &client, FmstrLink &link, const Options &opt, const std::vector<FmstrVariable> &vars)
+{
+    Writer writer(opt, vars);
+    Progress progress(link, writer);
+    FmstrRecLimits limits = client.RecorderLimits(opt.instance);
+    uint32_t pointSize = 0;
+    uint32_t overhead;
+    uint32_t points;
+    double fillTime = 0.0;
+    double last = -1.0; /* time of the previous run's last point, negative before the first run */
+
+    for (const auto &v : vars)
+    {
+        pointSize += v.size;
+    }
+    /* recorder and variable bookkeeping precede the samples, each aligned to the pointer size */
+    overhead = limits.recStructSize + (uint32_t)vars.size() * limits.varStructSize + 2U * sizeof(uint64_t);
+    if (limits.buffSize <= overhead + pointSize)
+    {
+        throw FmstrError("recorder buffer too small for the variables");
+    }
+    points = (limits.buffSize - overhead) / pointSize;
+    client.SetupRecorder(opt.instance, vars, points);
+
+    while (!progress.Done(opt))
+    {
+        double started = Seconds(progress.Start());
+        FmstrRecInfo info;
+
+        client.StartRecorder(opt.instance);
+        if (fillTime > 0.0)
+        {
+            std::this_thread::sleep_for(std::chrono::duration<double>(fillTime * 0.9));
+        }
+        do
+        {
+            info = client.RecorderInfo(opt.instance);
+        } while ((info.status == 2U) && (info.pointCount < points) && (stopRequested == 0));
+        client.StopRecorder(opt.instance);
+        info = client.RecorderInfo(opt.instance);
+
+        double stopped = Seconds(progress.Start());
+        fillTime = stopped - started;
+        if (info.pointCount == 0U)
+        {
+            continue;
+        }
+
+        std::vector<uint8_t> data = client.ReadMem(info.buffAddr, info.pointCount * info.pointSize);
+        double step = (limits.basePeriodNs != 0U) ? limits.basePeriodNs * 1e-9 : fillTime / info.pointCount;
+
+        /* the board may have sampled between the previous run and this one */
+        started = std::max(started, last + step);
+        if (last >= 0.0)
+        {
+            writer.Gap(last, started);
+        }
+        for (uint32_t i = 0; i < info.pointCount; i++)
+        {
+            uint32_t slot = (info.firstPoint + i) % info.pointCount;
+
+            writer.Sample(started + i * step, &data[slot * info.pointSize]);
+        }
+        last = started + (info.pointCount - 1U) * step;
+    }
+    client.StopRecorder(opt.instance);
+}
+
+void CapturePipe(FmstrClient &client, FmstrLink &link, const Options &opt)
+{
+    Writer writer(opt, {});
+    Progress progress(link, writer);
+    std::vector<uint8_t> data;
+
+    while (!progress.Done(opt))
+    {
+        client.PipeReceive(opt.port, data);
+        if (data.empty())
+        {
+            /* nothing buffered on the board, do not spin the link */
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+        writer.Raw(data);
+    }
+    std::fprintf(stderr, "\n%llu bytes\n", (unsigned long long)writer.Bytes());
+}
+
+void Usage()
+{
+    std::fputs("usage: fmstr_capture -d DEVICE [-b BAUD] [--list]\n"
+               "       fmstr_capture -d DEVICE [-m scope|recorder] [-f csv|bin] [-o FILE] [-t SECONDS] [-n SAMPLES]\n"
+               "                     [-i INSTANCE] VARIABLE...\n"
+               "       fmstr_capture -d DEVICE -m pipe [-p PORT] [-o FILE] [-t SECONDS]\n"
+               "DEVICE is a serial port, tcp:HOST:PORT for the network transport, rtt:NAME[:INDEX] for the\n"
+               "RTT shared memory stand-in, can:IFACE or canfd:IFACE for the CAN transport on SocketCAN.\n"
+               "VARIABLE is a TSA name, optionally with .member and [index] parts.\n",
+               stderr);
+}
+
+bool ParseOptions(int argc, char **argv, Options &opt)
+{
+    static const struct option longOptions[] = {
+        {"device", required_argument, nullptr, 'd'},   {"baud", required_argument, nullptr, 'b'},
+        {"mode", required_argument, nullptr, 'm'},     {"output", required_argument, nullptr, 'o'},
+        {"format", required_argument, nullptr, 'f'},   {"duration", required_argument, nullptr, 't'},
+        {"samples", required_argument, nullptr, 'n'},  {"instance", required_argument, nullptr, 'i'},
+        {"port", required_argument, nullptr, 'p'},     {"list", no_argument, nullptr, 'l'},
+        {"help", no_argument, nullptr, 'h'},           {nullptr, 0, nullptr, 0},
+    };
+    int c;
+
+    while ((c = getopt_long(argc, argv, "d:b:m:o:f:t:n:i:p:lh", longOptions, nullptr)) != -1)
+    {
+        switch (c)
+        {
+            case 'd':
+                opt.device = optarg;
+                break;
+            case 'b':
+                opt.baud = (unsigned)std::stoul(optarg);
+                break;
+            case 'm':
+                opt.mode = optarg;
+                break;
+            case 'o':
+                opt.output = optarg;
+                break;
+            case 'f':
+                opt.binary = (std::strcmp(optarg, "bin") == 0);
+                break;
+            case 't':
+                opt.duration = std::stod(optarg);
+                break;
+            case 'n':
+                opt.samples = std::stoull(optarg);
+                break;
+            case 'i':
+                opt.instance = (uint8_t)std::stoul(optarg);
+                break;
+            case 'p':
+                opt.port = (uint8_t)std::stoul(optarg);
+                break;
+            case 'l':
+                opt.list = true;
+                break;
+            default:
+                return false;
+        }
+    }
+    for (int i = optind; i < argc; i++)
+    {
+        opt.variables.push_back(argv[i]);
+    }
+    if (opt.device.empty() || (opt.mode != "scope" && opt.mode != "recorder" && opt.mode != "pipe"))
+    {
+        return false;
+    }
+    return opt.list || (opt.mode == "pipe") || !opt.variables.empty();
+}
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Options opt;
+
+    if (!ParseOptions(argc, argv, opt))
+    {
+        Usage();
+        return 2;
+    }
+    std::signal(SIGINT, OnSignal);
+    std::signal(SIGTERM, OnSignal);
+
+    try
+    {
+        FmstrLink link(opt.device, opt.baud);
+        FmstrClient client(link);
+
+        client.Connect();
+        std::fprintf(stderr, "%s, FreeMASTER %s, %u byte responses\n", client.ConfigString("NM").c_str(),
+                     client.ConfigString("VS").c_str(), client.MaxResponse());
+
+        if (opt.list)
+        {
+            for (const auto &e : client.Tsa())
+            {
+                if (e.entryType != 0U)
+                {
+                    std::printf("%-32s 0x%08x %5u %s\n", e.name.c_str(), e.addr, e.size,
+                                (e.entryType == 3U) ? "rw" : "ro");
+                }
+            }
+            return 0;
+        }
+
+        std::vector<FmstrVariable> vars;
+        for (const auto &name : opt.variables)
+        {
+            vars.push_back(client.Resolve(name));
+        }
+
+        if (opt.mode == "scope")
+        {
+            CaptureScope(client, link, opt, vars);
+        }
+        else if (opt.mode == "recorder")
+        {
+            CaptureRecorder(client, link, opt, vars);
+        }
+        else
+        {
+            CapturePipe(client, link, opt);
+        }
+        std::fputc('\n', stderr);
+    }
+    catch (const std::exception &e)
+    {
+        std::fprintf(stderr, "\nfmstr_capture: %s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
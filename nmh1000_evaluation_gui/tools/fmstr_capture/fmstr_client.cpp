@@ -0,0 +1,569 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file  fmstr_client.cpp
+ * @brief The fmstr_client.cpp file implements the FreeMASTER protocol commands used by fmstr_capture.
+ */
+
+#include "fmstr_client.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#include "freemaster_protocol.h"
+
+/* Operation codes, private to freemaster_scope.c and freemaster_rec.c */
+#define FMSTR_SCOPE_PRTCLSET_OP_CFGMEM 0x01U
+#define FMSTR_SCOPE_PRTCLSET_OP_CFGVAR 0x02U
+#define FMSTR_REC_PRTCLSET_OP_CFGMEM   0x01U
+#define FMSTR_REC_PRTCLSET_OP_CFGVAR   0x02U
+#define FMSTR_REC_PRTCLSET_OP_START    0x03U
+#define FMSTR_REC_PRTCLSET_OP_STOP     0x04U
+#define FMSTR_REC_PRTCLGET_OP_LIMITS   0x82U
+#define FMSTR_REC_PRTCLGET_OP_INFO     0x83U
+
+/* TSA entry types and special type strings, see freemaster_tsa.h */
+#define FMSTR_TSA_INFO_ENTRYTYPE_MASK 0x0003U
+#define FMSTR_TSA_INFO_NON_VAR        0x0000U
+#define FMSTR_TSA_SPECIAL_NOMEM       '\xED'
+#define FMSTR_TSA_STRUCT_TYPE         "\xED:STRUCT"
+
+/* FMSTR_CFG_F1_LARGE_MSG of freemaster_defcfg.h */
+#define FMSTR_CFG_F1_LARGE_MSG 0x04U
+
+//-----------------------------------------------------------------------
+// LEB128
+//-----------------------------------------------------------------------
+void FmstrPutUleb(std::vector<uint8_t> &out, uint64_t value)
+{
+    do
+    {
+        uint8_t b = value & 0x7FU;
+
+        value >>= 7;
+        out.push_back((value != 0U) ? (uint8_t)(b | 0x80U) : b);
+    } while (value != 0U);
+}
+
+uint64_t FmstrGetUleb(const std::vector<uint8_t> &data, size_t &pos)
+{
+    uint64_t value = 0;
+    unsigned shift = 0;
+
+    for (;;)
+    {
+        if (pos >= data.size())
+        {
+            throw FmstrError("truncated LEB number in response");
+        }
+        uint8_t b = data[pos++];
+
+        value |= (uint64_t)(b & 0x7FU) << shift;
+        shift += 7;
+        if ((b & 0x80U) == 0U)
+        {
+            return value;
+        }
+    }
+}
+
+//-----------------------------------------------------------------------
+// Variables
+//-----------------------------------------------------------------------
+std::string FmstrVariable::Format(const uint8_t *data) const
+{
+    uint64_t raw = 0;
+    char text[32];
+
+    for (unsigned i = 0; i < size; i++)
+    {
+        raw |= (uint64_t)data[i] << (8U * i);
+    }
+
+    switch (kind)
+    {
+        case FmstrKind::Unsigned:
+            std::snprintf(text, sizeof(text), "%llu", (unsigned long long)raw);
+            break;
+        case FmstrKind::Signed:
+        {
+            unsigned bits = 8U * size;
+            int64_t value = (bits < 64U) ? (int64_t)(raw << (64U - bits)) >> (64U - bits) : (int64_t)raw;
+
+            std::snprintf(text, sizeof(text), "%lld", (long long)value);
+            break;
+        }
+        case FmstrKind::Float:
+            if (size == 4U)
+            {
+                float f;
+                uint32_t r = (uint32_t)raw;
+
+                std::memcpy(&f, &r, sizeof(f));
+                std::snprintf(text, sizeof(text), "%.9g", f);
+            }
+            else
+            {
+                double d;
+
+                std::memcpy(&d, &raw, sizeof(d));
+                std::snprintf(text, sizeof(text), "%.17g", d);
+            }
+            break;
+        default:
+            std::snprintf(text, sizeof(text), "0x%0*llx", 2 * size, (unsigned long long)raw);
+            break;
+    }
+    return text;
+}
+
+//-----------------------------------------------------------------------
+// Client
+//-----------------------------------------------------------------------
+FmstrClient::FmstrClient(FmstrLink &link) : link_(link) {}
+
+std::string FmstrClient::Describe(uint8_t cmd, uint8_t status)
+{
+    static const struct
+    {
+        uint8_t code;
+        const char *text;
+    } codes[] = {
+        {FMSTR_STC_INVCMD, "unknown command"},         {FMSTR_STC_CMDCSERR, "command checksum error"},
+        {FMSTR_STC_CMDTOOLONG, "command too long"},    {FMSTR_STC_RSPBUFFOVF, "response too long"},
+        {FMSTR_STC_INVBUFF, "invalid buffer"},         {FMSTR_STC_INVSIZE, "invalid size"},
+        {FMSTR_STC_SERVBUSY, "service busy"},          {FMSTR_STC_NOTINIT, "not initialized"},
+        {FMSTR_STC_EACCESS, "access denied"},          {FMSTR_STC_PIPEERR, "pipe error"},
+        {FMSTR_STC_EAUTH, "authentication required"},  {FMSTR_STC_INSTERR, "bad instance"},
+        {FMSTR_STC_INVOPCODE, "invalid operation"},    {FMSTR_STC_INVCONF, "invalid configuration"},
+    };
+    char text[80];
+    const char *reason = "error";
+
+    for (const auto &c : codes)
+    {
+        if (c.code == status)
+        {
+            reason = c.text;
+        }
+    }
+    std::snprintf(text, sizeof(text), "command 0x%02x failed: %s (0x%02x)", cmd, reason, status);
+    return text;
+}
+
+std::vector<uint8_t> FmstrClient::Command(uint8_t cmd, const std::vector<uint8_t> &payload, int expectedLen)
+{
+    std::vector<uint8_t> response;
+    uint8_t status = link_.Transact(cmd, payload, expectedLen, response);
+
+    if ((status & FMSTR_STSF_ERROR) != 0U)
+    {
+        throw FmstrError(Describe(cmd, status));
+    }
+    return response;
+}
+
+void FmstrClient::Connect()
+{
+    maxResponse_ = std::min<uint32_t>(ConfigNumber("MTU"), link_.MaxResponse());
+
+    /* F1 is a single byte, its flags are below 0x80 and read the same as a LEB128 number */
+    if (link_.IsSerial() && ((ConfigNumber("F1") & FMSTR_CFG_F1_LARGE_MSG) != 0U))
+    {
+        uint32_t large = ConfigNumber("LM");
+
+        link_.EnableLargeFrames();
+        maxResponse_ = std::min<uint32_t>(large, link_.MaxResponse());
+    }
+}
+
+std::string FmstrClient::ConfigString(const std::string &name)
+{
+    std::vector<uint8_t> payload = {0}; /* index 0 selects the parameter by name */
+
+    payload.insert(payload.end(), name.begin(), name.end());
+    payload.push_back(0);
+
+    std::vector<uint8_t> resp = Command(FMSTR_CMD_GETCONFIG, payload);
+    size_t start = name.size() + 1U;
+
+    if (resp.size() < start)
+    {
+        throw FmstrError("short response to GETCONFIG " + name);
+    }
+    return std::string(resp.begin() + start, std::find(resp.begin() + start, resp.end(), 0));
+}
+
+uint32_t FmstrClient::ConfigNumber(const std::string &name)
+{
+    std::vector<uint8_t> payload = {0};
+
+    payload.insert(payload.end(), name.begin(), name.end());
+    payload.push_back(0);
+
+    std::vector<uint8_t> resp = Command(FMSTR_CMD_GETCONFIG, payload);
+    size_t pos = name.size() + 1U;
+
+    return (uint32_t)FmstrGetUleb(resp, pos);
+}
+
+std::vector<uint8_t> FmstrClient::ReadMem(uint32_t addr, uint32_t size)
+{
+    std::vector<uint8_t> data;
+
+    data.reserve(size);
+    while (size > 0U)
+    {
+        uint32_t chunk = std::min(size, maxResponse_);
+        std::vector<uint8_t> payload;
+
+        FmstrPutUleb(payload, addr);
+        FmstrPutUleb(payload, chunk);
+        std::vector<uint8_t> resp = Command(FMSTR_CMD_READMEM, payload, (int)chunk);
+        data.insert(data.end(), resp.begin(), resp.end());
+        addr += chunk;
+        size -= chunk;
+    }
+    return data;
+}
+
+std::string FmstrClient::ReadString(uint32_t addr)
+{
+    std::vector<uint8_t> payload;
+    size_t pos = 0;
+
+    if (addr == 0U)
+    {
+        return std::string();
+    }
+    FmstrPutUleb(payload, addr);
+    std::vector<uint8_t> resp = Command(FMSTR_CMD_GETSTRLEN, payload);
+    uint32_t len = (uint32_t)FmstrGetUleb(resp, pos);
+    std::vector<uint8_t> text = ReadMem(addr, len);
+
+    return std::string(text.begin(), text.end());
+}
+
+const std::vector<FmstrTsaEntry> &FmstrClient::Tsa()
+{
+    if (tsaLoaded_)
+    {
+        return tsa_;
+    }
+
+    for (uint32_t table = 0;; table++)
+    {
+        std::vector<uint8_t> payload;
+        size_t pos = 1;
+
+        FmstrPutUleb(payload, table);
+        std::vector<uint8_t> resp = Command(FMSTR_CMD_GETTSAINFO, payload);
+        if (resp.empty())
+        {
+            break;
+        }
+        uint8_t flags = resp[0];
+        uint32_t tblSize = (uint32_t)FmstrGetUleb(resp, pos);
+        uint32_t tblAddr = (uint32_t)FmstrGetUleb(resp, pos);
+        if ((tblSize == 0U) || (tblAddr == 0U))
+        {
+            break;
+        }
+
+        unsigned width = 4U;
+        if ((flags & FMSTR_TSA_INFO_SIZE_MASK) == FMSTR_TSA_INFO_ADRSIZE_16)
+        {
+            width = 2U;
+        }
+        else if ((flags & FMSTR_TSA_INFO_SIZE_MASK) == FMSTR_TSA_INFO_ADRSIZE_64)
+        {
+            /* host build of the driver, its data must sit below 4 GiB (link with -no-pie) */
+            width = 8U;
+        }
+        std::vector<uint8_t> raw = ReadMem(tblAddr, tblSize);
+        auto field = [&raw, width](size_t offset) {
+            uint64_t v = 0;
+
+            for (unsigned i = 0; i < width; i++)
+            {
+                v |= (uint64_t)raw[offset + i] << (8U * i);
+            }
+            return (uint32_t)v;
+        };
+
+        for (size_t e = 0; e + 4U * width <= raw.size(); e += 4U * width)
+        {
+            uint32_t info = field(e + 3U * width);
+            FmstrTsaEntry entry;
+
+            entry.name = ReadString(field(e));
+            entry.type = ReadString(field(e + width));
+            entry.addr = field(e + 2U * width);
+            entry.size = info >> 2;
+            entry.entryType = (uint8_t)(info & FMSTR_TSA_INFO_ENTRYTYPE_MASK);
+            tsa_.push_back(entry);
+        }
+    }
+    tsaLoaded_ = true;
+    return tsa_;
+}
+
+FmstrVariable FmstrClient::Resolve(const std::string &path)
+{
+    const std::vector<FmstrTsaEntry> &tsa = Tsa();
+    size_t end = path.find_first_of(".[");
+    std::string base = path.substr(0, end);
+    const FmstrTsaEntry *cur = nullptr;
+    uint32_t addr;
+    uint32_t size;
+    std::string type;
+
+    for (const auto &e : tsa)
+    {
+        if ((e.entryType != FMSTR_TSA_INFO_NON_VAR) && (e.name == base))
+        {
+            cur = &e;
+            break;
+        }
+    }
+    if (cur == nullptr)
+    {
+        throw FmstrError("variable " + base + " not found in TSA");
+    }
+    addr = cur->addr;
+    size = cur->size;
+    type = cur->type;
+
+    /* size of one element of the current type, base types encode it, structures have an entry */
+    auto elementSize = [&tsa](const std::string &t, uint32_t whole) -> uint32_t {
+        if (!t.empty() && (((uint8_t)t[0] & 0xE0U) == 0xE0U) && (t[0] != FMSTR_TSA_SPECIAL_NOMEM))
+        {
+            return 1U << ((uint8_t)t[0] & 0x03U);
+        }
+        for (const auto &e : tsa)
+        {
+            if ((e.type == FMSTR_TSA_STRUCT_TYPE) && (e.name == t))
+            {
+                return e.size;
+            }
+        }
+        return whole;
+    };
+
+    while (end != std::string::npos)
+    {
+        if (path[end] == '[')
+        {
+            size_t close = path.find(']', end);
+            uint32_t index = (uint32_t)std::stoul(path.substr(end + 1U, close - end - 1U));
+            uint32_t elem = elementSize(type, size);
+
+            if ((close == std::string::npos) || ((index + 1U) * elem > size))
+            {
+                throw FmstrError("bad index in " + path);
+            }
+            addr += index * elem;
+            size = elem;
+            end = path.find_first_of(".[", close + 1U);
+            continue;
+        }
+
+        size_t next = path.find_first_of(".[", end + 1U);
+        std::string member = path.substr(end + 1U, next - end - 1U);
+        bool found = false;
+
+        /* members follow the FMSTR_TSA_STRUCT entry of the type, offsets in addr */
+        for (size_t i = 0; (i < tsa.size()) && !found; i++)
+        {
+            if ((tsa[i].type != FMSTR_TSA_STRUCT_TYPE) || (tsa[i].name != type))
+            {
+                continue;
+            }
+            for (size_t m = i + 1U; m < tsa.size(); m++)
+            {
+                const FmstrTsaEntry &e = tsa[m];
+
+                if ((e.entryType != FMSTR_TSA_INFO_NON_VAR) || (!e.type.empty() && (e.type[0] == FMSTR_TSA_SPECIAL_NOMEM)))
+                {
+                    break;
+                }
+                if (e.name == member)
+                {
+                    addr += e.addr;
+                    size = e.size;
+                    type = e.type;
+                    found = true;
+                    break;
+                }
+            }
+        }
+        if (!found)
+        {
+            throw FmstrError("member " + member + " of " + type + " not found in TSA");
+        }
+        end = next;
+    }
+
+    FmstrVariable var;
+    var.name = path;
+    var.addr = addr;
+    var.size = (uint8_t)size;
+    if ((size != 1U) && (size != 2U) && (size != 4U) && (size != 8U))
+    {
+        throw FmstrError(path + " is not a scalar (" + std::to_string(size) + " bytes)");
+    }
+    if (!type.empty() && (((uint8_t)type[0] & 0xE0U) == 0xE0U))
+    {
+        uint8_t code = (uint8_t)type[0];
+        uint8_t tt = (code >> 2) & 0x03U;
+
+        if (tt == 2U)
+        {
+            var.kind = FmstrKind::Float;
+        }
+        else if (tt != 3U)
+        {
+            var.kind = ((code & 0x10U) != 0U) ? FmstrKind::Signed : FmstrKind::Unsigned;
+        }
+    }
+    return var;
+}
+
+void FmstrClient::Lock(uint8_t feature, uint8_t instance)
+{
+    std::vector<uint8_t> response;
+    uint8_t status;
+
+    if (!locked_.insert((uint16_t)((feature << 8) | instance)).second)
+    {
+        return;
+    }
+    status = link_.Transact(FMSTR_CMD_FEATLOCK, {feature, instance, 1}, 0, response);
+    if (status == FMSTR_STC_SERVBUSY)
+    {
+        throw FmstrError("instance " + std::to_string(instance) + " is used by another connection");
+    }
+    if (((status & FMSTR_STSF_ERROR) != 0U) && (status != FMSTR_STC_INVCMD))
+    {
+        throw FmstrError(Describe(FMSTR_CMD_FEATLOCK, status));
+    }
+}
+
+void FmstrClient::SetupScope(uint8_t scope, const std::vector<FmstrVariable> &vars)
+{
+    std::vector<uint8_t> payload = {scope, FMSTR_SCOPE_PRTCLSET_OP_CFGMEM, 1, (uint8_t)vars.size()};
+
+    Lock(FMSTR_FEATURE_SCOPE, scope);
+
+    for (size_t i = 0; i < vars.size(); i++)
+    {
+        std::vector<uint8_t> op = {(uint8_t)i};
+
+        FmstrPutUleb(op, vars[i].addr);
+        op.push_back(vars[i].size);
+        payload.push_back(FMSTR_SCOPE_PRTCLSET_OP_CFGVAR);
+        payload.push_back((uint8_t)op.size());
+        payload.insert(payload.end(), op.begin(), op.end());
+    }
+    Command(FMSTR_CMD_SETSCOPE, payload, 0);
+}
+
+std::vector<uint8_t> FmstrClient::ReadScope(uint8_t scope, uint32_t totalSize)
+{
+    return Command(FMSTR_CMD_READSCOPE, {scope}, (int)totalSize);
+}
+
+FmstrRecLimits FmstrClient::RecorderLimits(uint8_t rec)
+{
+    std::vector<uint8_t> resp = Command(FMSTR_CMD_GETREC, {rec, FMSTR_REC_PRTCLGET_OP_LIMITS});
+    FmstrRecLimits limits;
+    size_t pos = 0;
+
+    limits.buffSize = (uint32_t)FmstrGetUleb(resp, pos);
+    limits.basePeriodNs = (uint32_t)FmstrGetUleb(resp, pos);
+    limits.recStructSize = (uint32_t)FmstrGetUleb(resp, pos);
+    limits.varStructSize = (uint32_t)FmstrGetUleb(resp, pos);
+    return limits;
+}
+
+void FmstrClient::SetupRecorder(uint8_t rec, const std::vector<FmstrVariable> &vars, uint32_t points)
+{
+    std::vector<uint8_t> payload = {rec};
+    std::vector<uint8_t> mem = {(uint8_t)vars.size()};
+
+    Lock(FMSTR_FEATURE_REC, rec);
+    FmstrPutUleb(mem, points);
+    FmstrPutUleb(mem, 0); /* no pre-trigger, the host stops the recorder */
+    FmstrPutUleb(mem, 0); /* every sample */
+    payload.push_back(FMSTR_REC_PRTCLSET_OP_CFGMEM);
+    payload.push_back((uint8_t)mem.size());
+    payload.insert(payload.end(), mem.begin(), mem.end());
+
+    for (size_t i = 0; i < vars.size(); i++)
+    {
+        std::vector<uint8_t> op = {(uint8_t)i};
+
+        FmstrPutUleb(op, vars[i].addr);
+        op.push_back(vars[i].size);
+        op.push_back(0); /* no trigger */
+        FmstrPutUleb(op, 0); /* constant threshold, unused */
+        payload.push_back(FMSTR_REC_PRTCLSET_OP_CFGVAR);
+        payload.push_back((uint8_t)op.size());
+        payload.insert(payload.end(), op.begin(), op.end());
+    }
+    Command(FMSTR_CMD_SETREC, payload, 0);
+}
+
+void FmstrClient::StartRecorder(uint8_t rec)
+{
+    Command(FMSTR_CMD_SETREC, {rec, FMSTR_REC_PRTCLSET_OP_START, 0}, 0);
+}
+
+void FmstrClient::StopRecorder(uint8_t rec)
+{
+    Command(FMSTR_CMD_SETREC, {rec, FMSTR_REC_PRTCLSET_OP_STOP, 0}, 0);
+}
+
+FmstrRecInfo FmstrClient::RecorderInfo(uint8_t rec)
+{
+    std::vector<uint8_t> resp = Command(FMSTR_CMD_GETREC, {rec, FMSTR_REC_PRTCLGET_OP_INFO});
+    FmstrRecInfo info;
+    size_t pos = 2;
+
+    if (resp.size() < 2U)
+    {
+        throw FmstrError("short recorder info");
+    }
+    info.status = resp[0];
+    info.varCount = resp[1];
+    info.buffAddr = (uint32_t)FmstrGetUleb(resp, pos);
+    info.pointSize = (uint32_t)FmstrGetUleb(resp, pos);
+    info.pointCount = (uint32_t)FmstrGetUleb(resp, pos);
+    info.firstPoint = (uint32_t)FmstrGetUleb(resp, pos);
+    return info;
+}
+
+void FmstrClient::PipeReceive(uint8_t port, std::vector<uint8_t> &data)
+{
+    bool &odd = pipeOdd_[port];
+    uint8_t &ack = pipeAck_[port];
+    std::vector<uint8_t> resp;
+
+    Lock(FMSTR_FEATURE_PIPE, port);
+
+    /* the parity bit tells a new request from a repeated one, a repeat returns the same data */
+    resp = Command(FMSTR_CMD_PIPE, {(uint8_t)(port | (odd ? 0x80U : 0U)), ack});
+    if (resp.size() < 2U)
+    {
+        throw FmstrError("short pipe response");
+    }
+    data.assign(resp.begin() + 2, resp.end());
+    ack = (uint8_t)data.size();
+    odd = !odd;
+}
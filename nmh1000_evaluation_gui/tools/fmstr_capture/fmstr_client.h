@@ -0,0 +1,147 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file  fmstr_client.h
+ * @brief The fmstr_client.h file declares the FreeMASTER protocol commands used by fmstr_capture.
+ *
+ * @details Covers board configuration, memory reads, TSA symbol resolution and the scope, recorder
+ *          and pipe commands as decoded by freemaster_protocol.c, freemaster_scope.c,
+ *          freemaster_rec.c and freemaster_pipes.c. Numbers travel as (U|S)LEB128.
+ */
+
+#ifndef FMSTR_CLIENT_H_
+#define FMSTR_CLIENT_H_
+
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "fmstr_link.h"
+
+/*! @brief Numeric encoding of a variable, from the TSA base type code "111STTZZ". */
+enum class FmstrKind
+{
+    Unsigned,
+    Signed,
+    Float,
+    Raw
+};
+
+/*! @brief A resolved variable: target address, size and how to decode it. */
+struct FmstrVariable
+{
+    std::string name;
+    uint32_t addr = 0;
+    uint8_t size = 0;
+    FmstrKind kind = FmstrKind::Raw;
+
+    /*! @brief Decode one little-endian value to text. */
+    std::string Format(const uint8_t *data) const;
+};
+
+/*! @brief One entry of the target TSA tables. */
+struct FmstrTsaEntry
+{
+    std::string name;
+    std::string type;
+    uint32_t addr;
+    uint32_t size;
+    uint8_t entryType; /* FMSTR_TSA_INFO_xxx */
+};
+
+/*! @brief Recorder buffer state as reported by the INFO operation. */
+struct FmstrRecInfo
+{
+    uint8_t status;      /* 0 not configured, 1 stopped without data, 2 running, 3 stopped partly filled, 4 full */
+    uint8_t varCount;
+    uint32_t buffAddr;
+    uint32_t pointSize;
+    uint32_t pointCount; /* points stored */
+    uint32_t firstPoint; /* index of the oldest point in the circular buffer */
+};
+
+/*! @brief Recorder memory as reported by the LIMITS operation. */
+struct FmstrRecLimits
+{
+    uint32_t buffSize;
+    uint32_t basePeriodNs; /* 0 when the sampling period is unknown */
+    uint32_t recStructSize;
+    uint32_t varStructSize;
+};
+
+/*! @brief Host side of the FreeMASTER protocol on top of a serial or network link. */
+class FmstrClient
+{
+public:
+    explicit FmstrClient(FmstrLink &link);
+
+    /*! @brief Query the response buffer size and protocol version, call once after connecting.
+     *  @details Serial boards reporting FMSTR_CFG_F1_LARGE_MSG switch the link to large-message
+     *           frames, responses then grow to their LM configuration value. */
+    void Connect();
+
+    std::string ConfigString(const std::string &name);
+    uint32_t ConfigNumber(const std::string &name);
+
+    /*! @brief Read target memory, split into as many commands as the response size limit needs. */
+    std::vector<uint8_t> ReadMem(uint32_t addr, uint32_t size);
+
+    /*! @brief Read all TSA tables and their strings. */
+    const std::vector<FmstrTsaEntry> &Tsa();
+
+    /*! @brief Resolve "var", "var.member" or "var[index]" through the TSA tables. */
+    FmstrVariable Resolve(const std::string &path);
+
+    /*! @brief       Take a scope, recorder or pipe for this connection, once per instance.
+     *  @details     Boards serving several connections (FMSTR_SESSION_COUNT > 1) only let the owner
+     *               use them, single-session boards do not know the command and need no lock.
+     *  @param[in]   feature   FMSTR_FEATURE_xxx.
+     *  @param[in]   instance  scope or recorder index, or pipe port.
+     */
+    void Lock(uint8_t feature, uint8_t instance);
+
+    void SetupScope(uint8_t scope, const std::vector<FmstrVariable> &vars);
+    std::vector<uint8_t> ReadScope(uint8_t scope, uint32_t totalSize);
+
+    FmstrRecLimits RecorderLimits(uint8_t rec);
+    void SetupRecorder(uint8_t rec, const std::vector<FmstrVariable> &vars, uint32_t points);
+    void StartRecorder(uint8_t rec);
+    void StopRecorder(uint8_t rec);
+    FmstrRecInfo RecorderInfo(uint8_t rec);
+
+    /*! @brief       Fetch the bytes the target pipe has ready and acknowledge the previous ones.
+     *  @param[in]   port  pipe port.
+     *  @param[out]  data  received bytes, empty when the pipe had nothing to send.
+     */
+    void PipeReceive(uint8_t port, std::vector<uint8_t> &data);
+
+    uint32_t MaxResponse() const { return maxResponse_; }
+
+private:
+    std::vector<uint8_t> Command(uint8_t cmd, const std::vector<uint8_t> &payload, int expectedLen = FmstrLink::VarLength);
+    std::string ReadString(uint32_t addr);
+    static std::string Describe(uint8_t cmd, uint8_t status);
+
+    FmstrLink &link_;
+    uint32_t maxResponse_ = 60; /* until the MTU is known */
+    std::vector<FmstrTsaEntry> tsa_;
+    bool tsaLoaded_ = false;
+    std::map<uint8_t, bool> pipeOdd_;
+    std::map<uint8_t, uint8_t> pipeAck_;
+    std::set<uint16_t> locked_;
+};
+
+/*! @brief Append an unsigned LEB128 number. */
+void FmstrPutUleb(std::vector<uint8_t> &out, uint64_t value);
+
+/*! @brief Take an unsigned LEB128 number from the front of data, advancing pos. */
+uint64_t FmstrGetUleb(const std::vector<uint8_t> &data, size_t &pos);
+
+#endif // FMSTR_CLIENT_H_
@@ -0,0 +1,994 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file  fmstr_link.cpp
+ * @brief The fmstr_link.cpp file implements the host side of the FreeMASTER serial, network and CAN framing.
+ */
+
+#include "fmstr_link.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <linux/can/raw.h>
+#include <net/if.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "freemaster_protocol.h"
+#include "rtt_shm.h"
+
+namespace
+{
+/*! @brief FMSTR_CAN_CMDID and FMSTR_CAN_RESPID defaults of freemaster_can.h. */
+constexpr canid_t CanCmdId = 0x7AAU;
+constexpr canid_t CanRespId = 0x7AAU;
+
+/*! @brief CAN FD data lengths above 8. */
+constexpr uint8_t CanFdLengths[] = {12U, 16U, 20U, 24U, 32U, 48U, 64U};
+
+int64_t NowMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+speed_t BaudToSpeed(unsigned baud)
+{
+    switch (baud)
+    {
+        case 9600:
+            return B9600;
+        case 19200:
+            return B19200;
+        case 38400:
+            return B38400;
+        case 57600:
+            return B57600;
+        case 115200:
+            return B115200;
+        case 230400:
+            return B230400;
+        case 460800:
+            return B460800;
+        case 921600:
+            return B921600;
+        case 1000000:
+            return B1000000;
+        case 2000000:
+            return B2000000;
+        default:
+            throw FmstrError("unsupported baud rate " + std::to_string(baud));
+    }
+}
+} // namespace
+
+uint8_t FmstrCrc8(uint8_t crc, uint8_t data)
+{
+    crc ^= data;
+    for (int i = 0; i < 8; i++)
+    {
+        crc = (crc & 0x80U) ? (uint8_t)((crc << 1) ^ 0x07U) : (uint8_t)(crc << 1);
+    }
+    return crc;
+}
+
+uint16_t FmstrCrc16(uint16_t crc, uint8_t data)
+{
+    crc ^= (uint16_t)(data << 8);
+    for (int i = 0; i < 8; i++)
+    {
+        crc = (crc & 0x8000U) ? (uint16_t)((crc << 1) ^ 0x1021U) : (uint16_t)(crc << 1);
+    }
+    return crc;
+}
+
+FmstrLink::FmstrLink(const std::string &path, unsigned baud) : path_(path)
+{
+    struct termios tio;
+
+    if (path.compare(0, 4, "tcp:") == 0)
+    {
+        Connect(path.substr(4));
+        return;
+    }
+    if (path.compare(0, 4, "rtt:") == 0)
+    {
+        AttachRtt(path.substr(4));
+        return;
+    }
+    if (path.compare(0, 4, "can:") == 0)
+    {
+        OpenCan(path.substr(4), false);
+        return;
+    }
+    if (path.compare(0, 6, "canfd:") == 0)
+    {
+        OpenCan(path.substr(6), true);
+        return;
+    }
+
+    fd_ = open(path.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if (fd_ < 0)
+    {
+        throw FmstrError("cannot open " + path + ": " + std::strerror(errno));
+    }
+    if (tcgetattr(fd_, &tio) == 0)
+    {
+        cfmakeraw(&tio);
+        tio.c_cflag |= CLOCAL | CREAD;
+        tio.c_cflag &= ~(CSTOPB | CRTSCTS);
+        cfsetispeed(&tio, BaudToSpeed(baud));
+        cfsetospeed(&tio, BaudToSpeed(baud));
+        tcsetattr(fd_, TCSANOW, &tio);
+    }
+    Flush();
+}
+
+void FmstrLink::Connect(const std::string &address)
+{
+    size_t colon = address.rfind(':');
+    struct addrinfo hints = {};
+    struct addrinfo *list = nullptr;
+    int one = 1;
+
+    if (colon == std::string::npos)
+    {
+        throw FmstrError("expected tcp:HOST:PORT, got " + path_);
+    }
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    int err = getaddrinfo(address.substr(0, colon).c_str(), address.substr(colon + 1).c_str(), &hints, &list);
+    if (err != 0)
+    {
+        throw FmstrError(path_ + ": " + gai_strerror(err));
+    }
+    for (struct addrinfo *ai = list; (ai != nullptr) && (fd_ < 0); ai = ai->ai_next)
+    {
+        fd_ = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+        if ((fd_ >= 0) && (connect(fd_, ai->ai_addr, ai->ai_addrlen) != 0))
+        {
+            close(fd_);
+            fd_ = -1;
+        }
+    }
+    freeaddrinfo(list);
+    if (fd_ < 0)
+    {
+        throw FmstrError("cannot connect to " + path_ + ": " + std::strerror(errno));
+    }
+
+    /* one small request at a time, do not let Nagle hold it back */
+    setsockopt(fd_, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    fcntl(fd_, F_SETFL, fcntl(fd_, F_GETFL, 0) | O_NONBLOCK);
+    network_ = true;
+}
+
+void FmstrLink::AttachRtt(const std::string &name)
+{
+    std::string shmName = name;
+    size_t colon = name.rfind(':');
+    int fd;
+    void *map;
+
+    if (colon != std::string::npos)
+    {
+        shmName = name.substr(0, colon);
+        rttIndex_ = (unsigned)std::stoul(name.substr(colon + 1));
+    }
+    if (rttIndex_ >= RTT_SHM_MAX_BUFFERS)
+    {
+        throw FmstrError(path_ + ": RTT buffer index out of range");
+    }
+
+    fd = shm_open(shmName.c_str(), O_RDWR, 0);
+    if (fd < 0)
+    {
+        throw FmstrError("cannot open " + path_ + ": " + std::strerror(errno) + ", is the target running?");
+    }
+    map = mmap(nullptr, RTT_SHM_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+    {
+        throw FmstrError("cannot map " + path_ + ": " + std::strerror(errno));
+    }
+    rtt_ = (rtt_shm_t *)map;
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    if ((std::memcmp(rtt_->id, RTT_SHM_ID, sizeof(RTT_SHM_ID)) != 0) || (rtt_->up[rttIndex_].size == 0U) ||
+        (rtt_->down[rttIndex_].size == 0U))
+    {
+        throw FmstrError(path_ + ": no RTT buffer " + std::to_string(rttIndex_));
+    }
+
+    /* responses left over from an earlier client are not ours */
+    __atomic_store_n(&rtt_->up[rttIndex_].rdOff, __atomic_load_n(&rtt_->up[rttIndex_].wrOff, __ATOMIC_ACQUIRE),
+                     __ATOMIC_RELEASE);
+    network_ = true;
+}
+
+void FmstrLink::OpenCan(const std::string &iface, bool fd)
+{
+    struct sockaddr_can addr = {};
+    struct can_filter filter = {CanRespId, CAN_SFF_MASK | CAN_EFF_FLAG | CAN_RTR_FLAG};
+    int on = 1;
+
+    fd_ = socket(PF_CAN, SOCK_RAW | SOCK_NONBLOCK, CAN_RAW);
+    if (fd_ < 0)
+    {
+        throw FmstrError("cannot open " + path_ + ": " + std::strerror(errno));
+    }
+    setsockopt(fd_, SOL_CAN_RAW, CAN_RAW_FILTER, &filter, sizeof(filter));
+    if (fd && (setsockopt(fd_, SOL_CAN_RAW, CAN_RAW_FD_FRAMES, &on, sizeof(on)) != 0))
+    {
+        throw FmstrError(path_ + ": CAN FD frames not supported: " + std::strerror(errno));
+    }
+
+    addr.can_family = AF_CAN;
+    addr.can_ifindex = (int)if_nametoindex(iface.c_str());
+    if (addr.can_ifindex == 0)
+    {
+        throw FmstrError(path_ + ": no such interface");
+    }
+    if (bind(fd_, (struct sockaddr *)&addr, sizeof(addr)) != 0)
+    {
+        throw FmstrError("cannot bind " + path_ + ": " + std::strerror(errno));
+    }
+    can_ = true;
+    canFd_ = fd;
+    Flush();
+}
+
+size_t FmstrLink::RttRead(uint8_t *data, size_t size)
+{
+    rtt_shm_ring_t &ring = rtt_->up[rttIndex_];
+    uint32_t wrOff = __atomic_load_n(&ring.wrOff, __ATOMIC_ACQUIRE);
+    uint32_t rdOff = ring.rdOff;
+    size_t done = 0;
+
+    while ((rdOff != wrOff) && (done < size))
+    {
+        size_t chunk = std::min<size_t>(((wrOff > rdOff) ? wrOff : ring.size) - rdOff, size - done);
+
+        std::memcpy(data + done, (const uint8_t *)rtt_ + ring.offset + rdOff, chunk);
+        done += chunk;
+        rdOff = (uint32_t)((rdOff + chunk) % ring.size);
+    }
+    __atomic_store_n(&ring.rdOff, rdOff, __ATOMIC_RELEASE);
+    return done;
+}
+
+size_t FmstrLink::RttWrite(const uint8_t *data, size_t size)
+{
+    rtt_shm_ring_t &ring = rtt_->down[rttIndex_];
+    uint32_t rdOff = __atomic_load_n(&ring.rdOff, __ATOMIC_ACQUIRE);
+    uint32_t wrOff = ring.wrOff;
+    size_t avail = (rdOff > wrOff) ? (rdOff - wrOff - 1U) : (ring.size - wrOff + rdOff - 1U);
+    size_t done = 0;
+
+    /* one byte is always left free so that a full ring is not taken for an empty one */
+    while ((done < size) && (avail > 0U))
+    {
+        size_t chunk = std::min<size_t>(std::min<size_t>(size - done, avail), ring.size - wrOff);
+
+        std::memcpy((uint8_t *)rtt_ + ring.offset + wrOff, data + done, chunk);
+        done += chunk;
+        avail -= chunk;
+        wrOff = (uint32_t)((wrOff + chunk) % ring.size);
+    }
+    __atomic_store_n(&ring.wrOff, wrOff, __ATOMIC_RELEASE);
+    return done;
+}
+
+FmstrLink::~FmstrLink()
+{
+    if (fd_ >= 0)
+    {
+        close(fd_);
+    }
+    if (rtt_ != nullptr)
+    {
+        munmap(rtt_, RTT_SHM_SIZE);
+    }
+}
+
+uint8_t FmstrLink::Transact(uint8_t cmd, const std::vector<uint8_t> &payload, int expectedLen,
+                            std::vector<uint8_t> &response)
+{
+    for (int attempt = 0; attempt < attempts_; attempt++)
+    {
+        uint8_t status = 0;
+
+        if (attempt > 0)
+        {
+            stats_.retries++;
+            Flush();
+        }
+        Rx rx;
+
+        if (network_)
+        {
+            SendNetFrame(cmd, payload);
+            rx = ReceiveNetFrame(status, response);
+        }
+        else if (can_)
+        {
+            SendCanFrame(cmd, payload);
+            rx = ReceiveCanFrame(expectedLen, status, response);
+        }
+        else if (large_)
+        {
+            SendLargeFrame(cmd, payload);
+            rx = ReceiveLargeFrame(status, response);
+        }
+        else
+        {
+            SendFrame(cmd, payload);
+            rx = ReceiveFrame(expectedLen, status, response);
+        }
+        switch (rx)
+        {
+            case Rx::Ok:
+                stats_.frames++;
+                return status;
+            case Rx::Timeout:
+                stats_.timeouts++;
+                break;
+            case Rx::CrcError:
+                stats_.crcErrors++;
+                break;
+        }
+    }
+
+    char what[64];
+    std::snprintf(what, sizeof(what), "command 0x%02x: no valid response", cmd);
+    throw FmstrError(what);
+}
+
+void FmstrLink::SendFrame(uint8_t cmd, const std::vector<uint8_t> &payload)
+{
+    std::vector<uint8_t> frame;
+    uint8_t crc = 0;
+
+    if (payload.size() > 255U)
+    {
+        throw FmstrError("command payload too long");
+    }
+
+    frame.reserve(2U * payload.size() + 8U);
+    frame.push_back(FMSTR_SOB);
+    auto put = [&frame, &crc](uint8_t b, bool addCrc) {
+        if (addCrc)
+        {
+            crc = FmstrCrc8(crc, b);
+        }
+        frame.push_back(b);
+        if (b == FMSTR_SOB)
+        {
+            frame.push_back(b);
+        }
+    };
+    put(cmd, true);
+    put((uint8_t)payload.size(), true);
+    for (uint8_t b : payload)
+    {
+        put(b, true);
+    }
+    put(crc, false);
+
+    WriteAll(frame);
+}
+
+void FmstrLink::WriteAll(const std::vector<uint8_t> &frame)
+{
+    if (rtt_ != nullptr)
+    {
+        const int64_t deadline = NowMs() + timeoutMs_;
+
+        /* the target empties the down buffer on its next poll */
+        for (size_t done = 0; done < frame.size();)
+        {
+            size_t n = RttWrite(frame.data() + done, frame.size() - done);
+
+            done += n;
+            if ((n == 0U) && (NowMs() >= deadline))
+            {
+                throw FmstrError(path_ + ": RTT down buffer not read by the target");
+            }
+            if (n == 0U)
+            {
+                usleep(200);
+            }
+        }
+        stats_.txBytes += frame.size();
+        return;
+    }
+
+    for (size_t done = 0; done < frame.size();)
+    {
+        ssize_t n = write(fd_, frame.data() + done, frame.size() - done);
+
+        if (n > 0)
+        {
+            done += (size_t)n;
+            continue;
+        }
+        if ((n < 0) && (errno != EAGAIN) && (errno != EINTR))
+        {
+            throw FmstrError(path_ + ": write failed: " + std::strerror(errno));
+        }
+        struct pollfd pfd = {fd_, POLLOUT, 0};
+        poll(&pfd, 1, timeoutMs_);
+    }
+    stats_.txBytes += frame.size();
+}
+
+void FmstrLink::SendNetFrame(uint8_t cmd, const std::vector<uint8_t> &payload)
+{
+    const size_t total = payload.size() + 7U;
+    std::vector<uint8_t> frame;
+    uint8_t crc = 0;
+
+    if (payload.size() > MaxResponse())
+    {
+        throw FmstrError("command payload too long");
+    }
+
+    /* a retried command gets a new number, a late response to the old one is skipped */
+    sequence_++;
+    frame.reserve(total);
+    frame.push_back((uint8_t)(total >> 8));
+    frame.push_back((uint8_t)total);
+    frame.push_back(sequence_);
+    frame.push_back(cmd);
+    frame.push_back((uint8_t)(payload.size() >> 8));
+    frame.push_back((uint8_t)payload.size());
+    frame.insert(frame.end(), payload.begin(), payload.end());
+    for (size_t i = 3; i < frame.size(); i++)
+    {
+        crc = FmstrCrc8(crc, frame[i]);
+    }
+    frame.push_back(crc);
+
+    WriteAll(frame);
+}
+
+FmstrLink::Rx FmstrLink::ReceiveNetFrame(uint8_t &status, std::vector<uint8_t> &response)
+{
+    const int64_t deadline = NowMs() + timeoutMs_;
+
+    for (;;)
+    {
+        uint8_t header[6];
+        uint8_t crc = 0;
+        uint8_t byte;
+        size_t total;
+        size_t length;
+
+        for (uint8_t &b : header)
+        {
+            if (!ReadRaw(b, deadline))
+            {
+                return Rx::Timeout;
+            }
+        }
+        total = ((size_t)header[0] << 8) | header[1];
+        length = ((size_t)header[4] << 8) | header[5];
+        if ((total < 7U) || (total != length + 7U))
+        {
+            /* the byte stream is out of step, the caller flushes it before retrying */
+            return Rx::CrcError;
+        }
+
+        status = header[3];
+        crc = FmstrCrc8(FmstrCrc8(FmstrCrc8(crc, header[3]), header[4]), header[5]);
+        response.clear();
+        for (size_t i = 0; i <= length; i++)
+        {
+            if (!ReadRaw(byte, deadline))
+            {
+                return Rx::Timeout;
+            }
+            if (i < length)
+            {
+                crc = FmstrCrc8(crc, byte);
+                response.push_back(byte);
+            }
+        }
+
+        if (header[2] != sequence_)
+        {
+            /* response to a command that already timed out */
+            continue;
+        }
+        return (crc == byte) ? Rx::Ok : Rx::CrcError;
+    }
+}
+
+void FmstrLink::SendCanFrame(uint8_t cmd, const std::vector<uint8_t> &payload)
+{
+    const size_t header = canFd_ ? 2U : 1U;
+    const size_t maxData = canFd_ ? (CANFD_MAX_DLEN - 2U) : (CAN_MAX_DLEN - 1U);
+    std::vector<uint8_t> message;
+    uint8_t crc = 0;
+    uint8_t ctl = FMSTR_CANCTL_M2S | FMSTR_CANCTL_FST;
+
+    if (payload.size() > 255U)
+    {
+        throw FmstrError("command payload too long");
+    }
+
+    /* the serial frame without SOB and stuffing */
+    message.reserve(payload.size() + 3U);
+    message.push_back(cmd);
+    message.push_back((uint8_t)payload.size());
+    message.insert(message.end(), payload.begin(), payload.end());
+    for (uint8_t b : message)
+    {
+        crc = FmstrCrc8(crc, b);
+    }
+    message.push_back(crc);
+
+    for (size_t done = 0; done < message.size();)
+    {
+        struct canfd_frame frame = {};
+        size_t len = std::min(maxData, message.size() - done);
+
+        if (done + len == message.size())
+        {
+            ctl |= FMSTR_CANCTL_LST;
+        }
+        frame.can_id = CanCmdId;
+        frame.data[0] = canFd_ ? ctl : (uint8_t)(ctl | len);
+        frame.data[1] = (uint8_t)len;
+        std::memcpy(&frame.data[header], &message[done], len);
+        frame.len = (uint8_t)(header + len);
+        if (canFd_ && (frame.len > CAN_MAX_DLEN))
+        {
+            /* padded up to the next FD length */
+            frame.len = *std::lower_bound(std::begin(CanFdLengths), std::end(CanFdLengths), frame.len);
+        }
+        WriteCan(frame);
+
+        /* next frames: FST cleared and TGL toggled */
+        done += len;
+        ctl = (uint8_t)((ctl & ~FMSTR_CANCTL_FST) ^ FMSTR_CANCTL_TGL);
+    }
+}
+
+void FmstrLink::WriteCan(struct canfd_frame &frame)
+{
+    const size_t mtu = canFd_ ? CANFD_MTU : CAN_MTU;
+
+    if (canFd_)
+    {
+        frame.flags = CANFD_BRS;
+    }
+    for (;;)
+    {
+        ssize_t n = write(fd_, &frame, mtu);
+
+        if (n == (ssize_t)mtu)
+        {
+            break;
+        }
+        if ((n < 0) && (errno != EAGAIN) && (errno != ENOBUFS) && (errno != EINTR))
+        {
+            throw FmstrError(path_ + ": write failed: " + std::strerror(errno));
+        }
+        /* the interface queue is full, ENOBUFS is not reported through poll() */
+        usleep(200);
+    }
+    stats_.txBytes += frame.len;
+}
+
+bool FmstrLink::ReadCan(struct canfd_frame &frame, int64_t deadlineMs)
+{
+    for (;;)
+    {
+        int64_t left = deadlineMs - NowMs();
+        struct pollfd pfd = {fd_, POLLIN, 0};
+        ssize_t n;
+
+        if (left <= 0)
+        {
+            return false;
+        }
+        if (poll(&pfd, 1, (int)left) <= 0)
+        {
+            continue;
+        }
+        n = read(fd_, &frame, sizeof(frame));
+        if ((n == (ssize_t)CAN_MTU) || (n == (ssize_t)CANFD_MTU))
+        {
+            stats_.rxBytes += frame.len;
+            return true;
+        }
+        if ((n < 0) && (errno != EAGAIN) && (errno != EINTR))
+        {
+            throw FmstrError(path_ + ": read failed: " + std::strerror(errno));
+        }
+    }
+}
+
+FmstrLink::Rx FmstrLink::ReceiveCanFrame(int expectedLen, uint8_t &status, std::vector<uint8_t> &response)
+{
+    const int64_t deadline = NowMs() + timeoutMs_;
+    const size_t header = canFd_ ? 2U : 1U;
+    std::vector<uint8_t> message;
+    bool started = false;
+    uint8_t tgl = 0;
+
+    /* reassemble the message up to the frame marked last */
+    for (;;)
+    {
+        struct canfd_frame frame;
+        uint8_t ctl;
+        size_t len;
+
+        if (!ReadCan(frame, deadline))
+        {
+            return Rx::Timeout;
+        }
+        ctl = frame.data[0];
+        if ((frame.len < header) || ((ctl & FMSTR_CANCTL_M2S) != 0U))
+        {
+            /* a command of another client */
+            continue;
+        }
+        if ((ctl & FMSTR_CANCTL_FST) != 0U)
+        {
+            started = true;
+            tgl = 0;
+            message.clear();
+        }
+        if (!started)
+        {
+            continue;
+        }
+        if ((ctl & FMSTR_CANCTL_TGL) != tgl)
+        {
+            return Rx::CrcError;
+        }
+        tgl ^= FMSTR_CANCTL_TGL;
+
+        len = canFd_ ? frame.data[1] : (size_t)(ctl & FMSTR_CANCTL_LEN_MASK);
+        if (header + len > frame.len)
+        {
+            return Rx::CrcError;
+        }
+        message.insert(message.end(), &frame.data[header], &frame.data[header + len]);
+        if ((ctl & FMSTR_CANCTL_LST) != 0U)
+        {
+            break;
+        }
+    }
+
+    /* status, [length], data and CRC as on serial links */
+    uint8_t crc = 0;
+    size_t pos = 1;
+    size_t length;
+
+    if (message.size() < 2U)
+    {
+        return Rx::CrcError;
+    }
+    status = message[0];
+    if ((status & FMSTR_STSF_VARLEN) != 0U)
+    {
+        length = message[pos++];
+    }
+    else if ((status & FMSTR_STSF_ERROR) != 0U)
+    {
+        length = 0U;
+    }
+    else
+    {
+        length = (expectedLen > 0) ? (size_t)expectedLen : 0U;
+    }
+    if (message.size() != pos + length + 1U)
+    {
+        return Rx::CrcError;
+    }
+    for (size_t i = 0; i < message.size() - 1U; i++)
+    {
+        crc = FmstrCrc8(crc, message[i]);
+    }
+    response.assign(message.begin() + (ptrdiff_t)pos, message.end() - 1);
+    return (crc == message.back()) ? Rx::Ok : Rx::CrcError;
+}
+
+FmstrLink::Rx FmstrLink::ReceiveFrame(int expectedLen, uint8_t &status, std::vector<uint8_t> &response)
+{
+    const int64_t deadline = NowMs() + timeoutMs_;
+    bool start;
+    uint8_t byte;
+
+    /* Unescaped stream: start is set when the byte follows a single SOB */
+    auto next = [&](bool &isStart, uint8_t &b) -> bool {
+        if (!ReadRaw(b, deadline))
+        {
+            return false;
+        }
+        isStart = false;
+        if (b != FMSTR_SOB)
+        {
+            return true;
+        }
+        if (!ReadRaw(b, deadline))
+        {
+            return false;
+        }
+        isStart = (b != FMSTR_SOB);
+        return true;
+    };
+
+    /* skip anything up to the start of a frame */
+    do
+    {
+        if (!next(start, byte))
+        {
+            return Rx::Timeout;
+        }
+    } while (!start);
+
+    for (;;)
+    {
+        uint8_t crc = FmstrCrc8(0, byte);
+        size_t length;
+        bool restarted = false;
+
+        status = byte;
+        response.clear();
+        if ((status & FMSTR_STSF_VARLEN) != 0U)
+        {
+            if (!next(start, byte))
+            {
+                return Rx::Timeout;
+            }
+            if (start)
+            {
+                continue;
+            }
+            crc = FmstrCrc8(crc, byte);
+            length = byte;
+        }
+        else if ((status & FMSTR_STSF_ERROR) != 0U)
+        {
+            length = 0U;
+        }
+        else
+        {
+            length = (expectedLen > 0) ? (size_t)expectedLen : 0U;
+        }
+
+        /* data bytes and the CRC */
+        for (size_t i = 0; i <= length; i++)
+        {
+            if (!next(start, byte))
+            {
+                return Rx::Timeout;
+            }
+            if (start)
+            {
+                /* a new frame started, the previous one was cut short */
+                restarted = true;
+                break;
+            }
+            if (i < length)
+            {
+                crc = FmstrCrc8(crc, byte);
+                response.push_back(byte);
+            }
+        }
+        if (restarted)
+        {
+            continue;
+        }
+
+        return (crc == byte) ? Rx::Ok : Rx::CrcError;
+    }
+}
+
+void FmstrLink::SendLargeFrame(uint8_t cmd, const std::vector<uint8_t> &payload)
+{
+    std::vector<uint8_t> frame;
+    uint16_t crc = 0xFFFFU;
+
+    if (payload.size() > 0xFFF0U)
+    {
+        throw FmstrError("command payload too long");
+    }
+
+    frame.reserve(2U * payload.size() + 12U);
+    frame.push_back(FMSTR_SOB);
+    frame.push_back(FMSTR_SERIAL_LARGE);
+    auto put = [&frame, &crc](uint8_t b, bool addCrc) {
+        if (addCrc)
+        {
+            crc = FmstrCrc16(crc, b);
+        }
+        frame.push_back(b);
+        if (b == FMSTR_SOB)
+        {
+            frame.push_back(b);
+        }
+    };
+    put(cmd, true);
+    put((uint8_t)(payload.size() >> 8), true);
+    put((uint8_t)payload.size(), true);
+    for (uint8_t b : payload)
+    {
+        put(b, true);
+    }
+    put((uint8_t)(crc >> 8), false);
+    put((uint8_t)crc, false);
+
+    WriteAll(frame);
+}
+
+FmstrLink::Rx FmstrLink::ReceiveLargeFrame(uint8_t &status, std::vector<uint8_t> &response)
+{
+    const int64_t deadline = NowMs() + timeoutMs_;
+    bool start;
+    uint8_t byte;
+
+    /* Unescaped stream as in ReceiveFrame */
+    auto next = [&](bool &isStart, uint8_t &b) -> bool {
+        if (!ReadRaw(b, deadline))
+        {
+            return false;
+        }
+        isStart = false;
+        if (b != FMSTR_SOB)
+        {
+            return true;
+        }
+        if (!ReadRaw(b, deadline))
+        {
+            return false;
+        }
+        isStart = (b != FMSTR_SOB);
+        return true;
+    };
+
+    do
+    {
+        if (!next(start, byte))
+        {
+            return Rx::Timeout;
+        }
+    } while (!start);
+
+    for (;;)
+    {
+        /* status, 16-bit length, data and the CRC16, all of them added, a valid frame leaves 0 */
+        uint16_t crc = FmstrCrc16(0xFFFFU, byte);
+        uint8_t header[2];
+        size_t length = 0U;
+        bool restarted = false;
+
+        status = byte;
+        response.clear();
+        for (size_t i = 0; i < 2U + length + 2U; i++)
+        {
+            if (!next(start, byte))
+            {
+                return Rx::Timeout;
+            }
+            if (start)
+            {
+                /* a new frame started, the previous one was cut short */
+                restarted = true;
+                break;
+            }
+            crc = FmstrCrc16(crc, byte);
+            if (i < 2U)
+            {
+                header[i] = byte;
+                length = (i == 1U) ? (((size_t)header[0] << 8) | header[1]) : 0U;
+            }
+            else if (i < 2U + length)
+            {
+                response.push_back(byte);
+            }
+        }
+        if (restarted)
+        {
+            continue;
+        }
+
+        return (crc == 0U) ? Rx::Ok : Rx::CrcError;
+    }
+}
+
+bool FmstrLink::ReadRaw(uint8_t &byte, int64_t deadlineMs)
+{
+    while ((rxHead_ == rxTail_) && (rtt_ != nullptr))
+    {
+        size_t n = RttRead(rxBuf_, sizeof(rxBuf_));
+
+        if (n > 0U)
+        {
+            rxHead_ = 0;
+            rxTail_ = n;
+            stats_.rxBytes += n;
+        }
+        else if (NowMs() >= deadlineMs)
+        {
+            return false;
+        }
+        else
+        {
+            /* a probe polls the target memory too, 200 us keeps the round trip short */
+            usleep(200);
+        }
+    }
+    while (rxHead_ == rxTail_)
+    {
+        int64_t left = deadlineMs - NowMs();
+        struct pollfd pfd = {fd_, POLLIN, 0};
+        ssize_t n;
+
+        if (left <= 0)
+        {
+            return false;
+        }
+        if (poll(&pfd, 1, (int)left) <= 0)
+        {
+            continue;
+        }
+        n = read(fd_, rxBuf_, sizeof(rxBuf_));
+        if (n > 0)
+        {
+            rxHead_ = 0;
+            rxTail_ = (size_t)n;
+            stats_.rxBytes += (uint64_t)n;
+        }
+        else if ((n < 0) && (errno != EAGAIN) && (errno != EINTR))
+        {
+            throw FmstrError(path_ + ": read failed: " + std::strerror(errno));
+        }
+        else if ((n == 0) && network_)
+        {
+            throw FmstrError(path_ + ": connection closed by the board");
+        }
+        else if (n == 0)
+        {
+            /* PTY master closed, wait for the stand-in to come back */
+            usleep(1000);
+        }
+    }
+    byte = rxBuf_[rxHead_++];
+    return true;
+}
+
+void FmstrLink::Flush()
+{
+    uint8_t scratch[256];
+
+    rxHead_ = rxTail_ = 0;
+    if (rtt_ != nullptr)
+    {
+        while (RttRead(scratch, sizeof(scratch)) > 0U)
+        {
+        }
+        return;
+    }
+    while (read(fd_, scratch, sizeof(scratch)) > 0)
+    {
+    }
+}
@@ -0,0 +1,160 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file  fmstr_link.h
+ * @brief The fmstr_link.h file declares the host side of the FreeMASTER serial, network and CAN framing.
+ *
+ * @details Serial links mirror freemaster_serial.c: a command goes out as SOB, command, length,
+ *          data and CRC8, a response comes back as SOB, status, [length], data and CRC8. Every SOB
+ *          byte inside a frame is sent twice. The length byte is only present when the status has
+ *          FMSTR_STSF_VARLEN set, other successful responses carry as many bytes as the command
+ *          asked for and error responses carry none. Any character device can be used, a PTY works
+ *          as well as a USB serial port. Boards built with FMSTR_SERIAL_LARGE_MSG also take
+ *          large-message frames (EnableLargeFrames): SOB, FMSTR_SERIAL_LARGE, command, 16-bit
+ *          big-endian length, data and CRC16, answered by SOB, status, 16-bit length, data and
+ *          CRC16 whatever the status.
+ *
+ *          Network links mirror freemaster_net.c over TCP: both directions use a 16-bit big-endian
+ *          total length, sequence number, command or status, 16-bit data length, data and CRC8.
+ *          The response repeats the sequence number of its command.
+ *
+ *          RTT links carry the network framing through the up and down ring buffers of an RTT
+ *          control block. On the host the block is the shared memory stand-in of rtt_shm.h; the
+ *          link plays the debug probe, the board RTT builds need a probe-side RTT server instead.
+ *
+ *          CAN links mirror freemaster_can.c on a SocketCAN interface: the serial message without
+ *          SOB stuffing is cut into frames, each starting with a control byte (FMSTR_CANCTL_xxx).
+ *          Classic frames carry up to 7 message bytes with their count in the control byte, CAN FD
+ *          frames (canfd:) a length byte and up to 62 message bytes, padded to a valid FD length.
+ *          Commands and responses share the FMSTR_CAN_CMDID/RESPID default 0x7AA and are told
+ *          apart by the FMSTR_CANCTL_M2S bit.
+ */
+
+#ifndef FMSTR_LINK_H_
+#define FMSTR_LINK_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <linux/can.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/*! @brief Link or protocol failure, the message names the command and the reason. */
+class FmstrError : public std::runtime_error
+{
+public:
+    explicit FmstrError(const std::string &what) : std::runtime_error(what) {}
+};
+
+/*! @brief Frame and byte counters of one link. */
+struct FmstrLinkStats
+{
+    uint64_t txBytes = 0;
+    uint64_t rxBytes = 0;
+    uint64_t frames = 0;
+    uint64_t retries = 0;
+    uint64_t crcErrors = 0;
+    uint64_t timeouts = 0;
+};
+
+/*! @brief Serial port or TCP connection speaking the matching FreeMASTER framing. */
+class FmstrLink
+{
+public:
+    /*! @brief Response length of commands answering with FMSTR_STSF_VARLEN or an error only. */
+    static constexpr int VarLength = -1;
+
+    /*! @brief       Open the port in raw mode or connect to the board.
+     *  @param[in]   path  device, e.g. /dev/ttyACM0 or a PTY slave, tcp:HOST:PORT, rtt:NAME[:INDEX],
+     *                     can:IFACE or canfd:IFACE.
+     *  @param[in]   baud  line rate, ignored by PTYs, TCP, RTT and CAN.
+     */
+    FmstrLink(const std::string &path, unsigned baud);
+    ~FmstrLink();
+
+    FmstrLink(const FmstrLink &) = delete;
+    FmstrLink &operator=(const FmstrLink &) = delete;
+
+    /*! @brief       Send one command and wait for its response, retrying on timeouts and CRC errors.
+     *  @param[in]   cmd          FMSTR_CMD_xxx code.
+     *  @param[in]   payload      command data, at most 255 bytes on CAN and standard serial frames.
+     *  @param[in]   expectedLen  data length of a successful fixed-length response, or VarLength.
+     *  @param[out]  response     response data.
+     *  @return      response status code, FMSTR_STSF_ERROR is set for error responses.
+     */
+    uint8_t Transact(uint8_t cmd, const std::vector<uint8_t> &payload, int expectedLen, std::vector<uint8_t> &response);
+
+    const FmstrLinkStats &Stats() const { return stats_; }
+
+    /*! @brief Largest response data one frame can carry, whatever the board MTU. */
+    uint32_t MaxResponse() const { return network_ ? 0xFFF8U : (large_ ? 0xFFF0U : 254U); }
+
+    /*! @brief True for serial links, the only ones large-message frames apply to. */
+    bool IsSerial() const { return !network_ && !can_; }
+
+    /*! @brief Send commands in large-message frames, the board reports FMSTR_CFG_F1_LARGE_MSG. */
+    void EnableLargeFrames() { large_ = true; }
+
+    /*! @brief Response timeout in milliseconds, default 200. */
+    void SetTimeout(int timeoutMs) { timeoutMs_ = timeoutMs; }
+
+    /*! @brief Attempts per command, default 3. */
+    void SetAttempts(int attempts) { attempts_ = attempts; }
+
+private:
+    enum class Rx
+    {
+        Ok,
+        Timeout,
+        CrcError
+    };
+
+    void Connect(const std::string &address);
+    void AttachRtt(const std::string &name);
+    void OpenCan(const std::string &iface, bool fd);
+    size_t RttRead(uint8_t *data, size_t size);
+    size_t RttWrite(const uint8_t *data, size_t size);
+    void SendFrame(uint8_t cmd, const std::vector<uint8_t> &payload);
+    Rx ReceiveFrame(int expectedLen, uint8_t &status, std::vector<uint8_t> &response);
+    void SendLargeFrame(uint8_t cmd, const std::vector<uint8_t> &payload);
+    Rx ReceiveLargeFrame(uint8_t &status, std::vector<uint8_t> &response);
+    void SendNetFrame(uint8_t cmd, const std::vector<uint8_t> &payload);
+    Rx ReceiveNetFrame(uint8_t &status, std::vector<uint8_t> &response);
+    void SendCanFrame(uint8_t cmd, const std::vector<uint8_t> &payload);
+    Rx ReceiveCanFrame(int expectedLen, uint8_t &status, std::vector<uint8_t> &response);
+    void WriteCan(struct canfd_frame &frame);
+    bool ReadCan(struct canfd_frame &frame, int64_t deadlineMs);
+    void WriteAll(const std::vector<uint8_t> &frame);
+    bool ReadRaw(uint8_t &byte, int64_t deadlineMs);
+    void Flush();
+
+    int fd_ = -1;
+    std::string path_;
+    bool network_ = false;
+    struct rtt_shm *rtt_ = nullptr; /* mapped RTT control block, RTT links only */
+    unsigned rttIndex_ = 1;
+    bool can_ = false;
+    bool canFd_ = false; /* 64-byte CAN FD frames, can_ is set too */
+    bool large_ = false; /* serial large-message frames */
+    uint8_t sequence_ = 0;
+    int timeoutMs_ = 200;
+    int attempts_ = 3;
+    uint8_t rxBuf_[4096];
+    size_t rxHead_ = 0;
+    size_t rxTail_ = 0;
+    FmstrLinkStats stats_;
+};
+
+/*! @brief Update a FreeMASTER CRC8 (polynomial 0x07, seed 0) with one byte. */
+uint8_t FmstrCrc8(uint8_t crc, uint8_t data);
+
+/*! @brief Update a FreeMASTER CRC16 (CCITT polynomial 0x1021, seed 0xFFFF) with one byte. */
+uint16_t FmstrCrc16(uint16_t crc, uint8_t data);
+
+#endif // FMSTR_LINK_H_
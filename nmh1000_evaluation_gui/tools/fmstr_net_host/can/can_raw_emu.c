@@ -0,0 +1,260 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file  can_raw_emu.c
+ * @brief The can_raw_emu.c file implements the host emulation of a SocketCAN CAN_RAW socket.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <net/if.h>
+#include <sys/socket.h>
+#include <linux/can/raw.h>
+
+#include "can_raw_emu.h"
+
+/* Interface index if_nametoindex() gives CAN_RAW_EMU_IF */
+#define CAN_RAW_EMU_IFINDEX 7
+
+/* Frames each direction holds */
+#define CAN_RAW_EMU_QUEUE 64U
+
+/* Frames in one direction, oldest first */
+typedef struct
+{
+    struct canfd_frame frames[CAN_RAW_EMU_QUEUE];
+    bool fd[CAN_RAW_EMU_QUEUE];
+    uint32_t head;
+    uint32_t count;
+} can_raw_emu_queue_t;
+
+int __real_socket(int domain, int type, int protocol);
+int __real_setsockopt(int fd, int level, int name, const void *value, socklen_t size);
+int __real_bind(int fd, const struct sockaddr *addr, socklen_t size);
+unsigned int __real_if_nametoindex(const char *name);
+ssize_t __real_read(int fd, void *buf, size_t size);
+ssize_t __real_write(int fd, const void *buf, size_t size);
+int __real_close(int fd);
+
+static int canFd = -1; /* a /dev/null descriptor reserves the number */
+static bool canBound;
+static bool canFdFrames;
+static struct can_filter canFilter;
+static bool canFilterSet;
+static can_raw_emu_queue_t rxQueue; /* test to driver */
+static can_raw_emu_queue_t txQueue; /* driver to test */
+static int txRoom = -1;
+static can_raw_emu_stats_t canStats;
+
+static bool queue_put(can_raw_emu_queue_t *queue, const struct canfd_frame *frame, bool fd)
+{
+    uint32_t tail;
+
+    if (queue->count >= CAN_RAW_EMU_QUEUE)
+    {
+        return false;
+    }
+    tail = (queue->head + queue->count) % CAN_RAW_EMU_QUEUE;
+    queue->frames[tail] = *frame;
+    queue->fd[tail]     = fd;
+    queue->count++;
+    return true;
+}
+
+static bool queue_get(can_raw_emu_queue_t *queue, struct canfd_frame *frame, bool *fd)
+{
+    if (queue->count == 0U)
+    {
+        return false;
+    }
+    *frame      = queue->frames[queue->head];
+    *fd         = queue->fd[queue->head];
+    queue->head = (queue->head + 1U) % CAN_RAW_EMU_QUEUE;
+    queue->count--;
+    return true;
+}
+
+int __wrap_socket(int domain, int type, int protocol)
+{
+    if ((domain != PF_CAN) || ((type & ~(SOCK_NONBLOCK | SOCK_CLOEXEC)) != SOCK_RAW) || (protocol != CAN_RAW))
+    {
+        return __real_socket(domain, type, protocol);
+    }
+    if (canFd >= 0)
+    {
+        errno = EMFILE; /* one CAN socket is all the driver needs */
+        return -1;
+    }
+
+    canFd = open("/dev/null", O_RDWR);
+    if (canFd >= 0)
+    {
+        canBound     = false;
+        canFdFrames  = false;
+        canFilterSet = false;
+        memset(&rxQueue, 0, sizeof(rxQueue));
+        memset(&txQueue, 0, sizeof(txQueue));
+    }
+    return canFd;
+}
+
+int __wrap_setsockopt(int fd, int level, int name, const void *value, socklen_t size)
+{
+    if ((fd < 0) || (fd != canFd))
+    {
+        return __real_setsockopt(fd, level, name, value, size);
+    }
+
+    if ((level == SOL_CAN_RAW) && (name == CAN_RAW_FILTER) && (size == sizeof(canFilter)))
+    {
+        memcpy(&canFilter, value, sizeof(canFilter));
+        canFilterSet = true;
+        return 0;
+    }
+    if ((level == SOL_CAN_RAW) && (name == CAN_RAW_FD_FRAMES) && (size == sizeof(int)))
+    {
+        canFdFrames = (*(const int *)value != 0);
+        return 0;
+    }
+    errno = ENOPROTOOPT;
+    return -1;
+}
+
+int __wrap_bind(int fd, const struct sockaddr *addr, socklen_t size)
+{
+    const struct sockaddr_can *canAddr = (const struct sockaddr_can *)addr;
+
+    if ((fd < 0) || (fd != canFd))
+    {
+        return __real_bind(fd, addr, size);
+    }
+
+    if ((size < sizeof(*canAddr)) || (canAddr->can_family != AF_CAN) || (canAddr->can_ifindex != CAN_RAW_EMU_IFINDEX))
+    {
+        errno = ENODEV;
+        return -1;
+    }
+    canBound = true;
+    return 0;
+}
+
+unsigned int __wrap_if_nametoindex(const char *name)
+{
+    if (strcmp(name, CAN_RAW_EMU_IF) == 0)
+    {
+        return CAN_RAW_EMU_IFINDEX;
+    }
+    return __real_if_nametoindex(name);
+}
+
+ssize_t __wrap_read(int fd, void *buf, size_t size)
+{
+    struct canfd_frame frame;
+    size_t mtu;
+    bool fdFrame;
+
+    if ((fd < 0) || (fd != canFd))
+    {
+        return __real_read(fd, buf, size);
+    }
+
+    if (!canBound || !queue_get(&rxQueue, &frame, &fdFrame))
+    {
+        errno = EAGAIN;
+        return -1;
+    }
+    mtu = fdFrame ? CANFD_MTU : CAN_MTU;
+    if (size < mtu)
+    {
+        errno = EINVAL;
+        return -1;
+    }
+    memcpy(buf, &frame, mtu);
+    canStats.rxFrames++;
+    return (ssize_t)mtu;
+}
+
+ssize_t __wrap_write(int fd, const void *buf, size_t size)
+{
+    struct canfd_frame frame;
+    bool fdFrame = (size == CANFD_MTU);
+
+    if ((fd < 0) || (fd != canFd))
+    {
+        return __real_write(fd, buf, size);
+    }
+
+    /* CAN_RAW takes a whole classic frame, or an FD frame once CAN_RAW_FD_FRAMES is on */
+    if (!canBound || ((size != CAN_MTU) && !(fdFrame && canFdFrames)))
+    {
+        errno = EINVAL;
+        return -1;
+    }
+    memset(&frame, 0, sizeof(frame));
+    memcpy(&frame, buf, size);
+    if (frame.len > (fdFrame ? CANFD_MAX_DLEN : CAN_MAX_DLEN))
+    {
+        errno = EINVAL;
+        return -1;
+    }
+    if (((txRoom >= 0) && (txQueue.count >= (uint32_t)txRoom)) || !queue_put(&txQueue, &frame, fdFrame))
+    {
+        canStats.txRefused++;
+        errno = EAGAIN;
+        return -1;
+    }
+    canStats.txFrames++;
+    if (fdFrame)
+    {
+        canStats.txFdFrames++;
+    }
+    return (ssize_t)size;
+}
+
+int __wrap_close(int fd)
+{
+    if ((fd >= 0) && (fd == canFd))
+    {
+        canFd = -1;
+    }
+    return __real_close(fd);
+}
+
+bool CAN_RAW_EMU_Send(const struct canfd_frame *frame, bool fd)
+{
+    if ((canFd < 0) || (!fd && (frame->len > CAN_MAX_DLEN)))
+    {
+        return false;
+    }
+
+    /* the receive filter and the frame format decide, as in the kernel */
+    if ((fd && !canFdFrames) ||
+        (canFilterSet && (((frame->can_id ^ canFilter.can_id) & canFilter.can_mask) != 0U)))
+    {
+        canStats.rxFiltered++;
+        return true;
+    }
+    return queue_put(&rxQueue, frame, fd);
+}
+
+bool CAN_RAW_EMU_Receive(struct canfd_frame *frame, bool *fd)
+{
+    return queue_get(&txQueue, frame, fd);
+}
+
+void CAN_RAW_EMU_SetTxRoom(int frames)
+{
+    txRoom = frames;
+}
+
+const can_raw_emu_stats_t *CAN_RAW_EMU_GetStats(void)
+{
+    return &canStats;
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file  can_raw_emu.h
+ * @brief The can_raw_emu.h file declares the host emulation of a SocketCAN CAN_RAW socket.
+ *
+ * @details Stands in for the vcan interface under freemaster_can_socketcan.c where the kernel has no
+ *          AF_CAN sockets. The test binary is linked with --wrap of socket(), setsockopt(), bind(),
+ *          if_nametoindex(), read(), write() and close(); the wrappers take the one CAN socket the
+ *          driver opens and pass every other descriptor on to the C library. Like CAN_RAW the socket
+ *          applies the receive filter, delivers CAN FD frames only after CAN_RAW_FD_FRAMES and refuses
+ *          a write with EAGAIN while its transmit queue is full. The far end is the test, which plays
+ *          the FreeMASTER host through CAN_RAW_EMU_Send() and CAN_RAW_EMU_Receive().
+ */
+
+#ifndef CAN_RAW_EMU_H_
+#define CAN_RAW_EMU_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <linux/can.h>
+
+/*! @brief Interface name the emulated socket binds to, the default FMSTR_CAN_SOCKETCAN_IF. */
+#define CAN_RAW_EMU_IF "vcan0"
+
+/*! @brief Frame counters of the emulated socket. */
+typedef struct
+{
+    uint32_t rxFrames;   /*!< Frames read by the driver. */
+    uint32_t rxFiltered; /*!< Frames of the test dropped by the receive filter or the frame format. */
+    uint32_t txFrames;   /*!< Frames written by the driver, CAN FD frames included. */
+    uint32_t txFdFrames; /*!< Frames written with CANFD_MTU. */
+    uint32_t txRefused;  /*!< Writes refused with EAGAIN, the transmit queue was full. */
+} can_raw_emu_stats_t;
+
+/*! @brief       Put a frame on the bus toward the driver.
+ *  @param[in]   frame the frame, len is its data length.
+ *  @param[in]   fd    true for a CAN FD frame (CANFD_MTU), false for a classic frame (CAN_MTU, len <= 8).
+ *  @return      false when the socket is not open or the receive queue is full.
+ */
+bool CAN_RAW_EMU_Send(const struct canfd_frame *frame, bool fd);
+
+/*! @brief       Take the oldest frame the driver wrote.
+ *  @param[out]  frame the frame.
+ *  @param[out]  fd    true when it was written as a CAN FD frame.
+ *  @return      false when the driver did not write any.
+ */
+bool CAN_RAW_EMU_Receive(struct canfd_frame *frame, bool *fd);
+
+/*! @brief       Limit the transmit queue, as a bus that does not let the frames out.
+ *  @details     Test hook, writes beyond the given number of queued frames fail with EAGAIN, a negative
+ *               value removes the limit.
+ */
+void CAN_RAW_EMU_SetTxRoom(int frames);
+
+/*! @brief       Frame counters since the start of the program.
+ */
+const can_raw_emu_stats_t *CAN_RAW_EMU_GetStats(void);
+
+#endif /* CAN_RAW_EMU_H_ */
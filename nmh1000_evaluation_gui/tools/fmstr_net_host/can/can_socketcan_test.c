@@ -0,0 +1,495 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file  can_socketcan_test.c
+ * @brief The can_socketcan_test.c file checks freemaster_can_socketcan.c and the CAN FD framing.
+ *
+ * @details Plays the FreeMASTER host on the CAN_RAW emulation of can_raw_emu.c and sends requests
+ *          through the driver in the CAN FD framing of the fmstr_can_host build:
+ *
+ *          - responses of every length from 3 to 130 bytes, across the 62 message bytes of one
+ *            frame and every CAN FD data length, each frame checked for its control and length
+ *            bytes and for the padding up to the next valid data length;
+ *          - requests of 61 to 65 bytes and more, split into 64-byte CAN FD frames;
+ *          - requests in classic 8-byte frames and in a mix of both, and frames whose length byte
+ *            does not fit their data length;
+ *          - a response while the socket refuses writes, it must come complete and in order.
+ *
+ *          Each case compares the reassembled message with the expected one. Exits non-zero on the
+ *          first failure, run through "make check".
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "freemaster.h"
+#include "freemaster_protocol.h"
+#include "freemaster_can.h"
+#include "freemaster_can_socketcan.h"
+#include "can_raw_emu.h"
+
+/*! @brief Poll rounds a response may take before the case fails. */
+#define TEST_MAX_POLLS (1000)
+
+/*! @brief Message bytes of one CAN FD frame, after the control and the length byte. */
+#define TEST_FD_DATA_MAX (CANFD_MAX_DLEN - 2U)
+
+/*! @brief Message bytes of one classic frame in the CAN FD framing. */
+#define TEST_CLASSIC_DATA_MAX (CAN_MAX_DLEN - 2U)
+
+/*! @brief Largest message, the communication buffer with the command, length and checksum bytes. */
+#define TEST_MSG_MAX (FMSTR_COMM_BUFFER_SIZE + 3U)
+
+/*! @brief How the host splits a request into frames. */
+typedef enum
+{
+    kTestFrames_Fd,      /*!< 64-byte CAN FD frames. */
+    kTestFrames_Classic, /*!< Classic frames of up to 8 bytes. */
+    kTestFrames_Mixed,   /*!< The first frame CAN FD, the rest classic. */
+} test_frames_t;
+
+/*! @brief Memory the requests read and write. */
+static uint8_t testMem[512];
+
+FMSTR_TSA_TABLE_BEGIN(test_table)
+    FMSTR_TSA_RW_MEM(testMem, FMSTR_TSA_UINT8, testMem, sizeof(testMem))
+FMSTR_TSA_TABLE_END()
+
+FMSTR_TSA_TABLE_LIST_BEGIN()
+    FMSTR_TSA_TABLE(test_table)
+FMSTR_TSA_TABLE_LIST_END()
+
+/*! @brief Message of the FreeMASTER protocol on CAN, without the framing. */
+typedef struct
+{
+    uint8_t data[TEST_MSG_MAX];
+    size_t size;
+} test_msg_t;
+
+static void fail(const char *fmt, ...)
+{
+    va_list args;
+
+    va_start(args, fmt);
+    fputs("FAIL: ", stderr);
+    vfprintf(stderr, fmt, args);
+    fputc('\n', stderr);
+    va_end(args);
+    exit(1);
+}
+
+/*! @brief CRC8-CCITT of freemaster_utils.c, seed 0. */
+static uint8_t crc8(const uint8_t *data, size_t size)
+{
+    uint8_t crc = 0U;
+
+    for (size_t i = 0; i < size; i++)
+    {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++)
+        {
+            crc = (crc & 0x80U) ? (uint8_t)((crc << 1) ^ 0x07U) : (uint8_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+/*! @brief Smallest valid CAN FD data length holding size bytes. */
+static uint8_t fd_length(size_t size)
+{
+    static const uint8_t lengths[] = {12U, 16U, 20U, 24U, 32U, 48U, 64U};
+
+    if (size <= CAN_MAX_DLEN)
+    {
+        return (uint8_t)size;
+    }
+    for (size_t i = 0; i < sizeof(lengths); i++)
+    {
+        if (size <= lengths[i])
+        {
+            return lengths[i];
+        }
+    }
+    fail("no CAN FD data length holds %zu bytes", size);
+    return 0;
+}
+
+/*! @brief Request message: command, length, payload, CRC8. */
+static void msg_request(test_msg_t *msg, uint8_t cmd, const uint8_t *payload, size_t size)
+{
+    msg->data[0] = cmd;
+    msg->data[1] = (uint8_t)size;
+    memcpy(&msg->data[2], payload, size);
+    msg->data[size + 2U] = crc8(msg->data, size + 2U);
+    msg->size            = size + 3U;
+}
+
+/*! @brief Response message of a fixed-length status: status, data, CRC8. */
+static void msg_response(test_msg_t *msg, uint8_t status, const uint8_t *data, size_t size)
+{
+    msg->data[0] = status;
+    if (size > 0U)
+    {
+        memcpy(&msg->data[1], data, size);
+    }
+    msg->data[size + 1U] = crc8(msg->data, size + 1U);
+    msg->size            = size + 2U;
+}
+
+static size_t put_uleb(uint8_t *out, uint32_t value)
+{
+    size_t n = 0;
+
+    do
+    {
+        out[n] = (uint8_t)(value & 0x7FU);
+        value >>= 7;
+        if (value != 0U)
+        {
+            out[n] |= 0x80U;
+        }
+        n++;
+    } while (value != 0U);
+    return n;
+}
+
+static size_t readmem_payload(uint8_t *payload, size_t offset, size_t size)
+{
+    size_t n = put_uleb(payload, (uint32_t)(uintptr_t)&testMem[offset]);
+
+    return n + put_uleb(payload + n, (uint32_t)size);
+}
+
+static size_t writemem_payload(uint8_t *payload, size_t offset, const uint8_t *data, size_t size)
+{
+    size_t n = 0;
+
+    payload[n++] = 0U; /* flags, no mask */
+    n += put_uleb(payload + n, (uint32_t)(uintptr_t)&testMem[offset]);
+    n += put_uleb(payload + n, (uint32_t)size);
+    memcpy(payload + n, data, size);
+    return n + size;
+}
+
+/*! @brief One frame toward the driver, ctl and the length byte ahead of the data, padded for FD. */
+static void send_frame(uint8_t ctl, uint8_t len, const uint8_t *data, size_t size, bool fd)
+{
+    struct canfd_frame frame;
+
+    memset(&frame, 0, sizeof(frame));
+    frame.can_id  = FMSTR_CAN_CMDID;
+    frame.data[0] = ctl;
+    frame.data[1] = len;
+    memcpy(&frame.data[2], data, size);
+    frame.len = (uint8_t)(size + 2U);
+    if (fd)
+    {
+        frame.flags = CANFD_BRS;
+        for (; frame.len < fd_length(size + 2U); frame.len++)
+        {
+            frame.data[frame.len] = FMSTR_CAN_FD_PADDING;
+        }
+    }
+    if (!CAN_RAW_EMU_Send(&frame, fd))
+    {
+        fail("host send of a %u-byte frame", frame.len);
+    }
+}
+
+/*! @brief Split the message into frames as the host does, toggling from the first frame on. */
+static void send_message(const test_msg_t *msg, test_frames_t frames)
+{
+    uint8_t ctl = FMSTR_CANCTL_M2S | FMSTR_CANCTL_FST;
+    size_t done = 0;
+
+    while (done < msg->size)
+    {
+        bool fd    = (frames == kTestFrames_Fd) || ((frames == kTestFrames_Mixed) && (done == 0U));
+        size_t len = msg->size - done;
+
+        if (len > (fd ? TEST_FD_DATA_MAX : TEST_CLASSIC_DATA_MAX))
+        {
+            len = fd ? TEST_FD_DATA_MAX : TEST_CLASSIC_DATA_MAX;
+        }
+        if (done + len == msg->size)
+        {
+            ctl |= FMSTR_CANCTL_LST;
+        }
+        send_frame(ctl, (uint8_t)len, &msg->data[done], len, fd);
+        done += len;
+        ctl = (uint8_t)((ctl & ~FMSTR_CANCTL_FST) ^ FMSTR_CANCTL_TGL);
+    }
+}
+
+/*!
+ * @brief Poll until the driver sent a complete message, each frame checked on the way
+ *
+ * A frame is a CAN FD frame of the response identifier with bit rate switching, slave-to-master.
+ * The first frame alone has FST, the last alone LST, TGL starts clear and alternates. All frames
+ * but the last are full, and each is padded with FMSTR_CAN_FD_PADDING up to the smallest CAN FD
+ * data length holding it. Nothing may follow the message.
+ */
+static void receive_message(const char *what, test_msg_t *msg, uint32_t *frames)
+{
+    bool last = false;
+    uint8_t tgl = 0;
+
+    msg->size = 0;
+    *frames   = 0;
+    for (int i = 0; i < TEST_MAX_POLLS && !last; i++)
+    {
+        struct canfd_frame frame;
+        bool fd;
+
+        FMSTR_Poll();
+        while (!last && CAN_RAW_EMU_Receive(&frame, &fd))
+        {
+            uint8_t ctl = frame.data[0];
+            uint8_t len = frame.data[1];
+
+            if (!fd || (frame.can_id != FMSTR_CAN_RESPID) || ((frame.flags & CANFD_BRS) == 0U))
+            {
+                fail("%s: frame %u not a CAN FD frame of the response identifier", what, *frames);
+            }
+            if ((ctl & (FMSTR_CANCTL_M2S | FMSTR_CANCTL_SPC)) != 0U || ((ctl & FMSTR_CANCTL_TGL) != tgl) ||
+                (((ctl & FMSTR_CANCTL_FST) != 0U) != (*frames == 0U)))
+            {
+                fail("%s: frame %u control byte 0x%02X", what, *frames, ctl);
+            }
+            last = ((ctl & FMSTR_CANCTL_LST) != 0U);
+            if ((len == 0U) || (len > TEST_FD_DATA_MAX) || (!last && (len != TEST_FD_DATA_MAX)))
+            {
+                fail("%s: frame %u carries %u message bytes", what, *frames, len);
+            }
+            if (frame.len != fd_length(len + 2U))
+            {
+                fail("%s: frame %u of %u bytes for %u message bytes", what, *frames, frame.len, len);
+            }
+            for (uint8_t pad = (uint8_t)(len + 2U); pad < frame.len; pad++)
+            {
+                if (frame.data[pad] != FMSTR_CAN_FD_PADDING)
+                {
+                    fail("%s: frame %u padding byte %u is 0x%02X", what, *frames, pad, frame.data[pad]);
+                }
+            }
+            if (msg->size + len > sizeof(msg->data))
+            {
+                fail("%s: message longer than %zu bytes", what, sizeof(msg->data));
+            }
+            memcpy(&msg->data[msg->size], &frame.data[2], len);
+            msg->size += len;
+            tgl ^= FMSTR_CANCTL_TGL;
+            (*frames)++;
+        }
+    }
+    if (!last)
+    {
+        fail("%s: message incomplete after %u frames", what, *frames);
+    }
+    for (int i = 0; i < 10; i++)
+    {
+        struct canfd_frame frame;
+        bool fd;
+
+        FMSTR_Poll();
+        if (CAN_RAW_EMU_Receive(&frame, &fd))
+        {
+            fail("%s: frame after the last one", what);
+        }
+    }
+}
+
+/*! @brief Receive a message and compare it with the expected one, the frame count included. */
+static void expect_message(const char *what, const test_msg_t *expected)
+{
+    uint32_t expectedFrames = (uint32_t)((expected->size + TEST_FD_DATA_MAX - 1U) / TEST_FD_DATA_MAX);
+    test_msg_t msg;
+    uint32_t frames;
+
+    receive_message(what, &msg, &frames);
+    if (msg.size != expected->size || memcmp(msg.data, expected->data, msg.size) != 0)
+    {
+        fail("%s: %zu message bytes, %zu expected or content differs", what, msg.size, expected->size);
+    }
+    if (frames != expectedFrames)
+    {
+        fail("%s: %u frames instead of %u", what, frames, expectedFrames);
+    }
+}
+
+/*! @brief WRITEMEM of testMem from the given offset whose request message is exactly size bytes. */
+static size_t writemem_request_for(test_msg_t *msg, size_t offset, const uint8_t *data, size_t size)
+{
+    uint8_t payload[FMSTR_COMM_BUFFER_SIZE];
+
+    for (size_t n = size; n > 0U; n--)
+    {
+        msg_request(msg, FMSTR_CMD_WRITEMEM, payload, writemem_payload(payload, offset, data, n));
+        if (msg->size == size)
+        {
+            return n;
+        }
+    }
+    fail("no WRITEMEM request of %zu bytes", size);
+    return 0;
+}
+
+/*!
+ * @brief Responses of 3 to 130 bytes, one to three CAN FD frames of every data length
+ */
+static void test_fd_response(void)
+{
+    uint8_t payload[16];
+    test_msg_t request, response;
+    char what[48];
+
+    for (size_t size = 1; size + 2U <= 2U * TEST_FD_DATA_MAX + 6U; size++)
+    {
+        msg_request(&request, FMSTR_CMD_READMEM, payload, readmem_payload(payload, size, size));
+        msg_response(&response, FMSTR_STS_OK, &testMem[size], size);
+        send_message(&request, kTestFrames_Fd);
+        (void)snprintf(what, sizeof(what), "response of %zu bytes", response.size);
+        expect_message(what, &response);
+    }
+    printf("fd response: ok\n");
+}
+
+/*!
+ * @brief Requests around the one- and two-frame boundaries, split into CAN FD frames
+ */
+static void test_fd_request(void)
+{
+    static const size_t sizes[] = {61U, 62U, 63U, 64U, 65U, 123U, 124U, 125U, 126U, 186U, 187U};
+    uint8_t data[FMSTR_COMM_BUFFER_SIZE];
+    test_msg_t request, response;
+    char what[48];
+
+    msg_response(&response, FMSTR_STS_OK, NULL, 0);
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+    {
+        size_t n;
+
+        for (size_t j = 0; j < sizeof(data); j++)
+        {
+            data[j] = (uint8_t)(j * 29U + i * 3U + 11U);
+        }
+        n = writemem_request_for(&request, 200, data, sizes[i]);
+        send_message(&request, kTestFrames_Fd);
+        (void)snprintf(what, sizeof(what), "request of %zu bytes", sizes[i]);
+        expect_message(what, &response);
+        if (memcmp(&testMem[200], data, n) != 0)
+        {
+            fail("%s: memory not written", what);
+        }
+    }
+    printf("fd request: ok\n");
+}
+
+/*!
+ * @brief Requests in classic frames and in a mix of both, and frames whose length byte does not fit
+ */
+static void test_classic_frames(void)
+{
+    static const test_frames_t modes[] = {kTestFrames_Classic, kTestFrames_Mixed};
+    static const uint8_t over[TEST_FD_DATA_MAX];
+    uint8_t payload[FMSTR_COMM_BUFFER_SIZE];
+    uint8_t data[100];
+    test_msg_t request, response;
+
+    for (size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); m++)
+    {
+        /* a write of many frames, then a read back of more than one FD frame */
+        for (size_t i = 0; i < sizeof(data); i++)
+        {
+            data[i] = (uint8_t)(i * 17U + m * 5U + 3U);
+        }
+        msg_request(&request, FMSTR_CMD_WRITEMEM, payload, writemem_payload(payload, 300, data, sizeof(data)));
+        send_message(&request, modes[m]);
+        msg_response(&response, FMSTR_STS_OK, NULL, 0);
+        expect_message(modes[m] == kTestFrames_Classic ? "classic write" : "mixed write", &response);
+
+        msg_request(&request, FMSTR_CMD_READMEM, payload, readmem_payload(payload, 300, sizeof(data)));
+        send_message(&request, modes[m]);
+        msg_response(&response, FMSTR_STS_OK, data, sizeof(data));
+        expect_message(modes[m] == kTestFrames_Classic ? "classic read" : "mixed read", &response);
+    }
+
+    /* length bytes beyond the frame: 7 bytes in a classic frame, 62 in a 12-byte FD frame */
+    msg_response(&response, FMSTR_STC_CANMSGERR, NULL, 0);
+    send_frame(FMSTR_CANCTL_M2S | FMSTR_CANCTL_FST | FMSTR_CANCTL_LST, TEST_CLASSIC_DATA_MAX + 1U, over,
+               TEST_CLASSIC_DATA_MAX, false);
+    expect_message("classic frame overrun", &response);
+    send_frame(FMSTR_CANCTL_M2S | FMSTR_CANCTL_FST | FMSTR_CANCTL_LST, TEST_FD_DATA_MAX, over, 10U, true);
+    expect_message("fd frame overrun", &response);
+    printf("classic frames: ok\n");
+}
+
+/*!
+ * @brief A response of four frames while the socket refuses writes, then takes one frame at a time
+ */
+static void test_tx_queue_full(void)
+{
+    const can_raw_emu_stats_t *stats = CAN_RAW_EMU_GetStats();
+    uint8_t payload[16];
+    test_msg_t request, response;
+    struct canfd_frame frame;
+    uint32_t txFrames, txRefused;
+    bool fd;
+
+    msg_request(&request, FMSTR_CMD_READMEM, payload, readmem_payload(payload, 0, 200));
+    msg_response(&response, FMSTR_STS_OK, testMem, 200);
+
+    CAN_RAW_EMU_SetTxRoom(0);
+    txFrames  = stats->txFrames;
+    txRefused = stats->txRefused;
+    send_message(&request, kTestFrames_Fd);
+    for (int i = 0; i < TEST_MAX_POLLS; i++)
+    {
+        FMSTR_Poll();
+    }
+    if (CAN_RAW_EMU_Receive(&frame, &fd) || stats->txFrames != txFrames)
+    {
+        fail("queue full: frames went out while the socket refused writes");
+    }
+    if (stats->txRefused == txRefused)
+    {
+        fail("queue full: the driver did not try to send");
+    }
+
+    /* room for one frame per poll, the last frame is refused once like all others */
+    CAN_RAW_EMU_SetTxRoom(1);
+    expect_message("queue full", &response);
+    CAN_RAW_EMU_SetTxRoom(-1);
+    if (stats->txFrames - txFrames != 4U)
+    {
+        fail("queue full: %u frames written instead of 4", stats->txFrames - txFrames);
+    }
+    printf("tx queue full: ok\n");
+}
+
+int main(void)
+{
+    for (size_t i = 0; i < sizeof(testMem); i++)
+    {
+        testMem[i] = (uint8_t)(i * 7U + 1U);
+    }
+
+    FMSTR_CanSetInterface(CAN_RAW_EMU_IF);
+    if (FMSTR_Init() == FMSTR_FALSE)
+    {
+        fail("FMSTR_Init");
+    }
+
+    test_fd_response();
+    test_fd_request();
+    test_classic_frames();
+    test_tx_queue_full();
+    return 0;
+}
@@ -0,0 +1,217 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file  fmstr_net_host.c
+ * @brief The fmstr_net_host.c file runs the FreeMASTER network transport as a Linux process.
+ *
+ * @details Exercises freemaster_net.c, the protocol and the scope, recorder and pipe code of the
+ *          FRDM-MCXN947 project over loopback, without the board or an Ethernet link. A simulated
+ *          magnetic sample replaces the NMH1000 and is published under the names the board uses,
+ *          so the same host tools work against both:
+ *
+ *              ./fmstr_net_host &
+ *              fmstr_capture -d tcp:127.0.0.1:3344 -m recorder -t 10 -o out.csv registers.m_out
+ *
+ *          Several clients may be connected at once, up to FMSTR_SESSION_COUNT.
+ *
+ *          fmstr_rtt_host is the same program on the SEGGER RTT driver. The RTT control block is put
+ *          into shared memory (rtt/) and the host tool maps it in place of the debug probe:
+ *
+ *              ./fmstr_rtt_host &
+ *              fmstr_capture -d rtt:/fmstr_rtt -m scope -n 5000 -o out.csv registers.m_out
+ *
+ *          fmstr_pty_host runs the serial transport of the board UART build on a pseudo terminal,
+ *          the host tool opens the slave side it prints like the board's serial port:
+ *
+ *              ./fmstr_pty_host &
+ *              fmstr_capture -d /dev/pts/N -m recorder -t 10 -o out.csv registers.m_out
+ *
+ *          fmstr_usb_host runs the serial transport on the USB CDC driver of the board USB build. The
+ *          bulk endpoints are emulated (usb/) with a pseudo terminal as the far end, the host tool
+ *          opens it like the virtual COM port of the board. FMSTR_USB_FULL_SPEED=1 in the
+ *          environment selects 64-byte packets instead of 512:
+ *
+ *              ./fmstr_usb_host &
+ *              fmstr_capture -d /dev/pts/N -m pipe -t 10 -o out.bin
+ *
+ *          fmstr_can_host runs the CAN transport in CAN FD framing on the SocketCAN driver, on the
+ *          interface named by FMSTR_CAN_IF in the environment (vcan0 by default):
+ *
+ *              ip link add dev vcan0 type vcan && ip link set vcan0 mtu 72 up
+ *              ./fmstr_can_host &
+ *              fmstr_capture -d canfd:vcan0 -m scope -n 5000 -o out.csv registers.m_out
+ */
+
+#include <math.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "freemaster.h"
+#if HOST_USB
+#include "usb_device_descriptor.h"
+#include "usb_ep_fifo.h"
+#elif HOST_PTY
+#include "freemaster_serial_pty.h"
+#elif HOST_CAN
+#include "freemaster_can_socketcan.h"
+#endif
+
+/*! @brief Simulated sample period, matches the default sample period of the board. */
+#define HOST_SAMPLE_PERIOD_NS (1000000L)
+
+/*! @brief Pipe port streaming every sample, one byte each. */
+#define HOST_PIPE_PORT (1U)
+
+/*! @brief Subset of the board's host_io_output_vars_t with the same member names. */
+typedef struct
+{
+    uint8_t m_out;
+    uint8_t threshold;
+    uint8_t mag_switch_flag;
+} host_io_output_vars_t;
+
+host_io_output_vars_t registers = {.threshold = 50};
+
+/*! @brief Samples simulated since start-up. */
+uint32_t hostSampleCount;
+
+static FMSTR_U8 pipeRxBuff[16];
+static FMSTR_U8 pipeTxBuff[1024];
+static volatile sig_atomic_t stopRequested;
+
+FMSTR_TSA_TABLE_BEGIN(main_table)
+    FMSTR_TSA_STRUCT(host_io_output_vars_t)
+    FMSTR_TSA_MEMBER(host_io_output_vars_t, m_out, FMSTR_TSA_UINT8)
+    FMSTR_TSA_MEMBER(host_io_output_vars_t, threshold, FMSTR_TSA_UINT8)
+    FMSTR_TSA_MEMBER(host_io_output_vars_t, mag_switch_flag, FMSTR_TSA_UINT8)
+
+    FMSTR_TSA_RW_VAR(registers, FMSTR_TSA_USERTYPE(host_io_output_vars_t))
+    FMSTR_TSA_RO_VAR(hostSampleCount, FMSTR_TSA_UINT32)
+FMSTR_TSA_TABLE_END()
+
+FMSTR_TSA_TABLE_LIST_BEGIN()
+    FMSTR_TSA_TABLE(main_table)
+FMSTR_TSA_TABLE_LIST_END()
+
+static void on_signal(int sig)
+{
+    (void)sig;
+    stopRequested = 1;
+}
+
+static int64_t now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000L + ts.tv_nsec;
+}
+
+/*!
+ * @brief Produce one sample: a slow sine crossing the threshold, like a magnet passing by
+ */
+static void sample(FMSTR_HPIPE pipe)
+{
+    double phase = (double)hostSampleCount * (2.0 * M_PI / 2000.0);
+
+    registers.m_out = (uint8_t)(128.0 + 100.0 * sin(phase));
+    registers.mag_switch_flag = (registers.m_out > registers.threshold) ? 1U : 0U;
+    hostSampleCount++;
+#if FMSTR_USE_READ_CACHE > 0
+    FMSTR_ReadCacheInvalidate();
+#endif
+
+    FMSTR_Recorder(0);
+    if (pipe != NULL)
+    {
+        (void)FMSTR_PipeWrite(pipe, (FMSTR_ADDR)&registers.m_out, 1U, 0U);
+    }
+}
+
+int main(void)
+{
+    FMSTR_HPIPE pipe;
+    int64_t next;
+
+    signal(SIGINT, on_signal);
+    signal(SIGTERM, on_signal);
+
+#if HOST_USB
+    const char *port = USB_EP_FIFO_Init((getenv("FMSTR_USB_FULL_SPEED") != NULL) ? FS_CDC_VCOM_BULK_PACKET_SIZE :
+                                                                                   HS_CDC_VCOM_BULK_PACKET_SIZE);
+    if (port == NULL)
+    {
+        perror("fmstr_usb_host: pseudo terminal");
+        return 1;
+    }
+#elif HOST_CAN
+    const char *canIf = getenv("FMSTR_CAN_IF");
+
+    if (canIf != NULL)
+    {
+        FMSTR_CanSetInterface(canIf);
+    }
+#endif
+
+    if (FMSTR_Init() == FMSTR_FALSE)
+    {
+        fprintf(stderr, "fmstr_net_host: transport initialization failed\n");
+        return 1;
+    }
+    pipe = FMSTR_PipeOpen(HOST_PIPE_PORT, NULL, (FMSTR_ADDR)pipeRxBuff, sizeof(pipeRxBuff), (FMSTR_ADDR)pipeTxBuff,
+                          sizeof(pipeTxBuff), FMSTR_PIPE_TYPE_ANSI_TERMINAL, "samples");
+#if HOST_USB
+    /* Enumerated after FMSTR_Init(), as usb_link.c on the board */
+    USB_EP_FIFO_Configure();
+    fprintf(stderr, "fmstr_usb_host: CDC-ACM port %s\n", port);
+#elif HOST_PTY
+    fprintf(stderr, "fmstr_pty_host: serial port %s\n", FMSTR_SerialPtyGetName());
+#elif HOST_RTT
+    fprintf(stderr, "fmstr_rtt_host: RTT buffer %d in shared memory\n", FMSTR_NET_SEGGER_RTT_BUFFER_INDEX);
+#elif HOST_CAN
+    fprintf(stderr, "fmstr_can_host: CAN%s on %s\n", (FMSTR_CAN_FD > 0) ? " FD" : "",
+            (canIf != NULL) ? canIf : FMSTR_CAN_SOCKETCAN_IF);
+#else
+    fprintf(stderr, "fmstr_net_host: listening on 127.0.0.1:%d\n", FMSTR_NET_PORT);
+#endif
+
+    /* FMSTR_Poll() waits for the sockets up to FMSTR_NET_BLOCKING_TIMEOUT, samples catch up after it */
+    next = now_ns();
+    while (stopRequested == 0)
+    {
+#if HOST_USB
+        /* Endpoint completions come before the poll, as the USB interrupt would */
+        USB_EP_FIFO_Poll();
+#endif
+        FMSTR_Poll();
+#if HOST_RTT || HOST_USB || HOST_PTY || HOST_CAN
+        /* RTT, the endpoint emulation, the terminal and the CAN socket are polled without a wait of their own */
+        usleep(100);
+#endif
+        while (now_ns() >= next)
+        {
+            sample(pipe);
+            next += HOST_SAMPLE_PERIOD_NS;
+        }
+    }
+
+#if HOST_USB
+    {
+        const usb_ep_fifo_stats_t *stats = USB_EP_FIFO_GetStats();
+
+        fprintf(stderr, "fmstr_usb_host: OUT %u transfers in %u packets, IN %u transfers in %u packets (%u ZLP), %u busy\n",
+                stats->outTransfers, stats->outPackets, stats->inTransfers, stats->inPackets, stats->inZlps,
+                stats->busy);
+    }
+#endif
+    return 0;
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * FreeMASTER Communication Driver - User Configuration File of the host builds
+ */
+
+#ifndef __FREEMASTER_CFG_H
+#define __FREEMASTER_CFG_H
+
+////////////////////////////////////////////////////////////////////////////////
+// Definitions
+////////////////////////////////////////////////////////////////////////////////
+
+#define FMSTR_PLATFORM_CORTEX_M 1   /* Generic little-endian platform, table entries follow the host pointer size */
+
+//! Enable/Disable FreeMASTER support as a whole
+#define FMSTR_DISABLE           0   // To disable all FreeMASTER functionalities
+
+//! The driver is polled from the main loop
+#define FMSTR_LONG_INTR         0   // Complete message processing in interrupt
+#define FMSTR_SHORT_INTR        0   // Queuing done in interrupt
+#define FMSTR_POLL_DRIVEN       1   // No interrupt needed, polling only
+
+//! Select communication interface, the transports of the FRDM-MCXN947 UART, Ethernet, RTT, USB and CAN builds
+#if HOST_CAN
+#define FMSTR_TRANSPORT         FMSTR_CAN               // Use CAN transport layer
+#define FMSTR_CAN_DRV           FMSTR_CAN_SOCKETCAN     // Use SocketCAN driver, a vcan interface for testing
+#define FMSTR_CAN_FD            1                       // 64-byte CAN FD frames
+#define FMSTR_SESSION_COUNT     1                       // CAN carries one session
+
+#define FMSTR_APPLICATION_STR   "nmh1000 host can"
+#elif HOST_PTY
+#define FMSTR_TRANSPORT         FMSTR_SERIAL            // Serial framing on a pseudo terminal in place of the LPUART
+#define FMSTR_SERIAL_DRV        FMSTR_SERIAL_PTY        // Use PTY driver, the host tool opens the slave side
+#define FMSTR_USE_SERIAL_STATS  1                       // Count frames and errors
+#define FMSTR_SERIAL_LARGE_MSG  1                       // 16-bit length frames for the 1 kB buffer, as the board UART build
+#define FMSTR_SESSION_COUNT     1                       // Serial carries one session
+
+#define FMSTR_APPLICATION_STR   "nmh1000 host pty"
+#elif HOST_USB
+#define FMSTR_TRANSPORT         FMSTR_SERIAL            // Serial framing over the emulated CDC-ACM endpoints
+#define FMSTR_SERIAL_DRV        FMSTR_SERIAL_MCUX_USB   // Use USB CDC driver on the endpoint emulation (usb/)
+#define FMSTR_USE_SERIAL_STATS  1                       // Count frames and errors
+#define FMSTR_SERIAL_LARGE_MSG  1                       // 16-bit length frames for the 1 kB buffer, as the board USB build
+#define FMSTR_SESSION_COUNT     1                       // Serial carries one session
+
+#define FMSTR_APPLICATION_STR   "nmh1000 host usb"
+#elif HOST_RTT
+#define FMSTR_TRANSPORT         FMSTR_NET               // Use network transport layer
+#define FMSTR_NET_DRV           FMSTR_NET_SEGGER_RTT    // Use RTT driver on the shared memory stand-in (rtt/)
+#define FMSTR_NET_SEGGER_RTT_BUFFER_INDEX 1             // Own up and down buffers, as the board RTT builds
+#define FMSTR_NET_BLOCKING_TIMEOUT 0                    // Unused by the RTT driver
+#define FMSTR_SESSION_COUNT     1                       // RTT carries one session
+
+#define FMSTR_APPLICATION_STR   "nmh1000 host rtt"
+#else
+#define FMSTR_TRANSPORT         FMSTR_NET               // Use network transport layer
+#define FMSTR_NET_DRV           FMSTR_NET_SOCKET_TCP    // Use TCP driver for host BSD sockets
+#ifndef FMSTR_NET_PORT
+#define FMSTR_NET_PORT          3344                    // TCP port on the loopback interface
+#endif
+#define FMSTR_NET_BLOCKING_TIMEOUT 1                    // Poll waits up to 1 ms, it paces the main loop
+#define FMSTR_SESSION_COUNT     3                       // Simultaneous host connections
+#define FMSTR_USE_READ_CACHE    1                       // Shared reads per sample, as the board network build
+#define FMSTR_READ_CACHE_ENTRIES 16
+#define FMSTR_READ_CACHE_SIZE   512
+
+#define FMSTR_APPLICATION_STR   "nmh1000 host loopback"
+#endif
+
+//! Input/output communication buffer size
+#if HOST_CAN
+#define FMSTR_COMM_BUFFER_SIZE  252     // Largest response of the 8-bit frame counters
+#else
+#define FMSTR_COMM_BUFFER_SIZE  1024
+#endif
+
+//! Support for Application Commands
+#define FMSTR_USE_APPCMD        1  // Enable/disable App.Commands support
+#define FMSTR_APPCMD_BUFF_SIZE  32  // App.Command data buffer size
+#define FMSTR_MAX_APPCMD_CALLS  4   // How many app.cmd callbacks? (0=disable)
+
+//! Oscilloscope support
+#define FMSTR_USE_SCOPE         2   // Specify number of supported oscilloscopes
+#define FMSTR_MAX_SCOPE_VARS    8   // Specify maximum number of scope variables per one oscilloscope
+
+//! Recorder support
+#define FMSTR_USE_RECORDER      1   // Specify number of supported recorders
+#define FMSTR_REC_BUFF_SIZE     4096    // Built-in buffer size of recorder #0
+#define FMSTR_REC_TIMEBASE      FMSTR_REC_BASE_MILLISEC(1)  // Recorder is called once per simulated sample
+#define FMSTR_REC_FLOAT_TRIG    1   // Enable/disable floating point triggering
+
+// Target-side address translation (TSA)
+#define FMSTR_USE_TSA           1   // Enable TSA functionality
+#define FMSTR_USE_TSA_INROM     1   // TSA tables declared as const (put to ROM)
+#define FMSTR_USE_TSA_SAFETY    1   // Enable/Disable TSA memory protection
+#define FMSTR_USE_TSA_DYNAMIC   0   // Enable/Disable TSA entries to be added also in runtime
+
+// Pipes as data streaming over FreeMASTER protocol
+#define FMSTR_USE_PIPES         1   // Specify number of supported pipe objects
+
+// Enable/Disable read/write memory commands
+#define FMSTR_USE_READMEM       1   // Enable read memory commands
+#define FMSTR_USE_WRITEMEM      1   // Enable write memory commands
+#define FMSTR_USE_WRITEMEMMASK  1   // Enable write memory bits commands
+
+#endif /* __FREEMASTER_CFG_H */
+
+////////////////////////////////////////////////////////////////////////////////
+// EOF
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,211 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file  SEGGER_RTT.c
+ * @brief The SEGGER_RTT.c file implements the host stand-in of the SEGGER RTT API on shared memory.
+ */
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "SEGGER_RTT.h"
+#include "rtt_shm.h"
+
+/* Default sizes of buffer 0, BUFFER_SIZE_UP and BUFFER_SIZE_DOWN of SEGGER_RTT_Conf.h */
+#define RTT_SHM_UP0_SIZE   (1024U)
+#define RTT_SHM_DOWN0_SIZE (16U)
+
+static rtt_shm_t *rttShm;
+
+static uint8_t *rtt_data(const rtt_shm_ring_t *pRing)
+{
+    return (uint8_t *)rttShm + pRing->offset;
+}
+
+static void rtt_config(rtt_shm_ring_t *pRing, unsigned size, unsigned flags)
+{
+    /* Keep the ring of an earlier call when it is big enough, it may hold data */
+    if (pRing->size < size)
+    {
+        if (rttShm->used + size > RTT_SHM_SIZE)
+        {
+            fprintf(stderr, "SEGGER_RTT: %u byte buffer does not fit the shared memory\n", size);
+            exit(1);
+        }
+        pRing->offset = rttShm->used;
+        pRing->size = size;
+        pRing->wrOff = 0U;
+        pRing->rdOff = 0U;
+        rttShm->used += size;
+    }
+    pRing->flags = flags;
+}
+
+void SEGGER_RTT_Init(void)
+{
+    const char *name = getenv("FMSTR_RTT_SHM");
+    int fd;
+
+    if (rttShm != NULL)
+    {
+        return;
+    }
+    if (name == NULL)
+    {
+        name = RTT_SHM_DEFAULT_NAME;
+    }
+
+    /* A fresh object for every run, stale ring offsets of an earlier run are never seen */
+    (void)shm_unlink(name);
+    fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+    if ((fd < 0) || (ftruncate(fd, RTT_SHM_SIZE) != 0))
+    {
+        perror("SEGGER_RTT: shared memory");
+        exit(1);
+    }
+    rttShm = mmap(NULL, RTT_SHM_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (rttShm == MAP_FAILED)
+    {
+        perror("SEGGER_RTT: mmap");
+        exit(1);
+    }
+
+    memset(rttShm, 0, sizeof(*rttShm));
+    rttShm->used = (uint32_t)sizeof(*rttShm);
+    rtt_config(&rttShm->up[0], RTT_SHM_UP0_SIZE, SEGGER_RTT_MODE_NO_BLOCK_SKIP);
+    rtt_config(&rttShm->down[0], RTT_SHM_DOWN0_SIZE, SEGGER_RTT_MODE_NO_BLOCK_SKIP);
+
+    /* The probe looks for the identifier, publish it after the buffers */
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    memcpy(rttShm->id, RTT_SHM_ID, sizeof(RTT_SHM_ID));
+}
+
+int SEGGER_RTT_ConfigUpBuffer(unsigned BufferIndex, const char *sName, void *pBuffer, unsigned BufferSize,
+                              unsigned Flags)
+{
+    (void)sName;
+    (void)pBuffer;
+
+    SEGGER_RTT_Init();
+    if (BufferIndex >= RTT_SHM_MAX_BUFFERS)
+    {
+        return -1;
+    }
+    rtt_config(&rttShm->up[BufferIndex], (BufferIndex > 0U) ? BufferSize : 0U, Flags);
+    return 0;
+}
+
+int SEGGER_RTT_ConfigDownBuffer(unsigned BufferIndex, const char *sName, void *pBuffer, unsigned BufferSize,
+                                unsigned Flags)
+{
+    (void)sName;
+    (void)pBuffer;
+
+    SEGGER_RTT_Init();
+    if (BufferIndex >= RTT_SHM_MAX_BUFFERS)
+    {
+        return -1;
+    }
+    rtt_config(&rttShm->down[BufferIndex], (BufferIndex > 0U) ? BufferSize : 0U, Flags);
+    return 0;
+}
+
+unsigned SEGGER_RTT_Read(unsigned BufferIndex, void *pBuffer, unsigned BufferSize)
+{
+    rtt_shm_ring_t *pRing;
+    uint32_t wrOff;
+    uint32_t rdOff;
+    unsigned done = 0U;
+
+    if ((rttShm == NULL) || (BufferIndex >= RTT_SHM_MAX_BUFFERS) || (rttShm->down[BufferIndex].size == 0U))
+    {
+        return 0U;
+    }
+    pRing = &rttShm->down[BufferIndex];
+    wrOff = __atomic_load_n(&pRing->wrOff, __ATOMIC_ACQUIRE);
+    rdOff = pRing->rdOff;
+
+    while ((rdOff != wrOff) && (done < BufferSize))
+    {
+        unsigned chunk = ((wrOff > rdOff) ? wrOff : pRing->size) - rdOff;
+
+        if (chunk > BufferSize - done)
+        {
+            chunk = BufferSize - done;
+        }
+        memcpy((uint8_t *)pBuffer + done, rtt_data(pRing) + rdOff, chunk);
+        done += chunk;
+        rdOff += chunk;
+        if (rdOff == pRing->size)
+        {
+            rdOff = 0U;
+        }
+    }
+    __atomic_store_n(&pRing->rdOff, rdOff, __ATOMIC_RELEASE);
+    return done;
+}
+
+unsigned SEGGER_RTT_Write(unsigned BufferIndex, const void *pBuffer, unsigned NumBytes)
+{
+    rtt_shm_ring_t *pRing;
+    uint32_t wrOff;
+    unsigned done = 0U;
+
+    if ((rttShm == NULL) || (BufferIndex >= RTT_SHM_MAX_BUFFERS) || (rttShm->up[BufferIndex].size == 0U))
+    {
+        return 0U;
+    }
+    pRing = &rttShm->up[BufferIndex];
+    wrOff = pRing->wrOff;
+
+    while (done < NumBytes)
+    {
+        uint32_t rdOff = __atomic_load_n(&pRing->rdOff, __ATOMIC_ACQUIRE);
+        unsigned avail = (rdOff > wrOff) ? (rdOff - wrOff - 1U) : (pRing->size - wrOff + rdOff - 1U);
+        unsigned chunk;
+
+        if ((done == 0U) && (avail < NumBytes) && ((pRing->flags & SEGGER_RTT_MODE_MASK) == SEGGER_RTT_MODE_NO_BLOCK_SKIP))
+        {
+            return 0U;
+        }
+        if (avail == 0U)
+        {
+            if ((pRing->flags & SEGGER_RTT_MODE_MASK) != SEGGER_RTT_MODE_BLOCK_IF_FIFO_FULL)
+            {
+                break;
+            }
+            usleep(100);
+            continue;
+        }
+
+        /* up to the free space and the end of the ring */
+        chunk = NumBytes - done;
+        if (chunk > avail)
+        {
+            chunk = avail;
+        }
+        if (chunk > pRing->size - wrOff)
+        {
+            chunk = pRing->size - wrOff;
+        }
+        memcpy(rtt_data(pRing) + wrOff, (const uint8_t *)pBuffer + done, chunk);
+        done += chunk;
+        wrOff += chunk;
+        if (wrOff == pRing->size)
+        {
+            wrOff = 0U;
+        }
+        __atomic_store_n(&pRing->wrOff, wrOff, __ATOMIC_RELEASE);
+    }
+    return done;
+}
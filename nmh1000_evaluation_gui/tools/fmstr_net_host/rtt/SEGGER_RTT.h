@@ -0,0 +1,43 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file  SEGGER_RTT.h
+ * @brief The SEGGER_RTT.h file declares the host stand-in of the SEGGER RTT API.
+ *
+ * @details Only the calls of freemaster_net_segger_rtt.c are provided. The control block lives in
+ *          shared memory (rtt_shm.h) so that a host tool can act as the debug probe. The buffer
+ *          passed to SEGGER_RTT_ConfigUpBuffer() and SEGGER_RTT_ConfigDownBuffer() is not used,
+ *          a ring of the same size is allocated in the shared object instead.
+ */
+
+#ifndef SEGGER_RTT_H
+#define SEGGER_RTT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! @brief Buffer modes, as in SEGGER_RTT.h. */
+#define SEGGER_RTT_MODE_NO_BLOCK_SKIP       (0U) /*!< Write all or nothing. */
+#define SEGGER_RTT_MODE_NO_BLOCK_TRIM       (1U) /*!< Write what fits. */
+#define SEGGER_RTT_MODE_BLOCK_IF_FIFO_FULL  (2U) /*!< Wait for the reader. */
+#define SEGGER_RTT_MODE_MASK                (3U)
+
+void SEGGER_RTT_Init(void);
+int SEGGER_RTT_ConfigUpBuffer(unsigned BufferIndex, const char *sName, void *pBuffer, unsigned BufferSize,
+                              unsigned Flags);
+int SEGGER_RTT_ConfigDownBuffer(unsigned BufferIndex, const char *sName, void *pBuffer, unsigned BufferSize,
+                                unsigned Flags);
+unsigned SEGGER_RTT_Read(unsigned BufferIndex, void *pBuffer, unsigned BufferSize);
+unsigned SEGGER_RTT_Write(unsigned BufferIndex, const void *pBuffer, unsigned NumBytes);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SEGGER_RTT_H */
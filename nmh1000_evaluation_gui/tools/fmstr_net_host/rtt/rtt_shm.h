@@ -0,0 +1,56 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file  rtt_shm.h
+ * @brief The rtt_shm.h file defines the shared memory stand-in of the SEGGER RTT control block.
+ *
+ * @details On the board the debug probe finds the RTT control block in RAM and moves data through its
+ *          ring buffers. On the host the target process (SEGGER_RTT.c of this directory) puts the
+ *          same rings into a POSIX shared memory object and the host tool maps it in place of the
+ *          probe. Ring data is addressed by offsets from the start of the object instead of target
+ *          pointers. The writer of a ring only moves wrOff and the reader only moves rdOff, one byte
+ *          is always left free, as in SEGGER_RTT.c.
+ */
+
+#ifndef RTT_SHM_H_
+#define RTT_SHM_H_
+
+#include <stdint.h>
+
+/*! @brief Shared memory object name used when FMSTR_RTT_SHM is not set in the environment. */
+#define RTT_SHM_DEFAULT_NAME "/fmstr_rtt"
+
+/*! @brief Identifier written last by the target, a reader waits until it is there. */
+#define RTT_SHM_ID "SEGGER RTT SHM"
+
+/*! @brief Up and down buffers, SEGGER_RTT_MAX_NUM_UP_BUFFERS and ..._DOWN_BUFFERS of the default config. */
+#define RTT_SHM_MAX_BUFFERS (3U)
+
+/*! @brief Size of the object, the header followed by the ring data. */
+#define RTT_SHM_SIZE (64U * 1024U)
+
+/*! @brief One ring buffer. */
+typedef struct
+{
+    uint32_t offset; /*!< Ring data offset from the start of the object, 0 when not configured. */
+    uint32_t size;   /*!< Ring size in bytes. */
+    uint32_t wrOff;  /*!< Next byte to write, moved by the writer only. */
+    uint32_t rdOff;  /*!< Next byte to read, moved by the reader only. */
+    uint32_t flags;  /*!< SEGGER_RTT_MODE_xxx. */
+} rtt_shm_ring_t;
+
+/*! @brief Control block at the start of the object. */
+typedef struct rtt_shm
+{
+    char id[16];
+    uint32_t used; /*!< Bytes of the object taken, ring data is allocated after it. */
+    rtt_shm_ring_t up[RTT_SHM_MAX_BUFFERS];
+    rtt_shm_ring_t down[RTT_SHM_MAX_BUFFERS];
+} rtt_shm_t;
+
+#endif // RTT_SHM_H_
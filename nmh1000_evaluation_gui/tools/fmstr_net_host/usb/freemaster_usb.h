@@ -0,0 +1,21 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file  freemaster_usb.h
+ * @brief The freemaster_usb.h file sets the endpoint buffer size of freemaster_serial_usb.c, as on the board.
+ */
+
+#ifndef FREEMASTER_USB_H_
+#define FREEMASTER_USB_H_
+
+#include "usb_device_descriptor.h"
+
+/*! @brief Endpoint buffer size of freemaster_serial_usb.c, one high-speed bulk packet. */
+#define FMSTR_USB_PACKET_SIZE HS_CDC_VCOM_BULK_PACKET_SIZE
+
+#endif /* FREEMASTER_USB_H_ */
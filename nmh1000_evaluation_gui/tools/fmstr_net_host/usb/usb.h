@@ -0,0 +1,22 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file  usb.h
+ * @brief The usb.h file is the host stand-in of the MCUXpresso SDK USB stack header.
+ */
+
+#ifndef USB_H_
+#define USB_H_
+
+#include <stdint.h>
+
+/*! @brief Placement of the endpoint buffers, any host memory will do. */
+#define USB_DATA_ALIGN_SIZE           (4U)
+#define USB_DMA_NONINIT_DATA_ALIGN(n) __attribute__((aligned(n)))
+
+#endif /* USB_H_ */
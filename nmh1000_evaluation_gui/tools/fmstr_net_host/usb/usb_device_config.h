@@ -0,0 +1,16 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file  usb_device_config.h
+ * @brief The usb_device_config.h file is an empty host stand-in, freemaster_serial_usb.c needs only usb.h.
+ */
+
+#ifndef USB_DEVICE_CONFIG_H_
+#define USB_DEVICE_CONFIG_H_
+
+#endif /* USB_DEVICE_CONFIG_H_ */
@@ -0,0 +1,20 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file  usb_device_descriptor.h
+ * @brief The usb_device_descriptor.h file defines the bulk packet sizes of the emulated CDC-ACM device.
+ */
+
+#ifndef USB_DEVICE_DESCRIPTOR_H_
+#define USB_DEVICE_DESCRIPTOR_H_
+
+/*! @brief Bulk max packet size at high and full speed, as in the board's usb_device_descriptor.h. */
+#define HS_CDC_VCOM_BULK_PACKET_SIZE (512U)
+#define FS_CDC_VCOM_BULK_PACKET_SIZE (64U)
+
+#endif /* USB_DEVICE_DESCRIPTOR_H_ */
@@ -0,0 +1,194 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file  usb_ep_fifo.c
+ * @brief The usb_ep_fifo.c file implements the host emulation of the CDC-ACM bulk endpoints.
+ */
+
+#define _GNU_SOURCE /* posix_openpt() and cfmakeraw() */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "freemaster.h"
+#include "freemaster_serial_usb.h"
+#include "usb_ep_fifo.h"
+
+/* One pending transfer of an endpoint */
+typedef struct
+{
+    FMSTR_U8 *buffer;
+    uint32_t size;
+    uint32_t done;
+    bool busy;
+} usb_ep_transfer_t;
+
+static int ptyMaster = -1;
+static int ptySlave  = -1; /* kept open, the master reads EIO while no slave is open */
+static uint32_t epMaxPacket;
+static usb_ep_transfer_t epIn;
+static usb_ep_transfer_t epOut;
+static usb_ep_fifo_stats_t epStats;
+static bool epInHold;
+
+static FMSTR_BOOL usb_ep_fifo_send(FMSTR_U8 *data, FMSTR_U32 size)
+{
+    if (epIn.busy)
+    {
+        epStats.busy++;
+        return FMSTR_FALSE;
+    }
+    epIn.buffer = data;
+    epIn.size   = size;
+    epIn.done   = 0U;
+    epIn.busy   = true;
+    return FMSTR_TRUE;
+}
+
+static FMSTR_BOOL usb_ep_fifo_recv(FMSTR_U8 *data, FMSTR_U32 size)
+{
+    if (epOut.busy)
+    {
+        epStats.busy++;
+        return FMSTR_FALSE;
+    }
+    epOut.buffer = data;
+    epOut.size   = size;
+    epOut.done   = 0U;
+    epOut.busy   = true;
+    return FMSTR_TRUE;
+}
+
+const char *USB_EP_FIFO_Init(uint32_t maxPacket)
+{
+    struct termios tio;
+    const char *name;
+
+    epMaxPacket = maxPacket;
+    ptyMaster   = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if ((ptyMaster < 0) || (grantpt(ptyMaster) != 0) || (unlockpt(ptyMaster) != 0) ||
+        ((name = ptsname(ptyMaster)) == NULL))
+    {
+        return NULL;
+    }
+
+    /* Raw line discipline, no echo of the requests before the host tool configures the port */
+    ptySlave = open(name, O_RDWR | O_NOCTTY);
+    if ((ptySlave < 0) || (tcgetattr(ptySlave, &tio) != 0))
+    {
+        return NULL;
+    }
+    cfmakeraw(&tio);
+    (void)tcsetattr(ptySlave, TCSANOW, &tio);
+
+    FMSTR_SerialUsbRegisterAppFunctions(usb_ep_fifo_send);
+    FMSTR_SerialUsbRegisterRxFunction(usb_ep_fifo_recv);
+    return name;
+}
+
+void USB_EP_FIFO_Configure(void)
+{
+    epIn.busy  = false;
+    epOut.busy = false;
+    FMSTR_SerialUsbProcessEvent(FMSTR_SERIAL_USBCDC_EVENT_TYPE_CONFIGURED, NULL, 0U);
+}
+
+void USB_EP_FIFO_Poll(void)
+{
+    /* IN: packets to the host until the transfer is written or the terminal is full */
+    while (epIn.busy && !epInHold)
+    {
+        uint32_t chunk = epIn.size - epIn.done;
+        ssize_t n      = 0;
+
+        if (chunk > epMaxPacket)
+        {
+            chunk = epMaxPacket;
+        }
+        if (chunk > 0U)
+        {
+            n = write(ptyMaster, epIn.buffer + epIn.done, chunk);
+            if (n <= 0)
+            {
+                break;
+            }
+            epIn.done += (uint32_t)n;
+        }
+        else
+        {
+            /* Zero-length packet requested by the driver */
+            epStats.inZlps++;
+        }
+
+        if ((uint32_t)n == chunk)
+        {
+            epStats.inPackets++;
+        }
+        if (epIn.done == epIn.size)
+        {
+            epIn.busy = false;
+            epStats.inTransfers++;
+            FMSTR_SerialUsbProcessEvent(FMSTR_SERIAL_USBCDC_EVENT_TYPE_SENT, epIn.buffer, epIn.size);
+        }
+    }
+
+    /* OUT: packets from the host until a short one or a full buffer ends the transfer */
+    while (epOut.busy)
+    {
+        uint32_t chunk = epOut.size - epOut.done;
+        ssize_t n;
+
+        if (chunk > epMaxPacket)
+        {
+            chunk = epMaxPacket;
+        }
+        n = read(ptyMaster, epOut.buffer + epOut.done, chunk);
+        if (n <= 0)
+        {
+            break;
+        }
+        epOut.done += (uint32_t)n;
+        epStats.outPackets++;
+
+        if (((uint32_t)n < epMaxPacket) || (epOut.done == epOut.size))
+        {
+            epOut.busy = false;
+            epStats.outTransfers++;
+            /* The driver primes the other buffer from within the event */
+            FMSTR_SerialUsbProcessEvent(FMSTR_SERIAL_USBCDC_EVENT_TYPE_RECEIVED, epOut.buffer, epOut.done);
+        }
+    }
+}
+
+const usb_ep_fifo_stats_t *USB_EP_FIFO_GetStats(void)
+{
+    return &epStats;
+}
+
+void USB_EP_FIFO_HoldIn(bool hold)
+{
+    epInHold = hold;
+}
+
+bool USB_EP_FIFO_ReceiveZlp(void)
+{
+    if (!epOut.busy)
+    {
+        return false;
+    }
+    epOut.busy = false;
+    epStats.outPackets++;
+    epStats.outTransfers++;
+    FMSTR_SerialUsbProcessEvent(FMSTR_SERIAL_USBCDC_EVENT_TYPE_RECEIVED, epOut.buffer, epOut.done);
+    return true;
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file  usb_ep_fifo.h
+ * @brief The usb_ep_fifo.h file declares the host emulation of the CDC-ACM bulk endpoints.
+ *
+ * @details Stands in for usb_link.c and the USB device stack of the board. The bulk IN and OUT
+ *          endpoints are FIFOs of one transfer each, like the CDC-ACM class driver: a second send or
+ *          receive while one is pending is refused. Their far end is a pseudo terminal, a host tool
+ *          opens its slave side as a serial port. USB_EP_FIFO_Poll() plays the USB interrupt: an OUT
+ *          transfer completes with the first short packet or when the buffer is full, an IN transfer
+ *          once all its packets were written, and each completion is reported to
+ *          freemaster_serial_usb.c as on the board.
+ */
+
+#ifndef USB_EP_FIFO_H_
+#define USB_EP_FIFO_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*! @brief Transfer counters of the emulated endpoints. */
+typedef struct
+{
+    uint32_t outTransfers; /*!< Completed OUT transfers, each one a RECEIVED event. */
+    uint32_t outPackets;   /*!< OUT packets, a transfer takes several when the buffer is larger. */
+    uint32_t inTransfers;  /*!< Completed IN transfers, each one a SENT event. */
+    uint32_t inPackets;    /*!< IN packets including zero-length packets. */
+    uint32_t inZlps;       /*!< Zero-length packets ending a transfer of full packets. */
+    uint32_t busy;         /*!< Send or receive refused because the endpoint had a transfer pending. */
+} usb_ep_fifo_stats_t;
+
+/*! @brief       Open the pseudo terminal and register the endpoint functions of freemaster_serial_usb.c.
+ *  @param[in]   maxPacket bulk max packet size, 512 at high speed or 64 at full speed.
+ *  @return      The slave device path, NULL on failure.
+ *  @constraints Call before FMSTR_Init().
+ */
+const char *USB_EP_FIFO_Init(uint32_t maxPacket);
+
+/*! @brief       Configure the device as the host would after enumeration, the driver primes the OUT endpoint.
+ *  @constraints Call after FMSTR_Init().
+ */
+void USB_EP_FIFO_Configure(void);
+
+/*! @brief       Move data between the pseudo terminal and the pending transfers and report completions.
+ *  @constraints Call from the main loop, it replaces the USB interrupt.
+ */
+void USB_EP_FIFO_Poll(void);
+
+/*! @brief       Transfer counters since USB_EP_FIFO_Init().
+ */
+const usb_ep_fifo_stats_t *USB_EP_FIFO_GetStats(void);
+
+/*! @brief       Stop or resume taking IN packets, as a host that does not read the port.
+ *  @details     Test hook, a held IN transfer stays pending and the driver's second buffer fills up.
+ */
+void USB_EP_FIFO_HoldIn(bool hold);
+
+/*! @brief       Complete the pending OUT transfer with a zero-length packet.
+ *  @details     Test hook, a pseudo terminal cannot carry the zero-length packet a host sends after a
+ *               transfer of full packets.
+ *  @return      false when no OUT transfer was pending.
+ */
+bool USB_EP_FIFO_ReceiveZlp(void);
+
+#endif /* USB_EP_FIFO_H_ */
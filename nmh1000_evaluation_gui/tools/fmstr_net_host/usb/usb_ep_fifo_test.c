@@ -0,0 +1,417 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file  usb_ep_fifo_test.c
+ * @brief The usb_ep_fifo_test.c file checks freemaster_serial_usb.c on the endpoint emulation.
+ *
+ * @details Plays the host on the pseudo terminal of usb_ep_fifo.c at full speed (64-byte packets)
+ *          and walks the packet handling of the driver's double buffers through the cases a serial
+ *          port never shows:
+ *
+ *          - a request split over several OUT transfers, and one longer than a driver buffer;
+ *          - a request and a response ending exactly on a buffer boundary, followed by a
+ *            zero-length packet;
+ *          - a response of three buffers while the host does not read, both buffers stay owned
+ *            until it reads again.
+ *
+ *          Each case checks the response frame and the endpoint counters. Exits non-zero on the
+ *          first failure, run through "make check".
+ */
+
+#define _GNU_SOURCE /* cfmakeraw() */
+
+#include <fcntl.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "freemaster.h"
+#include "freemaster_protocol.h"
+#include "usb_device_descriptor.h"
+#include "usb_ep_fifo.h"
+#include "freemaster_usb.h"
+
+/*! @brief Poll rounds a response may take before the case fails. */
+#define TEST_MAX_POLLS (1000)
+
+/*! @brief Memory the requests read and write. */
+static uint8_t testMem[1200];
+
+FMSTR_TSA_TABLE_BEGIN(test_table)
+    FMSTR_TSA_RW_MEM(testMem, FMSTR_TSA_UINT8, testMem, sizeof(testMem))
+FMSTR_TSA_TABLE_END()
+
+FMSTR_TSA_TABLE_LIST_BEGIN()
+    FMSTR_TSA_TABLE(test_table)
+FMSTR_TSA_TABLE_LIST_END()
+
+/*! @brief Encoded frame, SOB bytes inside it doubled. */
+typedef struct
+{
+    uint8_t data[2 * FMSTR_COMM_BUFFER_SIZE + 16];
+    size_t size;
+} test_frame_t;
+
+static int hostFd;
+
+static void fail(const char *fmt, ...)
+{
+    va_list args;
+
+    va_start(args, fmt);
+    fputs("FAIL: ", stderr);
+    vfprintf(stderr, fmt, args);
+    fputc('\n', stderr);
+    va_end(args);
+    exit(1);
+}
+
+static uint16_t crc16(uint16_t crc, uint8_t data)
+{
+    crc ^= (uint16_t)(data << 8);
+    for (int i = 0; i < 8; i++)
+    {
+        crc = (crc & 0x8000U) ? (uint16_t)((crc << 1) ^ 0x1021U) : (uint16_t)(crc << 1);
+    }
+    return crc;
+}
+
+static void frame_put(test_frame_t *frame, uint8_t b)
+{
+    frame->data[frame->size++] = b;
+    if (b == FMSTR_SOB)
+    {
+        frame->data[frame->size++] = b;
+    }
+}
+
+/*! @brief Large-message frame: SOB, [FMSTR_SERIAL_LARGE, command] or status, 16-bit length, data, CRC16. */
+static void frame_encode(test_frame_t *frame, int cmd, uint8_t status, const uint8_t *data, size_t size)
+{
+    uint16_t crc = 0xFFFFU;
+    uint8_t head[3];
+    size_t n = 0;
+
+    frame->size             = 0;
+    frame->data[frame->size++] = FMSTR_SOB;
+    if (cmd >= 0)
+    {
+        frame->data[frame->size++] = FMSTR_SERIAL_LARGE;
+        head[n++]                  = (uint8_t)cmd;
+    }
+    else
+    {
+        head[n++] = status;
+    }
+    head[n++] = (uint8_t)(size >> 8);
+    head[n++] = (uint8_t)size;
+    for (size_t i = 0; i < n; i++)
+    {
+        crc = crc16(crc, head[i]);
+        frame_put(frame, head[i]);
+    }
+    for (size_t i = 0; i < size; i++)
+    {
+        crc = crc16(crc, data[i]);
+        frame_put(frame, data[i]);
+    }
+    frame_put(frame, (uint8_t)(crc >> 8));
+    frame_put(frame, (uint8_t)crc);
+}
+
+static size_t put_uleb(uint8_t *out, uint32_t value)
+{
+    size_t n = 0;
+
+    do
+    {
+        out[n] = (uint8_t)(value & 0x7FU);
+        value >>= 7;
+        if (value != 0U)
+        {
+            out[n] |= 0x80U;
+        }
+        n++;
+    } while (value != 0U);
+    return n;
+}
+
+static size_t readmem_payload(uint8_t *payload, size_t offset, size_t size)
+{
+    size_t n = put_uleb(payload, (uint32_t)(uintptr_t)&testMem[offset]);
+
+    return n + put_uleb(payload + n, (uint32_t)size);
+}
+
+static size_t writemem_payload(uint8_t *payload, size_t offset, const uint8_t *data, size_t size)
+{
+    size_t n = 0;
+
+    payload[n++] = 0U; /* flags, no mask */
+    n += put_uleb(payload + n, (uint32_t)(uintptr_t)&testMem[offset]);
+    n += put_uleb(payload + n, (uint32_t)size);
+    memcpy(payload + n, data, size);
+    return n + size;
+}
+
+static void host_write(const uint8_t *data, size_t size)
+{
+    if (write(hostFd, data, size) != (ssize_t)size)
+    {
+        fail("host write of %zu bytes", size);
+    }
+}
+
+/*! @brief One round of the board main loop: endpoint completions, then the protocol. */
+static void poll_board(void)
+{
+    USB_EP_FIFO_Poll();
+    FMSTR_Poll();
+}
+
+/*! @brief Poll until the expected response arrived byte for byte, nothing may follow it. */
+static void expect_response(const char *what, const test_frame_t *expected)
+{
+    uint8_t rx[sizeof(expected->data) + 64];
+    size_t got = 0;
+
+    for (int i = 0; i < TEST_MAX_POLLS && got < expected->size; i++)
+    {
+        ssize_t n;
+
+        poll_board();
+        n = read(hostFd, rx + got, sizeof(rx) - got);
+        if (n > 0)
+        {
+            got += (size_t)n;
+        }
+    }
+    for (int i = 0; i < 10; i++)
+    {
+        ssize_t n;
+
+        poll_board();
+        n = read(hostFd, rx + got, sizeof(rx) - got);
+        if (n > 0)
+        {
+            got += (size_t)n;
+        }
+    }
+    if (got != expected->size || memcmp(rx, expected->data, got) != 0)
+    {
+        fail("%s: %zu response bytes, %zu expected or content differs", what, got, expected->size);
+    }
+}
+
+/*! @brief Expected READMEM response of testMem[offset..offset+size). */
+static void readmem_response(test_frame_t *frame, size_t offset, size_t size)
+{
+    frame_encode(frame, -1, FMSTR_STS_OK, &testMem[offset], size);
+}
+
+/*! @brief Largest READMEM size whose encoded response is exactly the given length, 0 if none. */
+static size_t readmem_size_for(size_t encoded)
+{
+    test_frame_t frame;
+
+    for (size_t size = encoded; size > 0U; size--)
+    {
+        readmem_response(&frame, 0, size);
+        if (frame.size == encoded)
+        {
+            return size;
+        }
+    }
+    return 0;
+}
+
+/*!
+ * @brief A request arriving in pieces: two short transfers, and a write longer than a driver buffer
+ */
+static void test_split_request(void)
+{
+    const usb_ep_fifo_stats_t *stats = USB_EP_FIFO_GetStats();
+    uint8_t payload[FMSTR_COMM_BUFFER_SIZE];
+    uint8_t data[700];
+    test_frame_t request, response;
+    uint32_t outTransfers;
+
+    /* READMEM request cut in the middle, each half a transfer of its own */
+    frame_encode(&request, FMSTR_CMD_READMEM, 0, payload, readmem_payload(payload, 0, 16));
+    outTransfers = stats->outTransfers;
+    host_write(request.data, 3);
+    poll_board();
+    poll_board();
+    host_write(request.data + 3, request.size - 3);
+    readmem_response(&response, 0, 16);
+    expect_response("split request", &response);
+    if (stats->outTransfers - outTransfers != 2U)
+    {
+        fail("split request: %u OUT transfers instead of 2", stats->outTransfers - outTransfers);
+    }
+
+    /* WRITEMEM of 700 bytes, the request fills one driver buffer and goes on in the other */
+    for (size_t i = 0; i < sizeof(data); i++)
+    {
+        data[i] = (uint8_t)(i * 13U + 5U);
+    }
+    frame_encode(&request, FMSTR_CMD_WRITEMEM, 0, payload, writemem_payload(payload, 100, data, sizeof(data)));
+    outTransfers = stats->outTransfers;
+    host_write(request.data, request.size);
+    frame_encode(&response, -1, FMSTR_STS_OK, NULL, 0);
+    expect_response("long request", &response);
+    if (memcmp(&testMem[100], data, sizeof(data)) != 0)
+    {
+        fail("long request: memory not written");
+    }
+    if (stats->outTransfers - outTransfers < 2U)
+    {
+        fail("long request: received in a single transfer");
+    }
+    printf("split request: ok\n");
+}
+
+/*!
+ * @brief Frames ending exactly on a buffer boundary, each direction followed by a zero-length packet
+ */
+static void test_packet_boundary(void)
+{
+    const usb_ep_fifo_stats_t *stats = USB_EP_FIFO_GetStats();
+    uint8_t payload[FMSTR_COMM_BUFFER_SIZE];
+    test_frame_t request, response;
+    size_t size;
+    uint32_t zlps;
+
+    /* IN: response of exactly one buffer, the driver ends the transfer with a ZLP */
+    size = readmem_size_for(FMSTR_USB_PACKET_SIZE);
+    if (size == 0U)
+    {
+        fail("boundary: no READMEM size gives a %u-byte response", FMSTR_USB_PACKET_SIZE);
+    }
+    frame_encode(&request, FMSTR_CMD_READMEM, 0, payload, readmem_payload(payload, 0, size));
+    zlps = stats->inZlps;
+    host_write(request.data, request.size);
+    readmem_response(&response, 0, size);
+    expect_response("response on a buffer boundary", &response);
+    if (stats->inZlps - zlps != 1U)
+    {
+        fail("response on a buffer boundary: %u ZLPs instead of 1", stats->inZlps - zlps);
+    }
+
+    /* OUT: request of exactly one buffer, completed by the full buffer and followed by a ZLP */
+    size = 0;
+    for (size_t n = FMSTR_USB_PACKET_SIZE; n > 0U && size == 0U; n--)
+    {
+        frame_encode(&request, FMSTR_CMD_WRITEMEM, 0, payload, writemem_payload(payload, 0, testMem + 600, n));
+        if (request.size == FMSTR_USB_PACKET_SIZE)
+        {
+            size = n;
+        }
+    }
+    if (size == 0U)
+    {
+        fail("boundary: no WRITEMEM size gives a %u-byte request", FMSTR_USB_PACKET_SIZE);
+    }
+    host_write(request.data, request.size);
+    poll_board();
+    if (!USB_EP_FIFO_ReceiveZlp())
+    {
+        fail("request on a buffer boundary: no OUT transfer primed for the ZLP");
+    }
+    frame_encode(&response, -1, FMSTR_STS_OK, NULL, 0);
+    expect_response("request on a buffer boundary", &response);
+
+    /* the zero-length buffer was given back, the next request goes through */
+    frame_encode(&request, FMSTR_CMD_READMEM, 0, payload, readmem_payload(payload, 0, 8));
+    host_write(request.data, request.size);
+    readmem_response(&response, 0, 8);
+    expect_response("request after the ZLP", &response);
+    printf("packet boundary: ok\n");
+}
+
+/*!
+ * @brief A response of three buffers while the host does not read
+ */
+static void test_tx_stall(void)
+{
+    const usb_ep_fifo_stats_t *stats = USB_EP_FIFO_GetStats();
+    uint8_t payload[FMSTR_COMM_BUFFER_SIZE];
+    test_frame_t request, response;
+    uint8_t byte;
+    uint32_t inTransfers;
+
+    frame_encode(&request, FMSTR_CMD_READMEM, 0, payload, readmem_payload(payload, 0, 1020));
+    readmem_response(&response, 0, 1020);
+    if (response.size <= 2U * FMSTR_USB_PACKET_SIZE)
+    {
+        fail("stall: response of %zu bytes fits both buffers", response.size);
+    }
+
+    USB_EP_FIFO_HoldIn(true);
+    inTransfers = stats->inTransfers;
+    host_write(request.data, request.size);
+    for (int i = 0; i < TEST_MAX_POLLS; i++)
+    {
+        poll_board();
+    }
+    if (read(hostFd, &byte, 1) > 0 || stats->inTransfers != inTransfers)
+    {
+        fail("stall: data went out while the host did not read");
+    }
+    if (stats->busy != 0U)
+    {
+        fail("stall: the driver sent while a transfer was pending");
+    }
+
+    /* the host reads again, the response comes complete and in order */
+    USB_EP_FIFO_HoldIn(false);
+    expect_response("stalled response", &response);
+    if (stats->inTransfers - inTransfers != 3U)
+    {
+        fail("stalled response: %u IN transfers instead of 3", stats->inTransfers - inTransfers);
+    }
+    printf("tx stall: ok\n");
+}
+
+int main(void)
+{
+    struct termios tio;
+    const char *port;
+
+    for (size_t i = 0; i < sizeof(testMem); i++)
+    {
+        testMem[i] = (uint8_t)(i * 7U + 1U);
+    }
+
+    port = USB_EP_FIFO_Init(FS_CDC_VCOM_BULK_PACKET_SIZE);
+    if (port == NULL)
+    {
+        fail("pseudo terminal");
+    }
+    hostFd = open(port, O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if ((hostFd < 0) || (tcgetattr(hostFd, &tio) != 0))
+    {
+        fail("open %s", port);
+    }
+    cfmakeraw(&tio);
+    (void)tcsetattr(hostFd, TCSANOW, &tio);
+
+    if (FMSTR_Init() == FMSTR_FALSE)
+    {
+        fail("FMSTR_Init");
+    }
+    USB_EP_FIFO_Configure();
+
+    test_split_request();
+    test_packet_boundary();
+    test_tx_stall();
+    return 0;
+}
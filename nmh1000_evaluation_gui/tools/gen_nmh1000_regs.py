@@ -0,0 +1,355 @@
+#!/usr/bin/env python3
+#
+# Copyright 2024 NXP
+# All rights reserved.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+"""Generate the NMH1000 register descriptor table (sensors/nmh1000_regs.h/.c).
+
+Access, reset value and the reserved bits of each register come from the GUI
+register map (freemaster_gui/sensors/nmh1000/reg.csv), the register enum names
+and field masks from sensors/nmh1000.h. The project runs this as pre-build step;
+the outputs are only rewritten when their contents change.
+
+    gen_nmh1000_regs.py reg.csv nmh1000.h outdir
+    gen_nmh1000_regs.py --check reg.csv nmh1000.h outdir
+"""
+
+import argparse
+import csv
+import os
+import re
+import sys
+
+OUTPUT_BASE = "nmh1000_regs"
+
+# reg.csv columns
+COL_NAME, COL_ADDRESS, COL_ACCESS, COL_SIZE, COL_DATA, COL_BIT7 = range(6)
+
+# Rows reg.csv lists as read-only although their description makes them host writable
+ACCESS_OVERRIDES = {
+    "USER_ASSERT_THRESH": "R/W",
+    "USER_CLEAR_THRESH": "R/W",
+    "I2C_ADDR": "R/W",
+}
+
+# Reset values differing from the reg.csv Data column, taken from the register descriptions
+RESET_OVERRIDES = {
+    "STATUS": 0x62,    # MDO, MDR and RST_STAT are set on reset
+    "WHO_AM_I": 0x01,  # generic open market value
+    "I2C_ADDR": 0x60,  # default address loaded at exit of reset
+}
+
+# Registers the sensor changes by itself: status and data, CONTROL_REG1 for its self-clearing
+# ONE_SHOT and RST bits. Everything else only changes when written and may be cached.
+VOLATILE = {"STATUS", "CONTROL_REG1", "OUT_M_REG"}
+
+# The sensor does not auto-increment the register address, every read is one register
+BURST_MAX = 1
+
+ENUM_ENTRY = re.compile(r"^\s*(NMH1000_\w+)\s*=\s*(0x[0-9A-Fa-f]+|\d+)\s*,", re.M)
+REGISTER_BLOCK = re.compile(r"\*\* Register: (\w+)\s*\n\*\* Enum: (\w+)")
+FIELD_MASK = re.compile(r"#define\s+NMH1000_(\w+)_MASK\s+\(\(uint8_t\)\s*(0x[0-9A-Fa-f]+)\)")
+
+HEADER_TEMPLATE = """\
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/* Generated by tools/gen_nmh1000_regs.py from reg.csv and nmh1000.h, do not edit. */
+
+/**
+ * @file nmh1000_regs.h
+ * @brief The nmh1000_regs.h file declares the NMH1000 register descriptor table.
+ *
+ * @details One descriptor per register, indexed by register address. Writes to registers without
+ *          NMH1000_REG_WRITE or setting reserved bits are rejected before they reach the bus.
+ *          Registers without NMH1000_REG_VOLATILE only change when written and may be served from
+ *          a shadow copy. NMH1000_REG_BurstLength() gives the registers one transfer may cover.
+ */
+
+#ifndef NMH1000_REGS_H_
+#define NMH1000_REGS_H_
+
+/* Standard C Includes */
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief Number of registers, NMH1000_STATUS .. NMH1000_I2C_ADDR. */
+#define NMH1000_NUM_REGISTERS ({count}U)
+
+/*! @brief Most registers one read transfer may cover. */
+#define NMH1000_REG_BURST_MAX ({burst}U)
+
+/*! @brief Descriptor flags. */
+#define NMH1000_REG_READ     (0x01U) /*!< Register can be read. */
+#define NMH1000_REG_WRITE    (0x02U) /*!< Register can be written. */
+#define NMH1000_REG_VOLATILE (0x04U) /*!< Sensor changes the value by itself, do not cache. */
+
+/*! @brief This structure defines one register. */
+typedef struct
+{{
+    uint8_t address;    /*!< Register address. */
+    uint8_t flags;      /*!< NMH1000_REG_xxx. */
+    uint8_t writeMask;  /*!< Bits that may be written, the others are reserved. */
+    uint8_t resetValue; /*!< Value after POR or soft reset. */
+}} nmh1000_reg_desc_t;
+
+/*! @brief Register descriptors, indexed by register address. */
+extern const nmh1000_reg_desc_t cNmh1000Registers[NMH1000_NUM_REGISTERS];
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+/*! @brief       Look up the descriptor of a register.
+ *  @param[in]   address  register address.
+ *  @return      descriptor, or NULL when there is no such register.
+ *  @constraints None
+ *  @reeentrant  Yes
+ */
+static inline const nmh1000_reg_desc_t *NMH1000_REG_Find(uint8_t address)
+{{
+    return (address < NMH1000_NUM_REGISTERS) ? &cNmh1000Registers[address] : (const nmh1000_reg_desc_t *)0;
+}}
+
+/*! @brief       Check whether a register exists and can be read.
+ *  @param[in]   address  register address.
+ *  @return      true when the register can be read.
+ *  @constraints None
+ *  @reeentrant  Yes
+ */
+bool NMH1000_REG_IsReadable(uint8_t address);
+
+/*! @brief       Check whether a value may be written to a register.
+ *  @param[in]   address  register address.
+ *  @param[in]   value    value to write.
+ *  @return      true when the register is writable and the value leaves the reserved bits clear.
+ *  @constraints None
+ *  @reeentrant  Yes
+ */
+bool NMH1000_REG_IsWritable(uint8_t address, uint8_t value);
+
+/*! @brief       Check whether the last value read or written is still the register contents.
+ *  @param[in]   address  register address.
+ *  @return      true when the register is readable and not volatile.
+ *  @constraints None
+ *  @reeentrant  Yes
+ */
+bool NMH1000_REG_IsCacheable(uint8_t address);
+
+/*! @brief       Number of consecutive readable registers one transfer can read from an address.
+ *  @param[in]   address  first register address.
+ *  @param[in]   maxLen   most registers wanted.
+ *  @return      1 .. MIN(maxLen, NMH1000_REG_BURST_MAX), 0 when the first register cannot be read.
+ *  @constraints None
+ *  @reeentrant  Yes
+ */
+uint8_t NMH1000_REG_BurstLength(uint8_t address, uint8_t maxLen);
+
+#endif // NMH1000_REGS_H_
+"""
+
+SOURCE_TEMPLATE = """\
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/* Generated by tools/gen_nmh1000_regs.py from reg.csv and nmh1000.h, do not edit. */
+
+/**
+ * @file  nmh1000_regs.c
+ * @brief The nmh1000_regs.c file defines the NMH1000 register descriptor table.
+ */
+
+//-----------------------------------------------------------------------
+// SDK Includes
+//-----------------------------------------------------------------------
+#include <stddef.h>
+#include <stdint.h>
+
+#include "nmh1000.h"
+#include "nmh1000_regs.h"
+
+//-----------------------------------------------------------------------
+// Global Variables
+//-----------------------------------------------------------------------
+const nmh1000_reg_desc_t cNmh1000Registers[NMH1000_NUM_REGISTERS] = {{
+{rows}
+}};
+
+//-----------------------------------------------------------------------
+// Functions
+//-----------------------------------------------------------------------
+bool NMH1000_REG_IsReadable(uint8_t address)
+{{
+    const nmh1000_reg_desc_t *pReg = NMH1000_REG_Find(address);
+
+    return (pReg != NULL) && ((pReg->flags & NMH1000_REG_READ) != 0U);
+}}
+
+bool NMH1000_REG_IsWritable(uint8_t address, uint8_t value)
+{{
+    const nmh1000_reg_desc_t *pReg = NMH1000_REG_Find(address);
+
+    return (pReg != NULL) && ((pReg->flags & NMH1000_REG_WRITE) != 0U) && ((value & ~pReg->writeMask) == 0U);
+}}
+
+bool NMH1000_REG_IsCacheable(uint8_t address)
+{{
+    const nmh1000_reg_desc_t *pReg = NMH1000_REG_Find(address);
+
+    return (pReg != NULL) && ((pReg->flags & (NMH1000_REG_READ | NMH1000_REG_VOLATILE)) == NMH1000_REG_READ);
+}}
+
+uint8_t NMH1000_REG_BurstLength(uint8_t address, uint8_t maxLen)
+{{
+    uint8_t length = 0U;
+
+    if (maxLen > NMH1000_REG_BURST_MAX)
+    {{
+        maxLen = NMH1000_REG_BURST_MAX;
+    }}
+    while ((length < maxLen) && NMH1000_REG_IsReadable((uint8_t)(address + length)))
+    {{
+        length++;
+    }}
+
+    return length;
+}}
+"""
+
+
+def parse_int(text):
+    return int(text.strip(), 0)
+
+
+def read_register_map(path):
+    """Return the reg.csv rows as dicts, in address order."""
+    registers = []
+    with open(path, newline="", encoding="utf-8-sig") as f:
+        rows = csv.reader(f, skipinitialspace=True)
+        next(rows)  # column titles
+        for row in rows:
+            if len(row) < COL_BIT7 + 8 or not row[COL_NAME].strip():
+                continue
+            name = row[COL_NAME].strip()
+            bits = [row[COL_BIT7 + i].strip() for i in range(8)]
+            registers.append({
+                "name": name,
+                "address": parse_int(row[COL_ADDRESS]),
+                "access": ACCESS_OVERRIDES.get(name, row[COL_ACCESS].strip()),
+                "size": parse_int(row[COL_SIZE]),
+                "reset": RESET_OVERRIDES.get(name, parse_int(row[COL_DATA])),
+                # bit columns run from bit 7 down to bit 0, '-' marks a reserved bit
+                "mask": sum(1 << (7 - i) for i, bit in enumerate(bits) if bit not in ("", "-")),
+            })
+    registers.sort(key=lambda reg: reg["address"])
+    return registers
+
+
+def read_sensor_header(path):
+    """Return the enum name per address and the field masks per register name from nmh1000.h."""
+    with open(path, encoding="utf-8") as f:
+        text = f.read()
+
+    enum_names = {}
+    for name, value in ENUM_ENTRY.findall(text):
+        enum_names.setdefault(parse_int(value), name)
+
+    field_masks = {}
+    for match in REGISTER_BLOCK.finditer(text):
+        register = match.group(1)
+        end = text.find("** Register:", match.end())
+        block = text[match.end():end if end >= 0 else len(text)]
+        for field, mask in FIELD_MASK.findall(block):
+            if field.startswith(register + "_"):
+                field_masks[register] = field_masks.get(register, 0) | parse_int(mask)
+
+    return enum_names, field_masks
+
+
+def build_rows(registers, enum_names, field_masks):
+    if [reg["address"] for reg in registers] != list(range(len(registers))):
+        raise ValueError("reg.csv addresses are not contiguous from 0x00")
+
+    rows = []
+    for reg in registers:
+        if reg["size"] != 8:
+            raise ValueError("%s: only 8-bit registers are supported" % reg["name"])
+        enum = enum_names.get(reg["address"])
+        if enum is None:
+            raise ValueError("%s: no enum entry for address 0x%02X in nmh1000.h" % (reg["name"], reg["address"]))
+        header_mask = field_masks.get(reg["name"])
+        if header_mask is not None and header_mask != reg["mask"]:
+            raise ValueError("%s: reg.csv bits 0x%02X differ from nmh1000.h masks 0x%02X"
+                             % (reg["name"], reg["mask"], header_mask))
+
+        flags = []
+        if "R" in reg["access"]:
+            flags.append("NMH1000_REG_READ")
+        if "W" in reg["access"]:
+            flags.append("NMH1000_REG_WRITE")
+        if reg["name"] in VOLATILE:
+            flags.append("NMH1000_REG_VOLATILE")
+        write_mask = reg["mask"] if "W" in reg["access"] else 0
+
+        rows.append("    {%s, %s, 0x%02XU, 0x%02XU}, /* %s */"
+                    % (enum, " | ".join(flags) or "0U", write_mask, reg["reset"], reg["name"]))
+    return rows
+
+
+def update(path, contents, check):
+    """Write a file unless it already has the contents, return True when it was out of date."""
+    try:
+        with open(path, encoding="utf-8", newline="") as f:
+            if f.read() == contents:
+                return False
+    except FileNotFoundError:
+        pass
+    if not check:
+        with open(path, "w", encoding="utf-8", newline="\n") as f:
+            f.write(contents)
+    return True
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("csv", help="GUI register map, freemaster_gui/sensors/nmh1000/reg.csv")
+    parser.add_argument("header", help="sensor register definitions, sensors/nmh1000.h")
+    parser.add_argument("outdir", help="directory receiving nmh1000_regs.h and nmh1000_regs.c")
+    parser.add_argument("--check", action="store_true", help="only report whether the outputs are up to date")
+    opts = parser.parse_args()
+
+    registers = read_register_map(opts.csv)
+    enum_names, field_masks = read_sensor_header(opts.header)
+    try:
+        rows = build_rows(registers, enum_names, field_masks)
+    except ValueError as err:
+        sys.stderr.write("gen_nmh1000_regs: %s\n" % err)
+        return 1
+
+    outputs = {
+        OUTPUT_BASE + ".h": HEADER_TEMPLATE.format(count=len(rows), burst=BURST_MAX),
+        OUTPUT_BASE + ".c": SOURCE_TEMPLATE.format(rows="\n".join(rows)),
+    }
+    stale = [name for name, contents in outputs.items()
+             if update(os.path.join(opts.outdir, name), contents, opts.check)]
+
+    if opts.check and stale:
+        sys.stderr.write("gen_nmh1000_regs: out of date: %s\n" % ", ".join(stale))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
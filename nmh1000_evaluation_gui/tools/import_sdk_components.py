@@ -0,0 +1,161 @@
+#!/usr/bin/env python3
+#
+# Copyright 2024 NXP
+# All rights reserved.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+"""Copy the MCUXpresso SDK components of the network, USB and RTT builds into a project.
+
+The Debug_NET (NMH1000_FMSTR_NET) and Debug_USB (NMH1000_FMSTR_USB) configurations
+of the frdmmcxn947 project build lwIP, the ENET and LAN8741 PHY drivers and the USB
+device stack, the Debug_RTT (NMH1000_FMSTR_RTT) configuration of both projects the
+SEGGER RTT sources; none of them are part of this repository. They come from an
+unpacked SDK package of the board built with the lwIP and USB middleware selected,
+the RTT sources also from the RTT folder of the J-Link software package. Every file
+is looked up by name, so the layout differences between SDK releases do not matter.
+
+    import_sdk_components.py SDK_DIR PROJECT_DIR            (net, usb and rtt)
+    import_sdk_components.py --net SDK_DIR PROJECT_DIR
+    import_sdk_components.py --usb SDK_DIR PROJECT_DIR
+    import_sdk_components.py --rtt SDK_DIR PROJECT_DIR      (the only one for frdmmcxa153)
+
+Project folders written: lwip, enet, phy (net), usb, osa (usb) and rtt (rtt). The
+Debug and Release configurations do not build them.
+"""
+
+import argparse
+import os
+import shutil
+import sys
+
+# lwIP port of the MCXN947 ENET, select another with --port for a different SDK release
+DEFAULT_PORT = "enet_ethernetif_qos.c"
+
+# Sub-trees of the lwIP sources; apps stay out, the FreeMASTER driver uses the raw TCP API
+LWIP_SRC_DIRS = ("api", "core", "include", "netif")
+
+# Project folder -> files. A trailing "?" marks a file only some SDK releases have.
+# sys_arch.c of the lwIP port is left out: eth_link.c provides sys_now() from the power manager tick.
+NET_FILES = {
+    "lwip/port": ["ethernetif.c", "ethernetif.h", "ethernetif_priv.h"],
+    "enet": ["fsl_enet.c", "fsl_enet.h"],
+    "phy": ["fsl_phy.h", "fsl_phylan8741.c", "fsl_phylan8741.h"],
+}
+
+USB_FILES = {
+    "usb/include": ["usb.h", "usb_misc.h", "usb_spec.h", "usb_device.h"],
+    "usb/device": ["usb_device_dci.c", "usb_device_dci.h", "usb_device_ehci.c", "usb_device_ehci.h",
+                   "usb_device_ch9.c", "usb_device_ch9.h", "usb_device_class.c", "usb_device_class.h",
+                   "usb_device_cdc_acm.c", "usb_device_cdc_acm.h"],
+    "usb/phy": ["usb_phy.c", "usb_phy.h"],
+    "osa": ["fsl_os_abstraction.h", "fsl_os_abstraction_bm.c", "fsl_os_abstraction_config.h",
+            "fsl_os_abstraction_bm.h?"],
+}
+
+# Debug_RTT sets RTT_USE_ASM=0, the assembler variant of the write routine is not needed
+RTT_FILES = {
+    "rtt": ["SEGGER_RTT.c", "SEGGER_RTT.h", "SEGGER_RTT_Conf.h"],
+}
+
+
+class SdkIndex:
+    """File name -> paths in the SDK, the copies in the board examples last."""
+
+    def __init__(self, root):
+        self.root = root
+        self.files = {}
+        for dirpath, dirnames, filenames in os.walk(root):
+            dirnames.sort()
+            for name in filenames:
+                self.files.setdefault(name, []).append(os.path.join(dirpath, name))
+        for paths in self.files.values():
+            paths.sort(key=lambda p: (os.sep + "boards" + os.sep) in p)
+
+    def find(self, name):
+        paths = self.files.get(name)
+        return paths[0] if paths else None
+
+    def find_dir(self, marker):
+        """Directory holding the relative path marker, e.g. core/tcp.c for the lwIP sources."""
+        head, tail = os.path.split(marker)
+        for path in self.files.get(tail, []):
+            if path.endswith(os.sep + marker):
+                return path[:-len(marker) - 1]
+        return None
+
+
+def copy_files(index, project, groups, missing):
+    count = 0
+    for folder, names in groups.items():
+        for name in names:
+            optional = name.endswith("?")
+            name = name.rstrip("?")
+            path = index.find(name)
+            if path is None:
+                if not optional:
+                    missing.append(name)
+                continue
+            os.makedirs(os.path.join(project, folder), exist_ok=True)
+            shutil.copy2(path, os.path.join(project, folder, name))
+            count += 1
+    return count
+
+
+def copy_lwip_tree(index, project, missing):
+    src = index.find_dir(os.path.join("core", "tcp.c"))
+    port = index.find_dir(os.path.join("arch", "cc.h"))
+    if src is None or port is None:
+        missing.append("lwIP sources" if src is None else "lwIP port arch/cc.h")
+        return 0
+
+    count = 0
+    for sub in LWIP_SRC_DIRS:
+        dest = os.path.join(project, "lwip", "src", sub)
+        shutil.rmtree(dest, ignore_errors=True)
+        shutil.copytree(os.path.join(src, sub), dest)
+        count += sum(len(files) for _, _, files in os.walk(dest))
+    dest = os.path.join(project, "lwip", "port", "arch")
+    shutil.rmtree(dest, ignore_errors=True)
+    shutil.copytree(os.path.join(port, "arch"), dest)
+    count += len(os.listdir(dest))
+    return count
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("sdk", help="unpacked MCUXpresso SDK package of the board")
+    parser.add_argument("project", help="frdmmcxn947_nmh1000_fmstr or frdmmcxa153_nmh1000_fmstr project directory")
+    parser.add_argument("--net", action="store_true", help="only the components of the Debug_NET configuration")
+    parser.add_argument("--usb", action="store_true", help="only the components of the Debug_USB configuration")
+    parser.add_argument("--rtt", action="store_true", help="only the components of the Debug_RTT configuration")
+    parser.add_argument("--port", default=DEFAULT_PORT, help="lwIP ENET port source (default %s)" % DEFAULT_PORT)
+    opts = parser.parse_args()
+
+    if not os.path.isfile(os.path.join(opts.project, ".cproject")):
+        sys.stderr.write("import_sdk_components: %s is not an MCUXpresso project\n" % opts.project)
+        return 1
+    every = not opts.net and not opts.usb and not opts.rtt
+
+    index = SdkIndex(opts.sdk)
+    missing = []
+    count = 0
+    if opts.net or every:
+        net_files = dict(NET_FILES)
+        net_files["lwip/port"] = NET_FILES["lwip/port"] + [opts.port]
+        count += copy_lwip_tree(index, opts.project, missing)
+        count += copy_files(index, opts.project, net_files, missing)
+    if opts.usb or every:
+        count += copy_files(index, opts.project, USB_FILES, missing)
+    if opts.rtt or every:
+        count += copy_files(index, opts.project, RTT_FILES, missing)
+
+    if missing:
+        sys.stderr.write("import_sdk_components: not found in %s: %s\n" % (opts.sdk, ", ".join(missing)))
+        return 1
+    print("import_sdk_components: %d files copied to %s" % (count, opts.project))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())